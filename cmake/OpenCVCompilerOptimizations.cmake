@@ -309,7 +309,7 @@ if(X86 OR X86_64)
 
   if(NOT DEFINED CPU_DISPATCH)
     if(X86_64)
-      set(CPU_DISPATCH "SSE4_1;SSE4_2;AVX;FP16;AVX2;AVX512_SKX" CACHE STRING "${HELP_CPU_DISPATCH}")
+      set(CPU_DISPATCH "SSE4_1;SSE4_2;AVX;FP16;AVX2;AVX512_SKX;AVX512_CLX" CACHE STRING "${HELP_CPU_DISPATCH}")
     else()
       set(CPU_DISPATCH "SSE4_1;SSE4_2;AVX;FP16" CACHE STRING "${HELP_CPU_DISPATCH}")
     endif()
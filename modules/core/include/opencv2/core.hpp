@@ -546,6 +546,18 @@ The format of half precision floating point is defined in IEEE 754-2008.
 */
 CV_EXPORTS_W void convertFp16(InputArray src, OutputArray dst);
 
+/** @brief Converts an array to brain floating point numbers.
+
+This function converts FP32 (single precision floating point) from/to BF16 (the upper half of FP32 with 8-bit mantissa,
+see cv::bfloat16_t). CV_16U format is used to represent BF16 data. There are two use modes (src -> dst):
+CV_32F -> CV_16U and CV_16U -> CV_32F. FP32 values are rounded to the nearest even, BF16 -> FP32 conversion is exact.
+BF16 keeps the range of FP32, so it is preferred over FP16 for the large feature tensors and the weights of neural networks.
+
+@param src input array of CV_32F or CV_16U depth.
+@param dst output array of the same size and number of channels.
+*/
+CV_EXPORTS_W void convertBF16(InputArray src, OutputArray dst);
+
 /** @brief Performs a look-up table transform of an array.
 
 The function LUT fills the output array with values from the look-up table. Indices of the entries
@@ -920,6 +920,49 @@ protected:
 #endif
 };
 
+/** @brief Brain floating point number: the upper half of the IEEE 754 single precision number.
+
+It has the range of float with 8-bit mantissa. The conversion from float rounds to the nearest even.
+CV_16U format is used to represent BF16 data in Mat, see cv::convertBF16.
+*/
+class bfloat16_t
+{
+public:
+    bfloat16_t() : w(0) {}
+    explicit bfloat16_t(float x)
+    {
+        Cv32suf in;
+        in.f = x;
+        if ((in.u & 0x7fffffff) > 0x7f800000)
+            w = (ushort)((in.u >> 16) | 0x40);  // quiet NaN
+        else
+            w = (ushort)((in.u + 0x7fff + ((in.u >> 16) & 1)) >> 16);
+    }
+
+    operator float() const
+    {
+        Cv32suf out;
+        out.u = (unsigned)w << 16;
+        return out.f;
+    }
+
+    static bfloat16_t fromBits(ushort b)
+    {
+        bfloat16_t result;
+        result.w = b;
+        return result;
+    }
+    static bfloat16_t zero()
+    {
+        bfloat16_t result;
+        result.w = (ushort)0;
+        return result;
+    }
+    ushort bits() const { return w; }
+protected:
+    ushort w;
+};
+
 }
 #endif
 
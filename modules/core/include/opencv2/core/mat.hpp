@@ -2117,6 +2117,25 @@ public:
     MatAllocator* allocator;
     //! and the standard allocator
     static MatAllocator* getStdAllocator();
+    /** @brief Returns the allocator which caches the released buffers for the next allocations of similar size.
+
+    The cached buffers are kept by size classes in per-thread lists and a global list. Their total size is
+    limited by getBufferPoolController()->setMaxReservedSize() (the OPENCV_MAT_BUFFERPOOL_LIMIT environment
+    variable, 256 MB by default). Use it with setDefaultAllocator(), or set the OPENCV_MAT_BUFFERPOOL=1
+    environment variable to make it the default allocator. The memory held by the allocator is reported
+    by utils::getPoolAllocatorStatistics().
+    */
+    static MatAllocator* getPoolAllocator();
+    /** @brief Returns the allocator which backs the large buffers by huge pages (Linux only).
+
+    The buffers of OPENCV_MAT_HUGEPAGES_THRESHOLD bytes (2 MB by default) and larger are mapped with transparent
+    huge pages, or with the reserved huge pages if OPENCV_MAT_HUGEPAGES_MODE=explicit is set. The NUMA placement
+    of the pages is controlled by OPENCV_MAT_NUMA_POLICY: `default`, `interleave` across the allowed nodes,
+    or `first-touch` by the stripes of rows in parallel, so the pages are local to the threads of the following
+    parallel_for_ loops. Use it with setDefaultAllocator(), or set the OPENCV_MAT_HUGEPAGES=1 environment variable
+    to make it the default allocator.
+    */
+    static MatAllocator* getHugePageAllocator();
     static MatAllocator* getDefaultAllocator();
     static void setDefaultAllocator(MatAllocator* allocator);
 
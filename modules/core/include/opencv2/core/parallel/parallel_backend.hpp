@@ -40,6 +40,13 @@ namespace cv { namespace parallel {
  * - Configuration of compiler/linker options is responsibility of Application's scripts
  *
  *
+ * ### Builtin work-stealing backend
+ *
+ * `WORKSTEALING` backend is available on platforms with threads support (it is not selected automatically).
+ * It splits work adaptively (stripes are divided only when other workers are idle) and executes nested `parallel_for_()` calls in parallel.
+ * Activate it through `OPENCV_PARALLEL_BACKEND=WORKSTEALING` or `setParallelForBackend("WORKSTEALING")`.
+ *
+ *
  * ### Plugins support
  *
  * Runtime configuration options:
@@ -319,6 +319,8 @@ public:
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
+        EXTERNAL_DATA = 128,  //!< flag, write the data of the matrices into the binary file "<filename>.data" next to the
+                              //!< storage file. On reading, such matrices refer to the memory mapped data file without copying.
     };
     enum State
     {
@@ -233,6 +233,66 @@ The exact meaning of the return value depends on the threading framework used by
  */
 CV_EXPORTS_W int getThreadNum();
 
+/** @brief Isolated execution context for parallel regions.
+
+Each context owns its own set of worker threads (independent from the global thread pool configured
+by setNumThreads()) and optional CPU affinity of these workers. Context is installed on the calling thread
+through ParallelContext::Scope: all parallel_for_() calls made by this thread (including nested calls from
+the context workers) are dispatched into the installed context.
+
+This allows several pipelines in the same process to run with predictable latency without competing
+for the same worker threads:
+@code
+    cv::ParallelContext ctx(4, std::vector<int>{0, 1, 2, 3});  // 4 threads, workers are pinned to CPUs 0-3
+    {
+        cv::ParallelContext::Scope scope(ctx);
+        cv::resize(src, dst, Size(), 0.5, 0.5);  // processed by ctx workers
+    }
+@endcode
+
+@note Context object is a reference to shared state: copies refer to the same workers.
+Workers are stopped when the last reference is released.
+@note CPU affinity is supported on Linux and Windows only (ignored with a warning on other platforms).
+The calling thread affinity is not changed.
+ */
+class CV_EXPORTS ParallelContext
+{
+public:
+    /** @brief Creates context and starts its worker threads.
+    @param nthreads Number of threads used by the context (including the calling thread). Values \<= 0 mean the system default.
+    @param cpus Optional list of CPU indexes to pin the worker threads to. Workers are distributed over the list in round-robin order.
+    */
+    explicit ParallelContext(int nthreads = -1, const std::vector<int>& cpus = std::vector<int>());
+    ~ParallelContext();
+
+    /** @brief Returns the number of threads used by the context (including the calling thread) */
+    int getNumThreads() const;
+
+    /** @brief Returns CPU indexes which are used for workers affinity (empty if affinity is not set) */
+    const std::vector<int>& getCPUs() const;
+
+    /** @brief Installs context on the calling thread for the lifetime of the object (RAII).
+
+    Scopes may be nested, the previously installed context is restored on destruction.
+    Scope object must be destroyed by the same thread which has created it.
+    */
+    class CV_EXPORTS Scope
+    {
+    public:
+        explicit Scope(const ParallelContext& ctx);
+        ~Scope();
+    private:
+        Scope(const Scope&); // disabled
+        Scope& operator=(const Scope&); // disabled
+        struct Impl;
+        Impl* p;
+    };
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 /** @brief Returns full configuration time cmake output.
 
 Returned value is raw cmake output including version control system revision, compiler version,
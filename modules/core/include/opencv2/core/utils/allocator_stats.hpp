@@ -24,6 +24,9 @@ public:
     virtual void resetPeakUsage() = 0;
 };
 
+/** @brief Returns statistics of the memory allocated by Mat::getPoolAllocator(), including the cached buffers */
+CV_EXPORTS AllocatorStatisticsInterface& getPoolAllocatorStatistics();
+
 }} // namespace
 
 #endif // OPENCV_CORE_ALLOCATOR_STATS_HPP
@@ -23,6 +23,18 @@ void cvt32f16f(const float* src, float16_t* dst, int len)
     CV_CPU_DISPATCH(cvt32f16f, (src, dst, len),
         CV_CPU_DISPATCH_MODES_ALL);
 }
+void cvt16bf32f(const bfloat16_t* src, float* dst, int len)
+{
+    CV_INSTRUMENT_REGION();
+    CV_CPU_DISPATCH(cvt16bf32f, (src, dst, len),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+void cvt32f16bf(const float* src, bfloat16_t* dst, int len)
+{
+    CV_INSTRUMENT_REGION();
+    CV_CPU_DISPATCH(cvt32f16bf, (src, dst, len),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
 void addRNGBias32f(float* arr, const float* scaleBiasPairs, int len)
 {
     CV_INSTRUMENT_REGION();
@@ -285,4 +297,33 @@ void convertFp16(InputArray _src, OutputArray _dst)
     }
 }
 
+//==================================================================================================
+
+void convertBF16(InputArray _src, OutputArray _dst)
+{
+    CV_INSTRUMENT_REGION();
+
+    int sdepth = _src.depth();
+    CV_Check(sdepth, sdepth == CV_32F || sdepth == CV_16U, "Unsupported input depth");
+    int ddepth = sdepth == CV_32F ? CV_16U : CV_32F;
+
+    Mat src = _src.getMat();
+    _dst.create( src.dims, src.size, CV_MAKETYPE(ddepth, src.channels()) );
+    Mat dst = _dst.getMat();
+    int cn = src.channels();
+
+    const Mat* arrays[] = {&src, &dst, 0};
+    uchar* ptrs[2] = {};
+    NAryMatIterator it(arrays, ptrs);
+    const int len = (int)(it.size*cn);
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+    {
+        if( sdepth == CV_32F )
+            hal::cvt32f16bf((const float*)ptrs[0], (bfloat16_t*)ptrs[1], len);
+        else
+            hal::cvt16bf32f((const bfloat16_t*)ptrs[0], (float*)ptrs[1], len);
+    }
+}
+
 } // namespace cv
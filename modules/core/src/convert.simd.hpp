@@ -16,6 +16,8 @@ CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 
 void cvt16f32f(const float16_t* src, float* dst, int len);
 void cvt32f16f(const float* src, float16_t* dst, int len);
+void cvt16bf32f(const bfloat16_t* src, float* dst, int len);
+void cvt32f16bf(const float* src, bfloat16_t* dst, int len);
 void addRNGBias32f(float* arr, const float* scaleBiasPairs, int len);
 void addRNGBias64f(double* arr, const double* scaleBiasPairs, int len);
 
@@ -77,6 +79,66 @@ void cvt32f16f( const float* src, float16_t* dst, int len )
         dst[j] = float16_t(src[j]);
 }
 
+void cvt16bf32f( const bfloat16_t* src, float* dst, int len )
+{
+    CV_INSTRUMENT_REGION();
+    const ushort* src16 = (const ushort*)src;
+    int j = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    for( ; j < len; j += VECSZ )
+    {
+        if( j > len - VECSZ )
+        {
+            if( j == 0 )
+                break;
+            j = len - VECSZ;
+        }
+        v_uint32 a, b;
+        v_expand(vx_load(src16 + j), a, b);
+        v_store(dst + j, v_reinterpret_as_f32(a << 16));
+        v_store(dst + j + v_float32::nlanes, v_reinterpret_as_f32(b << 16));
+    }
+#endif
+    for( ; j < len; j++ )
+        dst[j] = (float)src[j];
+}
+
+#if CV_SIMD
+// Rounds to the nearest even, NaNs are kept quiet, the same as bfloat16_t(float)
+static inline v_uint32 v_cvt_32f16bf( const v_float32& a )
+{
+    const v_uint32 u = v_reinterpret_as_u32(a);
+    const v_uint32 rounded = (u + vx_setall_u32(0x7fff) + ((u >> 16) & vx_setall_u32(1))) >> 16;
+    const v_uint32 nan = (u >> 16) | vx_setall_u32(0x40);
+    const v_int32 isnan = v_reinterpret_as_s32(u & vx_setall_u32(0x7fffffff)) > vx_setall_s32(0x7f800000);
+    return v_select(v_reinterpret_as_u32(isnan), nan, rounded);
+}
+#endif
+
+void cvt32f16bf( const float* src, bfloat16_t* dst, int len )
+{
+    CV_INSTRUMENT_REGION();
+    ushort* dst16 = (ushort*)dst;
+    int j = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    for( ; j < len; j += VECSZ )
+    {
+        if( j > len - VECSZ )
+        {
+            if( j == 0 )
+                break;
+            j = len - VECSZ;
+        }
+        v_store(dst16 + j, v_pack(v_cvt_32f16bf(vx_load(src + j)),
+                                  v_cvt_32f16bf(vx_load(src + j + v_float32::nlanes))));
+    }
+#endif
+    for( ; j < len; j++ )
+        dst[j] = bfloat16_t(src[j]);
+}
+
 void addRNGBias32f( float* arr, const float* scaleBiasPairs, int len )
 {
     CV_INSTRUMENT_REGION();
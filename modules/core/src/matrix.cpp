@@ -4,6 +4,7 @@
 
 #include "precomp.hpp"
 #include "bufferpool.impl.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
 
 namespace cv {
 
@@ -188,7 +189,12 @@ MatAllocator* Mat::getDefaultAllocator()
         cv::AutoLock lock(cv::getInitializationMutex());
         if (g_matAllocator == NULL)
         {
-            g_matAllocator = getStdAllocator();
+            if (utils::getConfigurationParameterBool("OPENCV_MAT_BUFFERPOOL", false))
+                g_matAllocator = getPoolAllocator();
+            else if (utils::getConfigurationParameterBool("OPENCV_MAT_HUGEPAGES", false))
+                g_matAllocator = getHugePageAllocator();
+            else
+                g_matAllocator = getStdAllocator();
         }
     }
     return g_matAllocator;
@@ -0,0 +1,275 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
+#include "opencv2/core/utils/logger.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <fstream>
+#define OPENCV_HAVE_MMAP_HUGEPAGES 1
+#endif
+
+namespace cv {
+
+namespace {
+
+enum HugePagesMode { HUGEPAGES_TRANSPARENT, HUGEPAGES_EXPLICIT };
+enum NumaPolicy { NUMA_DEFAULT, NUMA_FIRST_TOUCH, NUMA_INTERLEAVE };
+
+// UMatData::allocatorFlags_ values, the way the buffer is released
+enum { BUFFER_MALLOC = 0, BUFFER_MAPPED = 1, BUFFER_MAPPED_HUGETLB = 2 };
+
+#ifdef OPENCV_HAVE_MMAP_HUGEPAGES
+
+// <numaif.h> constants, libnuma is not required
+static const int CV_MPOL_INTERLEAVE = 3;
+static const unsigned CV_MPOL_F_MEMS_ALLOWED = 1 << 2;
+static const int NUMA_MAX_NODES = 1024;
+
+// Reads the size in bytes from the first line starting with the key, 0 if it is not found
+static size_t readSystemSize(const char* filename, const char* key, size_t multiplier)
+{
+    std::ifstream f(filename);
+    std::string line;
+    while (std::getline(f, line))
+    {
+        if (line.compare(0, strlen(key), key) == 0)
+            return (size_t)strtoull(line.c_str() + strlen(key), NULL, 10) * multiplier;
+    }
+    return 0;
+}
+
+static void* mapAligned(size_t length, size_t alignment)
+{
+    const size_t mapped = length + alignment;
+    uchar* ptr = (uchar*)mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    uchar* aligned = alignPtr(ptr, (int)alignment);
+    if (aligned != ptr)
+        munmap(ptr, aligned - ptr);
+    const size_t tail = (ptr + mapped) - (aligned + length);
+    if (tail)
+        munmap(aligned + length, tail);
+    return aligned;
+}
+
+#endif // OPENCV_HAVE_MMAP_HUGEPAGES
+
+} // namespace
+
+// Backs the large buffers by huge pages, which reduces TLB misses of the image-wide loops.
+// On NUMA systems the pages are either interleaved across the nodes, or placed by the first touch
+// in the stripes of rows, as parallel_for_ splits the row loops, so each page is local to the thread
+// which processes it later. Smaller buffers are allocated by fastMalloc().
+class HugePageMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    HugePageMatAllocator()
+        : threshold(utils::getConfigurationParameterSizeT("OPENCV_MAT_HUGEPAGES_THRESHOLD", (size_t)2 << 20)),
+          mode(HUGEPAGES_TRANSPARENT), numaPolicy(NUMA_DEFAULT), pageSize(0), hugetlbPageSize(0)
+    {
+        const std::string modeName = utils::getConfigurationParameterString("OPENCV_MAT_HUGEPAGES_MODE", "transparent");
+        if (modeName == "explicit")
+            mode = HUGEPAGES_EXPLICIT;
+        else if (modeName != "transparent")
+            CV_LOG_WARNING(NULL, "OPENCV_MAT_HUGEPAGES_MODE: unknown value '" << modeName << "', transparent huge pages are used");
+
+        const std::string policyName = utils::getConfigurationParameterString("OPENCV_MAT_NUMA_POLICY", "default");
+        if (policyName == "first-touch")
+            numaPolicy = NUMA_FIRST_TOUCH;
+        else if (policyName == "interleave")
+            numaPolicy = NUMA_INTERLEAVE;
+        else if (policyName != "default")
+            CV_LOG_WARNING(NULL, "OPENCV_MAT_NUMA_POLICY: unknown value '" << policyName << "', the default policy is used");
+
+#ifdef OPENCV_HAVE_MMAP_HUGEPAGES
+        pageSize = readSystemSize("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "", 1);
+        if (pageSize == 0)
+            pageSize = (size_t)2 << 20;
+        hugetlbPageSize = readSystemSize("/proc/meminfo", "Hugepagesize:", 1024);
+
+        if (numaPolicy == NUMA_INTERLEAVE)
+        {
+            memset(nodeMask, 0, sizeof(nodeMask));
+            int numNodes = 0;
+            if (syscall(SYS_get_mempolicy, NULL, nodeMask, (unsigned long)NUMA_MAX_NODES, NULL, CV_MPOL_F_MEMS_ALLOWED) == 0)
+            {
+                for (int i = 0; i < NUMA_MAX_NODES; i++)
+                    numNodes += (nodeMask[i / (8 * sizeof(nodeMask[0]))] >> (i % (8 * sizeof(nodeMask[0])))) & 1;
+            }
+            if (numNodes <= 1)
+            {
+                CV_LOG_INFO(NULL, "Mat huge page allocator: single NUMA node is available, the pages are not interleaved");
+                numaPolicy = NUMA_DEFAULT;
+            }
+        }
+#else
+        CV_LOG_INFO(NULL, "Mat huge page allocator is not supported by this platform, fastMalloc() is used");
+#endif
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        UMatData* u = new UMatData(this);
+        u->allocatorFlags_ = BUFFER_MALLOC;
+        uchar* data = (uchar*)data0;
+        if (!data)
+        {
+            // the processing loops are split by rows, or by planes and rows of the multi-dimensional arrays
+            int rows = 1;
+            for (int i = 0; i < dims - 1; i++)
+                rows *= sizes[i];
+            data = (uchar*)allocateBuffer(total, rows, u->allocatorFlags_);
+        }
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            releaseBuffer(u->origdata, u->size, u->allocatorFlags_);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+private:
+    void* allocateBuffer(size_t size, int rows, int& kind) const
+    {
+        kind = BUFFER_MALLOC;
+#ifdef OPENCV_HAVE_MMAP_HUGEPAGES
+        if (size < threshold)
+            return fastMalloc(size);
+
+        void* ptr = NULL;
+        size_t length = 0;
+#ifdef MAP_HUGETLB
+        if (mode == HUGEPAGES_EXPLICIT && hugetlbPageSize > 0)
+        {
+            length = alignSize(size, (int)hugetlbPageSize);
+            ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+                kind = BUFFER_MAPPED_HUGETLB;
+            else
+            {
+                CV_LOG_ONCE_WARNING(NULL, "Mat huge page allocator: can't map the reserved huge pages (see /proc/sys/vm/nr_hugepages), "
+                                          "transparent huge pages are used");
+                ptr = NULL;
+            }
+        }
+#endif
+        if (!ptr)
+        {
+            length = alignSize(size, (int)pageSize);
+            ptr = mapAligned(length, pageSize);
+            if (!ptr)
+                return fastMalloc(size);  // reports the out of memory error
+            kind = BUFFER_MAPPED;
+#ifdef MADV_HUGEPAGE
+            madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+        }
+
+        // the pages are not allocated until the first touch
+        if (numaPolicy == NUMA_INTERLEAVE)
+        {
+            if (syscall(SYS_mbind, ptr, length, CV_MPOL_INTERLEAVE, nodeMask, (unsigned long)NUMA_MAX_NODES, 0) != 0)
+                CV_LOG_ONCE_WARNING(NULL, "Mat huge page allocator: can't interleave the pages across NUMA nodes");
+        }
+        else if (numaPolicy == NUMA_FIRST_TOUCH)
+            touchPages((uchar*)ptr, size, rows);
+        return ptr;
+#else
+        CV_UNUSED(rows);
+        return fastMalloc(size);
+#endif
+    }
+
+    void releaseBuffer(void* ptr, size_t size, int kind) const
+    {
+#ifdef OPENCV_HAVE_MMAP_HUGEPAGES
+        if (kind == BUFFER_MAPPED_HUGETLB)
+        {
+            munmap(ptr, alignSize(size, (int)hugetlbPageSize));
+            return;
+        }
+        if (kind == BUFFER_MAPPED)
+        {
+            munmap(ptr, alignSize(size, (int)pageSize));
+            return;
+        }
+#else
+        CV_UNUSED(size); CV_UNUSED(kind);
+#endif
+        fastFree(ptr);
+    }
+
+    // Touches the pages by the same stripes of rows which parallel_for_ uses by default
+    static void touchPages(uchar* data, size_t size, int rows)
+    {
+        const size_t rowSize = size / rows;
+        const size_t touchStep = 4096;  // the smallest page size, the huge page is touched several times
+        parallel_for_(Range(0, rows), [&](const Range& range)
+        {
+            uchar* start = data + range.start * rowSize;
+            uchar* end = range.end == rows ? data + size : data + range.end * rowSize;
+            for (uchar* p = start; p < end; p = alignPtr(p + 1, (int)touchStep))
+                *(volatile uchar*)p = 0;
+        });
+    }
+
+    const size_t threshold;
+    HugePagesMode mode;
+    NumaPolicy numaPolicy;
+    size_t pageSize;         // transparent huge page size
+    size_t hugetlbPageSize;  // default size of the reserved huge pages
+#ifdef OPENCV_HAVE_MMAP_HUGEPAGES
+    unsigned long nodeMask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+#endif
+};
+
+MatAllocator* Mat::getHugePageAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new HugePageMatAllocator())
+}
+
+} // namespace cv
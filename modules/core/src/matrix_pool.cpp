@@ -0,0 +1,302 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/utils/allocator_stats.impl.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
+#include "opencv2/core/utils/tls.hpp"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace cv {
+
+static cv::utils::AllocatorStatistics pool_allocator_stats;
+
+cv::utils::AllocatorStatisticsInterface& utils::getPoolAllocatorStatistics()
+{
+    return pool_allocator_stats;
+}
+
+namespace {
+
+// Smaller buffers are allocated by fastMalloc() directly
+static const size_t POOL_MIN_BUFFER_SIZE = 4096;
+// Larger buffers are shared by all threads only, the lock is cheap compared to the use of such buffer
+static const size_t POOL_MAX_THREAD_BUFFER_SIZE = 1 << 20;
+static const int POOL_THREAD_CACHE_SIZE = 8;
+
+// Rounds the size up to one of 4 size classes per power of two, so the overhead is below 25%
+static size_t getSizeClass(size_t size)
+{
+    size_t p = POOL_MIN_BUFFER_SIZE;
+    while (p <= size / 2)
+        p *= 2;
+    const size_t step = p / 4;
+    return (size + step - 1) / step * step;
+}
+
+struct ThreadCache
+{
+    ThreadCache() : count(0) {}
+
+    std::mutex mutex;  // the cache is released by other threads in freeAllReservedBuffers()
+    int count;
+    size_t sizes[POOL_THREAD_CACHE_SIZE];
+    void* buffers[POOL_THREAD_CACHE_SIZE];
+};
+
+} // namespace
+
+// Caches the released buffers by size classes, so the frequently reallocated matrices of the same size
+// (video frames, temporary buffers of the processing loops) don't hit the system allocator.
+// The released buffers are kept in the per-thread caches first, then in the global lists.
+// The total size of the cached buffers is limited by the BufferPoolController interface.
+class PoolMatAllocator CV_FINAL : public MatAllocator, public BufferPoolController
+{
+    class ThreadCacheTLS CV_FINAL : public TLSDataContainer
+    {
+    public:
+        ThreadCacheTLS(const PoolMatAllocator& owner_) : owner(owner_) {}
+        ~ThreadCacheTLS() { release(); }
+
+        ThreadCache& get() const { return *(ThreadCache*)getData(); }
+
+    protected:
+        void* createDataInstance() const CV_OVERRIDE
+        {
+            ThreadCache* cache = new ThreadCache();
+            std::lock_guard<std::mutex> lock(owner.mutex);
+            owner.caches.push_back(cache);
+            return cache;
+        }
+
+        // the buffers cached by the finished thread are moved to the global lists
+        void deleteDataInstance(void* pData) const CV_OVERRIDE
+        {
+            ThreadCache* cache = (ThreadCache*)pData;
+            {
+                std::lock_guard<std::mutex> lock(owner.mutex);
+                owner.caches.erase(std::find(owner.caches.begin(), owner.caches.end(), cache));
+                std::lock_guard<std::mutex> cacheLock(cache->mutex);
+                for (int i = 0; i < cache->count; i++)
+                    owner.buffers[cache->sizes[i]].push_back(cache->buffers[i]);
+                cache->count = 0;
+            }
+            delete cache;
+        }
+
+        const PoolMatAllocator& owner;
+    };
+
+public:
+    PoolMatAllocator()
+        : reservedSize(0),
+          maxReservedSize(utils::getConfigurationParameterSizeT("OPENCV_MAT_BUFFERPOOL_LIMIT", (size_t)1 << 28)),
+          tls(*this)
+    {}
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        uchar* data = data0 ? (uchar*)data0 : (uchar*)allocateBuffer(total);
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            releaseBuffer(u->origdata, u->size);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* id) const CV_OVERRIDE
+    {
+        CV_UNUSED(id);
+        return const_cast<PoolMatAllocator*>(this);
+    }
+
+    size_t getReservedSize() const CV_OVERRIDE
+    {
+        return reservedSize;
+    }
+
+    size_t getMaxReservedSize() const CV_OVERRIDE
+    {
+        return maxReservedSize;
+    }
+
+    void setMaxReservedSize(size_t size) CV_OVERRIDE
+    {
+        maxReservedSize = size;
+        trim(size);
+    }
+
+    void freeAllReservedBuffers() CV_OVERRIDE
+    {
+        trim(0);
+    }
+
+private:
+    void* allocateBuffer(size_t size) const
+    {
+        if (size < POOL_MIN_BUFFER_SIZE)
+            return systemAllocate(size);
+
+        const size_t sizeClass = getSizeClass(size);
+        if (sizeClass <= POOL_MAX_THREAD_BUFFER_SIZE)
+        {
+            ThreadCache& cache = tls.get();
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (int i = cache.count - 1; i >= 0; i--)
+            {
+                if (cache.sizes[i] == sizeClass)
+                {
+                    void* ptr = cache.buffers[i];
+                    cache.count--;
+                    cache.sizes[i] = cache.sizes[cache.count];
+                    cache.buffers[i] = cache.buffers[cache.count];
+                    reservedSize -= sizeClass;
+                    return ptr;
+                }
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::map<size_t, std::vector<void*> >::iterator it = buffers.find(sizeClass);
+            if (it != buffers.end() && !it->second.empty())
+            {
+                void* ptr = it->second.back();
+                it->second.pop_back();
+                reservedSize -= sizeClass;
+                return ptr;
+            }
+        }
+        return systemAllocate(sizeClass);
+    }
+
+    void releaseBuffer(void* ptr, size_t size) const
+    {
+        if (size < POOL_MIN_BUFFER_SIZE)
+        {
+            systemFree(ptr, size);
+            return;
+        }
+
+        const size_t sizeClass = getSizeClass(size);
+        if (reservedSize.fetch_add(sizeClass) + sizeClass > maxReservedSize)
+        {
+            reservedSize -= sizeClass;
+            systemFree(ptr, sizeClass);
+            return;
+        }
+        if (sizeClass <= POOL_MAX_THREAD_BUFFER_SIZE)
+        {
+            ThreadCache& cache = tls.get();
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            if (cache.count < POOL_THREAD_CACHE_SIZE)
+            {
+                cache.sizes[cache.count] = sizeClass;
+                cache.buffers[cache.count] = ptr;
+                cache.count++;
+                return;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers[sizeClass].push_back(ptr);
+    }
+
+    // Frees the cached buffers, the largest ones first, until the reserved size fits the limit
+    void trim(size_t limit) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::map<size_t, std::vector<void*> >::reverse_iterator it = buffers.rbegin();
+             it != buffers.rend() && reservedSize > limit; ++it)
+        {
+            while (!it->second.empty() && reservedSize > limit)
+            {
+                systemFree(it->second.back(), it->first);
+                it->second.pop_back();
+                reservedSize -= it->first;
+            }
+        }
+        for (size_t k = 0; k < caches.size() && reservedSize > limit; k++)
+        {
+            ThreadCache& cache = *caches[k];
+            std::lock_guard<std::mutex> cacheLock(cache.mutex);
+            while (cache.count > 0 && reservedSize > limit)
+            {
+                cache.count--;
+                systemFree(cache.buffers[cache.count], cache.sizes[cache.count]);
+                reservedSize -= cache.sizes[cache.count];
+            }
+        }
+    }
+
+    static void* systemAllocate(size_t size)
+    {
+        void* ptr = fastMalloc(size);
+        pool_allocator_stats.onAllocate(size);
+        return ptr;
+    }
+
+    static void systemFree(void* ptr, size_t size)
+    {
+        pool_allocator_stats.onFree(size);
+        fastFree(ptr);
+    }
+
+    mutable std::atomic<size_t> reservedSize;  // the total size of the cached buffers
+    std::atomic<size_t> maxReservedSize;
+
+    // The global lists and the registry of the thread caches, locked before the thread cache if both are needed
+    mutable std::mutex mutex;
+    mutable std::map<size_t, std::vector<void*> > buffers;
+    mutable std::vector<ThreadCache*> caches;
+
+    ThreadCacheTLS tls;
+};
+
+MatAllocator* Mat::getPoolAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new PoolMatAllocator())
+}
+
+} // namespace cv
@@ -495,6 +495,13 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     if (range.empty())
         return;
 
+    if (getThreadParallelForAPI() || isNestedParallelForSupported(getCurrentParallelForAPI().get()))
+    {
+        // backend schedules nested jobs itself
+        parallel_for_impl(range, body, nstripes);
+        return;
+    }
+
     static std::atomic<bool> flagNestedParallelFor(false);
     bool isNotNestedRegion = !flagNestedParallelFor.load();
     if (isNotNestedRegion)
@@ -530,7 +537,8 @@ void parallel_for_cb(int start, int end, void* data)
 static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
     using namespace cv::parallel;
-    if ((numThreads < 0 || numThreads > 1) && range.end - range.start > 1)
+    ParallelForAPI* contextAPI = getThreadParallelForAPI();  // ParallelContext ignores global setNumThreads()
+    if ((contextAPI || numThreads < 0 || numThreads > 1) && range.end - range.start > 1)
     {
         ParallelLoopBodyWrapperContext ctx(body, range, nstripes);
         ProxyLoopBody pbody(ctx);
@@ -541,6 +549,14 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
             return;
         }
 
+        if (contextAPI)
+        {
+            CV_CheckEQ(stripeRange.start, 0, "");
+            contextAPI->parallel_for(stripeRange.end, parallel_for_cb, (void*)&pbody);
+            ctx.finalize();  // propagate exceptions if exists
+            return;
+        }
+
         std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
         if (api)
         {
@@ -611,6 +627,12 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
 
 int getNumThreads(void)
 {
+    ParallelForAPI* contextAPI = getThreadParallelForAPI();
+    if (contextAPI)
+    {
+        return contextAPI->getNumThreads();
+    }
+
     std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
     if (api)
     {
@@ -758,6 +780,12 @@ void setNumThreads( int threads_ )
 
 int getThreadNum()
 {
+    ParallelForAPI* contextAPI = getThreadParallelForAPI();
+    if (contextAPI)
+    {
+        return contextAPI->getThreadNum();
+    }
+
     std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
     if (api)
     {
@@ -20,6 +20,10 @@
 #include "plugin_parallel_api.hpp"
 #include "plugin_parallel_wrapper.impl.hpp"
 
+#ifdef HAVE_PARALLEL_WORKSTEALING
+#include "parallel_workstealing.hpp"
+#endif
+
 
 namespace cv { namespace parallel {
 
@@ -60,6 +64,10 @@ std::shared_ptr<ParallelForAPI> createParallelForAPI()
             }
             isKnown = true;
         }
+        else if (info.name == "WORKSTEALING")
+        {
+            continue;  // builtin backend is enabled explicitly only, the legacy code is used by default
+        }
         try
         {
             CV_LOG_DEBUG(NULL, "core(parallel): trying backend: " << info.name << " (priority=" << info.priority << ")");
@@ -174,4 +182,85 @@ bool setParallelForBackend(const std::string& backendName, bool propagateNumThre
     return true;
 }
 
+ParallelForAPI* getThreadParallelForAPI()
+{
+    return getCoreTlsData().parallelForAPI;
+}
+
+void setThreadParallelForAPI(ParallelForAPI* api)
+{
+    getCoreTlsData().parallelForAPI = api;
+}
+
 }}  // namespace
+
+
+namespace cv {
+
+struct ParallelContext::Impl
+{
+#ifdef HAVE_PARALLEL_WORKSTEALING
+    Impl(int nthreads, const std::vector<int>& cpus_)
+        : backend(nthreads, cpus_), cpus(cpus_)
+    {
+        // nothing
+    }
+
+    parallel::workstealing::ParallelForBackend backend;
+#endif
+    std::vector<int> cpus;
+};
+
+ParallelContext::ParallelContext(int nthreads, const std::vector<int>& cpus)
+{
+#ifdef HAVE_PARALLEL_WORKSTEALING
+    p = makePtr<Impl>(nthreads, cpus);
+#else
+    CV_UNUSED(nthreads); CV_UNUSED(cpus);
+    CV_Error(Error::StsNotImplemented, "ParallelContext requires threads support");
+#endif
+}
+
+ParallelContext::~ParallelContext()
+{
+    // nothing
+}
+
+int ParallelContext::getNumThreads() const
+{
+#ifdef HAVE_PARALLEL_WORKSTEALING
+    return p->backend.getNumThreads();
+#else
+    return 1;
+#endif
+}
+
+const std::vector<int>& ParallelContext::getCPUs() const
+{
+    return p->cpus;
+}
+
+struct ParallelContext::Scope::Impl
+{
+    Ptr<ParallelContext::Impl> ctx;  // keeps context alive while it is installed
+    parallel::ParallelForAPI* prevAPI;
+};
+
+ParallelContext::Scope::Scope(const ParallelContext& ctx)
+    : p(new Impl())
+{
+    CV_Assert(ctx.p);
+    p->ctx = ctx.p;
+    p->prevAPI = parallel::getThreadParallelForAPI();
+#ifdef HAVE_PARALLEL_WORKSTEALING
+    parallel::setThreadParallelForAPI(&ctx.p->backend);
+#endif
+}
+
+ParallelContext::Scope::~Scope()
+{
+    parallel::setThreadParallelForAPI(p->prevAPI);
+    delete p;
+}
+
+}  // namespace
@@ -6,12 +6,23 @@
 
 #include "opencv2/core/parallel/parallel_backend.hpp"
 
+#if !defined(BUILD_PLUGIN) && (defined(HAVE_PTHREADS_PF) || defined(_WIN32))
+#define HAVE_PARALLEL_WORKSTEALING 1
+#endif
+
 namespace cv { namespace parallel {
 
 extern int numThreads;
 
 std::shared_ptr<ParallelForAPI>& getCurrentParallelForAPI();
 
+/** Returns backend installed on the calling thread by ParallelContext::Scope (NULL if there is no such backend) */
+ParallelForAPI* getThreadParallelForAPI();
+void setThreadParallelForAPI(ParallelForAPI* api);
+
+/** Returns true if backend executes nested parallel_for() calls in parallel (without global serialization) */
+bool isNestedParallelForSupported(const ParallelForAPI* api);
+
 #ifndef BUILD_PLUGIN
 
 #ifdef HAVE_TBB
@@ -22,6 +33,10 @@ std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendTBB();
 std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendOpenMP();
 #endif
 
+#ifdef HAVE_PARALLEL_WORKSTEALING
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing();
+#endif
+
 #endif  // BUILD_PLUGIN
 
 }}  // namespace
@@ -0,0 +1,366 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+
+#include "parallel.hpp"
+
+#ifdef HAVE_PARALLEL_WORKSTEALING
+
+#include "parallel_workstealing.hpp"
+#include "../parallel_impl.hpp"  // defaultNumberOfThreads()
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#define CV_WORKSTEALING_HAVE_AFFINITY 1
+#elif defined(_WIN32)
+#include <windows.h>
+#undef min
+#undef max
+#define CV_WORKSTEALING_HAVE_AFFINITY 1
+#endif
+
+namespace cv { namespace parallel { namespace workstealing {
+
+static int CV_WORKSTEALING_ACTIVE_WAIT = (int)utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_WORKSTEALING_ACTIVE_WAIT", 1000);  // iterations
+
+struct ParallelForBackend::Job
+{
+    FN_parallel_for_body_cb_t callback;
+    void* callback_data;
+    int grain;
+    std::atomic<int> remaining;  // number of not completed tasks
+};
+
+ParallelForBackend::ParallelForBackend()
+    : numThreads(0), numWorkers(0), isolated(false),
+      pendingTasks(0), sleepingWorkers(0), waitingCallers(0), startedWorkers(0), stopFlag(false)
+{
+    startWorkers((int)defaultNumberOfThreads());
+}
+
+ParallelForBackend::ParallelForBackend(int nThreads, const std::vector<int>& cpus_)
+    : numThreads(std::max(0, nThreads)), numWorkers(0), isolated(true), cpus(cpus_),
+      pendingTasks(0), sleepingWorkers(0), waitingCallers(0), startedWorkers(0), stopFlag(false)
+{
+#ifndef CV_WORKSTEALING_HAVE_AFFINITY
+    if (!cpus.empty())
+    {
+        CV_LOG_WARNING(NULL, "core(parallel): threads affinity is not supported on this platform");
+        cpus.clear();
+    }
+#endif
+    startWorkers(nThreads > 0 ? nThreads : (int)defaultNumberOfThreads());
+}
+
+ParallelForBackend::~ParallelForBackend()
+{
+    stopWorkers();
+}
+
+void ParallelForBackend::startWorkers(int nThreads)
+{
+    CV_Assert(workers.empty());
+    numWorkers = std::max(0, nThreads - 1);
+    queues.resize(numWorkers + 1);
+    for (size_t i = 0; i < queues.size(); i++)
+        queues[i] = new TaskQueue();
+    stopFlag = false;
+    startedWorkers = 0;
+    workers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; i++)
+        workers.push_back(std::thread(&ParallelForBackend::workerLoop, this, i));
+
+    // wait until workers are ready (slot is published, affinity is applied)
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    while (startedWorkers < numWorkers)
+        callerCond.wait(lock);
+}
+
+void ParallelForBackend::setWorkerAffinity(int slot)
+{
+    const int cpu = cpus[slot % cpus.size()];
+    CV_Assert(cpu >= 0);
+#if defined(__linux__) && !defined(__ANDROID__)
+    CV_Assert(cpu < CPU_SETSIZE);
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    int res = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (res != 0)
+        CV_LOG_WARNING(NULL, "core(parallel): can't set affinity of worker " << slot << " to CPU " << cpu << " (error " << res << ")");
+#elif defined(_WIN32)
+    CV_Assert(cpu < (int)(sizeof(DWORD_PTR) * 8));
+    if (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) == 0)
+        CV_LOG_WARNING(NULL, "core(parallel): can't set affinity of worker " << slot << " to CPU " << cpu);
+#else
+    CV_UNUSED(slot);
+#endif
+}
+
+void ParallelForBackend::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopFlag = true;
+    }
+    sleepCond.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    workers.clear();
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        CV_DbgAssert(queues[i]->tasks.empty());
+        delete queues[i];
+    }
+    queues.clear();
+    numWorkers = 0;
+}
+
+int ParallelForBackend::getCurrentSlot() const
+{
+    const CoreTLSData& tls = getCoreTlsData();
+    return tls.workerPool == this ? tls.workerSlot : numWorkers;  // worker's own queue or the shared queue
+}
+
+void ParallelForBackend::push(int slot, const Task& task)
+{
+    TaskQueue& q = *queues[slot];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(task);
+        q.size++;
+    }
+    pendingTasks++;
+    if (sleepingWorkers.load() > 0 || waitingCallers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleepCond.notify_one();
+        callerCond.notify_all();
+    }
+}
+
+bool ParallelForBackend::pop(int slot, Task& task)
+{
+    TaskQueue& q = *queues[slot];
+    if (q.size.load() == 0)
+        return false;
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty())
+        return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    q.size--;
+    pendingTasks--;
+    return true;
+}
+
+bool ParallelForBackend::steal(int slot, Task& task)
+{
+    const int N = (int)queues.size();
+    for (int i = 1; i < N; i++)
+    {
+        TaskQueue& q = *queues[(slot + i) % N];
+        if (q.size.load() == 0)
+            continue;
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+            continue;
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        q.size--;
+        pendingTasks--;
+        return true;
+    }
+    return false;
+}
+
+void ParallelForBackend::execute(int slot, const Task& task)
+{
+    Job& job = *task.job;
+    const int grain = job.grain;
+    int begin = task.begin, end = task.end;
+    while (begin < end)
+    {
+        if (end - begin > grain && queues[slot]->size.load() == 0)
+        {
+            // lazy binary splitting: expose a half of the range only if there is nothing to steal from us
+            int mid = begin + (end - begin) / 2;
+            push(slot, Task{ &job, mid, end });
+            end = mid;
+            continue;
+        }
+        int chunkEnd = std::min(end, begin + grain);
+        job.callback(begin, chunkEnd, job.callback_data);
+        int done = chunkEnd - begin;
+        begin = chunkEnd;
+        if ((job.remaining -= done) == 0 && waitingCallers.load() > 0)  // job owner may release 'job' after the last decrement
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            callerCond.notify_all();
+        }
+    }
+}
+
+void ParallelForBackend::workerLoop(int slot)
+{
+    CoreTLSData& tls = getCoreTlsData();
+    tls.workerPool = this;
+    tls.workerSlot = slot;
+    if (!cpus.empty())
+        setWorkerAffinity(slot);
+    if (isolated)
+        setThreadParallelForAPI(this);  // nested parallel_for() calls stay in this pool
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        startedWorkers++;
+        callerCond.notify_all();
+    }
+    int idle = 0;
+    for (;;)
+    {
+        Task task;
+        if (pop(slot, task) || steal(slot, task))
+        {
+            execute(slot, task);
+            idle = 0;
+            continue;
+        }
+        if (stopFlag.load())
+            break;
+        if (++idle < CV_WORKSTEALING_ACTIVE_WAIT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers++;
+        while (pendingTasks.load() == 0 && !stopFlag.load())
+            sleepCond.wait(lock);
+        sleepingWorkers--;
+        idle = 0;
+    }
+}
+
+void ParallelForBackend::parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data)
+{
+    if (tasks <= 0)
+        return;
+    if (numWorkers == 0 || tasks == 1)
+    {
+        body_callback(0, tasks, callback_data);
+        return;
+    }
+
+    Job job;
+    job.callback = body_callback;
+    job.callback_data = callback_data;
+    job.grain = std::max(1, tasks / (8 * (numWorkers + 1)));
+    job.remaining = tasks;
+
+    const int slot = getCurrentSlot();
+    execute(slot, Task{ &job, 0, tasks });
+
+    // help other threads until our job is completed (tasks of nested jobs are processed here too)
+    int idle = 0;
+    while (job.remaining.load() > 0)
+    {
+        Task task;
+        if (pop(slot, task) || steal(slot, task))
+        {
+            if (task.job == &job)
+            {
+                execute(slot, task);
+            }
+            else
+            {
+                // don't leak RNG state of foreign jobs into the calling thread
+                RNG rng = theRNG();
+                execute(slot, task);
+                theRNG() = rng;
+            }
+            idle = 0;
+        }
+        else if (++idle < CV_WORKSTEALING_ACTIVE_WAIT)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // the remaining tasks are executed by other threads
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            waitingCallers++;
+            while (job.remaining.load() > 0 && pendingTasks.load() == 0)
+                callerCond.wait(lock);
+            waitingCallers--;
+            idle = 0;
+        }
+    }
+}
+
+int ParallelForBackend::getThreadNum() const
+{
+    int slot = getCurrentSlot();
+    return slot < numWorkers ? slot + 1 : 0;
+}
+
+int ParallelForBackend::getNumThreads() const
+{
+    return numWorkers + 1;
+}
+
+int ParallelForBackend::setNumThreads(int nThreads)
+{
+    int oldNumThreads = numThreads;
+    numThreads = nThreads;
+    int threads = nThreads > 0 ? nThreads : (int)defaultNumberOfThreads();
+    if (threads != numWorkers + 1)
+    {
+        stopWorkers();
+        startWorkers(threads);
+    }
+    return oldNumThreads;
+}
+
+const char* ParallelForBackend::getName() const
+{
+    return "workstealing";
+}
+
+}  // namespace workstealing
+
+static
+std::shared_ptr<cv::parallel::workstealing::ParallelForBackend>& getWorkStealingInstance()
+{
+    static std::shared_ptr<cv::parallel::workstealing::ParallelForBackend> g_instance = std::make_shared<cv::parallel::workstealing::ParallelForBackend>();
+    return g_instance;
+}
+
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing()
+{
+    return getWorkStealingInstance();
+}
+
+bool isNestedParallelForSupported(const ParallelForAPI* api)
+{
+    return dynamic_cast<const cv::parallel::workstealing::ParallelForBackend*>(api) != NULL;
+}
+
+}}  // namespace
+
+#else  // HAVE_PARALLEL_WORKSTEALING
+
+namespace cv { namespace parallel {
+
+bool isNestedParallelForSupported(const ParallelForAPI* /*api*/)
+{
+    return false;
+}
+
+}}  // namespace
+
+#endif  // HAVE_PARALLEL_WORKSTEALING
@@ -0,0 +1,108 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_PARALLEL_PARALLEL_WORKSTEALING_HPP
+#define OPENCV_CORE_SRC_PARALLEL_PARALLEL_WORKSTEALING_HPP
+
+#include "opencv2/core/parallel/parallel_backend.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cv { namespace parallel { namespace workstealing {
+
+/** Work-stealing parallel_for API implementation
+ *
+ * Each worker owns a task deque: the owner pushes/pops from the back, idle workers steal from the front.
+ * Ranges are split lazily ("lazy binary splitting"): a half of the current range is exposed for stealing
+ * only when the local deque is drained, so the number of tasks adapts to the actual load instead of `nstripes`.
+ *
+ * The calling thread participates in the job and executes other tasks while waiting for completion,
+ * so nested parallel_for() calls are executed in parallel without deadlocks.
+ */
+class ParallelForBackend : public ParallelForAPI
+{
+public:
+    ParallelForBackend();
+    /** Creates isolated pool: its workers dispatch nested parallel_for() calls into this pool
+     *  @param nThreads number of threads including the calling thread, <= 0 - default
+     *  @param cpus CPU indexes for workers affinity (round-robin), empty - don't change affinity
+     */
+    ParallelForBackend(int nThreads, const std::vector<int>& cpus);
+    virtual ~ParallelForBackend();
+
+    virtual void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) CV_OVERRIDE;
+
+    virtual int getThreadNum() const CV_OVERRIDE;
+
+    virtual int getNumThreads() const CV_OVERRIDE;
+
+    virtual int setNumThreads(int nThreads) CV_OVERRIDE;
+
+    virtual const char* getName() const CV_OVERRIDE;
+
+protected:
+    struct Job;
+
+    struct Task
+    {
+        Job* job;
+        int begin;
+        int end;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::atomic<int> size;
+
+        TaskQueue() : size(0) {}
+    };
+
+    void startWorkers(int nThreads);
+    void stopWorkers();
+
+    void workerLoop(int slot);
+
+    /// binds the calling worker thread to its CPU from the 'cpus' list
+    void setWorkerAffinity(int slot);
+
+    /// returns queue index of the current thread: worker's own queue or the shared queue for external threads
+    int getCurrentSlot() const;
+
+    void push(int slot, const Task& task);
+    bool pop(int slot, Task& task);
+    bool steal(int slot, Task& task);
+
+    void execute(int slot, const Task& task);
+
+    int numThreads;  // requested value, 0 - use default
+    int numWorkers;  // number of spawned threads, the calling thread is not counted
+    bool isolated;
+    std::vector<int> cpus;
+
+    std::vector<std::thread> workers;
+    std::vector<TaskQueue*> queues;  // numWorkers worker queues + 1 shared queue for external threads
+
+    std::atomic<int> pendingTasks;
+    std::atomic<int> sleepingWorkers;
+    std::atomic<int> waitingCallers;  // parallel_for() calls waiting for completion of their jobs
+    int startedWorkers;  // guarded by sleepMutex
+    std::atomic<bool> stopFlag;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCond;
+    std::condition_variable callerCond;  // job is completed, new tasks are available or a worker is started
+
+private:
+    ParallelForBackend(const ParallelForBackend&); // disabled
+    ParallelForBackend& operator=(const ParallelForBackend&); // disabled
+};
+
+}}}  // namespace
+
+#endif // OPENCV_CORE_SRC_PARALLEL_PARALLEL_WORKSTEALING_HPP
@@ -41,6 +41,10 @@ std::vector<ParallelBackendInfo>& getBuiltinParallelBackendsInfo()
 #elif defined(PARALLEL_ENABLE_PLUGINS)
         DECLARE_DYNAMIC_BACKEND("OPENMP")  // TODO Intel OpenMP?
 #endif
+
+#ifdef HAVE_PARALLEL_WORKSTEALING
+        DECLARE_STATIC_BACKEND("WORKSTEALING", createParallelBackendWorkStealing)  // builtin, supports nested parallel_for(), opt-in only
+#endif
     };
     return g_backends;
 };
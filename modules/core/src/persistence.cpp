@@ -6,6 +6,17 @@
 #include "persistence.hpp"
 #include <unordered_map>
 #include <iterator>
+#include <map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPENCV_HAVE_MMAP 1
+#else
+#include <fstream>
+#endif
 
 namespace cv
 {
@@ -339,6 +350,113 @@ static inline void writeReal(uchar* p, double fval)
 #endif
 }
 
+//=====================================================================================
+
+// The external data file of FileStorage::EXTERNAL_DATA mode: the header, then the raw data of the matrices
+// in the native byte order, aligned by EXTERNAL_DATA_ALIGN
+static const char externalDataSignature[] = "OpenCV FileStorage data v1\n";
+static const unsigned externalDataByteOrderMark = 0x01020304;
+static const size_t EXTERNAL_DATA_ALIGN = 64;
+static const size_t EXTERNAL_DATA_HEADER_SIZE = EXTERNAL_DATA_ALIGN;
+
+// The whole file is mapped copy-on-write, so the matrices are modifiable and the pages are loaded on access
+class ExternalDataFile
+{
+public:
+    ExternalDataFile(const std::string& path) : data(0), size(0)
+    {
+#ifdef OPENCV_HAVE_MMAP
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            CV_Error_(Error::StsError, ("Can't open the data file %s", path.c_str()));
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size = (size_t)st.st_size;
+            void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            data = ptr != MAP_FAILED ? (uchar*)ptr : 0;
+        }
+        close(fd);
+        if (!data)
+            CV_Error_(Error::StsError, ("Can't map the data file %s", path.c_str()));
+#else
+        std::ifstream f(path.c_str(), std::ios::binary);
+        if (!f.is_open())
+            CV_Error_(Error::StsError, ("Can't open the data file %s", path.c_str()));
+        f.seekg(0, std::ios::end);
+        buf.resize((size_t)f.tellg());
+        f.seekg(0, std::ios::beg);
+        f.read((char*)buf.data(), buf.size());
+        data = buf.data();
+        size = buf.size();
+#endif
+        // the destructor is not called if the constructor throws, so the mapping is released here
+        if (size < EXTERNAL_DATA_HEADER_SIZE || memcmp(data, externalDataSignature, sizeof(externalDataSignature)) != 0)
+        {
+            release();
+            CV_Error_(Error::StsParseError, ("%s is not a FileStorage data file", path.c_str()));
+        }
+        unsigned mark;
+        memcpy(&mark, data + sizeof(externalDataSignature), sizeof(mark));
+        if (mark != externalDataByteOrderMark)
+        {
+            release();
+            CV_Error_(Error::StsParseError, ("The data file %s is written with the different byte order", path.c_str()));
+        }
+    }
+
+    ~ExternalDataFile()
+    {
+        release();
+    }
+
+    uchar* data;
+    size_t size;
+
+private:
+    void release()
+    {
+#ifdef OPENCV_HAVE_MMAP
+        if (data)
+            munmap(data, size);
+#endif
+        data = 0;
+        size = 0;
+    }
+
+#ifndef OPENCV_HAVE_MMAP
+    std::vector<uchar> buf;
+#endif
+};
+
+// The matrices refer to the external data file, which is released with the last of them
+class ExternalDataAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        u->allocatorContext.reset();
+        delete u;
+    }
+};
+
 class FileStorage::Impl : public FileStorage_API
 {
 public:
@@ -376,6 +494,11 @@ public:
 
         filename.clear();
         lineno = 0;
+
+        extFile = 0;
+        extFileName.clear();
+        extFileSize = 0;
+        extFiles.clear();
     }
 
     Impl(FileStorage* _fs)
@@ -412,6 +535,8 @@ public:
                 *out = cv::String(outbuf.begin(), outbuf.end());
             }
         }
+        if( extFile )
+            fclose( extFile );
         closeFile();
         init();
     }
@@ -518,6 +643,16 @@ public:
             }
         }
 
+        if( write_mode && (flags & FileStorage::EXTERNAL_DATA) )
+        {
+            if( mem_mode || isGZ )
+            {
+                release();
+                CV_Error( CV_StsBadFlag, "FileStorage::EXTERNAL_DATA is not compatible with FileStorage::MEMORY and compressed files" );
+            }
+            openExternalData( append );
+        }
+
         roots.clear();
         fs_data.clear();
         wrap_margin = 71;
@@ -911,6 +1046,74 @@ public:
         is_opened = false;
     }
 
+    void openExternalData( bool append )
+    {
+        const std::string path = filename + ".data";
+        size_t pos = path.find_last_of("/\\");
+        extFileName = pos == std::string::npos ? path : path.substr(pos + 1);
+
+        extFile = append ? fopen( path.c_str(), "r+b" ) : 0;
+        if( extFile )
+        {
+            fseek( extFile, 0, SEEK_END );
+            extFileSize = (int64)ftell( extFile );
+        }
+        else
+            extFile = fopen( path.c_str(), "wb" );
+        if( !extFile )
+        {
+            release();
+            CV_Error_( CV_StsError, ("Can't open the data file %s", path.c_str()) );
+        }
+
+        if( extFileSize == 0 )
+        {
+            uchar header[EXTERNAL_DATA_HEADER_SIZE] = {0};
+            memcpy( header, externalDataSignature, sizeof(externalDataSignature) );
+            memcpy( header + sizeof(externalDataSignature), &externalDataByteOrderMark, sizeof(externalDataByteOrderMark) );
+            writeExternalData( header, sizeof(header) );
+        }
+    }
+
+    void writeExternalData( const void* data, size_t size )
+    {
+        if( fwrite( data, 1, size, extFile ) != size )
+            CV_Error( CV_StsError, "Can't write the data file" );
+        extFileSize += (int64)size;
+    }
+
+    // Appends the matrix data to the external data file, returns the offset of the data
+    int64 writeExternalData( const Mat& m )
+    {
+        const uchar zeros[EXTERNAL_DATA_ALIGN] = {0};
+        int64 offset = (extFileSize + (int64)EXTERNAL_DATA_ALIGN - 1) & ~(int64)(EXTERNAL_DATA_ALIGN - 1);
+        writeExternalData( zeros, (size_t)(offset - extFileSize) );
+
+        const Mat* arrays[] = {&m, 0};
+        uchar* ptrs[1] = {};
+        NAryMatIterator it(arrays, ptrs);
+        size_t total = it.size*m.elemSize();
+        for( size_t i = 0; i < it.nplanes; i++, ++it )
+            writeExternalData( ptrs[0], total );
+        return offset;
+    }
+
+    Ptr<ExternalDataFile> getExternalData( const std::string& name )
+    {
+        std::map<std::string, Ptr<ExternalDataFile> >::iterator it = extFiles.find(name);
+        if( it != extFiles.end() )
+            return it->second;
+
+        // the data file is next to the storage file
+        std::string path = name;
+        size_t pos = filename.find_last_of("/\\");
+        if( !mem_mode && pos != std::string::npos )
+            path = filename.substr(0, pos + 1) + name;
+        Ptr<ExternalDataFile> data = makePtr<ExternalDataFile>(path);
+        extFiles[name] = data;
+        return data;
+    }
+
     void rewind()
     {
         if( file )
@@ -1781,6 +1984,11 @@ public:
     size_t strbufsize;
     size_t strbufpos;
     int lineno;
+
+    FILE* extFile;  //!< the external data file, FileStorage::EXTERNAL_DATA
+    std::string extFileName;
+    int64 extFileSize;
+    std::map<std::string, Ptr<ExternalDataFile> > extFiles;  //!< the mapped data files
 };
 
 FileStorage::FileStorage()
@@ -1978,6 +2186,42 @@ void write( FileStorage& fs, const String& name, const String& value )
     fs.p->write(name, value);
 }
 
+bool fs::writeExternalData( FileStorage& fs, const Mat& m, std::string& data_file, int64& offset )
+{
+    FileStorage::Impl* p = fs.p.get();
+    if( !p || !p->extFile )
+        return false;
+    data_file = p->extFileName;
+    offset = p->writeExternalData(m);
+    return true;
+}
+
+void fs::readExternalData( const FileNode& node, const std::string& data_file, int64 offset,
+                           int dims, const int* sizes, int elem_type, Mat& m )
+{
+    CV_Assert( node.fs );
+    CV_Check( data_file, !data_file.empty() && data_file.find_first_of("/\\") == std::string::npos,
+              "The data file must be next to the storage file" );
+    Ptr<ExternalDataFile> data = node.fs->getExternalData(data_file);
+
+    size_t total = CV_ELEM_SIZE(elem_type);
+    for( int i = 0; i < dims; i++ )
+        total *= sizes[i];
+    CV_Assert( offset >= (int64)EXTERNAL_DATA_HEADER_SIZE && (uint64)offset <= data->size &&
+               total <= data->size - (size_t)offset );
+
+    static ExternalDataAllocator* allocator = new ExternalDataAllocator();
+    Mat result(dims, sizes, elem_type, data->data + offset);
+    UMatData* u = new UMatData(allocator);
+    u->data = u->origdata = result.data;
+    u->size = total;
+    u->flags |= UMatData::USER_ALLOCATED;
+    u->allocatorContext = data;
+    u->refcount = 1;
+    result.u = u;
+    m = result;
+}
+
 void FileStorage::write(const String& name, int val) { p->write(name, val); }
 void FileStorage::write(const String& name, double val) { p->write(name, val); }
 void FileStorage::write(const String& name, const String& val) { p->write(name, val); }
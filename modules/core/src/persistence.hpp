@@ -94,6 +94,11 @@ int calcElemSize( const char* dt, int initial_size );
 char* encodeFormat( int elem_type, char* dt );
 int decodeFormat( const char* dt, int* fmt_pairs, int max_len );
 int decodeSimpleFormat( const char* dt );
+
+// FileStorage::EXTERNAL_DATA: the matrix data are kept in the binary file next to the storage file
+bool writeExternalData( FileStorage& fs, const Mat& m, std::string& data_file, int64& offset );
+void readExternalData( const FileNode& node, const std::string& data_file, int64 offset,
+                       int dims, const int* sizes, int elem_type, Mat& m );
 }
 
 
@@ -8,6 +8,18 @@
 namespace cv
 {
 
+// Writes the reference to the data in FileStorage::EXTERNAL_DATA mode
+static bool writeExternalData( FileStorage& fs, const Mat& m )
+{
+    std::string data_file;
+    int64 offset = 0;
+    if( !fs::writeExternalData( fs, m, data_file, offset ) )
+        return false;
+    fs << "data_file" << data_file;
+    fs << "data_offset" << (double)offset;  // int is 32-bit, double keeps the exact offsets up to 2^53
+    return true;
+}
+
 void write( FileStorage& fs, const String& name, const Mat& m )
 {
     char dt[16];
@@ -18,10 +30,13 @@ void write( FileStorage& fs, const String& name, const Mat& m )
         fs << "rows" << m.rows;
         fs << "cols" << m.cols;
         fs << "dt" << fs::encodeFormat( m.type(), dt );
-        fs << "data" << "[:";
-        for( int i = 0; i < m.rows; i++ )
-            fs.writeRaw(dt, m.ptr(i), m.cols*m.elemSize());
-        fs << "]";
+        if( !writeExternalData( fs, m ) )
+        {
+            fs << "data" << "[:";
+            for( int i = 0; i < m.rows; i++ )
+                fs.writeRaw(dt, m.ptr(i), m.cols*m.elemSize());
+            fs << "]";
+        }
         fs.endWriteStruct();
     }
     else
@@ -31,15 +46,18 @@ void write( FileStorage& fs, const String& name, const Mat& m )
         fs.writeRaw( "i", m.size.p, m.dims*sizeof(int) );
         fs << "]";
         fs << "dt" << fs::encodeFormat( m.type(), dt );
-        fs << "data" << "[:";
-        const Mat* arrays[] = {&m, 0};
-        uchar* ptrs[1] = {};
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size*m.elemSize();
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-            fs.writeRaw( dt, ptrs[0], total );
-        fs << "]";
+        if( !writeExternalData( fs, m ) )
+        {
+            fs << "data" << "[:";
+            const Mat* arrays[] = {&m, 0};
+            uchar* ptrs[1] = {};
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size*m.elemSize();
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+                fs.writeRaw( dt, ptrs[0], total );
+            fs << "]";
+        }
         fs.endWriteStruct();
     }
 }
@@ -129,23 +147,36 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
 
     elem_type = fs::decodeSimpleFormat( dt.c_str() );
 
+    int sizes[CV_MAX_DIM] = {0}, dims;
     read(node["rows"], rows, -1);
     if( rows >= 0 )
     {
         read(node["cols"], cols, -1);
-        m.create(rows, cols, elem_type);
+        dims = 2;
+        sizes[0] = rows;
+        sizes[1] = cols;
     }
     else
     {
-        int sizes[CV_MAX_DIM] = {0}, dims;
         FileNode sizes_node = node["sizes"];
         CV_Assert( !sizes_node.empty() );
 
         dims = (int)sizes_node.size();
+        CV_Assert( 0 < dims && dims <= CV_MAX_DIM );
         sizes_node.readRaw("i", sizes, dims*sizeof(sizes[0]));
+    }
 
-        m.create(dims, sizes, elem_type);
+    FileNode data_file_node = node["data_file"];
+    if( !data_file_node.empty() )
+    {
+        std::string data_file;
+        double offset = 0;
+        read(data_file_node, data_file, std::string());
+        read(node["data_offset"], offset, -1.);
+        fs::readExternalData(node, data_file, (int64)offset, dims, sizes, elem_type, m);
+        return;
     }
+    m.create(dims, sizes, elem_type);
 
     FileNode data_node = node["data"];
     CV_Assert(!data_node.empty());
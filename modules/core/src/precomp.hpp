@@ -322,6 +322,8 @@ struct ImplCollector
 };
 #endif
 
+namespace parallel { class ParallelForAPI; }
+
 struct CoreTLSData
 {
     CoreTLSData() :
@@ -329,10 +331,12 @@ struct CoreTLSData
         oclExecutionContextInitialized(false), useOpenCL(-1),
 //#endif
         useIPP(-1),
-        useIPP_NE(-1)
+        useIPP_NE(-1),
 #ifdef HAVE_OPENVX
-        ,useOpenVX(-1)
+        useOpenVX(-1),
 #endif
+        parallelForAPI(NULL),
+        workerPool(NULL), workerSlot(-1)
     {}
 
     RNG rng;
@@ -346,6 +350,9 @@ struct CoreTLSData
 #ifdef HAVE_OPENVX
     int useOpenVX; // 1 - use, 0 - do not use, -1 - auto/not initialized
 #endif
+    parallel::ParallelForAPI* parallelForAPI; // installed by ParallelContext::Scope, NULL - use global backend
+    const parallel::ParallelForAPI* workerPool; // work-stealing pool of the worker thread, NULL - not a worker
+    int workerSlot; // queue index of the worker thread in workerPool
 };
 
 CoreTLSData& getCoreTlsData();
@@ -2476,5 +2476,71 @@ TEST(Core_Magnitude, regression_19506)
     }
 }
 
+TEST(Core_ConvertBF16, accuracy)
+{
+    RNG& rng = theRNG();
+    for (int cols = 1; cols <= 70; cols++)
+    {
+        Mat src(3, cols, CV_32FC2), bf16, dst;
+        rng.fill(src, RNG::UNIFORM, -1e5, 1e5);
+        convertBF16(src, bf16);
+        ASSERT_EQ(CV_16UC2, bf16.type());
+        convertBF16(bf16, dst);
+        ASSERT_EQ(CV_32FC2, dst.type());
+        for (int i = 0; i < src.rows; i++)
+        {
+            for (int j = 0; j < cols * 2; j++)
+            {
+                const float x = src.ptr<float>(i)[j];
+                ASSERT_EQ(bfloat16_t(x).bits(), bf16.ptr<ushort>(i)[j]) << x;
+                ASSERT_EQ((float)bfloat16_t(x), dst.ptr<float>(i)[j]) << x;
+                ASSERT_LE(fabs(x - dst.ptr<float>(i)[j]), fabs(x) / 256) << x;
+            }
+        }
+    }
+}
+
+TEST(Core_ConvertBF16, special_values)
+{
+    const unsigned values[] = {
+        0x00000000, 0x80000000, 0x3f800000, 0x3f808000 /* tie, down to even */, 0x3f818000 /* tie, up to even */,
+        0x3f808001, 0x7f7fffff /* rounded to inf */, 0x7f800000, 0xff800000, 0x7fc00000, 0x7f800001 /* signaling NaN */,
+        0x00000001 /* denormal */
+    };
+    const ushort expected[] = {
+        0x0000, 0x8000, 0x3f80, 0x3f80, 0x3f82,
+        0x3f81, 0x7f80, 0x7f80, 0xff80, 0x7fc0, 0x7fc0,
+        0x0000
+    };
+    const int n = (int)(sizeof(values) / sizeof(values[0]));
+    Mat src(1, n * 5, CV_32F);  // long enough for the vectorized loop
+    for (int i = 0; i < src.cols; i++)
+        src.ptr<unsigned>()[i] = values[i % n];
+    Mat bf16;
+    convertBF16(src, bf16);
+    for (int i = 0; i < src.cols; i++)
+        EXPECT_EQ(expected[i % n], bf16.at<ushort>(i)) << std::hex << values[i % n];
+
+    // BF16 -> FP32 is exact
+    Mat all(1, 65536, CV_16U), dst, back;
+    for (int i = 0; i < all.cols; i++)
+        all.at<ushort>(i) = (ushort)i;
+    convertBF16(all, dst);
+    for (int i = 0; i < all.cols; i++)
+        ASSERT_EQ((unsigned)i << 16, dst.at<unsigned>(i));
+    Mat finite = all.colRange(0, 0x7f80);
+    convertBF16(finite, dst);
+    convertBF16(dst, back);
+    EXPECT_EQ(0, cvtest::norm(finite, back, NORM_INF));
+
+    const int sizes[] = { 2, 3, 4, 5 };
+    Mat nd(4, sizes, CV_32F), ndBF16;
+    randu(nd, -1, 1);
+    convertBF16(nd, ndBF16);
+    EXPECT_EQ(CV_16U, ndBF16.type());
+    EXPECT_EQ(nd.size, ndBF16.size);
+
+    EXPECT_THROW(convertBF16(Mat(2, 2, CV_8U), dst), cv::Exception);
+}
 
 }} // namespace
@@ -1837,4 +1837,110 @@ TEST(Core_InputOutput, FileStorage_copy_constructor_17412_heap)
     EXPECT_EQ(0, remove(fname.c_str()));
 }
 
+TEST(Core_InputOutput, FileStorage_external_data)
+{
+    const char* suffixes[] = { ".yml", ".xml", ".json" };
+    for (size_t k = 0; k < sizeof(suffixes) / sizeof(suffixes[0]); k++)
+    {
+        std::string fname = tempfile(suffixes[k]);
+        std::string dataFname = fname + ".data";
+
+        Mat m2d(37, 41, CV_64FC3), big(500, 700, CV_32F), small(1, 3, CV_8U);
+        randu(m2d, -1, 1);
+        randu(big, 0, 100);
+        randu(small, 0, 256);
+        Mat roi = big(Rect(10, 20, 30, 40));  // not continuous
+        const int sizes[] = { 3, 4, 5 };
+        Mat nd(3, sizes, CV_16SC2);
+        randu(nd, -1000, 1000);
+        {
+            FileStorage fs(fname, FileStorage::WRITE + FileStorage::EXTERNAL_DATA);
+            ASSERT_TRUE(fs.isOpened());
+            fs << "m2d" << m2d << "big" << big << "roi" << roi;
+            fs << "nested" << "{" << "small" << small << "nd" << nd << "}";
+            fs << "value" << 42;
+        }
+
+        // the text file contains the headers only
+        std::ifstream f(fname.c_str(), std::ios::binary | std::ios::ate);
+        EXPECT_LT((int64)f.tellg(), 4096) << fname;
+        f.close();
+
+        Mat m2d_, big_, big2_, roi_, small_, nd_;
+        {
+            FileStorage fs(fname, FileStorage::READ);
+            ASSERT_TRUE(fs.isOpened());
+            fs["m2d"] >> m2d_;
+            fs["big"] >> big_;
+            fs["big"] >> big2_;
+            fs["roi"] >> roi_;
+            fs["nested"]["small"] >> small_;
+            fs["nested"]["nd"] >> nd_;
+            EXPECT_EQ(42, (int)fs["value"]);
+        }
+        // the matrices refer to the mapped data file after release of the storage
+        EXPECT_EQ(0, cvtest::norm(m2d, m2d_, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(big, big_, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(roi, roi_, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(small, small_, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(nd, nd_, NORM_INF));
+        EXPECT_EQ(nd.size, nd_.size);
+        EXPECT_EQ(big_.data, big2_.data);  // no copies
+        EXPECT_EQ((size_t)0, (size_t)m2d_.data % 64);
+
+        // the mapping is copy-on-write
+        big_.setTo(0);
+        EXPECT_EQ(0, countNonZero(big2_));
+        {
+            FileStorage fs(fname, FileStorage::READ);
+            Mat big3_;
+            fs["big"] >> big3_;
+            EXPECT_EQ(0, cvtest::norm(big, big3_, NORM_INF));
+        }
+
+        EXPECT_EQ(0, remove(fname.c_str()));
+        EXPECT_EQ(0, remove(dataFname.c_str()));
+    }
+}
+
+TEST(Core_InputOutput, FileStorage_external_data_append)
+{
+    std::string fname = tempfile(".yml");
+    std::string dataFname = fname + ".data";
+    Mat a(10, 10, CV_8U, Scalar(1)), b(20, 5, CV_32F, Scalar(2));
+    {
+        FileStorage fs(fname, FileStorage::WRITE + FileStorage::EXTERNAL_DATA);
+        fs << "a" << a;
+    }
+    {
+        FileStorage fs(fname, FileStorage::APPEND + FileStorage::EXTERNAL_DATA);
+        fs << "b" << b;
+    }
+    {
+        FileStorage fs(fname, FileStorage::READ);
+        Mat a_, b_;
+        fs["a"] >> a_;
+        fs["b"] >> b_;
+        EXPECT_EQ(0, cvtest::norm(a, a_, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(b, b_, NORM_INF));
+    }
+    EXPECT_THROW(FileStorage(fname + ".gz", FileStorage::WRITE + FileStorage::EXTERNAL_DATA), cv::Exception);
+    remove((fname + ".gz").c_str());
+    EXPECT_THROW(FileStorage(".yml", FileStorage::WRITE + FileStorage::MEMORY + FileStorage::EXTERNAL_DATA), cv::Exception);
+
+    // the corrupted data file
+    {
+        std::ofstream f(dataFname.c_str(), std::ios::binary | std::ios::trunc);
+        f << "garbage";
+    }
+    {
+        FileStorage fs(fname, FileStorage::READ);
+        Mat a_;
+        EXPECT_THROW(fs["a"] >> a_, cv::Exception);
+    }
+
+    EXPECT_EQ(0, remove(fname.c_str()));
+    EXPECT_EQ(0, remove(dataFname.c_str()));
+}
+
 }} // namespace
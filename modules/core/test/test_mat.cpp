@@ -10,6 +10,9 @@
 #endif
 
 #include "opencv2/core/cuda.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -2449,4 +2452,107 @@ TEST(Mat, reverse_iterator_19967)
 
 }
 
+TEST(Mat, pool_allocator)
+{
+    MatAllocator* allocator = Mat::getPoolAllocator();
+    BufferPoolController* pool = allocator->getBufferPoolController();
+    const size_t maxReservedSize = pool->getMaxReservedSize();
+    pool->setMaxReservedSize(16 << 20);
+    pool->freeAllReservedBuffers();
+    EXPECT_EQ((size_t)0, pool->getReservedSize());
+
+    const uchar* data = NULL;
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(480, 640, CV_8UC3);
+        data = m.data;
+    }
+    EXPECT_GE(pool->getReservedSize(), (size_t)480 * 640 * 3);
+    {
+        // the same size class
+        Mat m;
+        m.allocator = allocator;
+        m.create(478, 640, CV_8UC3);
+        EXPECT_EQ(data, m.data);
+        EXPECT_EQ((size_t)0, pool->getReservedSize());
+    }
+    pool->setMaxReservedSize(256 << 10);
+    EXPECT_EQ((size_t)0, pool->getReservedSize());
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(480, 640, CV_8UC3);  // exceeds the limit, it is not cached
+        Mat small;
+        small.allocator = allocator;
+        small.create(100, 100, CV_8UC1);
+    }
+    EXPECT_GE(pool->getReservedSize(), (size_t)100 * 100);
+    EXPECT_LE(pool->getReservedSize(), (size_t)256 << 10);
+    pool->freeAllReservedBuffers();
+    EXPECT_EQ((size_t)0, pool->getReservedSize());
+
+    pool->setMaxReservedSize(maxReservedSize);
+}
+
+TEST(Mat, pool_allocator_threads)
+{
+    MatAllocator* allocator = Mat::getPoolAllocator();
+    BufferPoolController* pool = allocator->getBufferPoolController();
+    pool->freeAllReservedBuffers();
+    const uint64_t usage = cv::utils::getPoolAllocatorStatistics().getCurrentUsage();
+
+    MatAllocator* defaultAllocator = Mat::getDefaultAllocator();
+    Mat::setDefaultAllocator(allocator);
+    std::vector<Mat> released(16);
+    parallel_for_(Range(0, 64), [&](const Range& range)
+    {
+        for (int i = range.start; i < range.end; i++)
+        {
+            Mat m(64 + i % 16 * 32, 100, CV_32FC1, Scalar::all(i));
+            ASSERT_EQ(allocator, m.u->currAllocator);
+            ASSERT_EQ(0, countNonZero(m != i));
+        }
+    });
+    for (size_t i = 0; i < released.size(); i++)
+        released[i].create(200, 300, CV_8UC1);
+    Mat::setDefaultAllocator(defaultAllocator);
+
+    // the buffers allocated by this thread are released by another thread
+    std::thread t([&]{ released.clear(); });
+    t.join();
+    EXPECT_GT(pool->getReservedSize(), (size_t)0);
+
+    pool->freeAllReservedBuffers();
+    EXPECT_EQ((size_t)0, pool->getReservedSize());
+    EXPECT_EQ(usage, cv::utils::getPoolAllocatorStatistics().getCurrentUsage());
+}
+
+TEST(Mat, hugepage_allocator)
+{
+    MatAllocator* allocator = Mat::getHugePageAllocator();
+    const int sizes[] = { 1, 10, 1000, 1000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(sizes[i], 1000, CV_32FC1);
+        ASSERT_TRUE(m.isContinuous());
+        m.setTo(Scalar::all((double)i));
+        EXPECT_EQ(0, countNonZero(m != (double)i));
+
+        Mat roi = m.rowRange(0, sizes[i] / 2 + 1).clone();
+        m.release();
+        EXPECT_EQ(0, countNonZero(roi != (double)i));
+    }
+
+    const int blobShape[] = { 2, 64, 56, 56 };
+    Mat blob;
+    blob.allocator = allocator;
+    blob.create(4, blobShape, CV_32F);
+    randu(blob, 0, 1);
+    Mat ref = blob.clone();
+    EXPECT_EQ(0, cvtest::norm(ref, blob, NORM_INF));
+}
+
 }} // namespace
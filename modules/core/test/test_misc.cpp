@@ -2,7 +2,9 @@
 // It is subject to the license terms in the LICENSE file found in the top-level directory
 // of this distribution and at http://opencv.org/license.html.
 #include "test_precomp.hpp"
+#include "opencv2/core/parallel/parallel_backend.hpp"
 #include <cmath>
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -243,6 +245,137 @@ TEST(Core_Parallel, propagate_exceptions)
     }, cv::Exception);
 }
 
+// Restores the parallel backend and the number of threads on exit from the test
+struct ParallelBackendGuard
+{
+    ParallelBackendGuard()
+        : numThreads(cv::getNumThreads()), backend(currentBackend())
+    {}
+    ~ParallelBackendGuard()
+    {
+        cv::parallel::setParallelForBackend("");
+        if (backend != currentBackend())
+            cv::parallel::setParallelForBackend(backend);
+        cv::setNumThreads(numThreads);
+    }
+
+    static std::string currentBackend()
+    {
+        const char* name = cv::currentParallelFramework();
+        return name ? name : "";
+    }
+
+    const int numThreads;
+    const std::string backend;
+};
+
+TEST(Core_Parallel, workstealing_nested)
+{
+    ParallelBackendGuard guard;
+    if (!cv::parallel::setParallelForBackend("WORKSTEALING"))
+        throw SkipTestException("WORKSTEALING parallel backend is not available");
+    cv::setNumThreads(4);
+
+    Mat dst(64, 256, CV_32SC1, Scalar::all(0));
+    EXPECT_NO_THROW({
+        parallel_for_(cv::Range(0, dst.rows), [&](const cv::Range& r)
+        {
+            for (int y = r.start; y < r.end; y++)
+            {
+                int* row = dst.ptr<int>(y);
+                parallel_for_(cv::Range(0, dst.cols), [&](const cv::Range& c)
+                {
+                    for (int x = c.start; x < c.end; x++)
+                        row[x] += y + x;
+                });
+            }
+        });
+    });
+    for (int y = 0; y < dst.rows; y++)
+        for (int x = 0; x < dst.cols; x++)
+            ASSERT_EQ(y + x, dst.at<int>(y, x)) << "y=" << y << " x=" << x;
+
+    Mat dst2(100, 100, CV_8SC1, Scalar::all(0));
+    EXPECT_THROW({
+        parallel_for_(cv::Range(0, 4), [&](const cv::Range&)
+        {
+            parallel_for_(cv::Range(0, dst2.rows), ThrowErrorParallelLoopBody(dst2, dst2.rows / 2));
+        });
+    }, cv::Exception);
+}
+
+TEST(Core_Parallel, context_scope)
+{
+    cv::ParallelContext ctx(3);
+    EXPECT_EQ(3, ctx.getNumThreads());
+    const int globalNumThreads = cv::getNumThreads();
+    {
+        cv::ParallelContext::Scope scope(ctx);
+        EXPECT_EQ(3, cv::getNumThreads());
+        {
+            cv::ParallelContext ctx2(2);
+            cv::ParallelContext::Scope scope2(ctx2);
+            EXPECT_EQ(2, cv::getNumThreads());
+        }
+        EXPECT_EQ(3, cv::getNumThreads());
+    }
+    EXPECT_EQ(globalNumThreads, cv::getNumThreads());
+}
+
+TEST(Core_Parallel, context_concurrent_tenants)
+{
+    const int N = 3;
+    std::vector<cv::ParallelContext> contexts;
+    for (int i = 0; i < N; i++)
+        contexts.push_back(cv::ParallelContext(2 + i));
+
+    std::vector<Mat> results(N);
+    std::vector<std::thread> tenants;
+    for (int i = 0; i < N; i++)
+    {
+        tenants.push_back(std::thread([&, i]()
+        {
+            cv::ParallelContext::Scope scope(contexts[i]);
+            Mat dst(128, 128, CV_32SC1, Scalar::all(0));
+            for (int iter = 0; iter < 10; iter++)
+            {
+                parallel_for_(cv::Range(0, dst.rows), [&](const cv::Range& r)
+                {
+                    for (int y = r.start; y < r.end; y++)
+                    {
+                        int* row = dst.ptr<int>(y);
+                        parallel_for_(cv::Range(0, dst.cols), [&](const cv::Range& c)
+                        {
+                            for (int x = c.start; x < c.end; x++)
+                                row[x] += i + 1;
+                        });
+                    }
+                });
+            }
+            results[i] = dst;
+        }));
+    }
+    for (size_t i = 0; i < tenants.size(); i++)
+        tenants[i].join();
+
+    for (int i = 0; i < N; i++)
+        EXPECT_EQ(0, cvtest::norm(results[i], Mat(128, 128, CV_32SC1, Scalar::all(10 * (i + 1))), NORM_INF)) << "tenant=" << i;
+}
+
+TEST(Core_Parallel, context_affinity)
+{
+    std::vector<int> cpus(1, 0);
+    cv::ParallelContext ctx(2, cpus);
+    EXPECT_EQ(cpus, ctx.getCPUs());
+    cv::ParallelContext::Scope scope(ctx);
+    Mat dst(64, 64, CV_8UC1, Scalar::all(0));
+    parallel_for_(cv::Range(0, dst.rows), [&](const cv::Range& r)
+    {
+        dst.rowRange(r).setTo(1);
+    });
+    EXPECT_EQ(dst.total(), (size_t)countNonZero(dst));
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
@@ -426,6 +426,10 @@ CV__DNN_INLINE_NS_BEGIN
     public:
         virtual void forwardSlice(const float* src, float* dst, int len,
                                   size_t outPlaneSize, int cn0, int cn1) const = 0;
+
+        /** @brief Quantizes the function into INT8 lookup table (see ActivationLayerInt8) */
+        virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                                 const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE;
     };
 
     class CV_EXPORTS ReLULayer : public ActivationLayer
@@ -508,6 +512,25 @@ CV__DNN_INLINE_NS_BEGIN
         static Ptr<ExpLayer> create(const LayerParams &params);
     };
 
+    /** @brief Gaussian error linear unit: `y = 0.5 * x * (1 + erf(x / sqrt(2)))`
+     *
+     * The tanh approximation `y = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))`
+     * is used if "approximate" parameter is "tanh".
+     */
+    class CV_EXPORTS GeluLayer : public ActivationLayer
+    {
+    public:
+        bool approximate;
+
+        static Ptr<GeluLayer> create(const LayerParams &params);
+    };
+
+    class CV_EXPORTS ErfLayer : public ActivationLayer
+    {
+    public:
+        static Ptr<ErfLayer> create(const LayerParams &params);
+    };
+
     /* Layers used in semantic segmentation */
 
     class CV_EXPORTS CropLayer : public Layer
@@ -689,6 +712,169 @@ CV__DNN_INLINE_NS_BEGIN
         static Ptr<Layer> create(const LayerParams& params);
     };
 
+    /* Transformers */
+
+    /** @brief Normalizes every sample over the trailing axes starting from @p axis:
+     * `y = (x - mean(x)) / sqrt(var(x) + epsilon) * scale + bias`.
+     *
+     * Scale and optional bias are stored in blobs and have the shape of the normalized axes.
+     */
+    class CV_EXPORTS LayerNormLayer : public Layer
+    {
+    public:
+        int axis;
+        float epsilon;
+        bool hasBias;
+
+        static Ptr<LayerNormLayer> create(const LayerParams& params);
+    };
+
+    /** @brief Matrix product of N-D blobs with numpy-style broadcasting of batch dimensions.
+     *
+     * The last two dimensions of inputs are multiplied as matrices. 1-D operands are treated as
+     * row (first input) or column (second input) vectors. A constant operand may be stored in blobs,
+     * @p constInput specifies its position (0 or 1).
+     */
+    class CV_EXPORTS MatMulLayer : public Layer
+    {
+    public:
+        int constInput;
+
+        static Ptr<MatMulLayer> create(const LayerParams& params);
+    };
+
+    /** @brief Einstein summation over one or more inputs, e.g. "bhid,bhjd->bhij".
+     *
+     * Operands are contracted pairwise from left to right. Ellipsis and implicit output mode are supported,
+     * repeated labels inside one operand (diagonals) are not.
+     */
+    class CV_EXPORTS EinsumLayer : public Layer
+    {
+    public:
+        String equation;
+
+        static Ptr<EinsumLayer> create(const LayerParams& params);
+    };
+
+    /** @brief Selects elements from the second or the third input depending on the first one:
+     * `y = condition != 0 ? x1 : x2`. Inputs are broadcasted numpy-style.
+     */
+    class CV_EXPORTS WhereLayer : public Layer
+    {
+    public:
+        static Ptr<WhereLayer> create(const LayerParams& params);
+    };
+
+    /** @brief Scaled dot-product attention: `y = softmax(Q * K^T * scale + mask) * V`.
+     *
+     * Inputs are queries [..., Sq, D], keys [..., Sk, D] (or already transposed keys [..., D, Sk]
+     * if @p keyTransposed is set), values [..., Sk, Dv] and an optional additive mask
+     * broadcastable to [..., Sq, Sk]. Attention weights are computed row by row and never
+     * stored entirely.
+     */
+    class CV_EXPORTS AttentionLayer : public Layer
+    {
+    public:
+        float scale;
+        bool keyTransposed;
+
+        static Ptr<AttentionLayer> create(const LayerParams& params);
+    };
+
+    /* Quantization */
+
+    /** @brief Converts FP32 blobs to INT8: `q = saturate(round(x / scale) + zeropoint)`
+     *
+     * Every input has its own pair of quantization parameters ("scales" and "zeropoints" arrays).
+     */
+    class CV_EXPORTS QuantizeLayer : public Layer
+    {
+    public:
+        std::vector<float> scales;
+        std::vector<int> zeropoints;
+
+        static Ptr<QuantizeLayer> create(const LayerParams &params);
+    };
+
+    /** @brief Converts INT8 blobs to FP32: `x = scale * (q - zeropoint)` */
+    class CV_EXPORTS DequantizeLayer : public Layer
+    {
+    public:
+        std::vector<float> scales;
+        std::vector<int> zeropoints;
+
+        static Ptr<DequantizeLayer> create(const LayerParams &params);
+    };
+
+    class CV_EXPORTS ConvolutionLayerInt8 : public BaseConvolutionLayer
+    {
+    public:
+        int input_zp, output_zp;
+        float output_sc;
+
+        static Ptr<BaseConvolutionLayer> create(const LayerParams& params);
+    };
+
+    class CV_EXPORTS InnerProductLayerInt8 : public Layer
+    {
+    public:
+        int axis;
+        int input_zp, output_zp;
+
+        static Ptr<InnerProductLayerInt8> create(const LayerParams& params);
+    };
+
+    class CV_EXPORTS PoolingLayerInt8 : public Layer
+    {
+    public:
+        int type;
+        std::vector<size_t> kernel_size, strides;
+        std::vector<size_t> pads_begin, pads_end;
+        String padMode;
+        bool globalPooling;
+        bool ceilMode;
+        bool avePoolPaddedArea;
+        int input_zp, output_zp;
+        float input_sc, output_sc;
+
+        static Ptr<PoolingLayerInt8> create(const LayerParams& params);
+    };
+
+    /** @brief Weighted sum of INT8 blobs of the same shape with requantization to the output scale. */
+    class CV_EXPORTS EltwiseLayerInt8 : public Layer
+    {
+    public:
+        static Ptr<EltwiseLayerInt8> create(const LayerParams& params);
+    };
+
+    class CV_EXPORTS ConcatLayerInt8 : public Layer
+    {
+    public:
+        int axis;
+
+        static Ptr<ConcatLayerInt8> create(const LayerParams& params);
+    };
+
+    /** @brief Element-wise INT8 function defined by lookup table (per channel or shared). */
+    class CV_EXPORTS ActivationLayerInt8 : public ActivationLayer
+    {
+    public:
+        using ActivationLayer::forwardSlice;
+
+        /** @brief Applies lookup table to INT8 data
+         *  @param src source data
+         *  @param dst destination data
+         *  @param len number of elements in every plane to process
+         *  @param planeSize distance between planes of subsequent channels
+         *  @param cn0 first channel
+         *  @param cn1 last channel (exclusive)
+         */
+        virtual void forwardSlice(const int8_t* src, int8_t* dst, int len,
+                                  size_t planeSize, int cn0, int cn1) const = 0;
+
+        static Ptr<ActivationLayerInt8> create(const LayerParams& params);
+    };
+
 //! @}
 //! @}
 CV__DNN_INLINE_NS_END
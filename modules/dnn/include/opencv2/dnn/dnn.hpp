@@ -368,6 +368,20 @@ CV__DNN_INLINE_NS_BEGIN
          */
         virtual void getScaleShift(Mat& scale, Mat& shift) const;
 
+        /**
+         * @brief Tries to quantize the given layer and compute the quantization parameters required for fixed point implementation.
+         * @param[in] scales input and output scales.
+         * @param[in] zeropoints input and output zeropoints.
+         * @param[out] params Quantized parameters required for fixed point implementation of that layer.
+         * @returns True if layer can be quantized.
+         *
+         * Quantized values are represented as `real = scale * (q - zeropoint)` with `q` of CV_8S type.
+         * On success @p params describes a layer which consumes and produces CV_8S blobs
+         * (@p params.type is changed to the type of fixed point implementation if it differs).
+         */
+        virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                                 const std::vector<std::vector<int> > &zeropoints, LayerParams& params);
+
         /**
          * @brief "Deattaches" all the layers, attached to particular layer.
          */
@@ -732,11 +746,39 @@ CV__DNN_INLINE_NS_BEGIN
                                           CV_OUT std::vector<size_t>& weights,
                                           CV_OUT std::vector<size_t>& blobs) const; // FIXIT: CV_WRAP
 
+        /** @brief Computes peak bytes number which is required to store intermediate blobs
+         * if they are placed into a single arena by the static memory planner.
+         * Blobs which are not used at the same time share memory of the arena.
+         * @param netInputShapes vector of shapes for all net inputs.
+         * @returns bytes number for inputs of the network and the arena of intermediate blobs.
+         *
+         * The planner is used by the default backend on CPU target (set OPENCV_DNN_MEMORY_PLANNER=0 to disable it).
+         * Compare with @p blobs value of getMemoryConsumption() which doesn't take memory reusing into account.
+         */
+        CV_WRAP size_t getMemoryPeak(const std::vector<MatShape>& netInputShapes) const;
+        /** @overload */
+        CV_WRAP size_t getMemoryPeak(const MatShape& netInputShape) const;
+
         /** @brief Enables or disables layer fusion in the network.
          * @param fusion true to enable the fusion, false to disable. The fusion is enabled by default.
          */
         CV_WRAP void enableFusion(bool fusion);
 
+        /** @brief Returns a quantized Net from a floating-point Net.
+         *  @param calibData Calibration data to compute the quantization parameters.
+         *  For networks with N inputs every N consecutive blobs form a single calibration sample
+         *  (in order of network inputs, see setInputsNames()).
+         *  @returns Network with INT8 (CV_8S) implementations of supported layers.
+         *
+         *  Weights are quantized symmetrically per output channel, activations are quantized
+         *  asymmetrically per tensor using ranges collected by forward passes over @p calibData.
+         *  Layers without fixed point implementation stay in FP32, required conversions are inserted automatically.
+         *  Blobs of quantized layers are CV_8S internally, inputs and any requested outputs of the resulting
+         *  network (including outputs of intermediate layers) are FP32.
+         *  Quantized network is executed by DNN_BACKEND_OPENCV on DNN_TARGET_CPU only.
+         */
+        CV_WRAP Net quantize(InputArrayOfArrays calibData);
+
         /** @brief Returns overall time for inference and timings (in ticks) for layers.
          *
          * Indexes in returned vector correspond to layers ids. Some layers can be fused with others,
@@ -747,6 +789,27 @@ CV__DNN_INLINE_NS_BEGIN
          */
         CV_WRAP int64 getPerfProfile(CV_OUT std::vector<double>& timings);
 
+        /** @brief Returns per-layer profile of the last forward pass.
+         *
+         * For every layer the report contains its wall time, number of floating point operations (see getFLOPS()),
+         * number of bytes moved (inputs, outputs and weights), achieved GFLOP/s and arithmetic intensity
+         * (FLOPs per byte) which helps to find memory-bound and compute-bound layers. Layers fused with others
+         * have zero time and bytes, their operations are performed by the fusing layer.
+         * Timings are collected by every forward() call so no additional configuration is required.
+         * Timings are reliable for DNN_BACKEND_OPENCV on DNN_TARGET_CPU only (see getPerfProfile()).
+         *
+         * @param format "json" for a report with layers and total statistics or
+         *               "trace" for Chrome trace event format (open in chrome://tracing or Perfetto UI).
+         * @returns String with the report.
+         */
+        CV_WRAP String dumpProfile(const String& format = "json");
+        /** @brief Dump per-layer profile of the last forward pass to a file
+         *  @param path   path to output file
+         *  @param format "json" or "trace"
+         *  @see dumpProfile()
+         */
+        CV_WRAP void dumpProfileToFile(const String& path, const String& format = "json");
+
     private:
         struct Impl;
         Ptr<Impl> impl;
@@ -1589,6 +1652,45 @@ public:
     CV_WRAP int getMaxCandidates() const;
 };
 
+/** @brief Serves inference requests from many threads by merging them into dynamic batches.
+ *
+ * Requests are processed by a dedicated thread. It waits up to @p maxDelay milliseconds since
+ * the oldest pending request to collect up to @p maxBatchSize samples of the same shape,
+ * concatenates them along the first (batch) axis, runs a single forward pass and
+ * splits the output back between the requests.
+ *
+ * The queue uses the network exclusively: methods of the network must not be called
+ * from other threads while the queue exists. Pending requests are completed on destruction.
+ */
+class CV_EXPORTS InferenceQueue
+{
+public:
+    virtual ~InferenceQueue();
+
+    /** @brief Creates a queue.
+     * @param net network with a single input. The first dimension of the input and the output is a batch one.
+     * @param maxBatchSize maximal number of samples in a batch.
+     * @param maxDelay maximal time in milliseconds the oldest request waits for the others to form a batch.
+     * @param outputName name of the layer which output is returned, the default output of network if empty.
+     */
+    static Ptr<InferenceQueue> create(const Net& net, int maxBatchSize = 8, double maxDelay = 2.0,
+                                      const String& outputName = String());
+
+    /** @brief Enqueues a request. Thread-safe.
+     * @param blob N-D blob with one or more samples along the first dimension, e.g. from blobFromImage.
+     * The blob is copied so it may be reused just after the call.
+     * @return the output rows which correspond to the samples of @p blob.
+     * Errors of processing are raised by AsyncArray::get().
+     */
+    virtual AsyncArray enqueue(InputArray blob) = 0;
+
+    /** @brief Returns the number of requests waiting to be processed. */
+    virtual int getNumPendingRequests() const = 0;
+
+    /** @brief Returns the number of forward passes and the number of processed samples. */
+    virtual void getStatistics(int64& numBatches, int64& numSamples) const = 0;
+};
+
 //! @}
 CV__DNN_INLINE_NS_END
 }
@@ -76,6 +76,8 @@ static size_t DNN_NETWORK_DUMP = utils::getConfigurationParameterSizeT("OPENCV_D
 
 // this option is useful to run valgrind memory errors detection
 static bool DNN_DISABLE_MEMORY_OPTIMIZATIONS = utils::getConfigurationParameterBool("OPENCV_DNN_DISABLE_MEMORY_OPTIMIZATIONS", false);
+// place intermediate blobs of the OpenCV/CPU backend into a single arena using a static memory plan
+static bool DNN_MEMORY_PLANNER = utils::getConfigurationParameterBool("OPENCV_DNN_MEMORY_PLANNER", true);
 
 #ifdef HAVE_OPENCL
 static bool DNN_OPENCL_ALLOW_ALL_DEVICES = utils::getConfigurationParameterBool("OPENCV_DNN_OPENCL_ALLOW_ALL_DEVICES", false);
@@ -565,9 +567,9 @@ struct LayerPin
 
 struct LayerData
 {
-    LayerData() : id(-1), skip(false), flag(0) {}
+    LayerData() : id(-1), dtype(CV_32F), skip(false), flag(0) {}
     LayerData(int _id, const String &_name, const String &_type, LayerParams &_params)
-        : id(_id), name(_name), type(_type), params(_params), skip(false), flag(0)
+        : id(_id), name(_name), type(_type), params(_params), dtype(CV_32F), skip(false), flag(0)
     {
         CV_TRACE_FUNCTION();
 
@@ -580,6 +582,7 @@ struct LayerData
     String name;
     String type;
     LayerParams params;
+    int dtype;  // Datatype of output blobs.
 
     std::vector<LayerPin> inputBlobsId;
     std::set<int> inputLayersId;
@@ -861,9 +864,34 @@ struct DataLayer : public Layer
     bool skip;
 };
 
+// Static placement of blobs: every memory host (see BlobManager) gets an offset
+// in the arena of its data type. Hosts which are alive at the same time never overlap.
+struct MemoryPlan
+{
+    // host -> (data type, offset in elements)
+    std::map<LayerPin, std::pair<int, size_t> > offsets;
+    // data type -> number of elements in the arena
+    std::map<int, size_t> arenaSizes;
+    // layers which are computed in-place
+    std::set<int> inPlaceLayers;
+    // layers which outputs are placed since the step of the preceding convolution or fully-connected layer,
+    // so that layer may compute eltwise sum (and activation) directly to them (see fuseLayers)
+    std::set<int> reservedOutputs;
+
+    size_t getArenaBytes() const
+    {
+        size_t bytes = 0;
+        for (std::map<int, size_t>::const_iterator it = arenaSizes.begin(); it != arenaSizes.end(); ++it)
+            bytes += it->second * CV_ELEM_SIZE(it->first);
+        return bytes;
+    }
+};
+
 struct BlobManager
 {
 public:
+    BlobManager() : usePlan(false) {}
+
     // Increase references counter to layer output.
     void addReference(const LayerPin& lp)
     {
@@ -935,9 +963,52 @@ public:
         }
     }
 
-    void reuseOrCreate(const MatShape& shape, const LayerPin& lp, Mat& dst, bool use_half)
+    // Allocate blobs inside the arenas according to the plan instead of
+    // reusing memory by references counting.
+    void setMemoryPlan(const MemoryPlan& plan_)
+    {
+        plan = plan_;
+        usePlan = true;
+        for (std::map<int, Mat>::iterator it = arenas.begin(); it != arenas.end();)
+        {
+            if (plan.arenaSizes.find(it->first) == plan.arenaSizes.end())
+                arenas.erase(it++);
+            else
+                ++it;
+        }
+        for (std::map<int, size_t>::const_iterator it = plan.arenaSizes.begin(); it != plan.arenaSizes.end(); ++it)
+        {
+            CV_CheckLE(it->second, (size_t)INT_MAX, "Arena of intermediate blobs is too big");
+            // if the arena already has the same size, the memory is not reallocated
+            arenas[it->first].create(1, (int)it->second, it->first);
+        }
+    }
+
+    void releaseArenas()
+    {
+        arenas.clear();
+    }
+
+    bool isOutputReserved(int lid) const
     {
-        if (!DNN_DISABLE_MEMORY_OPTIMIZATIONS)
+        return usePlan && plan.reservedOutputs.count(lid) != 0;
+    }
+
+    void reuseOrCreate(const MatShape& shape, const LayerPin& lp, Mat& dst, int dtype)
+    {
+        if (usePlan)
+        {
+            std::map<LayerPin, std::pair<int, size_t> >::const_iterator planIt = plan.offsets.find(lp);
+            if (planIt != plan.offsets.end())
+            {
+                CV_CheckTypeEQ(planIt->second.first, dtype, "");
+                const int offset = (int)planIt->second.second;
+                dst = arenas[dtype].colRange(offset, offset + total(shape)).reshape(1, shape);
+                addHost(lp, dst);
+                return;
+            }
+        }
+        else if (!DNN_DISABLE_MEMORY_OPTIMIZATIONS)
         {
             Mat bestBlob;
             LayerPin bestBlobPin;
@@ -957,7 +1028,8 @@ public:
                 {
                     Mat& unusedBlob = hostIt->second;
                     if (unusedBlob.total() >= targetTotal &&
-                        unusedBlob.total() < bestBlobTotal)
+                        unusedBlob.total() < bestBlobTotal &&
+                        unusedBlob.type() == dtype)
                     {
                         bestBlobPin = hostIt->first;
                         bestBlob = unusedBlob;
@@ -976,14 +1048,14 @@ public:
         {
             // if dst already has been allocated with total(shape) elements,
             // it won't be recreated and pointer of dst.data remains the same.
-            dst.create(shape, use_half ? CV_16S : CV_32F);
+            dst.create(shape, dtype);
             addHost(lp, dst);
         }
     }
 
     void allocateBlobsForLayer(LayerData &ld, const LayerShapes& layerShapes,
                                std::vector<LayerPin>& pinsForInternalBlobs,
-                               bool use_half = false)
+                               int dtype = CV_32F)
     {
         CV_TRACE_FUNCTION();
 
@@ -1006,10 +1078,20 @@ public:
         {
             if (ld.inputBlobs.size() == 1)
             {
-                // Get number of references to the input memory.
-                int numRef = numReferences(ld.inputBlobsId[0]);
-                // If current layer is one and only customer of this blob.
-                inPlace = numRef == 1;
+                if (usePlan)
+                {
+                    // Lifetimes of blobs in the plan depend on this decision.
+                    inPlace = plan.inPlaceLayers.count(ld.id) != 0;
+                    if (inPlace)
+                        CV_CheckTypeEQ(ld.inputBlobs[0]->type(), dtype, "");
+                }
+                else
+                {
+                    // Get number of references to the input memory.
+                    int numRef = numReferences(ld.inputBlobsId[0]);
+                    // If current layer is one and only customer of this blob.
+                    inPlace = numRef == 1 && ld.inputBlobs[0]->type() == dtype;
+                }
             }
         }
 
@@ -1054,7 +1136,7 @@ public:
                         reuse(ld.inputBlobsId[0], blobPin);
                     }
                     else
-                        reuseOrCreate(shapes[index], blobPin, *blobs[index], use_half);
+                        reuseOrCreate(shapes[index], blobPin, *blobs[index], dtype);
                 }
             }
         }
@@ -1068,6 +1150,9 @@ public:
         refCounter.clear();
         reuseMap.clear();
         memHosts.clear();
+        // arenas are kept to avoid reallocation if the plan has the same size
+        plan = MemoryPlan();
+        usePlan = false;
     }
 
 private:
@@ -1084,6 +1169,10 @@ private:
     // For origin blobs key == value.
     std::map<LayerPin, LayerPin> reuseMap;
     std::map<LayerPin, Mat> memHosts;
+
+    MemoryPlan plan;
+    bool usePlan;
+    std::map<int, Mat> arenas;
 };
 
 static Ptr<BackendWrapper> wrapMat(int backendId, int targetId, cv::Mat& m)
@@ -1184,6 +1273,7 @@ struct Net::Impl : public detail::NetImplBase
 
         lastLayerId = 0;
         netWasAllocated = false;
+        netWasQuantized = false;
         fusion = true;
         isAsync = false;
         preferableBackend = DNN_BACKEND_DEFAULT;
@@ -1208,9 +1298,12 @@ struct Net::Impl : public detail::NetImplBase
     int lastLayerId;
 
     bool netWasAllocated;
+    bool netWasQuantized;
+    std::map<LayerPin, std::pair<float, int> > blobsQuantParams;  // scale and zero point of INT8 blobs of quantized net
     bool fusion;
     bool isAsync;
     std::vector<int64> layersTimings;
+    std::vector<int64> layersStartTicks;
     Mat output_blob;
 
 #ifdef HAVE_CUDA
@@ -1365,6 +1458,7 @@ struct Net::Impl : public detail::NetImplBase
         }
 
         layersTimings.clear();
+        layersStartTicks.clear();
     }
 
     void setUpNet(const std::vector<LayerPin>& blobsToKeep_ = std::vector<LayerPin>())
@@ -1454,6 +1548,13 @@ struct Net::Impl : public detail::NetImplBase
                 preferableTarget = DNN_TARGET_CPU;
             }
 
+            if (netWasQuantized && (preferableBackend != DNN_BACKEND_OPENCV || preferableTarget != DNN_TARGET_CPU))
+            {
+                CV_LOG_WARNING(NULL, "DNN: quantized network is supported by OpenCV backend on CPU only, switching to OpenCV/CPU");
+                preferableBackend = DNN_BACKEND_OPENCV;
+                preferableTarget = DNN_TARGET_CPU;
+            }
+
             clear();
 
             this->blobsToKeep = blobsToKeep_;
@@ -2520,9 +2621,10 @@ struct Net::Impl : public detail::NetImplBase
         CV_Assert(layerShapesIt != layersShapes.end());
 
         std::vector<LayerPin> pinsForInternalBlobs;
+        const bool use_half = preferableBackend == DNN_BACKEND_OPENCV &&
+                              preferableTarget == DNN_TARGET_OPENCL_FP16;
         blobManager.allocateBlobsForLayer(ld, layerShapesIt->second, pinsForInternalBlobs,
-                                          preferableBackend == DNN_BACKEND_OPENCV &&
-                                          preferableTarget == DNN_TARGET_OPENCL_FP16);
+                                          (use_half && ld.dtype == CV_32F) ? CV_16S : ld.dtype);
         ld.outputBlobsWrappers.resize(ld.outputBlobs.size());
         for (int i = 0; i < ld.outputBlobs.size(); ++i)
             ld.outputBlobsWrappers[i] = wrap(ld.outputBlobs[i]);
@@ -2579,6 +2681,7 @@ struct Net::Impl : public detail::NetImplBase
         // we try to embed this activation into the convolution and disable separate execution of the activation
         std::set<LayerPin> pinsToKeep(blobsToKeep_.begin(),
                                       blobsToKeep_.end());
+        const bool isOpenCVCPU = preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU;
         MapIdToLayerData::iterator it;
         for (it = layers.begin(); it != layers.end(); it++)
         {
@@ -2602,10 +2705,12 @@ struct Net::Impl : public detail::NetImplBase
                 LayerPin lpNext(ld.consumers[0].lid, 0);
                 while (nextData)
                 {
-                    /* we use `tryFuse` member of convolution layer to fuse eltwise later
+                    /* we use `tryFuse` member of convolution (and fully-connected on CPU) layer to fuse eltwise later
                      * it's not intended to be fused here; hence, we stop when we encounter eltwise
                      */
-                    if (preferableBackend == DNN_BACKEND_CUDA && ld.type == "Convolution" && nextData->type == "Eltwise")
+                    if (nextData->type == "Eltwise" &&
+                        ((preferableBackend == DNN_BACKEND_CUDA && ld.type == "Convolution") ||
+                         (isOpenCVCPU && (ld.type == "Convolution" || ld.type == "InnerProduct"))))
                         break;
                     Ptr<Layer> nextLayer = nextData->layerInstance;
                     if (currLayer->tryFuse(nextLayer))
@@ -2684,9 +2789,12 @@ struct Net::Impl : public detail::NetImplBase
 
                 // OpenCL: fuse convolution layer followed by eltwise + relu
                 // CUDA: fuse convolution layer followed by eltwise (and optional activation)
+                // CPU: fuse convolution or fully-connected layer followed by eltwise sum (and optional activation)
                 while (nextData &&
-                    (IS_DNN_OPENCL_TARGET(preferableTarget) || IS_DNN_CUDA_TARGET(preferableTarget)) &&
-                    ld.layerInstance->type == "Convolution"
+                    (((IS_DNN_OPENCL_TARGET(preferableTarget) || IS_DNN_CUDA_TARGET(preferableTarget)) &&
+                      ld.layerInstance->type == "Convolution") ||
+                     (isOpenCVCPU &&
+                      (ld.layerInstance->type == "Convolution" || ld.layerInstance->type == "InnerProduct")))
                 )  // semantic of 'if'
                 {
                     Ptr<EltwiseLayer> nextEltwiseLayer = nextData->layerInstance.dynamicCast<EltwiseLayer>();
@@ -2741,12 +2849,38 @@ struct Net::Impl : public detail::NetImplBase
                         }
                     }
 
+                    if (isOpenCVCPU)
+                    {
+                        // the layer writes the sum to the output of eltwise, which must be reserved by the memory plan
+                        // since the layer is computed
+                        if (!blobManager.isOutputReserved(nextData->id))
+                            break;
+                        // the second operand is added to the output of the layer before its activation,
+                        // so only sum of the blobs of the same shape without coefficients is supported
+                        if (nextData->params.has("operation") && toLowerCase(nextData->params.get<String>("operation")) != "sum")
+                            break;
+                        if (nextData->params.has("coeff"))
+                        {
+                            DictValue paramCoeff = nextData->params.get("coeff");
+                            bool isCoeffOneOne = paramCoeff.size() == 2;
+                            for (int i = 0; isCoeffOneOne && i < paramCoeff.size(); i++)
+                                isCoeffOneOne &= paramCoeff.get<float>(i) == 1.0f;
+                            if (!isCoeffOneOne)
+                                break;
+                        }
+                        if (ld.dtype != CV_32F || nextData->inputBlobs.size() != 2 ||
+                            nextData->inputBlobs[0]->size != nextData->inputBlobs[1]->size ||
+                            nextData->inputBlobs[0]->type() != nextData->inputBlobs[1]->type())
+                            break;
+                    }
+
                     {
                         LayerData *eltwiseData = nextData;
 
                         // Eltwise layer has two inputs. We need to determine which
                         // is a base convolution layer and which could be used as it's bias.
                         LayerData* biasLayerData = 0;
+                        Mat* biasBlob = 0;
                         for (int i = 0; i < 2; ++i)
                         {
                             LayerData *downLayerData = &layers[eltwiseData->inputBlobsId[i].lid];
@@ -2764,6 +2898,7 @@ struct Net::Impl : public detail::NetImplBase
                             if (downLayerData && ld.id == downLayerData->id)
                             {
                                 biasLayerData = &layers[eltwiseData->inputBlobsId[1 - i].lid];
+                                biasBlob = eltwiseData->inputBlobs[1 - i];
                                 break;
                             }
                         }
@@ -2841,12 +2976,32 @@ struct Net::Impl : public detail::NetImplBase
                                     }
                                 }
 
+                                if (isOpenCVCPU)
+                                {
+                                    /* supported fusion options:
+                                     * => layer + eltwise sum
+                                     * => activation(layer + eltwise sum)
+                                     * the layer must not have fused activation before eltwise
+                                     */
+                                    auto layer = nextEltwiseLayer.staticCast<Layer>();
+                                    if (currLayer->tryFuse(layer))
+                                    {
+                                        fuse_eltwise = true;
+                                        if (!nextFusabeleActivLayer.empty() && nextData &&
+                                            blobManager.isOutputReserved(nextData->id) &&
+                                            currLayer->setActivation(nextFusabeleActivLayer))
+                                            fuse_activation = true;
+                                    }
+                                }
+
                                 CV_Assert(!fuse_activation || fuse_eltwise); /* cannot fuse activation without eltwise */
                                 if(fuse_eltwise && fuse_activation)
                                 {
                                     CV_Assert(nextData);
                                     CV_Assert_N(biasLayerData->outputBlobsWrappers.size() == 1, ld.inputBlobsWrappers.size() == 1);
                                     ld.inputBlobsWrappers.push_back(biasLayerData->outputBlobsWrappers[0]);
+                                    if (isOpenCVCPU)
+                                        ld.inputBlobs.push_back(biasBlob);
                                     printf_(("\tfused with %s\n", nextEltwiseLayer->name.c_str()));
                                     printf_(("\tfused with %s\n", nextFusabeleActivLayer->name.c_str()));
                                     eltwiseData->skip = true;
@@ -2865,10 +3020,20 @@ struct Net::Impl : public detail::NetImplBase
                                     // Also we need to move all the consumers' references.
                                     // To prevent memory collisions (i.e. when input of
                                     // [conv] and output of [eltwise] is the same blob)
-                                    // we allocate a new blob.
+                                    // we allocate a new blob. On CPU the output of [activ] is used, the memory plan
+                                    // doesn't place other blobs there since [conv] is computed.
                                     CV_Assert_N(ld.outputBlobs.size() == 1, ld.outputBlobsWrappers.size() == 1);
-                                    ld.outputBlobs[0] = ld.outputBlobs[0].clone();
-                                    ld.outputBlobsWrappers[0] = wrap(ld.outputBlobs[0]);
+                                    if (isOpenCVCPU)
+                                    {
+                                        CV_Assert_N(nextData->outputBlobs.size() == 1, nextData->outputBlobsWrappers.size() == 1);
+                                        ld.outputBlobs[0] = nextData->outputBlobs[0];
+                                        ld.outputBlobsWrappers[0] = nextData->outputBlobsWrappers[0];
+                                    }
+                                    else
+                                    {
+                                        ld.outputBlobs[0] = ld.outputBlobs[0].clone();
+                                        ld.outputBlobsWrappers[0] = wrap(ld.outputBlobs[0]);
+                                    }
 
                                     eltwiseData->outputBlobs = ld.outputBlobs;
                                     nextData->outputBlobs = ld.outputBlobs;
@@ -2892,9 +3057,11 @@ struct Net::Impl : public detail::NetImplBase
                                 }
                                 else if (fuse_eltwise) // conv + eltwise (note: conv could have fused activations before eltwise)
                                 {
-                                    CV_Assert(IS_DNN_CUDA_TARGET(preferableTarget));
+                                    CV_Assert(IS_DNN_CUDA_TARGET(preferableTarget) || isOpenCVCPU);
                                     CV_Assert_N(biasLayerData->outputBlobsWrappers.size() == 1, ld.inputBlobsWrappers.size() == 1);
                                     ld.inputBlobsWrappers.push_back(biasLayerData->outputBlobsWrappers[0]);
+                                    if (isOpenCVCPU)
+                                        ld.inputBlobs.push_back(biasBlob);
                                     printf_(("\tfused with %s\n", nextEltwiseLayer->name.c_str()));
                                     eltwiseData->skip = true;
                                     // This optimization is for cases like
@@ -2909,10 +3076,20 @@ struct Net::Impl : public detail::NetImplBase
                                     // Also we need to move all the consumers' references.
                                     // To prevent memory collisions (i.e. when input of
                                     // [conv] and output of [eltwise] is the same blob)
-                                    // we allocate a new blob.
+                                    // we allocate a new blob. On CPU the output of [eltwise] is used, the memory plan
+                                    // doesn't place other blobs there since [conv] is computed.
                                     CV_Assert_N(ld.outputBlobs.size() == 1, ld.outputBlobsWrappers.size() == 1);
-                                    ld.outputBlobs[0] = ld.outputBlobs[0].clone();
-                                    ld.outputBlobsWrappers[0] = wrap(ld.outputBlobs[0]);
+                                    if (isOpenCVCPU)
+                                    {
+                                        CV_Assert_N(eltwiseData->outputBlobs.size() == 1, eltwiseData->outputBlobsWrappers.size() == 1);
+                                        ld.outputBlobs[0] = eltwiseData->outputBlobs[0];
+                                        ld.outputBlobsWrappers[0] = eltwiseData->outputBlobsWrappers[0];
+                                    }
+                                    else
+                                    {
+                                        ld.outputBlobs[0] = ld.outputBlobs[0].clone();
+                                        ld.outputBlobsWrappers[0] = wrap(ld.outputBlobs[0]);
+                                    }
 
                                     eltwiseData->outputBlobs = ld.outputBlobs;
                                     eltwiseData->outputBlobsWrappers = ld.outputBlobsWrappers;
@@ -3111,6 +3288,198 @@ struct Net::Impl : public detail::NetImplBase
         }
     }
 
+    // Computes a static placement of the blobs which are allocated by BlobManager.
+    // Lifetimes of memory hosts are tracked over the layers order with the same
+    // references counting as in allocateLayers() (including in-place computations).
+    // Then the hosts are packed into arenas (one per data type) by greedy best-fit:
+    // the biggest hosts are placed first into the smallest gap between the hosts
+    // with intersecting lifetimes. Inputs of the network are not placed into the arenas.
+    void planMemory(const LayersShapesMap& layersShapes, const std::vector<LayerPin>& blobsToKeep_,
+                    MemoryPlan& plan)
+    {
+        CV_TRACE_FUNCTION();
+
+        struct Host
+        {
+            size_t total;
+            int dtype;
+            int first, last;  // indices of layers in execution order
+        };
+        const int alwaysAlive = INT_MAX;
+
+        plan = MemoryPlan();
+        std::map<LayerPin, int> refCounter;
+        std::map<LayerPin, LayerPin> reuseMap;
+        std::map<LayerPin, Host> hosts;
+        std::map<int, int> reservedFrom;  // layer id -> step, see MemoryPlan::reservedOutputs
+
+        LayersShapesMap::const_iterator inputShapesIt = layersShapes.find(0);
+        CV_Assert(inputShapesIt != layersShapes.end());
+        for (int i = 0; i < (int)inputShapesIt->second.out.size(); ++i)
+            refCounter[LayerPin(0, i)] += 1;
+        for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+        {
+            const std::vector<LayerPin>& inputs = it->second.inputBlobsId;
+            for (size_t i = 0; i < inputs.size(); ++i)
+                refCounter[inputs[i]] += 1;
+        }
+        for (size_t i = 0; i < blobsToKeep_.size(); ++i)
+            refCounter[blobsToKeep_[i]] += 1;
+
+        int step = 0;
+        for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it, ++step)
+        {
+            const LayerData& ld = it->second;
+            LayersShapesMap::const_iterator shapesIt = layersShapes.find(ld.id);
+            CV_Assert(shapesIt != layersShapes.end());
+            const LayerShapes& layerShapes = shapesIt->second;
+            const ShapesVec& outShapes = layerShapes.out;
+            const size_t numOutputs = std::max((size_t)1, outShapes.size());
+
+            // candidates for fusion with the following eltwise sum, BatchNorm and Scale layers are fused before it
+            if (fusion && (ld.type == "Convolution" || ld.type == "InnerProduct") && ld.consumers.size() == 1 &&
+                std::find(blobsToKeep_.begin(), blobsToKeep_.end(), LayerPin(ld.id, 0)) == blobsToKeep_.end())
+            {
+                const LayerData* next = &layers[ld.consumers[0].lid];
+                while ((next->type == "BatchNorm" || next->type == "Scale") && next->consumers.size() == 1)
+                    next = &layers[next->consumers[0].lid];
+                if (next->type == "Eltwise" && next->inputBlobsId.size() == 2)
+                {
+                    reservedFrom[next->id] = step;
+                    if (next->consumers.size() == 1 &&
+                        !layers[next->consumers[0].lid].layerInstance.dynamicCast<ActivationLayer>().empty())
+                        reservedFrom[next->consumers[0].lid] = step;
+                }
+            }
+            std::map<int, int>::const_iterator reservedIt = reservedFrom.find(ld.id);
+            if (reservedIt != reservedFrom.end())
+                plan.reservedOutputs.insert(ld.id);
+
+            LayerPin inPlaceHost;
+            if (layerShapes.supportInPlace && ld.id != 0 && ld.inputBlobsId.size() == 1)
+            {
+                const LayerPin& inp = ld.inputBlobsId[0];
+                std::map<LayerPin, LayerPin>::const_iterator hostIt = reuseMap.find(inp);
+                if (hostIt != reuseMap.end() && refCounter[hostIt->second] == 1 &&
+                    layers[inp.lid].dtype == ld.dtype)
+                {
+                    inPlaceHost = hostIt->second;
+                    plan.inPlaceLayers.insert(ld.id);
+                }
+            }
+
+            std::vector<LayerPin> pinsForInternalBlobs;
+            for (size_t i = 0; i < layerShapes.internal.size(); ++i)
+            {
+                if (total(layerShapes.internal[i]))
+                    pinsForInternalBlobs.push_back(LayerPin(ld.id, (int)(numOutputs + i)));
+            }
+            for (size_t i = 0; i < pinsForInternalBlobs.size(); ++i)
+                refCounter[pinsForInternalBlobs[i]] += 1;
+
+            // BlobManager enumerates internal blobs after the outputs (see allocateBlobsForLayer)
+            for (size_t i = 0; i < outShapes.size() + layerShapes.internal.size() && !outShapes.empty(); ++i)
+            {
+                const MatShape& blobShape = i < outShapes.size() ? outShapes[i] : layerShapes.internal[i - outShapes.size()];
+                if (!total(blobShape))
+                    continue;
+                LayerPin pin(ld.id, (int)i);
+                if (i < outShapes.size() && inPlaceHost.valid())
+                {
+                    reuseMap[pin] = inPlaceHost;
+                    std::map<LayerPin, int>::iterator userRefIt = refCounter.find(pin);
+                    if (userRefIt != refCounter.end())
+                    {
+                        refCounter[inPlaceHost] += userRefIt->second;
+                        refCounter.erase(userRefIt);
+                    }
+                    else
+                        refCounter[inPlaceHost] += 1;  // never released
+                }
+                else
+                {
+                    reuseMap[pin] = pin;
+                    Host host;
+                    host.total = total(blobShape);
+                    host.dtype = ld.dtype;
+                    host.first = reservedIt != reservedFrom.end() ? reservedIt->second : step;
+                    host.last = alwaysAlive;
+                    hosts[pin] = host;
+                }
+            }
+
+            std::vector<LayerPin> released(ld.inputBlobsId);
+            released.insert(released.end(), pinsForInternalBlobs.begin(), pinsForInternalBlobs.end());
+            for (size_t i = 0; i < released.size(); ++i)
+            {
+                std::map<LayerPin, LayerPin>::const_iterator hostIt = reuseMap.find(released[i]);
+                if (hostIt == reuseMap.end())
+                    continue;
+                int& numRefs = refCounter[hostIt->second];
+                CV_Assert(numRefs > 0);
+                if (--numRefs == 0)
+                    hosts[hostIt->second].last = step;
+            }
+        }
+
+        std::vector<std::pair<size_t, LayerPin> > order;
+        for (std::map<LayerPin, Host>::const_iterator it = hosts.begin(); it != hosts.end(); ++it)
+        {
+            if (it->first.lid != 0)
+                order.push_back(std::make_pair(it->second.total * CV_ELEM_SIZE(it->second.dtype), it->first));
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [](const std::pair<size_t, LayerPin>& a, const std::pair<size_t, LayerPin>& b)
+                         { return a.first > b.first; });
+
+        std::vector<LayerPin> placed;
+        std::map<LayerPin, size_t> sizes;  // aligned sizes of placed hosts in elements
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            const LayerPin& pin = order[i].second;
+            const Host& host = hosts[pin];
+            const int esz = CV_ELEM_SIZE(host.dtype);
+            const size_t size = alignSize(host.total, 64 % esz == 0 ? 64 / esz : 1);
+
+            std::vector<std::pair<size_t, size_t> > busy;  // [begin, end) of the conflicting hosts
+            for (size_t j = 0; j < placed.size(); ++j)
+            {
+                const Host& other = hosts[placed[j]];
+                if (other.dtype == host.dtype && other.first <= host.last && host.first <= other.last)
+                {
+                    const size_t begin = plan.offsets[placed[j]].second;
+                    busy.push_back(std::make_pair(begin, begin + sizes[placed[j]]));
+                }
+            }
+            std::sort(busy.begin(), busy.end());
+
+            size_t offset = 0, bestOffset = 0, bestGap = std::numeric_limits<size_t>::max();
+            bool found = false;
+            for (size_t j = 0; j < busy.size(); ++j)
+            {
+                if (busy[j].first > offset)
+                {
+                    const size_t gap = busy[j].first - offset;
+                    if (gap >= size && gap < bestGap)
+                    {
+                        bestOffset = offset;
+                        bestGap = gap;
+                        found = true;
+                    }
+                }
+                offset = std::max(offset, busy[j].second);
+            }
+            if (!found)
+                bestOffset = offset;
+
+            plan.offsets[pin] = std::make_pair(host.dtype, bestOffset);
+            sizes[pin] = size;
+            size_t& arenaSize = plan.arenaSizes[host.dtype];
+            arenaSize = std::max(arenaSize, bestOffset + size);
+            placed.push_back(pin);
+        }
+    }
+
     void allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
     {
         CV_TRACE_FUNCTION();
@@ -3136,6 +3505,15 @@ struct Net::Impl : public detail::NetImplBase
         getLayersShapes(inputShapes, layersShapes);
 
         blobManager.reset();
+        if (DNN_MEMORY_PLANNER && !DNN_DISABLE_MEMORY_OPTIMIZATIONS &&
+            preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU)
+        {
+            MemoryPlan plan;
+            planMemory(layersShapes, blobsToKeep_, plan);
+            blobManager.setMemoryPlan(plan);
+        }
+        else
+            blobManager.releaseArenas();
         backendWrappers.clear();
 
         for(auto& layer : layers)
@@ -3167,6 +3545,7 @@ struct Net::Impl : public detail::NetImplBase
         }
 
         layersTimings.resize(lastLayerId + 1, 0);
+        layersStartTicks.resize(lastLayerId + 1, 0);
         fuseLayers(blobsToKeep_);
     }
 
@@ -3178,6 +3557,7 @@ struct Net::Impl : public detail::NetImplBase
 
         if( !ld.skip )
         {
+            layersStartTicks[ld.id] = getTickCount();
             TickMeter tm;
             tm.start();
 
@@ -3397,6 +3777,7 @@ struct Net::Impl : public detail::NetImplBase
         else
         {
             layersTimings[ld.id] = 0;
+            layersStartTicks[ld.id] = 0;
         }
 
         ld.flag = 1;
@@ -3628,10 +4009,23 @@ struct Net::Impl : public detail::NetImplBase
             convertFp16(ld.outputBlobs[pin.oid], output_blob);
             return output_blob;
         }
+        else if (ld.outputBlobs[pin.oid].depth() == CV_8S)
+            return dequantizeBlob(pin);
         else
             return ld.outputBlobs[pin.oid];
     }
 
+    // Any requested output of quantized net is returned in FP32.
+    Mat dequantizeBlob(const LayerPin& pin)
+    {
+        std::map<LayerPin, std::pair<float, int> >::const_iterator it = blobsQuantParams.find(pin);
+        CV_Assert(it != blobsQuantParams.end());
+        const float scale = it->second.first;
+        Mat blob;
+        layers[pin.lid].outputBlobs[pin.oid].convertTo(blob, CV_32F, scale, -scale * it->second.second);
+        return blob;
+    }
+
     Mat getBlob(String outputName)
     {
         return getBlob(getPinByAlias(outputName));
@@ -3693,6 +4087,7 @@ struct Net::Impl : public detail::NetImplBase
 #endif
 
     string dump();
+    string dumpProfile(const String& format);
 
     void dumpNetworkToFile()
     {
@@ -4136,7 +4531,14 @@ void Net::forward(OutputArrayOfArrays outputBlobs, const String& outputName)
                 ld.outputBlobsWrappers[i]->copyToHost();
             }
         }
-        if (ld.outputBlobs[0].depth() == CV_32F)
+        if (ld.outputBlobs[0].depth() == CV_8S)
+        {
+            std::vector<Mat> & outputvec = *(std::vector<Mat> *)outputBlobs.getObj();
+            outputvec.resize(ld.outputBlobs.size());
+            for (int i = 0; i < outputvec.size(); i++)
+                outputvec[i] = impl->dequantizeBlob(LayerPin(pin.lid, i));
+        }
+        else if (ld.outputBlobs[0].depth() != CV_16S)
         {
             std::vector<Mat> & outputvec = *(std::vector<Mat> *)outputBlobs.getObj();
             outputvec = ld.outputBlobs;
@@ -4170,7 +4572,12 @@ void Net::forward(OutputArrayOfArrays outputBlobs, const String& outputName)
         {
             outputvec.resize(ld.outputBlobs.size());
             for (int i = 0; i < outputvec.size(); ++i)
-                ld.outputBlobs[i].copyTo(outputvec[i]);
+            {
+                if (ld.outputBlobs[i].depth() == CV_8S)
+                    impl->dequantizeBlob(LayerPin(pin.lid, i)).copyTo(outputvec[i]);
+                else
+                    ld.outputBlobs[i].copyTo(outputvec[i]);
+            }
         }
     }
 }
@@ -4688,6 +5095,130 @@ void Net::dumpToFile(const String& path) {
     file.close();
 }
 
+static std::string escapeJSON(const std::string& str)
+{
+    std::ostringstream out;
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        const char c = str[i];
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            out << cv::format("\\u%04x", (int)c);
+        else
+            out << c;
+    }
+    return out.str();
+}
+
+string Net::Impl::dumpProfile(const String& format)
+{
+    CV_CheckEQ(layersTimings.size(), (size_t)lastLayerId + 1, "Run forward() before profile dump");
+    const bool trace = format == "trace";
+    CV_Check(format, trace || format == "json", "Supported profile formats are 'json' and 'trace'");
+
+    const double msPerTick = 1e3 / getTickFrequency();
+    int64 firstTick = 0;
+    for (size_t i = 1; i < layersStartTicks.size(); i++)
+    {
+        if (layersStartTicks[i] != 0 && (firstTick == 0 || layersStartTicks[i] < firstTick))
+            firstTick = layersStartTicks[i];
+    }
+
+    std::ostringstream out;
+    out.precision(6);
+    if (trace)
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    else
+        out << "{\n\"backend\": " << preferableBackend << ", \"target\": " << preferableTarget << ",\n\"layers\": [\n";
+
+    double totalTime = 0;
+    int64 totalFlops = 0, totalBytes = 0;
+    bool first = true;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        Ptr<Layer> layer = ld.getLayerInstance();
+
+        std::vector<MatShape> inShapes, outShapes;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            const LayerPin& pin = ld.inputBlobsId[i];
+            inShapes.push_back(shape(layers[pin.lid].outputBlobs[pin.oid]));
+        }
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+            outShapes.push_back(shape(ld.outputBlobs[i]));
+        const int64 flops = layer->getFLOPS(inShapes, outShapes);
+
+        // fused layers don't touch memory, the fusing layer reads all its actual inputs (fused operands too)
+        int64 bytes = 0;
+        if (!ld.skip)
+        {
+            for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+                bytes += ld.inputBlobs[i]->total() * ld.inputBlobs[i]->elemSize();
+            for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+                bytes += ld.outputBlobs[i].total() * ld.outputBlobs[i].elemSize();
+            for (size_t i = 0; i < layer->blobs.size(); i++)
+                bytes += layer->blobs[i].total() * layer->blobs[i].elemSize();
+        }
+
+        const double time = layersTimings[ld.id] * msPerTick;
+        const double start = ld.skip ? 0 : (layersStartTicks[ld.id] - firstTick) * msPerTick;
+        const double gflops = time > 0 ? flops * 1e-6 / time : 0;
+        const double intensity = bytes > 0 ? (double)flops / bytes : 0;
+        totalTime += time;
+        totalFlops += flops;
+        totalBytes += bytes;
+
+        if (trace)
+        {
+            if (ld.skip)
+                continue;
+            // complete events with timestamps in microseconds, fixed notation keeps them exact for long runs
+            out << (first ? "" : ",\n") << "{\"name\": \"" << escapeJSON(ld.name) << "\", \"cat\": \"" << escapeJSON(ld.type)
+                << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": " << cv::format("%.3f", start * 1e3)
+                << ", \"dur\": " << cv::format("%.3f", time * 1e3)
+                << ", \"args\": {\"flops\": " << flops << ", \"bytes\": " << bytes
+                << ", \"gflops_per_sec\": " << gflops << ", \"arithmetic_intensity\": " << intensity << "}}";
+        }
+        else
+        {
+            out << (first ? "" : ",\n") << "{\"id\": " << ld.id << ", \"name\": \"" << escapeJSON(ld.name)
+                << "\", \"type\": \"" << escapeJSON(ld.type) << "\", \"fused\": " << (ld.skip ? "true" : "false")
+                << ", \"start_ms\": " << cv::format("%.6f", start) << ", \"time_ms\": " << cv::format("%.6f", time)
+                << ", \"flops\": " << flops << ", \"bytes\": " << bytes
+                << ", \"gflops_per_sec\": " << gflops << ", \"arithmetic_intensity\": " << intensity << "}";
+        }
+        first = false;
+    }
+
+    if (trace)
+        out << "\n]}\n";
+    else
+    {
+        out << "\n],\n\"total\": {\"time_ms\": " << cv::format("%.6f", totalTime) << ", \"flops\": " << totalFlops << ", \"bytes\": " << totalBytes
+            << ", \"gflops_per_sec\": " << (totalTime > 0 ? totalFlops * 1e-6 / totalTime : 0)
+            << ", \"arithmetic_intensity\": " << (totalBytes > 0 ? (double)totalFlops / totalBytes : 0) << "}\n}\n";
+    }
+    return out.str();
+}
+
+String Net::dumpProfile(const String& format)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(!empty());
+    return impl->dumpProfile(format);
+}
+
+void Net::dumpProfileToFile(const String& path, const String& format)
+{
+    std::ofstream file(path.c_str());
+    CV_Assert(file.is_open());
+    file << dumpProfile(format);
+}
+
 Ptr<Layer> Net::getLayer(LayerId layerId)
 {
     LayerData &ld = impl->getLayerData(layerId);
@@ -4902,9 +5433,10 @@ void Net::getMemoryConsumption(const int layerId,
 
     ShapesVec inLayerShapes, outLayerShapes;
     getLayerShapes(netInputShapes, layerId, inLayerShapes, outLayerShapes);
+    size_t elemSize = CV_ELEM_SIZE(layer->second.dtype);
     for(int i = 0; i < outLayerShapes.size(); i++)
     {
-        blobs += total(outLayerShapes[i]) * sizeof(float);
+        blobs += total(outLayerShapes[i]) * elemSize;
     }
 }
 
@@ -4966,9 +5498,10 @@ void Net::getMemoryConsumption(const std::vector<MatShape>& netInputShapes,
             w += weightsBlob.total()*weightsBlob.elemSize();
         }
 
+        size_t elemSize = CV_ELEM_SIZE(layer->second.dtype);
         for(int j = 0; j < outLayerShapes[i].size(); j++)
         {
-            b += total(outLayerShapes[i][j]) * sizeof(float);
+            b += total(outLayerShapes[i][j]) * elemSize;
         }
 
         weights.push_back(w);
@@ -4983,6 +5516,28 @@ void Net::getMemoryConsumption(const MatShape& netInputShape, std::vector<int>&
                          weights, blobs);
 }
 
+size_t Net::getMemoryPeak(const std::vector<MatShape>& netInputShapes) const
+{
+    CV_TRACE_FUNCTION();
+
+    Impl::LayersShapesMap layersShapes;
+    impl->getLayersShapes(netInputShapes, layersShapes);
+
+    MemoryPlan plan;
+    impl->planMemory(layersShapes, std::vector<LayerPin>(), plan);
+
+    size_t inputs = 0;
+    const size_t elemSize = CV_ELEM_SIZE(impl->layers[0].dtype);
+    for (size_t i = 0; i < netInputShapes.size(); i++)
+        inputs += total(netInputShapes[i]) * elemSize;
+    return inputs + plan.getArenaBytes();
+}
+
+size_t Net::getMemoryPeak(const MatShape& netInputShape) const
+{
+    return getMemoryPeak(std::vector<MatShape>(1, netInputShape));
+}
+
 void Net::enableFusion(bool fusion)
 {
     if( impl->fusion != fusion )
@@ -4993,6 +5548,231 @@ void Net::enableFusion(bool fusion)
     }
 }
 
+// Asymmetric quantization parameters for the range [rmin, rmax] (the range is extended to include zero)
+static void getQuantizationParams(float rmin, float rmax, float& scale, int& zeropoint)
+{
+    rmin = std::min(rmin, 0.f);
+    rmax = std::max(rmax, 0.f);
+    scale = (rmax - rmin) / 255.f;
+    if (scale == 0.f)
+        scale = 1.f;
+    zeropoint = saturate_cast<schar>(-128 - cvRound(rmin / scale));
+}
+
+Net Net::quantize(InputArrayOfArrays calibData)
+{
+    CV_TRACE_FUNCTION();
+
+    // Net can be quantized only once.
+    if (impl->netWasQuantized)
+        CV_Error(Error::StsBadArg, "Cannot quantize a quantized net");
+
+    std::vector<Mat> samples;
+    if (calibData.isMatVector() || calibData.isUMatVector())
+        calibData.getMatVector(samples);
+    else
+        samples.push_back(calibData.getMat());
+    CV_Assert(!samples.empty());
+
+    DataLayer& netInputLayer = *impl->netInputLayer;
+    std::vector<String> inputNames = netInputLayer.outNames;
+    if (inputNames.empty())
+        inputNames.push_back("");
+    const size_t numInputs = inputNames.size();
+    CV_CheckEQ(samples.size() % numInputs, (size_t)0, "Number of calibration blobs must be a multiple of the number of network inputs");
+
+    // Save the state of the net, calibration runs all the layers without fusion on CPU.
+    std::vector<Mat> origInputs = netInputLayer.inputsData;
+    std::vector<double> origScaleFactors = netInputLayer.scaleFactors;
+    std::vector<Scalar> origMeans = netInputLayer.means;
+    std::vector<Mat> origInputBlobs = impl->layers[0].outputBlobs;
+    std::vector<double> scaleFactors(numInputs, 1.0);
+    std::vector<Scalar> means(numInputs);
+    for (size_t i = 0; i < std::min(numInputs, origScaleFactors.size()); i++)
+    {
+        scaleFactors[i] = origScaleFactors[i];
+        means[i] = origMeans[i];
+    }
+    const bool origFusion = impl->fusion;
+    const int origBackend = impl->preferableBackend, origTarget = impl->preferableTarget;
+
+    impl->fusion = false;
+    impl->preferableBackend = DNN_BACKEND_OPENCV;
+    impl->preferableTarget = DNN_TARGET_CPU;
+    impl->netWasAllocated = false;
+    impl->clear();
+    netInputLayer.inputsData.clear();  // don't overwrite user's input blobs
+
+    std::map<LayerPin, std::pair<float, float> > ranges;
+    std::map<int, int> numOutputs;
+    std::vector<LayerPin> pins;
+    for (size_t s = 0; s < samples.size(); s += numInputs)
+    {
+        for (size_t i = 0; i < numInputs; i++)
+            setInput(samples[s + i], inputNames[i], scaleFactors[i], means[i]);
+
+        if (pins.empty())
+        {
+            // keep all the outputs of all the layers
+            std::vector<LayerPin> firstPins;
+            for (Impl::MapIdToLayerData::iterator it = impl->layers.begin(); it != impl->layers.end(); ++it)
+                firstPins.push_back(LayerPin(it->first, 0));
+            impl->setUpNet(firstPins);
+            for (Impl::MapIdToLayerData::iterator it = impl->layers.begin(); it != impl->layers.end(); ++it)
+            {
+                // only the first output of unconnected layers is used (e.g. max pooling without indices)
+                const int nout = (int)it->second.outputBlobs.size();
+                numOutputs[it->first] = it->second.requiredOutputs.empty() ? std::min(nout, 1) : nout;
+                for (int oid = 0; oid < numOutputs[it->first]; oid++)
+                    pins.push_back(LayerPin(it->first, oid));
+            }
+        }
+        impl->setUpNet(pins);
+        impl->forwardToLayer(impl->getLayerData(impl->getLatestLayerPin(pins).lid));
+
+        for (size_t i = 0; i < pins.size(); i++)
+        {
+            const Mat& blob = impl->layers[pins[i].lid].outputBlobs[pins[i].oid];
+            if (blob.depth() != CV_32F || blob.empty())
+                continue;
+            double minVal = 0, maxVal = 0;
+            minMaxIdx(blob, &minVal, &maxVal);
+            std::map<LayerPin, std::pair<float, float> >::iterator it = ranges.find(pins[i]);
+            if (it == ranges.end())
+                ranges[pins[i]] = std::make_pair((float)minVal, (float)maxVal);
+            else
+            {
+                it->second.first = std::min(it->second.first, (float)minVal);
+                it->second.second = std::max(it->second.second, (float)maxVal);
+            }
+        }
+    }
+
+    // Restore the state.
+    netInputLayer.inputsData = origInputs;
+    netInputLayer.scaleFactors = origScaleFactors;
+    netInputLayer.means = origMeans;
+    impl->fusion = origFusion;
+    impl->preferableBackend = origBackend;
+    impl->preferableTarget = origTarget;
+    impl->netWasAllocated = false;
+    impl->clear();
+    impl->layers[0].outputBlobs = origInputBlobs;
+    impl->layers[0].outputBlobsWrappers.clear();
+    impl->layers[0].outputBlobsWrappers.resize(origInputBlobs.size());
+
+    std::map<LayerPin, std::pair<float, int> > qparams;
+    for (std::map<LayerPin, std::pair<float, float> >::iterator it = ranges.begin(); it != ranges.end(); ++it)
+    {
+        float sc;
+        int zp;
+        getQuantizationParams(it->second.first, it->second.second, sc, zp);
+        qparams[it->first] = std::make_pair(sc, zp);
+    }
+
+    // Build the quantized net. Layers are added in the same order, so connections remain valid.
+    Net dstNet;
+    dstNet.impl->netWasQuantized = true;
+    dstNet.impl->fusion = origFusion;
+    dstNet.impl->preferableBackend = DNN_BACKEND_OPENCV;
+    dstNet.impl->preferableTarget = DNN_TARGET_CPU;
+    dstNet.setInputsNames(netInputLayer.outNames);
+    for (size_t i = 0; i < netInputLayer.shapes.size() && i < netInputLayer.outNames.size(); i++)
+    {
+        if (!netInputLayer.shapes[i].empty())
+            dstNet.setInputShape(netInputLayer.outNames[i], netInputLayer.shapes[i]);
+    }
+
+    std::map<LayerPin, LayerPin> nativePins;  // source pin -> pin of dstNet which produces the same blob
+    std::set<LayerPin> int8Pins;  // source pins which are produced by INT8 layers of dstNet
+    std::map<LayerPin, LayerPin> convertedPins;  // source pin -> pin of Quantize/Dequantize layer
+    for (int oid = 0; oid < numOutputs[0]; oid++)
+        nativePins[LayerPin(0, oid)] = LayerPin(0, oid);
+
+    for (Impl::MapIdToLayerData::iterator it = impl->layers.begin(); it != impl->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        Ptr<Layer> layer = ld.getLayerInstance();
+
+        std::vector<std::vector<float> > scales(2);
+        std::vector<std::vector<int> > zeropoints(2);
+        bool canQuantize = true, hasInt8Input = false;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            const LayerPin& pin = ld.inputBlobsId[i];
+            hasInt8Input = hasInt8Input || int8Pins.count(pin) != 0;
+            canQuantize = canQuantize && qparams.count(pin) != 0;
+            scales[0].push_back(canQuantize ? qparams[pin].first : 1.f);
+            zeropoints[0].push_back(canQuantize ? qparams[pin].second : 0);
+        }
+        for (int oid = 0; oid < numOutputs[ld.id]; oid++)
+        {
+            const LayerPin pin(ld.id, oid);
+            canQuantize = canQuantize && qparams.count(pin) != 0;
+            scales[1].push_back(canQuantize ? qparams[pin].first : 1.f);
+            zeropoints[1].push_back(canQuantize ? qparams[pin].second : 0);
+        }
+
+        // Quantize layers which benefit from INT8 computations and the layers which continue INT8 subgraphs.
+        LayerParams params = ld.params;
+        bool quantized = false;
+        if (canQuantize && !ld.inputBlobsId.empty() &&
+            (ld.type == "Convolution" || ld.type == "InnerProduct" || hasInt8Input))
+        {
+            quantized = layer->tryQuantize(scales, zeropoints, params);
+        }
+        if (!quantized)
+            params = ld.params;
+
+        std::vector<LayerPin> inputPins(ld.inputBlobsId.size());
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            const LayerPin& pin = ld.inputBlobsId[i];
+            CV_Assert(nativePins.count(pin));
+            inputPins[i] = nativePins[pin];
+            if ((int8Pins.count(pin) != 0) == quantized)
+                continue;
+
+            std::map<LayerPin, LayerPin>::iterator cvt = convertedPins.find(pin);
+            if (cvt != convertedPins.end())
+            {
+                inputPins[i] = cvt->second;
+                continue;
+            }
+            LayerParams lp;
+            lp.name = impl->layers[pin.lid].name + (pin.oid ? format("/%d", pin.oid) : "") +
+                      (quantized ? "/quantize" : "/dequantize");
+            lp.type = quantized ? "Quantize" : "Dequantize";
+            lp.set("scales", qparams[pin].first);
+            lp.set("zeropoints", qparams[pin].second);
+            int cvtId = dstNet.addLayer(lp.name, lp.type, lp);
+            dstNet.connect(inputPins[i].lid, inputPins[i].oid, cvtId, 0);
+            dstNet.impl->layers[cvtId].dtype = quantized ? CV_8S : CV_32F;
+            if (quantized)
+                dstNet.impl->blobsQuantParams[LayerPin(cvtId, 0)] = qparams[pin];
+            inputPins[i] = convertedPins[pin] = LayerPin(cvtId, 0);
+        }
+
+        // INT8 blobs are dequantized on request, so any layer may be used as an output of the quantized net.
+        int newId = dstNet.addLayer(ld.name, params.type, params);
+        dstNet.impl->layers[newId].dtype = quantized ? CV_8S : CV_32F;
+        for (size_t i = 0; i < inputPins.size(); i++)
+            dstNet.connect(inputPins[i].lid, inputPins[i].oid, newId, (int)i);
+        for (int oid = 0; oid < numOutputs[ld.id]; oid++)
+        {
+            nativePins[LayerPin(ld.id, oid)] = LayerPin(newId, oid);
+            if (quantized)
+            {
+                int8Pins.insert(LayerPin(ld.id, oid));
+                dstNet.impl->blobsQuantParams[LayerPin(newId, oid)] = std::make_pair(scales[1][oid], zeropoints[1][oid]);
+            }
+        }
+    }
+    return dstNet;
+}
+
 void Net::setHalideScheduler(const String& scheduler)
 {
     CV_TRACE_FUNCTION();
@@ -5156,6 +5936,8 @@ Ptr<BackendNode> Layer::tryAttach(const Ptr<BackendNode>& node)
 
 bool Layer::setActivation(const Ptr<ActivationLayer>&) { return false; }
 bool Layer::tryFuse(Ptr<Layer>&) { return false; }
+bool Layer::tryQuantize(const std::vector<std::vector<float> >&, const std::vector<std::vector<int> >&,
+                        LayerParams&) { return false; }
 void Layer::getScaleShift(Mat& scale, Mat& shift) const
 {
     scale = Mat();
@@ -0,0 +1,259 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/detail/async_promise.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+InferenceQueue::~InferenceQueue() {}
+
+class InferenceQueueImpl CV_FINAL : public InferenceQueue
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct Request
+    {
+        Mat blob;
+        AsyncPromise promise;
+        Clock::time_point arrival;
+    };
+
+public:
+    InferenceQueueImpl(const Net& net_, int maxBatchSize_, double maxDelay_, const String& outputName_)
+        : net(net_), maxBatchSize(maxBatchSize_), outputName(outputName_), stop(false),
+          numBatches(0), numSamples(0)
+    {
+        CV_Assert(!net.empty());
+        CV_CheckGT(maxBatchSize, 0, "");
+        CV_CheckGE(maxDelay_, 0.0, "");
+        maxDelay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(maxDelay_));
+        worker = std::thread(&InferenceQueueImpl::run, this);
+    }
+
+    ~InferenceQueueImpl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_all();
+        worker.join();
+    }
+
+    AsyncArray enqueue(InputArray blob_) CV_OVERRIDE
+    {
+        Mat blob = blob_.getMat();
+        CV_Assert(!blob.empty());
+        CV_CheckGE(blob.dims, 2, "");
+
+        Request request;
+        blob.copyTo(request.blob);
+        AsyncArray result = request.promise.getArrayResult();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            CV_Assert(!stop);
+            request.arrival = Clock::now();
+            requests.push_back(std::move(request));
+        }
+        cond.notify_one();
+        return result;
+    }
+
+    int getNumPendingRequests() const CV_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return (int)requests.size();
+    }
+
+    void getStatistics(int64& numBatches_, int64& numSamples_) const CV_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        numBatches_ = numBatches;
+        numSamples_ = numSamples;
+    }
+
+private:
+    // Requests can be batched if their blobs differ by the first dimension only
+    static bool isCompatible(const Mat& a, const Mat& b)
+    {
+        if (a.type() != b.type() || a.dims != b.dims)
+            return false;
+        for (int i = 1; i < a.dims; i++)
+        {
+            if (a.size[i] != b.size[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Number of samples which may be batched with the oldest request. Must be called under the lock.
+    int getNumCompatibleSamples() const
+    {
+        const Mat& first = requests.front().blob;
+        int samples = 0;
+        for (size_t i = 0; i < requests.size() && samples < maxBatchSize; i++)
+        {
+            if (isCompatible(first, requests[i].blob))
+                samples += requests[i].blob.size[0];
+        }
+        return samples;
+    }
+
+    // Extracts requests for the next batch. Must be called under the lock.
+    void popBatch(std::vector<Request>& batch)
+    {
+        batch.clear();
+        int samples = 0;
+        for (size_t i = 0; i < requests.size();)
+        {
+            const Mat& blob = requests[i].blob;
+            // the oldest request is always processed even if it exceeds the batch size
+            if (batch.empty() || (isCompatible(batch[0].blob, blob) && samples + blob.size[0] <= maxBatchSize))
+            {
+                samples += blob.size[0];
+                batch.push_back(std::move(requests[i]));
+                requests.erase(requests.begin() + i);
+                if (samples >= maxBatchSize)
+                    break;
+            }
+            else
+                i++;
+        }
+    }
+
+    void process(std::vector<Request>& batch)
+    {
+        try
+        {
+            int samples = 0;
+            for (size_t i = 0; i < batch.size(); i++)
+                samples += batch[i].blob.size[0];
+
+            Mat input;
+            if (batch.size() == 1)
+                input = batch[0].blob;
+            else
+            {
+                const Mat& first = batch[0].blob;
+                std::vector<int> shape(first.size.p, first.size.p + first.dims);
+                shape[0] = samples;
+                input.create(shape, first.type());
+                const size_t sampleSize = first.total() / first.size[0] * first.elemSize();
+                uchar* dst = input.ptr();
+                for (size_t i = 0; i < batch.size(); i++)
+                {
+                    const size_t size = batch[i].blob.size[0] * sampleSize;
+                    memcpy(dst, batch[i].blob.ptr(), size);
+                    dst += size;
+                }
+            }
+
+            net.setInput(input);
+            Mat output = net.forward(outputName);
+            if (batch.size() > 1)
+                CV_CheckEQ(output.size[0], samples, "The first dimension of the output doesn't match the batch size");
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                numBatches += 1;
+                numSamples += samples;
+            }
+
+            std::vector<int> shape(output.size.p, output.size.p + output.dims);
+            const size_t sampleSize = output.total() / output.size[0] * output.elemSize();
+            uchar* src = output.ptr();
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                if (batch.size() == 1)
+                {
+                    setValue(batch[i].promise, output);
+                    break;
+                }
+                shape[0] = batch[i].blob.size[0];
+                setValue(batch[i].promise, Mat(shape, output.type(), src));
+                src += shape[0] * sampleSize;
+            }
+        }
+        catch (const cv::Exception& e)
+        {
+            for (size_t i = 0; i < batch.size(); i++)
+                setException(batch[i].promise, e);
+        }
+        catch (const std::exception& e)
+        {
+            cv::Exception ex(Error::StsError, e.what(), CV_Func, __FILE__, __LINE__);
+            for (size_t i = 0; i < batch.size(); i++)
+                setException(batch[i].promise, ex);
+        }
+    }
+
+    // Results of requests which AsyncArray is released by the caller are dropped
+    static void setValue(AsyncPromise& promise, const Mat& value)
+    {
+        try
+        {
+            promise.setValue(value);
+        }
+        catch (const cv::Exception&) {}
+    }
+
+    static void setException(AsyncPromise& promise, const cv::Exception& e)
+    {
+        try
+        {
+            promise.setException(e);
+        }
+        catch (const cv::Exception&) {}
+    }
+
+    void run()
+    {
+        std::vector<Request> batch;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait(lock, [&]{ return stop || !requests.empty(); });
+            if (requests.empty())
+                break;  // stopped and all the requests are completed
+
+            const Clock::time_point deadline = requests.front().arrival + maxDelay;
+            while (!stop && getNumCompatibleSamples() < maxBatchSize && Clock::now() < deadline)
+                cond.wait_until(lock, deadline);
+
+            popBatch(batch);
+            lock.unlock();
+            process(batch);
+            batch.clear();
+            lock.lock();
+        }
+    }
+
+    Net net;
+    const int maxBatchSize;
+    Clock::duration maxDelay;
+    const String outputName;
+
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Request> requests;
+    bool stop;
+    int64 numBatches, numSamples;
+    std::thread worker;
+};
+
+Ptr<InferenceQueue> InferenceQueue::create(const Net& net, int maxBatchSize, double maxDelay, const String& outputName)
+{
+    return makePtr<InferenceQueueImpl>(net, maxBatchSize, maxDelay, outputName);
+}
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -0,0 +1,102 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class ConcatLayerInt8Impl CV_FINAL : public ConcatLayerInt8
+{
+public:
+    // inputs are requantized to the output scale: out = saturate(round(inp * multipliers[i] + offsets[i]))
+    std::vector<float> multipliers, offsets;
+
+    ConcatLayerInt8Impl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        axis = params.get<int>("axis", 1);
+
+        DictValue scales = params.get("scales"), zeropoints = params.get("zeropoints");
+        CV_CheckEQ(scales.size(), zeropoints.size(), "");
+        const float outputScale = params.get<float>("output_scale");
+        const int outputZp = params.get<int>("output_zeropoint");
+        for (int i = 0; i < scales.size(); i++)
+        {
+            float multiplier = scales.get<float>(i) / outputScale;
+            multipliers.push_back(multiplier);
+            offsets.push_back(outputZp - zeropoints.get<int>(i) * multiplier);
+        }
+    }
+
+    virtual bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                                 const int requiredOutputs,
+                                 std::vector<MatShape> &outputs,
+                                 std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() > 0);
+        CV_CheckEQ(inputs.size(), multipliers.size(), "");
+        outputs.resize(1, inputs[0]);
+        int cAxis = normalize_axis(axis, inputs[0]);
+
+        int axisSum = 0;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            MatShape curShape = inputs[i];
+            CV_Assert(curShape.size() == outputs[0].size());
+            for (int curAxis = 0; curAxis < outputs[0].size(); curAxis++)
+            {
+                if (curAxis != cAxis && outputs[0][curAxis] != curShape[curAxis])
+                    CV_Error(Error::StsBadSize, "Inconsistent shape for ConcatLayer");
+            }
+            axisSum += curShape[cAxis];
+        }
+        outputs[0][cAxis] = axisSum;
+        return false;
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        int cAxis = normalize_axis(axis, inputs[0].dims);
+        Mat& outMat = outputs[0];
+        CV_CheckTypeEQ(outMat.type(), CV_8S, "");
+
+        std::vector<Range> ranges(outputs[0].dims, Range::all());
+        ranges[cAxis].start = 0;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_8S, "");
+            ranges[cAxis].end = ranges[cAxis].start + inputs[i].size[cAxis];
+            Mat dst = outMat(&ranges[0]);
+            if (multipliers[i] == 1.f && offsets[i] == 0.f)
+                inputs[i].copyTo(dst);
+            else
+                inputs[i].convertTo(dst, CV_8S, multipliers[i], offsets[i]);
+            ranges[cAxis].start = ranges[cAxis].end;
+        }
+    }
+};
+
+Ptr<ConcatLayerInt8> ConcatLayerInt8::create(const LayerParams& params)
+{
+    return Ptr<ConcatLayerInt8>(new ConcatLayerInt8Impl(params));
+}
+
+}
+}
@@ -0,0 +1,379 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+#include <numeric>
+
+namespace cv
+{
+namespace dnn
+{
+
+// Combines lookup tables of the consecutive INT8 activations: result[c][x] = second[c][first[c][x]]
+static Mat combineLUTs(const Mat& first, const Mat& second)
+{
+    CV_Assert(first.rows == 1 || second.rows == 1 || first.rows == second.rows);
+    Mat lut(std::max(first.rows, second.rows), 256, CV_8S);
+    for (int c = 0; c < lut.rows; c++)
+    {
+        const int8_t* lut1 = first.ptr<int8_t>(first.rows == 1 ? 0 : c);
+        const int8_t* lut2 = second.ptr<int8_t>(second.rows == 1 ? 0 : c) + 128;
+        int8_t* dst = lut.ptr<int8_t>(c);
+        for (int i = 0; i < 256; i++)
+            dst[i] = lut2[lut1[i]];
+    }
+    return lut;
+}
+
+class ConvolutionLayerInt8Impl CV_FINAL : public ConvolutionLayerInt8
+{
+public:
+    enum { BLK_SIZE = 32 };  // number of output pixels processed by a single GEMM call
+
+    Mat weightsMat;
+    std::vector<int> biasvec;
+    std::vector<float> outputMultiplier;
+    Mat activationLUT;
+    Int8GemmDispatcher gemm;
+    bool isDepthwise;
+
+    ConvolutionLayerInt8Impl(const LayerParams &params)
+    {
+        setParamsFrom(params);
+        getConvolutionKernelParams(params, kernel_size, pads_begin, pads_end, strides, dilations, padMode, adjust_pads);
+
+        numOutput = params.get<int>("num_output");
+        int ngroups = params.get<int>("group", 1);
+        CV_Assert(numOutput % ngroups == 0);
+        CV_CheckEQ(kernel_size.size(), (size_t)2, "Only 2D INT8 convolution is supported");
+
+        kernel = Size(kernel_size[1], kernel_size[0]);
+        stride = Size(strides[1], strides[0]);
+        for (int i = 0; i < pads_begin.size(); i++) {
+            if (pads_begin[i] != pads_end[i])
+                CV_Error(Error::StsNotImplemented, "Unsupported asymmetric padding in convolution layer");
+        }
+        pad = Size(pads_begin[1], pads_begin[0]);
+        dilation = Size(dilations[1], dilations[0]);
+
+        input_zp = params.get<int>("input_zeropoint");
+        output_zp = params.get<int>("output_zeropoint");
+        output_sc = params.get<float>("output_scale");
+
+        CV_Assert(blobs.size() == 3);
+        CV_CheckTypeEQ(blobs[0].type(), CV_8S, "");
+        CV_CheckTypeEQ(blobs[1].type(), CV_32S, "");
+        CV_CheckTypeEQ(blobs[2].type(), CV_32F, "");
+        CV_Assert(blobs[0].dims == 4 && blobs[0].size[0] == numOutput);
+        CV_Assert(blobs[1].total() == (size_t)numOutput && blobs[2].total() == (size_t)numOutput);
+        outputMultiplier.assign(blobs[2].ptr<float>(), blobs[2].ptr<float>() + numOutput);
+        isDepthwise = false;
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() == 1 && inputs[0].size() == 4);
+        const int* weightShape = blobs[0].size.p;
+        internals.clear();
+
+        std::vector<int> inpShape(inputs[0].begin() + 2, inputs[0].end());
+        int outCn = weightShape[0];
+        std::vector<int> outShape;
+        outShape.push_back(inputs[0][0]);
+        outShape.push_back(outCn);
+
+        int inpCn = inputs[0][1];
+        if (padMode.empty())
+        {
+            for (int i = 0; i < inpShape.size(); i++)
+                outShape.push_back((inpShape[i] + pads_begin[i] + pads_end[i] - dilations[i] * (kernel_size[i] - 1) - 1) / strides[i] + 1);
+        }
+        else
+        {
+            getConvPoolOutParams(inpShape, kernel_size, strides, padMode, dilations, outShape);
+        }
+
+        int ngroups = inpCn / weightShape[1];
+        if (ngroups == 0 || ngroups * weightShape[1] != inpCn)
+            CV_Error(Error::StsError, format("Number of input channels should "
+                     "be multiple of %d but got %d", weightShape[1], inpCn));
+        CV_Assert(ngroups > 0 && inpCn % ngroups == 0 && outCn % ngroups == 0);
+
+        outputs.resize(1, outShape);
+        return false;
+    }
+
+    virtual void finalize(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr) CV_OVERRIDE
+    {
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+        CV_Assert(inputs.size() == 1 && inputs[0].dims == 4 && inputs[0].type() == CV_8S);
+
+        std::vector<int> inpShape;
+        for (int i = 2; i < inputs[0].dims; i++)
+            inpShape.push_back(inputs[0].size[i]);
+        getConvPoolPaddings(inpShape, kernel_size, strides, padMode, pads_begin, pads_end);
+        for (int i = 0; i < pads_begin.size(); i++) {
+            if (pads_begin[i] != pads_end[i])
+                CV_Error(Error::StsNotImplemented, "Unsupported asymmetric padding in convolution layer");
+        }
+        pad = Size(pads_begin[1], pads_begin[0]);
+
+        const int inpCn = inputs[0].size[1];
+        const int ngroups = inpCn / blobs[0].size[1];
+        isDepthwise = blobs[0].size[1] == 1 && ngroups == numOutput;
+        if (isDepthwise)
+        {
+            // direct implementation: zero point of input is compensated in the bias, weights are used as is
+            weightsMat = blobs[0].reshape(1, numOutput);
+            biasvec.resize(numOutput);
+            for (int i = 0; i < numOutput; i++)
+            {
+                const int8_t* wptr = weightsMat.ptr<int8_t>(i);
+                int wsum = 0;
+                for (int j = 0; j < weightsMat.cols; j++)
+                    wsum += wptr[j];
+                biasvec[i] = blobs[1].ptr<int>()[i] - input_zp * wsum;
+            }
+        }
+        else
+        {
+            prepareWeightsInt8(blobs[0], blobs[1].reshape(1, 1), input_zp, gemm, weightsMat, biasvec);
+        }
+    }
+
+    bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE
+    {
+        if (layer.empty())
+        {
+            activationLUT.release();
+            return false;
+        }
+        Ptr<ActivationLayerInt8> activ_int8 = layer.dynamicCast<ActivationLayerInt8>();
+        if (activ_int8.empty())
+            return false;
+        const Mat& lut = activ_int8->blobs[0];
+        if (lut.rows != 1 && lut.rows != numOutput)
+            return false;
+        activationLUT = activationLUT.empty() ? lut.clone() : combineLUTs(activationLUT, lut);
+        return true;
+    }
+
+    class ParallelConv : public cv::ParallelLoopBody
+    {
+    public:
+        const ConvolutionLayerInt8Impl* layer_;
+        const Mat* input_;
+        Mat* output_;
+        int ngroups_, nblocks_, nstripes_;
+
+        ParallelConv(const ConvolutionLayerInt8Impl* layer, const Mat& input, Mat& output, int ngroups, int nstripes)
+            : layer_(layer), input_(&input), output_(&output), ngroups_(ngroups), nstripes_(nstripes)
+        {
+            const int outPlaneSize = output.size[2] * output.size[3];
+            nblocks_ = (outPlaneSize + BLK_SIZE - 1) / BLK_SIZE;
+        }
+
+        void operator()(const Range& r0) const CV_OVERRIDE
+        {
+            const Mat& input = *input_;
+            Mat& output = *output_;
+            const int batchSize = input.size[0], inpCn = input.size[1];
+            const int inpH = input.size[2], inpW = input.size[3];
+            const int outCn = output.size[1], outH = output.size[2], outW = output.size[3];
+            const int outPlaneSize = outH * outW;
+            const int inpGroupCn = inpCn / ngroups_, outGroupCn = outCn / ngroups_;
+            const Size kernel = layer_->kernel, stride = layer_->stride, pad = layer_->pad, dilation = layer_->dilation;
+            const int ksize = inpGroupCn * kernel.area();
+            const int vecsize_aligned = (int)alignSize(ksize, VEC_ALIGN_INT8);
+            const int8_t inpZp = saturate_cast<schar>(layer_->input_zp);
+            const Mat& lut = layer_->activationLUT;
+
+            const int ntasks = batchSize * ngroups_ * nblocks_;
+            const int stripeSize = (ntasks + nstripes_ - 1) / nstripes_;
+            const int taskStart = r0.start * stripeSize, taskEnd = std::min(r0.end * stripeSize, ntasks);
+
+            AutoBuffer<int8_t> rowbuf_(BLK_SIZE * vecsize_aligned + VEC_ALIGN_INT8);
+            int8_t* rowbuf = alignPtr(rowbuf_.data(), VEC_ALIGN_INT8);
+
+            for (int task = taskStart; task < taskEnd; task++)
+            {
+                const int n = task / (ngroups_ * nblocks_);
+                const int g = (task / nblocks_) % ngroups_;
+                const int ofs0 = (task % nblocks_) * BLK_SIZE;
+                const int blockSize = std::min((int)BLK_SIZE, outPlaneSize - ofs0);
+
+                // im2row: every row contains the receptive field of a single output pixel
+                for (int i = 0; i < blockSize; i++)
+                {
+                    const int oy = (ofs0 + i) / outW, ox = (ofs0 + i) % outW;
+                    int8_t* row = rowbuf + i * vecsize_aligned;
+                    int k = 0;
+                    for (int c = 0; c < inpGroupCn; c++)
+                    {
+                        const int8_t* inpPlane = input.ptr<int8_t>(n, g * inpGroupCn + c);
+                        for (int ky = 0; ky < kernel.height; ky++)
+                        {
+                            const int iy = oy * stride.height - pad.height + ky * dilation.height;
+                            if (iy < 0 || iy >= inpH)
+                            {
+                                memset(row + k, inpZp, kernel.width);
+                                k += kernel.width;
+                                continue;
+                            }
+                            const int8_t* inpRow = inpPlane + iy * inpW;
+                            for (int kx = 0; kx < kernel.width; kx++, k++)
+                            {
+                                const int ix = ox * stride.width - pad.width + kx * dilation.width;
+                                row[k] = ix >= 0 && ix < inpW ? inpRow[ix] : inpZp;
+                            }
+                        }
+                    }
+                    memset(row + k, 0, vecsize_aligned - k);
+                }
+
+                const int oc0 = g * outGroupCn;
+                int8_t* outptr = output.ptr<int8_t>(n, oc0) + ofs0;
+                layer_->gemm(layer_->weightsMat.ptr<int8_t>(oc0), layer_->weightsMat.step1(),
+                             &layer_->biasvec[oc0], &layer_->outputMultiplier[oc0],
+                             rowbuf, vecsize_aligned, outptr, outPlaneSize, 1,
+                             layer_->output_zp, outGroupCn, blockSize, vecsize_aligned);
+
+                if (!lut.empty())
+                {
+                    for (int oc = 0; oc < outGroupCn; oc++)
+                    {
+                        const int8_t* table = lut.ptr<int8_t>(lut.rows == 1 ? 0 : oc0 + oc) + 128;
+                        int8_t* dst = outptr + oc * outPlaneSize;
+                        for (int i = 0; i < blockSize; i++)
+                            dst[i] = table[dst[i]];
+                    }
+                }
+            }
+        }
+    };
+
+    class ParallelDepthwiseConv : public cv::ParallelLoopBody
+    {
+    public:
+        const ConvolutionLayerInt8Impl* layer_;
+        const Mat* input_;
+        Mat* output_;
+
+        ParallelDepthwiseConv(const ConvolutionLayerInt8Impl* layer, const Mat& input, Mat& output)
+            : layer_(layer), input_(&input), output_(&output) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const Mat& input = *input_;
+            Mat& output = *output_;
+            const int inpH = input.size[2], inpW = input.size[3];
+            const int outCn = output.size[1], outH = output.size[2], outW = output.size[3];
+            const Size kernel = layer_->kernel, stride = layer_->stride, pad = layer_->pad, dilation = layer_->dilation;
+            const int inpZp = layer_->input_zp, outZp = layer_->output_zp;
+            const Mat& lut = layer_->activationLUT;
+
+            for (int plane = r.start; plane < r.end; plane++)
+            {
+                const int n = plane / outCn, c = plane % outCn;
+                const int8_t* inpPlane = input.ptr<int8_t>(n, c);
+                int8_t* outPlane = output.ptr<int8_t>(n, c);
+                const int8_t* wptr = layer_->weightsMat.ptr<int8_t>(c);
+                const int bias = layer_->biasvec[c];
+                const float multiplier = layer_->outputMultiplier[c];
+                const int8_t* table = lut.empty() ? 0 : lut.ptr<int8_t>(lut.rows == 1 ? 0 : c) + 128;
+
+                for (int oy = 0; oy < outH; oy++)
+                {
+                    const int iy0 = oy * stride.height - pad.height;
+                    for (int ox = 0; ox < outW; ox++)
+                    {
+                        const int ix0 = ox * stride.width - pad.width;
+                        int acc = bias;
+                        for (int ky = 0; ky < kernel.height; ky++)
+                        {
+                            const int iy = iy0 + ky * dilation.height;
+                            const int8_t* w = wptr + ky * kernel.width;
+                            if (iy < 0 || iy >= inpH)
+                            {
+                                for (int kx = 0; kx < kernel.width; kx++)
+                                    acc += w[kx] * inpZp;
+                                continue;
+                            }
+                            const int8_t* inpRow = inpPlane + iy * inpW;
+                            for (int kx = 0; kx < kernel.width; kx++)
+                            {
+                                const int ix = ix0 + kx * dilation.width;
+                                acc += w[kx] * (ix >= 0 && ix < inpW ? (int)inpRow[ix] : inpZp);
+                            }
+                        }
+                        int8_t v = saturate_cast<schar>(cvRound(acc * multiplier) + outZp);
+                        outPlane[oy * outW + ox] = table ? table[v] : v;
+                    }
+                }
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        const Mat& input = inputs[0];
+        Mat& output = outputs[0];
+        CV_CheckTypeEQ(input.type(), CV_8S, "");
+        CV_CheckTypeEQ(output.type(), CV_8S, "");
+        CV_Assert(input.isContinuous() && output.isContinuous());
+
+        if (isDepthwise)
+        {
+            const int nplanes = output.size[0] * output.size[1];
+            parallel_for_(Range(0, nplanes), ParallelDepthwiseConv(this, input, output));
+        }
+        else
+        {
+            const int ngroups = input.size[1] / blobs[0].size[1];
+            const int nstripes = std::max(getNumThreads(), 1) * 4;
+            parallel_for_(Range(0, nstripes), ParallelConv(this, input, output, ngroups, nstripes), nstripes);
+        }
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() == outputs.size());
+
+        int64 flops = 0;
+        int karea = std::accumulate(kernel_size.begin(), kernel_size.end(), 1, std::multiplies<size_t>());
+        for (int i = 0; i < outputs.size(); i++)
+        {
+            flops += total(outputs[i])*(CV_BIG_INT(2)*karea*inputs[i][1] + 1);
+        }
+        return flops;
+    }
+};
+
+Ptr<BaseConvolutionLayer> ConvolutionLayerInt8::create(const LayerParams &params)
+{
+    return Ptr<BaseConvolutionLayer>(new ConvolutionLayerInt8Impl(params));
+}
+
+}
+}
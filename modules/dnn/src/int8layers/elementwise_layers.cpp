@@ -0,0 +1,164 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class ActivationLayerInt8Impl CV_FINAL : public ActivationLayerInt8
+{
+public:
+    class PBody : public cv::ParallelLoopBody
+    {
+    public:
+        const ActivationLayerInt8Impl* layer_;
+        const Mat* src_;
+        Mat* dst_;
+        int nstripes_;
+
+        PBody(const ActivationLayerInt8Impl* layer, const Mat& src, Mat& dst, int nstripes)
+            : layer_(layer), src_(&src), dst_(&dst), nstripes_(nstripes) {}
+
+        void operator()(const Range &r) const CV_OVERRIDE
+        {
+            int nsamples = 1, outCn = 1;
+            size_t planeSize = 1;
+
+            if (src_->dims > 1)
+            {
+                nsamples = src_->size[0];
+                outCn = src_->size[1];
+            }
+            else
+                outCn = src_->size[0];
+
+            for (int i = 2; i < src_->dims; ++i)
+                planeSize *= src_->size[i];
+
+            size_t stripeSize = (planeSize + nstripes_ - 1)/nstripes_;
+            size_t stripeStart = r.start*stripeSize;
+            size_t stripeEnd = std::min(r.end*stripeSize, planeSize);
+
+            for( int i = 0; i < nsamples; i++ )
+            {
+                const int8_t* srcptr = src_->ptr<int8_t>(i) + stripeStart;
+                int8_t* dstptr = dst_->ptr<int8_t>(i) + stripeStart;
+                layer_->forwardSlice(srcptr, dstptr, (int)(stripeEnd - stripeStart), planeSize, 0, outCn);
+            }
+        }
+    };
+
+    ActivationLayerInt8Impl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        CV_Assert(blobs.size() == 1);
+        CV_CheckTypeEQ(blobs[0].type(), CV_8S, "");
+        CV_CheckEQ(blobs[0].cols, 256, "Lookup table must contain 256 elements per channel");
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        Layer::getMemoryShapes(inputs, requiredOutputs, outputs, internals);
+        return true;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            const Mat& src = inputs[i];
+            Mat& dst = outputs[i];
+            CV_CheckTypeEQ(src.type(), CV_8S, "");
+            CV_Assert(src.isContinuous() && dst.isContinuous());
+            const int outCn = src.dims > 1 ? src.size[1] : src.size[0];
+            CV_Assert(blobs[0].rows == 1 || blobs[0].rows == outCn);
+
+            const int nstripes = getNumThreads();
+            PBody body(this, src, dst, nstripes);
+            parallel_for_(Range(0, nstripes), body, nstripes);
+        }
+    }
+
+    void forwardSlice(const int8_t* src, int8_t* dst, int len, size_t planeSize, int cn0, int cn1) const CV_OVERRIDE
+    {
+        const Mat& lut = blobs[0];
+        const bool perChannel = lut.rows > 1;
+        for (int cn = cn0; cn < cn1; cn++, src += planeSize, dst += planeSize)
+        {
+            const int8_t* table = lut.ptr<int8_t>(perChannel ? cn : 0) + 128;
+            for (int i = 0; i < len; i++)
+                dst[i] = table[src[i]];
+        }
+    }
+
+    void forwardSlice(const float*, float*, int, size_t, int, int) const CV_OVERRIDE
+    {
+        CV_Error(Error::StsNotImplemented, "FP32 input is not supported by INT8 activation layer");
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(outputs);
+        int64 flops = 0;
+        for (size_t i = 0; i < inputs.size(); i++)
+            flops += total(inputs[i]);
+        return flops;
+    }
+};
+
+bool ActivationLayer::tryQuantize(const std::vector<std::vector<float> > &scales,
+                                  const std::vector<std::vector<int> > &zeropoints, LayerParams& params)
+{
+    if (scales[0].size() != 1 || scales[1].size() != 1)
+        return false;
+
+    // Evaluate the function on all the possible INT8 values of every channel.
+    const float inputScale = scales[0][0], outputScale = scales[1][0];
+    const int inputZp = zeropoints[0][0], outputZp = zeropoints[1][0];
+    const int numChannels = blobs.empty() ? 1 : (int)blobs[0].total();
+    Mat src(numChannels, 256, CV_32F), dst(numChannels, 256, CV_32F);
+    for (int c = 0; c < numChannels; c++)
+    {
+        float* srcptr = src.ptr<float>(c);
+        for (int i = 0; i < 256; i++)
+            srcptr[i] = (i - 128 - inputZp) * inputScale;
+    }
+    forwardSlice(src.ptr<float>(), dst.ptr<float>(), 256, 256, 0, numChannels);
+
+    Mat lut;
+    dst.convertTo(lut, CV_8S, 1.f / outputScale, outputZp);
+
+    params.type = "ActivationInt8";
+    params.blobs.clear();
+    params.blobs.push_back(lut);
+    return true;
+}
+
+Ptr<ActivationLayerInt8> ActivationLayerInt8::create(const LayerParams& params)
+{
+    return Ptr<ActivationLayerInt8>(new ActivationLayerInt8Impl(params));
+}
+
+}
+}
@@ -0,0 +1,146 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class EltwiseLayerInt8Impl CV_FINAL : public EltwiseLayerInt8
+{
+public:
+    // out = saturate(round(sum(coeffs[i] * inputs[i]) + offset))
+    std::vector<float> coeffs;
+    float offset;
+
+    EltwiseLayerInt8Impl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        DictValue paramCoeff = params.get("coeff");
+        coeffs.resize(paramCoeff.size());
+        for (int i = 0; i < paramCoeff.size(); i++)
+            coeffs[i] = paramCoeff.get<float>(i);
+        offset = params.get<float>("offset", 0.f);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() >= 2);
+        CV_CheckEQ(inputs.size(), coeffs.size(), "Number of inputs must be equal to the number of coefficients");
+        for (size_t i = 1; i < inputs.size(); i++)
+            CV_Assert(inputs[i] == inputs[0]);
+        outputs.assign(1, inputs[0]);
+        return false;
+    }
+
+    class EltwiseInvoker : public ParallelLoopBody
+    {
+    public:
+        const EltwiseLayerInt8Impl* layer_;
+        std::vector<const int8_t*> srcs_;
+        int8_t* dst_;
+        int total_, nstripes_;
+
+        EltwiseInvoker(const EltwiseLayerInt8Impl* layer, const std::vector<Mat>& srcs, Mat& dst, int nstripes)
+            : layer_(layer), dst_(dst.ptr<int8_t>()), total_((int)dst.total()), nstripes_(nstripes)
+        {
+            for (size_t i = 0; i < srcs.size(); i++)
+                srcs_.push_back(srcs[i].ptr<int8_t>());
+        }
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int stripeSize = (total_ + nstripes_ - 1) / nstripes_;
+            const int start = std::min(r.start * stripeSize, total_);
+            const int end = std::min(r.end * stripeSize, total_);
+            const std::vector<float>& coeffs = layer_->coeffs;
+            const size_t ninputs = srcs_.size();
+            const float offset = layer_->offset;
+
+            int i = start;
+#if CV_SIMD
+            const int nlanes = v_int8::nlanes;
+            const v_float32 voffset = vx_setall_f32(offset);
+            for (; i <= end - nlanes; i += nlanes)
+            {
+                v_float32 s0 = voffset, s1 = voffset, s2 = voffset, s3 = voffset;
+                for (size_t k = 0; k < ninputs; k++)
+                {
+                    v_int16 x0, x1;
+                    v_int32 y0, y1, y2, y3;
+                    v_expand(vx_load(srcs_[k] + i), x0, x1);
+                    v_expand(x0, y0, y1);
+                    v_expand(x1, y2, y3);
+                    v_float32 c = vx_setall_f32(coeffs[k]);
+                    s0 = v_fma(v_cvt_f32(y0), c, s0);
+                    s1 = v_fma(v_cvt_f32(y1), c, s1);
+                    s2 = v_fma(v_cvt_f32(y2), c, s2);
+                    s3 = v_fma(v_cvt_f32(y3), c, s3);
+                }
+                v_int16 r0 = v_pack(v_round(s0), v_round(s1));
+                v_int16 r1 = v_pack(v_round(s2), v_round(s3));
+                v_store(dst_ + i, v_pack(r0, r1));
+            }
+            vx_cleanup();
+#endif
+            for (; i < end; i++)
+            {
+                float s = offset;
+                for (size_t k = 0; k < ninputs; k++)
+                    s += srcs_[k][i] * coeffs[k];
+                dst_[i] = saturate_cast<schar>(cvRound(s));
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_8S, "");
+            CV_Assert(inputs[i].isContinuous());
+        }
+        CV_CheckTypeEQ(outputs[0].type(), CV_8S, "");
+        CV_Assert(outputs[0].isContinuous());
+
+        const int nstripes = std::max(getNumThreads(), 1);
+        parallel_for_(Range(0, nstripes), EltwiseInvoker(this, inputs, outputs[0], nstripes), nstripes);
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(outputs); // suppress unused variable warning
+        CV_Assert(inputs.size());
+
+        return 2 * total(inputs[0]) * inputs.size();
+    }
+};
+
+Ptr<EltwiseLayerInt8> EltwiseLayerInt8::create(const LayerParams& params)
+{
+    return Ptr<EltwiseLayerInt8>(new EltwiseLayerInt8Impl(params));
+}
+
+}
+}
@@ -0,0 +1,173 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class FullyConnectedLayerInt8Impl CV_FINAL : public InnerProductLayerInt8
+{
+public:
+    Mat weightsMat;
+    std::vector<int> biasvec;
+    std::vector<float> outputMultiplier;
+    Mat activationLUT;
+    Int8GemmDispatcher gemm;
+
+    FullyConnectedLayerInt8Impl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        axis = params.get<int>("axis", 1);
+        input_zp = params.get<int>("input_zeropoint");
+        output_zp = params.get<int>("output_zeropoint");
+
+        CV_Assert(blobs.size() == 3);
+        int numOutput = params.get<int>("num_output");
+        CV_CheckTypeEQ(blobs[0].type(), CV_8S, "");
+        CV_CheckTypeEQ(blobs[1].type(), CV_32S, "");
+        CV_CheckTypeEQ(blobs[2].type(), CV_32F, "");
+        CV_Assert(blobs[0].dims == 2 && blobs[0].rows == numOutput);
+        CV_Assert(blobs[1].total() == (size_t)numOutput && blobs[2].total() == (size_t)numOutput);
+
+        prepareWeightsInt8(blobs[0], blobs[1].reshape(1, 1), input_zp, gemm, weightsMat, biasvec);
+        outputMultiplier.assign(blobs[2].ptr<float>(), blobs[2].ptr<float>() + numOutput);
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &) const CV_OVERRIDE
+    {
+        CV_CheckEQ(inputs.size(), (size_t)1, "");
+        int numOutput = blobs[0].size[0];
+        int cAxis = normalize_axis(axis, inputs[0]);
+        CV_CheckEQ(total(inputs[0], cAxis), (int)blobs[0].size[1], "");
+
+        MatShape outShape(cAxis + 1);
+        for (int i = 0; i < cAxis; ++i)
+            outShape[i] = inputs[0][i];
+        outShape.back() = numOutput;
+
+        outputs.resize(1, outShape);
+        return false;
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    virtual bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE
+    {
+        if (layer.empty())
+        {
+            activationLUT.release();
+            return false;
+        }
+        Ptr<ActivationLayerInt8> activ_int8 = layer.dynamicCast<ActivationLayerInt8>();
+        // per-channel lookup tables are indexed by the second dimension of the output which is
+        // the channels dimension only for 2D outputs, so only shared tables are fused
+        if (activ_int8.empty() || !activationLUT.empty() || activ_int8->blobs[0].rows != 1)
+            return false;
+        activationLUT = activ_int8->blobs[0];
+        return true;
+    }
+
+    class FullyConnected : public ParallelLoopBody
+    {
+    public:
+        const FullyConnectedLayerInt8Impl* layer_;
+        const Mat* srcMat_;
+        Mat* dstMat_;
+        int nstripes_;
+
+        FullyConnected(const FullyConnectedLayerInt8Impl* layer, const Mat& srcMat, Mat& dstMat, int nstripes)
+            : layer_(layer), srcMat_(&srcMat), dstMat_(&dstMat), nstripes_(nstripes) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const Mat& weights = layer_->weightsMat;
+            const int numOutput = weights.rows, nsamples = srcMat_->rows;
+            const int stripeSize = (int)alignSize((numOutput + nstripes_ - 1) / nstripes_, 4);
+            const int m0 = std::min(r.start * stripeSize, numOutput);
+            const int m1 = std::min(r.end * stripeSize, numOutput);
+            if (m0 >= m1)
+                return;
+
+            int8_t* dstptr = dstMat_->ptr<int8_t>() + m0;
+            layer_->gemm(weights.ptr<int8_t>(m0), weights.step1(),
+                         &layer_->biasvec[m0], &layer_->outputMultiplier[m0],
+                         srcMat_->ptr<int8_t>(), srcMat_->step1(), dstptr, 1, numOutput,
+                         layer_->output_zp, m1 - m0, nsamples, weights.cols);
+
+            const Mat& lut = layer_->activationLUT;
+            if (!lut.empty())
+            {
+                const int8_t* table = lut.ptr<int8_t>() + 128;
+                for (int n = 0; n < nsamples; n++)
+                {
+                    int8_t* dst = dstptr + n * numOutput;
+                    for (int m = 0; m < m1 - m0; m++)
+                        dst[m] = table[dst[m]];
+                }
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> input, output;
+        inputs_arr.getMatVector(input);
+        outputs_arr.getMatVector(output);
+
+        const int axisCan = normalize_axis(axis, input[0].dims);
+        const int outerSize = input[0].total(0, axisCan);
+        const int innerSize = blobs[0].size[1];
+
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            CV_CheckTypeEQ(input[i].type(), CV_8S, "");
+            CV_CheckTypeEQ(output[i].type(), CV_8S, "");
+            Mat srcMat = input[i].reshape(1, outerSize);
+            Mat dstMat = output[i].reshape(1, outerSize);
+
+            // input vectors are padded to the aligned size of weights rows
+            Mat srcAligned = Mat::zeros(outerSize, weightsMat.cols, CV_8S);
+            srcMat.copyTo(srcAligned.colRange(0, innerSize));
+
+            const int nstripes = std::max(getNumThreads(), 1);
+            parallel_for_(Range(0, nstripes), FullyConnected(this, srcAligned, dstMat, nstripes), nstripes);
+        }
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(inputs); // suppress unused variable warning
+        long flops = 0;
+
+        int innerSize = blobs[0].size[1];
+        for(int i = 0; i < outputs.size(); i++)
+        {
+            flops += CV_BIG_INT(3)*innerSize*total(outputs[i]);
+        }
+
+        return flops;
+    }
+};
+
+Ptr<InnerProductLayerInt8> InnerProductLayerInt8::create(const LayerParams& params)
+{
+    return Ptr<InnerProductLayerInt8>(new FullyConnectedLayerInt8Impl(params));
+}
+
+}
+}
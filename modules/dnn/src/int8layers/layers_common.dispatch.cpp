@@ -0,0 +1,76 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+
+#include "layers_common.simd.hpp"  // baseline implementation, must precede dispatched declarations
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+Int8GemmDispatcher::Int8GemmDispatcher()
+{
+    // the VNNI kernel expects weights biased by the unsigned input offset, see prepareWeightsInt8()
+    useVNNI = CV_TRY_AVX512_CLX && CV_CPU_HAS_SUPPORT_AVX512_CLX;
+    useAVX512 = CV_TRY_AVX512_SKX && CV_CPU_HAS_SUPPORT_AVX512_SKX;
+    useAVX2 = CV_TRY_AVX2 && CV_CPU_HAS_SUPPORT_AVX2;
+}
+
+void Int8GemmDispatcher::operator()(const int8_t* aptr, size_t astep, const int* bias, const float* multiplier,
+                                    const int8_t* bptr, size_t bstep, int8_t* cptr, size_t cstep_m, size_t cstep_n,
+                                    int outZp, int ma, int nb, int vecsize_aligned) const
+{
+#if CV_TRY_AVX512_CLX
+    if (useVNNI)
+        opt_AVX512_CLX::fastGEMMInt8(aptr, astep, bias, multiplier, bptr, bstep, cptr, cstep_m, cstep_n,
+                                     outZp, ma, nb, vecsize_aligned);
+    else
+#endif
+#if CV_TRY_AVX512_SKX
+    if (useAVX512)
+        opt_AVX512_SKX::fastGEMMInt8(aptr, astep, bias, multiplier, bptr, bstep, cptr, cstep_m, cstep_n,
+                                     outZp, ma, nb, vecsize_aligned);
+    else
+#endif
+#if CV_TRY_AVX2
+    if (useAVX2)
+        opt_AVX2::fastGEMMInt8(aptr, astep, bias, multiplier, bptr, bstep, cptr, cstep_m, cstep_n,
+                               outZp, ma, nb, vecsize_aligned);
+    else
+#endif
+        cpu_baseline::fastGEMMInt8(aptr, astep, bias, multiplier, bptr, bstep, cptr, cstep_m, cstep_n,
+                                   outZp, ma, nb, vecsize_aligned);
+}
+
+void prepareWeightsInt8(const Mat& weights, const Mat& bias, int inputZp, const Int8GemmDispatcher& dispatcher,
+                        Mat& weightsMat, std::vector<int>& biasvec)
+{
+    CV_Assert(weights.type() == CV_8S);
+    Mat wm = weights.reshape(1, weights.size[0]);
+    const int outCn = wm.rows, vecsize = wm.cols;
+    const int vecsize_aligned = (int)alignSize(vecsize, VEC_ALIGN_INT8);
+    weightsMat = Mat::zeros(outCn, vecsize_aligned, CV_8S);
+    wm.copyTo(weightsMat.colRange(0, vecsize));
+
+    CV_Assert(bias.empty() || (bias.type() == CV_32S && bias.total() == (size_t)outCn));
+    biasvec.resize(outCn);
+    for (int i = 0; i < outCn; i++)
+    {
+        const int8_t* wptr = weightsMat.ptr<int8_t>(i);
+        int wsum = 0;
+        for (int j = 0; j < vecsize; j++)
+            wsum += wptr[j];
+        // sum((x - zp) * w) = sum(x * w) - zp * sum(w)
+        int b = (bias.empty() ? 0 : bias.ptr<int>()[i]) - inputZp * wsum;
+        if (dispatcher.useVNNI)
+            b -= 128 * wsum;
+        biasvec[i] = b;
+    }
+}
+
+}
+}
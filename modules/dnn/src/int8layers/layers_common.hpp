@@ -0,0 +1,73 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_DNN_INT8LAYERS_LAYERS_COMMON_HPP__
+#define __OPENCV_DNN_INT8LAYERS_LAYERS_COMMON_HPP__
+#include <opencv2/dnn.hpp>
+#include <opencv2/dnn/shape_utils.hpp>
+
+#define CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+// dispatched AVX2/AVX512/VNNI optimizations
+#include "./layers_common.simd.hpp"
+#include "int8layers/layers_common.simd_declarations.hpp"
+#undef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+namespace cv
+{
+namespace dnn
+{
+// Shared with FP32 layers, see layers/layers_common.hpp. That header can't be included together with
+// this one because both declare dispatched functions of the same translation unit name.
+void getConvolutionKernelParams(const LayerParams &params, std::vector<size_t>& kernel, std::vector<size_t>& pads_begin,
+                                std::vector<size_t>& pads_end, std::vector<size_t>& strides, std::vector<size_t>& dilations,
+                                cv::String &padMode, std::vector<size_t>& adjust_pads);
+
+void getPoolingKernelParams(const LayerParams &params, std::vector<size_t>& kernel, std::vector<bool>& globalPooling,
+                            std::vector<size_t>& pads_begin, std::vector<size_t>& pads_end, std::vector<size_t>& strides, cv::String &padMode);
+
+void getConvPoolOutParams(const std::vector<int>& inp, const std::vector<size_t>& kernel,
+                          const std::vector<size_t>& stride, const String &padMode,
+                          const std::vector<size_t>& dilation, std::vector<int>& out);
+
+void getConvPoolPaddings(const std::vector<int>& inp, const std::vector<size_t>& kernel,
+                         const std::vector<size_t>& strides, const String &padMode,
+                         std::vector<size_t>& pads_begin, std::vector<size_t>& pads_end);
+
+// rows of INT8 weights are padded to the widest supported SIMD register (512 bits)
+enum { VEC_ALIGN_INT8 = 64 };
+
+/** @brief Dispatches fastGEMMInt8() to the best available implementation.
+ *
+ * Bias compensation required by AVX512-VNNI code path is computed by the caller,
+ * see Int8GemmDispatcher::useVNNI.
+ */
+struct Int8GemmDispatcher
+{
+    Int8GemmDispatcher();
+
+    void operator()(const int8_t* aptr, size_t astep, const int* bias, const float* multiplier,
+                    const int8_t* bptr, size_t bstep, int8_t* cptr, size_t cstep_m, size_t cstep_n,
+                    int outZp, int ma, int nb, int vecsize_aligned) const;
+
+    bool useVNNI;
+    bool useAVX512;
+    bool useAVX2;
+};
+
+/** @brief Prepares weights for fastGEMMInt8()
+ *
+ * @param weights INT8 weights, every output channel is stored in a row
+ * @param bias INT32 bias of output channels (empty - zero bias)
+ * @param inputZp zero point of the input blob
+ * @param dispatcher kernel dispatcher
+ * @param[out] weightsMat weights with rows aligned to VEC_ALIGN_INT8
+ * @param[out] biasvec bias with compensation of the input zero point (and of VNNI input shift if necessary)
+ */
+void prepareWeightsInt8(const Mat& weights, const Mat& bias, int inputZp, const Int8GemmDispatcher& dispatcher,
+                        Mat& weightsMat, std::vector<int>& biasvec);
+
+}
+}
+
+#endif
@@ -0,0 +1,233 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+namespace dnn {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+/** INT8 matrix product with requantization of the result:
+ *
+ *  c[m*cstep_m + n*cstep_n] = saturate(round((bias[m] + dot(a[m], b[n])) * multiplier[m]) + outZp)
+ *
+ *  Rows of @p aptr and @p bptr have `vecsize_aligned` elements (multiple of `VEC_ALIGN_INT8`),
+ *  padding elements must be zero in at least one of them.
+ *
+ *  @note AVX512-VNNI implementation computes dot products as `dot(a[m], b[n] + 128)`,
+ *  so the `bias[m]` passed to `opt_AVX512_CLX::fastGEMMInt8` must be compensated by `-128 * sum(a[m])`.
+ */
+void fastGEMMInt8( const int8_t* aptr, size_t astep, const int* bias, const float* multiplier,
+                   const int8_t* bptr, size_t bstep, int8_t* cptr, size_t cstep_m, size_t cstep_n,
+                   int outZp, int ma, int nb, int vecsize_aligned );
+
+#if !defined(CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY)
+
+static inline int8_t requantizeInt8(int acc, float multiplier, int outZp)
+{
+    return saturate_cast<schar>(cvRound(acc * multiplier) + outZp);
+}
+
+#if CV_AVX_512VNNI
+
+void fastGEMMInt8( const int8_t* aptr, size_t astep, const int* bias, const float* multiplier,
+                   const int8_t* bptr, size_t bstep, int8_t* cptr, size_t cstep_m, size_t cstep_n,
+                   int outZp, int ma, int nb, int vecsize_aligned )
+{
+    CV_DbgAssert(vecsize_aligned % 64 == 0);
+    const __m512i signbit = _mm512_set1_epi8((char)0x80);
+    const __m512i z = _mm512_setzero_si512();
+    int m = 0;
+    for( ; m <= ma - 4; m += 4 )
+    {
+        const int8_t* a0 = aptr + astep*m;
+        const int8_t* a1 = a0 + astep;
+        const int8_t* a2 = a1 + astep;
+        const int8_t* a3 = a2 + astep;
+        int n = 0;
+        for( ; n <= nb - 2; n += 2 )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            const int8_t* b1 = b0 + bstep;
+            __m512i s00 = z, s01 = z, s10 = z, s11 = z, s20 = z, s21 = z, s30 = z, s31 = z;
+            for( int k = 0; k < vecsize_aligned; k += 64 )
+            {
+                // vpdpbusd multiplies unsigned bytes by signed ones: shift activations to the unsigned range
+                __m512i vb0 = _mm512_xor_si512(_mm512_loadu_si512(b0 + k), signbit);
+                __m512i vb1 = _mm512_xor_si512(_mm512_loadu_si512(b1 + k), signbit);
+                __m512i va = _mm512_loadu_si512(a0 + k);
+                s00 = _mm512_dpbusd_epi32(s00, vb0, va);
+                s01 = _mm512_dpbusd_epi32(s01, vb1, va);
+                va = _mm512_loadu_si512(a1 + k);
+                s10 = _mm512_dpbusd_epi32(s10, vb0, va);
+                s11 = _mm512_dpbusd_epi32(s11, vb1, va);
+                va = _mm512_loadu_si512(a2 + k);
+                s20 = _mm512_dpbusd_epi32(s20, vb0, va);
+                s21 = _mm512_dpbusd_epi32(s21, vb1, va);
+                va = _mm512_loadu_si512(a3 + k);
+                s30 = _mm512_dpbusd_epi32(s30, vb0, va);
+                s31 = _mm512_dpbusd_epi32(s31, vb1, va);
+            }
+            int8_t* c0 = cptr + cstep_m*m + cstep_n*n;
+            c0[0] = requantizeInt8(bias[m] + _mm512_reduce_add_epi32(s00), multiplier[m], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m] + _mm512_reduce_add_epi32(s01), multiplier[m], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+1] + _mm512_reduce_add_epi32(s10), multiplier[m+1], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+1] + _mm512_reduce_add_epi32(s11), multiplier[m+1], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+2] + _mm512_reduce_add_epi32(s20), multiplier[m+2], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+2] + _mm512_reduce_add_epi32(s21), multiplier[m+2], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+3] + _mm512_reduce_add_epi32(s30), multiplier[m+3], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+3] + _mm512_reduce_add_epi32(s31), multiplier[m+3], outZp);
+        }
+        for( ; n < nb; n++ )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            __m512i s0 = z, s1 = z, s2 = z, s3 = z;
+            for( int k = 0; k < vecsize_aligned; k += 64 )
+            {
+                __m512i vb0 = _mm512_xor_si512(_mm512_loadu_si512(b0 + k), signbit);
+                s0 = _mm512_dpbusd_epi32(s0, vb0, _mm512_loadu_si512(a0 + k));
+                s1 = _mm512_dpbusd_epi32(s1, vb0, _mm512_loadu_si512(a1 + k));
+                s2 = _mm512_dpbusd_epi32(s2, vb0, _mm512_loadu_si512(a2 + k));
+                s3 = _mm512_dpbusd_epi32(s3, vb0, _mm512_loadu_si512(a3 + k));
+            }
+            int8_t* c0 = cptr + cstep_m*m + cstep_n*n;
+            c0[0] = requantizeInt8(bias[m] + _mm512_reduce_add_epi32(s0), multiplier[m], outZp);
+            c0[cstep_m] = requantizeInt8(bias[m+1] + _mm512_reduce_add_epi32(s1), multiplier[m+1], outZp);
+            c0[cstep_m*2] = requantizeInt8(bias[m+2] + _mm512_reduce_add_epi32(s2), multiplier[m+2], outZp);
+            c0[cstep_m*3] = requantizeInt8(bias[m+3] + _mm512_reduce_add_epi32(s3), multiplier[m+3], outZp);
+        }
+    }
+    for( ; m < ma; m++ )
+    {
+        const int8_t* a0 = aptr + astep*m;
+        for( int n = 0; n < nb; n++ )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            __m512i s0 = z;
+            for( int k = 0; k < vecsize_aligned; k += 64 )
+                s0 = _mm512_dpbusd_epi32(s0, _mm512_xor_si512(_mm512_loadu_si512(b0 + k), signbit),
+                                         _mm512_loadu_si512(a0 + k));
+            cptr[cstep_m*m + cstep_n*n] = requantizeInt8(bias[m] + _mm512_reduce_add_epi32(s0), multiplier[m], outZp);
+        }
+    }
+}
+
+#else  // CV_AVX_512VNNI
+
+#if CV_SIMD
+// Wide accumulators are summed by 128-bit blocks through memory. GCC 12 reports false -Wmaybe-uninitialized
+// warnings for the AVX-512 extract/unpack intrinsics used by v_reduce_sum(v_int32x16) and v_transpose4x4().
+static inline int reduceSum(const v_int32& a)
+{
+    int CV_DECL_ALIGNED(CV_SIMD_WIDTH) buf[v_int32::nlanes];
+    v_store_aligned(buf, a);
+    v_int32x4 s = v_load_aligned(buf);
+    for( int i = 4; i < v_int32::nlanes; i += 4 )
+        s += v_load_aligned(buf + i);
+    return v_reduce_sum(s);
+}
+#endif
+
+void fastGEMMInt8( const int8_t* aptr, size_t astep, const int* bias, const float* multiplier,
+                   const int8_t* bptr, size_t bstep, int8_t* cptr, size_t cstep_m, size_t cstep_n,
+                   int outZp, int ma, int nb, int vecsize_aligned )
+{
+    int m = 0;
+#if CV_SIMD
+    const int nlanes = v_int8::nlanes;
+    CV_DbgAssert(vecsize_aligned % nlanes == 0);
+    for( ; m <= ma - 4; m += 4 )
+    {
+        const int8_t* a0 = aptr + astep*m;
+        const int8_t* a1 = a0 + astep;
+        const int8_t* a2 = a1 + astep;
+        const int8_t* a3 = a2 + astep;
+        int n = 0;
+        for( ; n <= nb - 2; n += 2 )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            const int8_t* b1 = b0 + bstep;
+            v_int32 s00 = vx_setzero_s32(), s01 = s00, s10 = s00, s11 = s00,
+                    s20 = s00, s21 = s00, s30 = s00, s31 = s00;
+            for( int k = 0; k < vecsize_aligned; k += nlanes )
+            {
+                v_int8 vb0 = vx_load(b0 + k), vb1 = vx_load(b1 + k);
+                v_int8 va = vx_load(a0 + k);
+                s00 = v_dotprod_expand_fast(va, vb0, s00);
+                s01 = v_dotprod_expand_fast(va, vb1, s01);
+                va = vx_load(a1 + k);
+                s10 = v_dotprod_expand_fast(va, vb0, s10);
+                s11 = v_dotprod_expand_fast(va, vb1, s11);
+                va = vx_load(a2 + k);
+                s20 = v_dotprod_expand_fast(va, vb0, s20);
+                s21 = v_dotprod_expand_fast(va, vb1, s21);
+                va = vx_load(a3 + k);
+                s30 = v_dotprod_expand_fast(va, vb0, s30);
+                s31 = v_dotprod_expand_fast(va, vb1, s31);
+            }
+            int8_t* c0 = cptr + cstep_m*m + cstep_n*n;
+            c0[0] = requantizeInt8(bias[m] + reduceSum(s00), multiplier[m], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m] + reduceSum(s01), multiplier[m], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+1] + reduceSum(s10), multiplier[m+1], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+1] + reduceSum(s11), multiplier[m+1], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+2] + reduceSum(s20), multiplier[m+2], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+2] + reduceSum(s21), multiplier[m+2], outZp);
+            c0 += cstep_m;
+            c0[0] = requantizeInt8(bias[m+3] + reduceSum(s30), multiplier[m+3], outZp);
+            c0[cstep_n] = requantizeInt8(bias[m+3] + reduceSum(s31), multiplier[m+3], outZp);
+        }
+        for( ; n < nb; n++ )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            v_int32 s0 = vx_setzero_s32(), s1 = s0, s2 = s0, s3 = s0;
+            for( int k = 0; k < vecsize_aligned; k += nlanes )
+            {
+                v_int8 vb0 = vx_load(b0 + k);
+                s0 = v_dotprod_expand_fast(vx_load(a0 + k), vb0, s0);
+                s1 = v_dotprod_expand_fast(vx_load(a1 + k), vb0, s1);
+                s2 = v_dotprod_expand_fast(vx_load(a2 + k), vb0, s2);
+                s3 = v_dotprod_expand_fast(vx_load(a3 + k), vb0, s3);
+            }
+            int8_t* c0 = cptr + cstep_m*m + cstep_n*n;
+            c0[0] = requantizeInt8(bias[m] + reduceSum(s0), multiplier[m], outZp);
+            c0[cstep_m] = requantizeInt8(bias[m+1] + reduceSum(s1), multiplier[m+1], outZp);
+            c0[cstep_m*2] = requantizeInt8(bias[m+2] + reduceSum(s2), multiplier[m+2], outZp);
+            c0[cstep_m*3] = requantizeInt8(bias[m+3] + reduceSum(s3), multiplier[m+3], outZp);
+        }
+    }
+#endif
+    for( ; m < ma; m++ )
+    {
+        const int8_t* a0 = aptr + astep*m;
+        for( int n = 0; n < nb; n++ )
+        {
+            const int8_t* b0 = bptr + bstep*n;
+            int k = 0, s = 0;
+#if CV_SIMD
+            v_int32 s0 = vx_setzero_s32();
+            for( ; k < vecsize_aligned; k += v_int8::nlanes )
+                s0 = v_dotprod_expand_fast(vx_load(a0 + k), vx_load(b0 + k), s0);
+            s = reduceSum(s0);
+#endif
+            for( ; k < vecsize_aligned; k++ )
+                s += (int)a0[k] * b0[k];
+            cptr[cstep_m*m + cstep_n*n] = requantizeInt8(bias[m] + s, multiplier[m], outZp);
+        }
+    }
+#if CV_SIMD
+    vx_cleanup();
+#endif
+}
+
+#endif  // CV_AVX_512VNNI
+
+#endif  // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+}}  // namespace
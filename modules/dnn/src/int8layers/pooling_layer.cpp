@@ -0,0 +1,240 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace cv
+{
+namespace dnn
+{
+
+class PoolingLayerInt8Impl CV_FINAL : public PoolingLayerInt8
+{
+public:
+    PoolingLayerInt8Impl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        String pool = toLowerCase(params.get<String>("pool", "max"));
+        if (pool == "max")
+            type = MAX;
+        else if (pool == "ave")
+            type = AVE;
+        else
+            CV_Error(Error::StsNotImplemented, "Unsupported INT8 pooling type \"" + pool + "\"");
+
+        isGlobalPooling = std::vector<bool>(3, false);
+        getPoolingKernelParams(params, kernel_size, isGlobalPooling, pads_begin, pads_end, strides, padMode);
+        globalPooling = isGlobalPooling[0] || isGlobalPooling[1] || isGlobalPooling[2];
+        ceilMode = params.get<bool>("ceil_mode", true);
+        avePoolPaddedArea = params.get<bool>("ave_pool_padded_area", true);
+
+        input_sc = params.get<float>("input_scale");
+        input_zp = params.get<int>("input_zeropoint");
+        output_sc = params.get<float>("output_scale");
+        output_zp = params.get<int>("output_zeropoint");
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() == 1 && inputs[0].size() == 4);
+
+        std::vector<int> inpShape(inputs[0].begin() + 2, inputs[0].end());
+        std::vector<int> outShape(inputs[0].begin(), inputs[0].begin() + 2);
+
+        std::vector<size_t> local_kernel;
+        if (globalPooling) {
+            for (int i = 0; i < inpShape.size(); i++) {
+                int idx = isGlobalPooling.size() - inpShape.size() + i;
+                local_kernel.push_back(isGlobalPooling[idx] ? inpShape[i] : kernel_size[idx]);
+            }
+        } else {
+            local_kernel = kernel_size;
+        }
+
+        if (padMode.empty())
+        {
+            for (int i = 0; i < local_kernel.size(); i++) {
+                float dst = (float) (inpShape[i] + pads_begin[i] + pads_end[i] - local_kernel[i]) / strides[i];
+                outShape.push_back(1 + (ceilMode ? ceil(dst) : floor(dst)));
+            }
+
+            // If we have padding, ensure that the last pooling starts strictly
+            // inside the image (instead of at the padding); otherwise clip the last.
+            for (int i = 0; i < local_kernel.size(); i++) {
+                if (pads_end[i] && (outShape[2 + i] - 1) * strides[i] >= inpShape[i] + pads_end[i]) {
+                    --outShape[2 + i];
+                    CV_Assert((outShape[2 + i] - 1) * strides[i] < inpShape[i] + pads_end[i]);
+                }
+            }
+        } else {
+            getConvPoolOutParams(inpShape, local_kernel, strides, padMode,
+                                 std::vector<size_t>(local_kernel.size(), 1), outShape);
+        }
+
+        outputs.assign(1, outShape);
+        return false;
+    }
+
+    void finalize(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr) CV_OVERRIDE
+    {
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+        CV_Assert(inputs.size() == 1 && inputs[0].dims == 4);
+
+        std::vector<int> inp;
+        for (int i = 2; i < inputs[0].dims; i++)
+            inp.push_back(inputs[0].size[i]);
+        if (globalPooling) {
+            std::vector<size_t> finalKernel;
+            for (int i = 0; i < inp.size(); i++) {
+                int idx = isGlobalPooling.size() - inp.size() + i;
+                finalKernel.push_back(isGlobalPooling[idx] ? inp[i] : kernel_size[idx]);
+            }
+            kernel_size = finalKernel;
+        }
+        getConvPoolPaddings(inp, kernel_size, strides, padMode, pads_begin, pads_end);
+
+        // maximum of INT8 values is requantized to the output scale by lookup table
+        requantizeLUT.resize(256);
+        for (int i = 0; i < 256; i++)
+            requantizeLUT[i] = saturate_cast<schar>(cvRound((i - 128 - input_zp) * input_sc / output_sc) + output_zp);
+    }
+
+    class PoolingInvoker : public ParallelLoopBody
+    {
+    public:
+        const PoolingLayerInt8Impl* layer_;
+        const Mat* src_;
+        Mat* dst_;
+
+        PoolingInvoker(const PoolingLayerInt8Impl* layer, const Mat& src, Mat& dst)
+            : layer_(layer), src_(&src), dst_(&dst) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const Mat& src = *src_;
+            Mat& dst = *dst_;
+            const int inp_height = src.size[2], inp_width = src.size[3];
+            const int out_height = dst.size[2], out_width = dst.size[3];
+            const int kernel_h = (int)layer_->kernel_size[0], kernel_w = (int)layer_->kernel_size[1];
+            const int stride_h = (int)layer_->strides[0], stride_w = (int)layer_->strides[1];
+            const int pad_t = (int)layer_->pads_begin[0], pad_l = (int)layer_->pads_begin[1];
+            const int pad_b = (int)layer_->pads_end[0], pad_r = (int)layer_->pads_end[1];
+            const bool isMax = layer_->type == MAX;
+            const int8_t* lut = &layer_->requantizeLUT[128];
+            const int inpZp = layer_->input_zp, outZp = layer_->output_zp;
+            const float multiplier = layer_->input_sc / layer_->output_sc;
+
+            for (int plane = r.start; plane < r.end; plane++)
+            {
+                const int8_t* srcData = src.ptr<int8_t>() + (size_t)plane * inp_height * inp_width;
+                int8_t* dstData = dst.ptr<int8_t>() + (size_t)plane * out_height * out_width;
+                for (int y0 = 0; y0 < out_height; y0++)
+                {
+                    int ystart = y0 * stride_h - pad_t;
+                    int yend = std::min(ystart + kernel_h, inp_height + pad_b);
+                    int ydelta = yend - ystart;
+                    ystart = std::max(ystart, 0);
+                    yend = std::min(yend, inp_height);
+                    for (int x0 = 0; x0 < out_width; x0++)
+                    {
+                        int xstart = x0 * stride_w - pad_l;
+                        int xend = std::min(xstart + kernel_w, inp_width + pad_r);
+                        int xdelta = xend - xstart;
+                        xstart = std::max(xstart, 0);
+                        xend = std::min(xend, inp_width);
+
+                        if (isMax)
+                        {
+                            int max_val = -128;
+                            for (int y = ystart; y < yend; y++)
+                            {
+                                const int8_t* srcRow = srcData + y * inp_width;
+                                for (int x = xstart; x < xend; x++)
+                                    max_val = std::max(max_val, (int)srcRow[x]);
+                            }
+                            dstData[y0 * out_width + x0] = lut[max_val];
+                        }
+                        else
+                        {
+                            int sum_val = 0;
+                            for (int y = ystart; y < yend; y++)
+                            {
+                                const int8_t* srcRow = srcData + y * inp_width;
+                                for (int x = xstart; x < xend; x++)
+                                    sum_val += srcRow[x];
+                            }
+                            // padded values are zeros of real domain, i.e. equal to the input zero point
+                            const int count = (yend - ystart) * (xend - xstart);
+                            const int area = layer_->avePoolPaddedArea ? xdelta * ydelta : count;
+                            const float val = (sum_val - count * inpZp) * multiplier / std::max(area, 1);
+                            dstData[y0 * out_width + x0] = saturate_cast<schar>(cvRound(val) + outZp);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        CV_CheckTypeEQ(inputs[0].type(), CV_8S, "");
+        CV_CheckTypeEQ(outputs[0].type(), CV_8S, "");
+        CV_Assert(inputs[0].isContinuous() && outputs[0].isContinuous());
+
+        const int nplanes = inputs[0].size[0] * inputs[0].size[1];
+        parallel_for_(Range(0, nplanes), PoolingInvoker(this, inputs[0], outputs[0]));
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(inputs); // suppress unused variable warning
+        long flops = 0;
+        size_t karea = std::accumulate(kernel_size.begin(), kernel_size.end(),
+                                       1, std::multiplies<size_t>());
+        for(int i = 0; i < outputs.size(); i++)
+        {
+            flops += total(outputs[i])*karea;
+        }
+        return flops;
+    }
+
+private:
+    enum Type
+    {
+        MAX,
+        AVE
+    };
+    std::vector<bool> isGlobalPooling;
+    std::vector<int8_t> requantizeLUT;
+};
+
+Ptr<PoolingLayerInt8> PoolingLayerInt8::create(const LayerParams& params)
+{
+    return Ptr<PoolingLayerInt8>(new PoolingLayerInt8Impl(params));
+}
+
+}
+}
@@ -0,0 +1,123 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+static void getQuantizationParams(const LayerParams& params, std::vector<float>& scales, std::vector<int>& zeropoints)
+{
+    DictValue sc = params.get("scales");
+    DictValue zp = params.get("zeropoints");
+    CV_CheckEQ(sc.size(), zp.size(), "Number of scales must be equal to the number of zeropoints");
+    scales.resize(sc.size());
+    zeropoints.resize(zp.size());
+    for (int i = 0; i < sc.size(); i++)
+    {
+        scales[i] = sc.get<float>(i);
+        zeropoints[i] = zp.get<int>(i);
+        CV_Check(scales[i], scales[i] > 0, "Quantization scale must be positive");
+    }
+}
+
+class QuantizeLayerImpl CV_FINAL : public QuantizeLayer
+{
+public:
+    QuantizeLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        getQuantizationParams(params, scales, zeropoints);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_CheckEQ(inputs.size(), scales.size(), "");
+        Layer::getMemoryShapes(inputs, requiredOutputs, outputs, internals);
+        return false;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_32F, "");
+            CV_CheckTypeEQ(outputs[i].type(), CV_8S, "");
+            inputs[i].convertTo(outputs[i], CV_8S, 1.f / scales[i], zeropoints[i]);
+        }
+    }
+};
+
+class DequantizeLayerImpl CV_FINAL : public DequantizeLayer
+{
+public:
+    DequantizeLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        getQuantizationParams(params, scales, zeropoints);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_CheckEQ(inputs.size(), scales.size(), "");
+        Layer::getMemoryShapes(inputs, requiredOutputs, outputs, internals);
+        return false;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_8S, "");
+            CV_CheckTypeEQ(outputs[i].type(), CV_32F, "");
+            inputs[i].convertTo(outputs[i], CV_32F, scales[i], -(scales[i] * zeropoints[i]));
+        }
+    }
+};
+
+Ptr<QuantizeLayer> QuantizeLayer::create(const LayerParams& params)
+{
+    return Ptr<QuantizeLayer>(new QuantizeLayerImpl(params));
+}
+
+Ptr<DequantizeLayer> DequantizeLayer::create(const LayerParams& params)
+{
+    return Ptr<DequantizeLayer>(new DequantizeLayerImpl(params));
+}
+
+}
+}
@@ -0,0 +1,264 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class AttentionLayerImpl CV_FINAL : public AttentionLayer
+{
+public:
+    AttentionLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        scale = params.get<float>("scale", 1.f);
+        keyTransposed = params.get<bool>("key_transposed", false);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(inputs.size() == 3 || inputs.size() == 4);
+        const MatShape& q = inputs[0];
+        const MatShape& k = inputs[1];
+        const MatShape& v = inputs[2];
+        const size_t dims = q.size();
+        CV_CheckGE(dims, (size_t)2, "");
+        CV_CheckEQ(k.size(), dims, "");
+        CV_CheckEQ(v.size(), dims, "");
+        for (size_t i = 0; i < dims - 2; i++)
+        {
+            CV_CheckEQ(k[i], q[i], "Batch dimensions of queries and keys must be equal");
+            CV_CheckEQ(v[i], q[i], "Batch dimensions of queries and values must be equal");
+        }
+        const int keyLen = keyTransposed ? k[dims - 1] : k[dims - 2];
+        const int keyDepth = keyTransposed ? k[dims - 2] : k[dims - 1];
+        CV_CheckEQ(keyDepth, q[dims - 1], "Depths of queries and keys must be equal");
+        CV_CheckEQ(v[dims - 2], keyLen, "Number of keys and values must be equal");
+
+        if (inputs.size() == 4)
+        {
+            MatShape scores = q;
+            scores.back() = keyLen;
+            const MatShape& mask = inputs[3];
+            CV_CheckLE(mask.size(), dims, "");
+            for (size_t i = 0; i < mask.size(); i++)
+            {
+                const int dim = scores[dims - mask.size() + i];
+                if (mask[i] != 1 && mask[i] != dim)
+                    CV_Error(Error::StsBadSize, "Attention mask can't be broadcasted to the shape of scores");
+            }
+        }
+
+        MatShape out = q;
+        out.back() = v.back();
+        outputs.assign(1, out);
+        return false;
+    }
+
+    class AttentionInvoker : public ParallelLoopBody
+    {
+    public:
+        const Mat *q_, *k_, *v_;
+        Mat* dst_;
+        const float* mask_;
+        // offsets of the mask for every matrix of scores and its steps by queries and keys
+        std::vector<size_t> maskOffsets_;
+        size_t maskQueryStep_, maskKeyStep_;
+        float scale_;
+        bool keyTransposed_;
+        int numQueries_, numKeys_, depth_, valueDepth_;
+
+        AttentionInvoker(const Mat& q, const Mat& k, const Mat& v, const Mat& mask, Mat& dst,
+                         float scale, bool keyTransposed)
+            : q_(&q), k_(&k), v_(&v), dst_(&dst), mask_(0), maskQueryStep_(0), maskKeyStep_(0),
+              scale_(scale), keyTransposed_(keyTransposed)
+        {
+            const int dims = q.dims;
+            numQueries_ = q.size[dims - 2];
+            depth_ = q.size[dims - 1];
+            numKeys_ = v.size[dims - 2];
+            valueDepth_ = v.size[dims - 1];
+
+            const int numMatrices = (int)q.total(0, dims - 2);
+            maskOffsets_.assign(numMatrices, 0);
+            if (!mask.empty())
+            {
+                mask_ = mask.ptr<float>();
+                MatShape maskShape = shape(mask);
+                maskShape.insert(maskShape.begin(), dims - maskShape.size(), 1);
+                maskKeyStep_ = maskShape[dims - 1] == 1 ? 0 : 1;
+                maskQueryStep_ = maskShape[dims - 2] == 1 ? 0 : maskShape[dims - 1];
+                for (int m = 0; m < numMatrices; m++)
+                {
+                    size_t offset = 0, step = (size_t)maskShape[dims - 2] * maskShape[dims - 1];
+                    for (int i = dims - 3, idx = m; i >= 0; i--)
+                    {
+                        const int coord = idx % q.size[i];
+                        idx /= q.size[i];
+                        if (maskShape[i] != 1)
+                            offset += coord * step;
+                        step *= maskShape[i];
+                    }
+                    maskOffsets_[m] = offset;
+                }
+            }
+        }
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int D = depth_, Dv = valueDepth_, Sk = numKeys_;
+            AutoBuffer<float> scoresBuf(Sk);
+            float* scores = scoresBuf.data();
+
+            for (int row = r.start; row < r.end; row++)
+            {
+                const int m = row / numQueries_, i = row % numQueries_;
+                const float* q = q_->ptr<float>() + (size_t)row * D;
+                const float* keys = k_->ptr<float>() + (size_t)m * Sk * D;
+                const float* values = v_->ptr<float>() + (size_t)m * Sk * Dv;
+                float* dst = dst_->ptr<float>() + (size_t)row * Dv;
+
+                if (!keyTransposed_)
+                {
+                    for (int j = 0; j < Sk; j++)
+                    {
+                        const float* key = keys + (size_t)j * D;
+                        int d = 0;
+                        float s = 0.f;
+#if CV_SIMD
+                        v_float32 vs = vx_setzero_f32();
+                        for (; d <= D - v_float32::nlanes; d += v_float32::nlanes)
+                            vs = v_fma(vx_load(q + d), vx_load(key + d), vs);
+                        s = v_reduce_sum(vs);
+#endif
+                        for (; d < D; d++)
+                            s += q[d] * key[d];
+                        scores[j] = s;
+                    }
+                }
+                else
+                {
+                    // keys are stored as D x Sk matrix, accumulate scores by rows of it
+                    memset(scores, 0, Sk * sizeof(scores[0]));
+                    for (int d = 0; d < D; d++)
+                    {
+                        const float qd = q[d];
+                        const float* key = keys + (size_t)d * Sk;
+                        int j = 0;
+#if CV_SIMD
+                        v_float32 vq = vx_setall_f32(qd);
+                        for (; j <= Sk - v_float32::nlanes; j += v_float32::nlanes)
+                            v_store(scores + j, v_fma(vq, vx_load(key + j), vx_load(scores + j)));
+#endif
+                        for (; j < Sk; j++)
+                            scores[j] += qd * key[j];
+                    }
+                }
+
+                float maxScore = -FLT_MAX;
+                if (mask_)
+                {
+                    const float* mask = mask_ + maskOffsets_[m] + i * maskQueryStep_;
+                    for (int j = 0; j < Sk; j++)
+                    {
+                        scores[j] = scores[j] * scale_ + mask[j * maskKeyStep_];
+                        maxScore = std::max(maxScore, scores[j]);
+                    }
+                }
+                else
+                {
+                    for (int j = 0; j < Sk; j++)
+                    {
+                        scores[j] *= scale_;
+                        maxScore = std::max(maxScore, scores[j]);
+                    }
+                }
+
+                float sum = 0.f;
+                for (int j = 0; j < Sk; j++)
+                {
+                    scores[j] = std::exp(scores[j] - maxScore);
+                    sum += scores[j];
+                }
+                const float invSum = 1.f / sum;
+
+                memset(dst, 0, Dv * sizeof(dst[0]));
+                for (int j = 0; j < Sk; j++)
+                {
+                    const float p = scores[j] * invSum;
+                    const float* value = values + (size_t)j * Dv;
+                    int d = 0;
+#if CV_SIMD
+                    v_float32 vp = vx_setall_f32(p);
+                    for (; d <= Dv - v_float32::nlanes; d += v_float32::nlanes)
+                        v_store(dst + d, v_fma(vp, vx_load(value + d), vx_load(dst + d)));
+#endif
+                    for (; d < Dv; d++)
+                        dst[d] += p * value[d];
+                }
+            }
+#if CV_SIMD
+            vx_cleanup();
+#endif
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_32F, "");
+            CV_Assert(inputs[i].isContinuous());
+        }
+        CV_Assert(outputs[0].isContinuous());
+
+        Mat mask = inputs.size() > 3 ? inputs[3] : Mat();
+        const Mat& q = inputs[0];
+        const int numRows = (int)q.total(0, q.dims - 1);
+        parallel_for_(Range(0, numRows), AttentionInvoker(q, inputs[1], inputs[2], mask, outputs[0], scale, keyTransposed));
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        const MatShape& q = inputs[0];
+        const MatShape& v = inputs[2];
+        int64 numKeys = v[v.size() - 2];
+        return total(q, 0, (int)q.size() - 1) * numKeys * (2 * q.back() + 2 * v.back() + 4);
+    }
+};
+
+Ptr<AttentionLayer> AttentionLayer::create(const LayerParams& params)
+{
+    return Ptr<AttentionLayer>(new AttentionLayerImpl(params));
+}
+
+}
+}
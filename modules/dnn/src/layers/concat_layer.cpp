@@ -301,6 +301,20 @@ public:
     }
 #endif
 
+    virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                             const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE
+    {
+        if (padding || scales[1].size() != 1)
+            return false;
+
+        params.type = "ConcatInt8";
+        params.set("scales", DictValue::arrayReal(scales[0].begin(), scales[0].size()));
+        params.set("zeropoints", DictValue::arrayInt(zeropoints[0].begin(), zeropoints[0].size()));
+        params.set("output_scale", scales[1][0]);
+        params.set("output_zeropoint", zeropoints[1][0]);
+        return true;
+    }
+
     virtual Ptr<BackendNode> initVkCom(const std::vector<Ptr<BackendWrapper> > &input) CV_OVERRIDE
     {
 #ifdef HAVE_VULKAN
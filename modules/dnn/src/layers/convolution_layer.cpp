@@ -48,6 +48,7 @@
 #include "../ie_ngraph.hpp"
 #include "../op_vkcom.hpp"
 
+#include <opencv2/core/utils/configuration.private.hpp>
 #include <opencv2/core/utils/logger.hpp>
 
 #include "opencv2/core/hal/hal.hpp"
@@ -74,6 +75,8 @@ namespace cv
 namespace dnn
 {
 
+static bool DNN_CONV_WINOGRAD = utils::getConfigurationParameterBool("OPENCV_DNN_CONV_WINOGRAD", true);
+
 class BaseConvolutionLayerImpl : public ConvolutionLayer
 {
 public:
@@ -249,6 +252,12 @@ public:
     std::vector<float> biasvec;
     std::vector<float> reluslope;
     Ptr<ActivationLayer> activ;
+    // CPU: the second input (eltwise sum operand) is added to the output before the activation
+    bool fusedAdd;
+
+    // specialized CPU implementations, chosen in finalize()
+    bool useWinograd, useDepthwise;
+    Mat weightsWinograd;  // transformed weights, computed on the first forward() after weights fusion
 
 #ifdef HAVE_OPENCL
     Ptr<OCL4DNNConvSpatial<float> > convolutionOp;
@@ -271,6 +280,8 @@ public:
 
     ConvolutionLayerImpl(const LayerParams &params) : BaseConvolutionLayerImpl(params)
     {
+        useWinograd = useDepthwise = false;
+        fusedAdd = false;
 #ifdef HAVE_OPENCL
         newActiv = false;
         activType = OCL4DNN_CONV_FUSED_ACTIV_NONE;
@@ -422,6 +433,21 @@ public:
 
         weightsMultipliers.assign(numOutput, 1.0);
 
+        useWinograd = useDepthwise = false;
+        weightsWinograd.release();
+        if (!blobs.empty() && inputs[0].dims == 4 && inputs[0].type() == CV_32F)
+        {
+            const int inpCn = inputs[0].size[1], ngroups = inpCn / blobs[0].size[1];
+            const int inpH = inputs[0].size[2], inpW = inputs[0].size[3];
+            if (ngroups == 1)
+                useWinograd = DNN_CONV_WINOGRAD && ParallelWinograd::isApplicable(kernel_size, strides, dilations,
+                                                                                 inpCn, numOutput, inpH, inpW);
+            else
+                useDepthwise = ngroups == inpCn && numOutput == inpCn &&
+                               !ParallelConv::isDepthwise3x3Applicable(kernel_size, strides, pads_begin,
+                                                                       dilations, inpW);
+        }
+
         Mat biasMat = hasBias() ? blobs[1].reshape(1, numOutput) : Mat();
         biasvec.resize(numOutput+2);
         if( biasMat.empty() )
@@ -453,7 +479,10 @@ public:
 
         activ = layer;
         if (activ.empty())
+        {
             reluslope.clear();
+            fusedAdd = false;
+        }
 #ifdef HAVE_OPENCL
         newActiv = true;
         activType = OCL4DNN_CONV_FUSED_ACTIV_NONE;
@@ -587,6 +616,14 @@ public:
             }
         }
 #endif
+        if (preferableTarget == DNN_TARGET_CPU && !top.dynamicCast<EltwiseLayer>().empty())
+        {
+            // the sum is computed before the activation, so the activation can't be fused earlier
+            if (fusedAdd || !activ.empty() || blobs.empty())
+                return false;
+            fusedAdd = true;
+            return true;
+        }
         return BaseConvolutionLayerImpl::tryFuse(top);
     }
 
@@ -603,6 +640,8 @@ public:
 
         if (!w.empty())
         {
+            weightsWinograd.release();
+
             // Keep origin weights unchanged.
             if (weightsMat.data == blobs[0].data)
                 weightsMat = weightsMat.clone();
@@ -910,15 +949,32 @@ public:
         const std::vector<float>* biasvec_;
         const std::vector<float>* reluslope_;
         const ActivationLayer* activ_;
+        const Mat* residual_;
         bool is1x1_;
         bool useAVX;
         bool useAVX2;
         bool useAVX512;
         int blk_size_cn;
 
+        // for now only 3x3 depth-wise convolutions are supported
+        static bool isDepthwise3x3Applicable(const std::vector<size_t>& kernel_size, const std::vector<size_t>& strides,
+                                             const std::vector<size_t>& pads_begin, const std::vector<size_t>& dilations,
+                                             int width)
+        {
+            if (kernel_size.size() != 2 || kernel_size[0] != 3 || kernel_size[1] != 3)
+                return false;
+            int stride_h = (int)strides[0], stride_w = (int)strides[1];
+            int dilation_h = (int)dilations[0], dilation_w = (int)dilations[1];
+            int pad_t = (int)pads_begin[0], pad_l = (int)pads_begin[1];
+            return width >= 16 + dilation_w*2 &&
+                // computing at most 1 pixel from each side can involve padding
+                max(stride_w, dilation_w) >= pad_l && max(stride_h, dilation_h) >= pad_t &&
+                pad_l <= 1 && pad_t <= 1;
+        }
+
         ParallelConv()
             : input_(0), weights_(0), output_(0), ngroups_(0), nstripes_(0),
-              biasvec_(0), reluslope_(0), activ_(0), is1x1_(false), useAVX(false), useAVX2(false), useAVX512(false)
+              biasvec_(0), reluslope_(0), activ_(0), residual_(0), is1x1_(false), useAVX(false), useAVX2(false), useAVX512(false)
             , blk_size_cn(0)
         {}
 
@@ -928,7 +984,7 @@ public:
                          const std::vector<size_t>& kernel_size, const std::vector<size_t>& strides,
                          const std::vector<size_t>& pads_begin, const std::vector<size_t>& pads_end,
                          const std::vector<size_t>& dilations,
-                         const ActivationLayer* activ, int ngroups, int nstripes )
+                         const ActivationLayer* activ, const Mat* residual, int ngroups, int nstripes )
         {
             size_t karea = std::accumulate(kernel_size.begin(), kernel_size.end(),
                                            1, std::multiplies<size_t>());
@@ -946,6 +1002,8 @@ public:
                        input.isContinuous(),
                        output.isContinuous(),
                        biasvec.size() == (size_t)output.size[1]+2);
+            CV_Assert(!residual || (residual->size == output.size && residual->type() == output.type() &&
+                                    residual->isContinuous()));
             CV_Check(weights.step1(), weights.step1() % VEC_ALIGN == 0, "");
             CV_CheckType(weights.type(), CV_32FC1, "");
             ParallelConv p;
@@ -1022,6 +1080,7 @@ public:
             p.biasvec_ = &biasvec;
             p.reluslope_ = &reluslope;
             p.activ_ = p.reluslope_->empty() ? activ : 0;
+            p.residual_ = residual;
 
             parallel_for_(Range(0, nstripes), p, nstripes);
         }
@@ -1071,13 +1130,7 @@ public:
             int stripeSize;
             Range r = r0;
             bool depthWiseConvolution = !is1x1 && isConv2D && ngroups > 1 && inpCn == 1 &&
-                outCn == 1 && kernel_d == 1 && dilation_d == 1 && stride_d == 0 && pad_d == 0 &&
-                width >= 16 + dilation_w*(kernel_w - 1);
-            // for now only 3x3 depth-wise convolutions are supported
-            depthWiseConvolution = depthWiseConvolution && kernel_w == 3 && kernel_h == 3 &&
-                // computing at most 1 pixel from each side can involve padding
-                max(stride_w, dilation_w) >= pad_l && max(stride_h, dilation_h) >= pad_t &&
-                pad_l <= 1 && pad_t <= 1;
+                outCn == 1 && isDepthwise3x3Applicable(kernel_size, strides, pads_begin, dilations, width);
 
             if( !depthWiseConvolution && nstripes >= batchSize*2 )
             {
@@ -1660,6 +1713,14 @@ public:
                     }
                 }
 
+                // the epilogue is applied to the stripe while it's still in cache
+                if( residual_ )
+                {
+                    const float* data_res0 = residual_->ptr<float>() + subsampleIdx*outPlaneSize*outCn;
+                    for( i = 0; i < outCn; i++ )
+                        addResidual(data_out0 + i*outPlaneSize + stripeStart,
+                                    data_res0 + i*outPlaneSize + stripeStart, stripeEnd - stripeStart);
+                }
                 if( activ_ )
                     activ_->forwardSlice(data_out0 + stripeStart, data_out0 + stripeStart,
                                          (int)(stripeEnd - stripeStart),
@@ -1668,6 +1729,490 @@ public:
         }
     };
 
+    /* Winograd F(6x6, 3x3) convolution, see "Fast Algorithms for Convolutional Neural Networks"
+       by A. Lavin and S. Gray. Every 8x8 input tile is transformed as V = B^T*d*B, output 6x6 tile
+       is computed as Y = A^T*M*A, where M[k] = sum_c U[k][c]*V[k][c] is evaluated by 64 matrix
+       products of transformed weights U = G*g*G^T by transformed input tiles. */
+    class ParallelWinograd : public cv::ParallelLoopBody
+    {
+    public:
+        enum { TILE_SIZE = 6, WINO_SIZE = 8, WINO_AREA = 64 };
+
+        const Mat* input_;
+        const Mat* weights_;
+        Mat* output_;
+        int pad_t_, pad_l_, tilesX_, tilesY_, blkTiles_, nblocks_;
+        const std::vector<float>* biasvec_;
+        const std::vector<float>* reluslope_;
+        bool useAVX;
+        bool useAVX2;
+        bool useAVX512;
+
+        ParallelWinograd()
+            : input_(0), weights_(0), output_(0), pad_t_(0), pad_l_(0), tilesX_(0), tilesY_(0),
+              blkTiles_(0), nblocks_(0), biasvec_(0), reluslope_(0), useAVX(false), useAVX2(false), useAVX512(false)
+        {}
+
+        static bool isApplicable(const std::vector<size_t>& kernel_size, const std::vector<size_t>& strides,
+                                 const std::vector<size_t>& dilations, int inpCn, int outCn, int height, int width)
+        {
+            // transformations of tiles don't pay off for thin layers and small images:
+            // with a few tiles per image the GEMMs are too narrow
+            const int ntiles = ((height + TILE_SIZE - 1) / TILE_SIZE) * ((width + TILE_SIZE - 1) / TILE_SIZE);
+            return kernel_size.size() == 2 && kernel_size[0] == 3 && kernel_size[1] == 3 &&
+                   strides[0] == 1 && strides[1] == 1 && dilations[0] == 1 && dilations[1] == 1 &&
+                   inpCn >= 16 && outCn >= 16 && ntiles >= 16;
+        }
+
+        // weights: outCn x (inpCn*9), dst: WINO_AREA x (outCn*inpCn)
+        static void transformWeights(const Mat& weights, int inpCn, Mat& dst)
+        {
+            static const float G[WINO_SIZE][3] = {
+                { 1.f, 0.f, 0.f },
+                { -2.f/9, -2.f/9, -2.f/9 },
+                { -2.f/9, 2.f/9, -2.f/9 },
+                { 1.f/90, 1.f/45, 2.f/45 },
+                { 1.f/90, -1.f/45, 2.f/45 },
+                { 1.f/45, 1.f/90, 1.f/180 },
+                { 1.f/45, -1.f/90, 1.f/180 },
+                { 0.f, 0.f, 1.f }
+            };
+            const int outCn = weights.rows;
+            dst.create(WINO_AREA, outCn*inpCn, CV_32F);
+            float* dstptr = dst.ptr<float>();
+            size_t dststep = dst.step1();
+            for (int oc = 0; oc < outCn; oc++)
+            {
+                for (int ic = 0; ic < inpCn; ic++)
+                {
+                    const float* g = weights.ptr<float>(oc) + ic*9;
+                    float tmp[WINO_SIZE][3];
+                    for (int i = 0; i < WINO_SIZE; i++)
+                        for (int j = 0; j < 3; j++)
+                            tmp[i][j] = G[i][0]*g[j] + G[i][1]*g[3 + j] + G[i][2]*g[6 + j];
+                    // U is stored transposed, the same way as the transformed input tiles
+                    for (int i = 0; i < WINO_SIZE; i++)
+                        for (int j = 0; j < WINO_SIZE; j++)
+                            dstptr[(j*WINO_SIZE + i)*dststep + oc*inpCn + ic] =
+                                tmp[i][0]*G[j][0] + tmp[i][1]*G[j][1] + tmp[i][2]*G[j][2];
+                }
+            }
+        }
+
+        static void run(const Mat& input, Mat& output, const Mat& weights,
+                        const std::vector<float>& biasvec, const std::vector<float>& reluslope,
+                        const std::vector<size_t>& pads_begin, const ActivationLayer* activ,
+                        const Mat* residual, int nstripes)
+        {
+            CV_Assert_N(input.dims == 4, output.dims == 4, input.type() == CV_32F, output.type() == CV_32F,
+                        input.isContinuous(), output.isContinuous(),
+                        weights.rows == WINO_AREA, weights.cols == input.size[1]*output.size[1]);
+            CV_Assert(!residual || (residual->size == output.size && residual->type() == output.type() &&
+                                    residual->isContinuous()));
+            ParallelWinograd p;
+            p.input_ = &input;
+            p.weights_ = &weights;
+            p.output_ = &output;
+            p.pad_t_ = (int)pads_begin[0];
+            p.pad_l_ = (int)pads_begin[1];
+            p.tilesY_ = (output.size[2] + TILE_SIZE - 1) / TILE_SIZE;
+            p.tilesX_ = (output.size[3] + TILE_SIZE - 1) / TILE_SIZE;
+            p.biasvec_ = &biasvec;
+            p.reluslope_ = &reluslope;
+            p.useAVX = checkHardwareSupport(CPU_AVX);
+            p.useAVX2 = checkHardwareSupport(CPU_AVX2);
+            p.useAVX512 = CV_CPU_HAS_SUPPORT_AVX512_SKX;
+            p.blkTiles_ = p.useAVX512 ? 32 : 16;
+            p.nblocks_ = (p.tilesX_*p.tilesY_ + p.blkTiles_ - 1) / p.blkTiles_;
+
+            int ntasks = input.size[0]*p.nblocks_;
+            parallel_for_(Range(0, ntasks), p, std::min(nstripes, ntasks));
+
+            // ReLU and PReLU are applied by the output transformation
+            if (residual || (activ && reluslope.empty()))
+            {
+                const int outCn = output.size[1], outPlaneSize = (int)output.total(2);
+                float* outptr = output.ptr<float>();
+                parallel_for_(Range(0, output.size[0]*outCn), [&](const Range& r)
+                {
+                    for (int i = r.start; i < r.end; i++)
+                    {
+                        float* ptr = outptr + (size_t)i*outPlaneSize;
+                        if (residual)
+                            addResidual(ptr, residual->ptr<float>() + (size_t)i*outPlaneSize, outPlaneSize);
+                        if (activ && reluslope.empty())
+                            activ->forwardSlice(ptr, ptr, outPlaneSize, outPlaneSize, i % outCn, i % outCn + 1);
+                    }
+                }, nstripes);
+            }
+        }
+
+        // B^T*x, where x are rows of 8x8 matrix
+        static inline void transformInputRows(v_float32x4* x)
+        {
+            v_float32x4 q5_25 = v_setall_f32(5.25f), q4_25 = v_setall_f32(4.25f), q2_5 = v_setall_f32(2.5f),
+                        q1_25 = v_setall_f32(1.25f), q0_5 = v_setall_f32(0.5f), q0_25 = v_setall_f32(0.25f),
+                        q2 = v_setall_f32(2.f), q4 = v_setall_f32(4.f);
+            v_float32x4 r0 = v_fma(x[4] - x[2], q5_25, x[0] - x[6]);
+            v_float32x4 r7 = v_fma(x[3] - x[5], q5_25, x[7] - x[1]);
+            v_float32x4 t1 = x[2] + x[6] - x[4]*q4_25;
+            v_float32x4 t2 = x[1] + x[5] - x[3]*q4_25;
+            v_float32x4 t3 = v_fma(x[2], q0_25, x[6]) - x[4]*q1_25;
+            v_float32x4 t4 = v_fma(x[1], q0_5, x[5]*q2) - x[3]*q2_5;
+            v_float32x4 t5 = v_fma(x[2] - x[4]*q1_25, q4, x[6]);
+            v_float32x4 t6 = v_fma(x[1], q2, x[5]*q0_5) - x[3]*q2_5;
+            x[0] = r0;
+            x[1] = t1 + t2;
+            x[2] = t1 - t2;
+            x[3] = t3 + t4;
+            x[4] = t3 - t4;
+            x[5] = t5 + t6;
+            x[6] = t5 - t6;
+            x[7] = r7;
+        }
+
+        // A^T*m, where m are rows of 8x8 matrix, rows 6 and 7 of the result are zeros
+        static inline void transformOutputRows(v_float32x4* m)
+        {
+            v_float32x4 q2 = v_setall_f32(2.f), q4 = v_setall_f32(4.f), q8 = v_setall_f32(8.f),
+                        q16 = v_setall_f32(16.f), q32 = v_setall_f32(32.f);
+            v_float32x4 t1 = m[1] + m[2], t2 = m[1] - m[2];
+            v_float32x4 t3 = m[3] + m[4], t4 = m[3] - m[4];
+            v_float32x4 t5 = m[5] + m[6], t6 = m[5] - m[6];
+            m[0] = v_fma(t5, q32, m[0] + t1 + t3);
+            m[1] = v_fma(t6, q16, v_fma(t4, q2, t2));
+            m[2] = v_fma(t5, q8, v_fma(t3, q4, t1));
+            m[3] = v_fma(t6, q4, v_fma(t4, q8, t2));
+            m[4] = v_fma(t5, q2, v_fma(t3, q16, t1));
+            m[5] = v_fma(t4, q32, m[7] + t2 + t6);
+            m[6] = m[7] = v_setzero_f32();
+        }
+
+        // 8x8 matrix is stored as left (l) and right (r) halves of rows
+        static inline void transpose8x8(v_float32x4* l, v_float32x4* r)
+        {
+            v_float32x4 t[16];
+            v_transpose4x4(l[0], l[1], l[2], l[3], t[0], t[1], t[2], t[3]);
+            v_transpose4x4(l[4], l[5], l[6], l[7], t[4], t[5], t[6], t[7]);
+            v_transpose4x4(r[0], r[1], r[2], r[3], t[8], t[9], t[10], t[11]);
+            v_transpose4x4(r[4], r[5], r[6], r[7], t[12], t[13], t[14], t[15]);
+            for (int i = 0; i < 4; i++)
+            {
+                l[i] = t[i];
+                r[i] = t[i + 4];
+                l[i + 4] = t[i + 8];
+                r[i + 4] = t[i + 12];
+            }
+        }
+
+        virtual void operator ()(const Range &r) const CV_OVERRIDE
+        {
+            const int inpCn = input_->size[1], height = input_->size[2], width = input_->size[3];
+            const int outCn = output_->size[1], outH = output_->size[2], outW = output_->size[3];
+            const int inpPlaneSize = height*width, outPlaneSize = outH*outW;
+            const int blkTiles = blkTiles_, ntiles = tilesX_*tilesY_;
+            const float* biasptr = &biasvec_->at(0);
+            const float* reluptr = reluslope_->empty() ? 0 : &reluslope_->at(0);
+            const float* wptr = weights_->ptr<float>();
+            const size_t wstep = weights_->step1();
+
+            // transformed input tiles: WINO_AREA x inpCn x blkTiles,
+            // products of transformed tiles by weights: WINO_AREA x outCn x blkTiles
+            const size_t vstep = (size_t)inpCn*blkTiles, mstep = (size_t)outCn*blkTiles;
+            AutoBuffer<float> vbuf_(WINO_AREA*(vstep + mstep));
+            float* vbuf = vbuf_.data();
+            float* mbuf = vbuf + WINO_AREA*vstep;
+            // unused tiles of the last block must be finite
+            memset(vbuf, 0, WINO_AREA*vstep*sizeof(vbuf[0]));
+
+            for (int task = r.start; task < r.end; task++)
+            {
+                const int n = task / nblocks_;
+                const int tile0 = (task % nblocks_)*blkTiles;
+                const int tile1 = std::min(tile0 + blkTiles, ntiles);
+                const float* inptr0 = input_->ptr<float>() + (size_t)n*inpCn*inpPlaneSize;
+                float* outptr0 = output_->ptr<float>() + (size_t)n*outCn*outPlaneSize;
+
+                for (int tile = tile0; tile < tile1; tile++)
+                {
+                    const int y0 = (tile / tilesX_)*TILE_SIZE - pad_t_, x0 = (tile % tilesX_)*TILE_SIZE - pad_l_;
+                    const bool inside = y0 >= 0 && x0 >= 0 && y0 + WINO_SIZE <= height && x0 + WINO_SIZE <= width;
+                    float* vptr = vbuf + (tile - tile0);
+                    for (int c = 0; c < inpCn; c++, vptr += blkTiles)
+                    {
+                        const float* inptr = inptr0 + (size_t)c*inpPlaneSize;
+                        float patch[WINO_AREA];
+                        const float* src = inptr + y0*width + x0;
+                        int srcstep = width;
+                        if (!inside)
+                        {
+                            // zero padding
+                            for (int i = 0; i < WINO_SIZE; i++)
+                            {
+                                int y = y0 + i;
+                                for (int j = 0; j < WINO_SIZE; j++)
+                                {
+                                    int x = x0 + j;
+                                    patch[i*WINO_SIZE + j] = (unsigned)y < (unsigned)height &&
+                                                             (unsigned)x < (unsigned)width ? inptr[y*width + x] : 0.f;
+                                }
+                            }
+                            src = patch;
+                            srcstep = WINO_SIZE;
+                        }
+
+                        v_float32x4 l[WINO_SIZE], rt[WINO_SIZE];
+                        for (int i = 0; i < WINO_SIZE; i++)
+                        {
+                            l[i] = v_load(src + i*srcstep);
+                            rt[i] = v_load(src + i*srcstep + 4);
+                        }
+                        // B^T*(B^T*d)^T = (B^T*d*B)^T
+                        transformInputRows(l);
+                        transformInputRows(rt);
+                        transpose8x8(l, rt);
+                        transformInputRows(l);
+                        transformInputRows(rt);
+
+                        float buf[WINO_AREA];
+                        for (int i = 0; i < WINO_SIZE; i++)
+                        {
+                            v_store(buf + i*WINO_SIZE, l[i]);
+                            v_store(buf + i*WINO_SIZE + 4, rt[i]);
+                        }
+                        for (int k = 0; k < WINO_AREA; k++)
+                            vptr[k*vstep] = buf[k];
+                    }
+                }
+
+                for (int k = 0; k < WINO_AREA; k++)
+                {
+                    const float* aptr = wptr + k*wstep;
+                    const float* bptr = vbuf + k*vstep;
+                    float* cptr = mbuf + k*mstep;
+                #if CV_TRY_AVX512_SKX
+                    if (useAVX512)
+                        opt_AVX512_SKX::fastGEMM(aptr, inpCn, bptr, blkTiles, cptr, blkTiles, outCn, inpCn, blkTiles);
+                    else
+                #endif
+                #if CV_TRY_AVX2
+                    if (useAVX2)
+                        opt_AVX2::fastGEMM(aptr, inpCn, bptr, blkTiles, cptr, blkTiles, outCn, inpCn, blkTiles);
+                    else
+                #endif
+                #if CV_TRY_AVX
+                    if (useAVX)
+                        opt_AVX::fastGEMM(aptr, inpCn, bptr, blkTiles, cptr, blkTiles, outCn, inpCn, blkTiles);
+                    else
+                #endif
+                    for (int m = 0; m < outCn; m++)
+                    {
+                        const float* aptr0 = aptr + m*inpCn;
+                        float* cptr0 = cptr + m*blkTiles;
+                        for (int j = 0; j < blkTiles; j += 8)
+                        {
+                            v_float32x4 s0 = v_setzero_f32(), s1 = v_setzero_f32();
+                            for (int c = 0; c < inpCn; c++)
+                            {
+                                v_float32x4 a = v_setall_f32(aptr0[c]);
+                                s0 = v_fma(a, v_load(bptr + c*blkTiles + j), s0);
+                                s1 = v_fma(a, v_load(bptr + c*blkTiles + j + 4), s1);
+                            }
+                            v_store(cptr0 + j, s0);
+                            v_store(cptr0 + j + 4, s1);
+                        }
+                    }
+                }
+
+                for (int tile = tile0; tile < tile1; tile++)
+                {
+                    const int y0 = (tile / tilesX_)*TILE_SIZE, x0 = (tile % tilesX_)*TILE_SIZE;
+                    const int ylimit = std::min((int)TILE_SIZE, outH - y0), xlimit = std::min((int)TILE_SIZE, outW - x0);
+                    const float* mptr = mbuf + (tile - tile0);
+                    for (int oc = 0; oc < outCn; oc++, mptr += blkTiles)
+                    {
+                        float buf[WINO_AREA];
+                        for (int k = 0; k < WINO_AREA; k++)
+                            buf[k] = mptr[k*mstep];
+
+                        v_float32x4 l[WINO_SIZE], rt[WINO_SIZE];
+                        for (int i = 0; i < WINO_SIZE; i++)
+                        {
+                            l[i] = v_load(buf + i*WINO_SIZE);
+                            rt[i] = v_load(buf + i*WINO_SIZE + 4);
+                        }
+                        // A^T*(A^T*M^T)^T = A^T*M*A
+                        transformOutputRows(l);
+                        transformOutputRows(rt);
+                        transpose8x8(l, rt);
+                        transformOutputRows(l);
+                        transformOutputRows(rt);
+
+                        v_float32x4 vbias = v_setall_f32(biasptr[oc]), z = v_setzero_f32();
+                        v_float32x4 vslope = v_setall_f32(reluptr ? reluptr[oc] : 1.f);
+                        for (int i = 0; i < TILE_SIZE; i++)
+                        {
+                            l[i] += vbias;
+                            rt[i] += vbias;
+                            if (reluptr)
+                            {
+                                l[i] = v_select(l[i] > z, l[i], l[i]*vslope);
+                                rt[i] = v_select(rt[i] > z, rt[i], rt[i]*vslope);
+                            }
+                        }
+
+                        float* outptr = outptr0 + (size_t)oc*outPlaneSize + y0*outW + x0;
+                        if (ylimit == TILE_SIZE && xlimit == TILE_SIZE)
+                        {
+                            for (int i = 0; i < TILE_SIZE; i++)
+                            {
+                                v_store(outptr + i*outW, l[i]);
+                                v_store_low(outptr + i*outW + 4, rt[i]);
+                            }
+                        }
+                        else
+                        {
+                            for (int i = 0; i < ylimit; i++)
+                            {
+                                v_store(buf, l[i]);
+                                v_store(buf + 4, rt[i]);
+                                for (int j = 0; j < xlimit; j++)
+                                    outptr[i*outW + j] = buf[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // Direct depth-wise convolution with arbitrary kernel size, strides, dilations and paddings.
+    class ParallelDepthwiseConv : public cv::ParallelLoopBody
+    {
+    public:
+        const Mat* input_;
+        const Mat* weights_;
+        Mat* output_;
+        std::vector<size_t> kernel_size, pads_begin, strides, dilations;
+        const std::vector<float>* biasvec_;
+        const std::vector<float>* reluslope_;
+        const ActivationLayer* activ_;
+        const Mat* residual_;
+
+        ParallelDepthwiseConv()
+            : input_(0), weights_(0), output_(0), biasvec_(0), reluslope_(0), activ_(0), residual_(0)
+        {}
+
+        static void run(const Mat& input, Mat& output, const Mat& weights,
+                        const std::vector<float>& biasvec, const std::vector<float>& reluslope,
+                        const std::vector<size_t>& kernel_size, const std::vector<size_t>& strides,
+                        const std::vector<size_t>& pads_begin, const std::vector<size_t>& dilations,
+                        const ActivationLayer* activ, const Mat* residual, int nstripes)
+        {
+            CV_Assert_N(input.dims == 4, output.dims == 4, input.type() == CV_32F, output.type() == CV_32F,
+                        input.isContinuous(), output.isContinuous(), input.size[1] == output.size[1],
+                        weights.rows == output.size[1], weights.cols == (int)(kernel_size[0]*kernel_size[1]));
+            CV_Assert(!residual || (residual->size == output.size && residual->type() == output.type() &&
+                                    residual->isContinuous()));
+            ParallelDepthwiseConv p;
+            p.input_ = &input;
+            p.weights_ = &weights;
+            p.output_ = &output;
+            p.kernel_size = kernel_size; p.strides = strides; p.dilations = dilations;
+            p.pads_begin = pads_begin;
+            p.biasvec_ = &biasvec;
+            p.reluslope_ = &reluslope;
+            p.activ_ = reluslope.empty() ? activ : 0;
+            p.residual_ = residual;
+
+            int nplanes = output.size[0]*output.size[1];
+            parallel_for_(Range(0, nplanes), p, std::min(nstripes, nplanes));
+        }
+
+        virtual void operator ()(const Range &r) const CV_OVERRIDE
+        {
+            const int channels = input_->size[1], height = input_->size[2], width = input_->size[3];
+            const int outH = output_->size[2], outW = output_->size[3];
+            const int kernel_h = (int)kernel_size[0], kernel_w = (int)kernel_size[1];
+            const int stride_h = (int)strides[0], stride_w = (int)strides[1];
+            const int dilation_h = (int)dilations[0], dilation_w = (int)dilations[1];
+            const int pad_t = (int)pads_begin[0], pad_l = (int)pads_begin[1];
+            const int inpPlaneSize = height*width, outPlaneSize = outH*outW;
+
+            // the range of output columns for every kernel column, which don't involve padding
+            std::vector<int> xstart(kernel_w), xend(kernel_w);
+            for (int kx = 0; kx < kernel_w; kx++)
+            {
+                int ofs = kx*dilation_w - pad_l;
+                xstart[kx] = ofs >= 0 ? 0 : (-ofs + stride_w - 1)/stride_w;
+                xend[kx] = width - 1 - ofs < 0 ? 0 : std::min((width - 1 - ofs)/stride_w + 1, outW);
+                xstart[kx] = std::min(xstart[kx], xend[kx]);
+            }
+
+            for (int plane = r.start; plane < r.end; plane++)
+            {
+                const int c = plane % channels;
+                const float* inptr = input_->ptr<float>() + (size_t)plane*inpPlaneSize;
+                float* outptr = output_->ptr<float>() + (size_t)plane*outPlaneSize;
+                const float* wptr = weights_->ptr<float>(c);
+                const float bias = biasvec_->at(c);
+                const float slope = reluslope_->empty() ? 1.f : reluslope_->at(c);
+
+                for (int y = 0; y < outH; y++)
+                {
+                    float* out = outptr + y*outW;
+                    for (int x = 0; x < outW; x++)
+                        out[x] = bias;
+
+                    for (int ky = 0; ky < kernel_h; ky++)
+                    {
+                        const int iy = y*stride_h - pad_t + ky*dilation_h;
+                        if ((unsigned)iy >= (unsigned)height)
+                            continue;
+                        for (int kx = 0; kx < kernel_w; kx++)
+                        {
+                            const float w = wptr[ky*kernel_w + kx];
+                            const float* inrow = inptr + iy*width + kx*dilation_w - pad_l;
+                            int x = xstart[kx], x1 = xend[kx];
+                        #if CV_SIMD
+                            const int nlanes = v_float32::nlanes;
+                            v_float32 vw = vx_setall_f32(w);
+                            if (stride_w == 1)
+                            {
+                                for (; x <= x1 - nlanes; x += nlanes)
+                                    v_store(out + x, v_fma(vx_load(inrow + x), vw, vx_load(out + x)));
+                            }
+                            else if (stride_w == 2)
+                            {
+                                // the last odd element may be out of the row
+                                for (; x <= x1 - nlanes - 1; x += nlanes)
+                                {
+                                    v_float32 v0, v1;
+                                    v_load_deinterleave(inrow + x*2, v0, v1);
+                                    v_store(out + x, v_fma(v0, vw, vx_load(out + x)));
+                                }
+                            }
+                        #endif
+                            for (; x < x1; x++)
+                                out[x] += w*inrow[x*stride_w];
+                        }
+                    }
+
+                    if (!reluslope_->empty())
+                    {
+                        for (int x = 0; x < outW; x++)
+                            out[x] = out[x] > 0.f ? out[x] : out[x]*slope;
+                    }
+                }
+
+                if (residual_)
+                    addResidual(outptr, residual_->ptr<float>() + (size_t)plane*outPlaneSize, outPlaneSize);
+                if (activ_)
+                    activ_->forwardSlice(outptr, outptr, outPlaneSize, outPlaneSize, c, c + 1);
+            }
+        }
+    };
+
 #ifdef HAVE_OPENCL
     bool forward_ocl(InputArrayOfArrays inps, OutputArrayOfArrays outs, OutputArrayOfArrays internals)
     {
@@ -1896,8 +2441,12 @@ public:
         int ngroups = inputs[0].size[1] / inpGroupCn;
         CV_Assert(outputs[0].size[1] % ngroups == 0);
 
+        CV_Assert(!fusedAdd || inputs.size() == 2);
+        const Mat* residual = fusedAdd ? &inputs[1] : 0;
+
         reluslope.clear();
-        if( activ )
+        // with fused eltwise sum the activation is applied after the sum
+        if( activ && !fusedAdd )
         {
             Ptr<ReLULayer> activ_relu = activ.dynamicCast<ReLULayer>();
             if( !activ_relu.empty() )
@@ -1958,7 +2507,7 @@ public:
                    pad.height,  pad.width, dilation.height, dilation.width,
                    weightsMat.step1(), padMode.c_str() ,tengine_graph);*/
         }
-        if(NULL != tengine_graph)
+        if(NULL != tengine_graph && !fusedAdd)
         {
             tengine_ret = tengine_forward(tengine_graph);
         }
@@ -1975,8 +2524,21 @@ public:
         {
             int nstripes = std::max(getNumThreads(), 1);
 
-            ParallelConv::run(inputs[0], outputs[0], weightsMat, biasvec, reluslope,
-                            kernel_size, strides, pads_begin, pads_end, dilations, activ.get(), ngroups, nstripes);
+            if (useWinograd && !blobs.empty())
+            {
+                if (weightsWinograd.empty())
+                    ParallelWinograd::transformWeights(weightsMat, inputs[0].size[1], weightsWinograd);
+                ParallelWinograd::run(inputs[0], outputs[0], weightsWinograd, biasvec, reluslope,
+                                      pads_begin, activ.get(), residual, nstripes);
+            }
+            else if (useDepthwise && !blobs.empty())
+            {
+                ParallelDepthwiseConv::run(inputs[0], outputs[0], weightsMat, biasvec, reluslope,
+                                           kernel_size, strides, pads_begin, dilations, activ.get(), residual, nstripes);
+            }
+            else
+                ParallelConv::run(inputs[0], outputs[0], weightsMat, biasvec, reluslope,
+                                kernel_size, strides, pads_begin, pads_end, dilations, activ.get(), residual, ngroups, nstripes);
         }
 #if CV_SSE3
         _MM_SET_FLUSH_ZERO_MODE(ftzMode);
@@ -2068,6 +2630,38 @@ public:
     }
 #endif
 
+    virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                             const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE
+    {
+        // weights are quantized per output channel, bias is converted to INT32 accumulator scale
+        if (blobs.empty() || blobs[0].dims != 4 || scales[0].size() != 1 || scales[1].size() != 1)
+            return false;
+
+        Mat weightsInt8;
+        std::vector<float> weightsScales;
+        quantizeWeightsPerChannel(blobs[0], weightsInt8, weightsScales);
+
+        const float inputScale = scales[0][0], outputScale = scales[1][0];
+        Mat biasInt32(1, numOutput, CV_32S), outputMultiplier(1, numOutput, CV_32F);
+        for (int i = 0; i < numOutput; i++)
+        {
+            const float biasScale = inputScale * weightsScales[i];
+            biasInt32.at<int>(i) = hasBias() ? cvRound(blobs[1].ptr<float>()[i] / biasScale) : 0;
+            outputMultiplier.at<float>(i) = biasScale / outputScale;
+        }
+
+        params.type = "ConvolutionInt8";
+        params.blobs.clear();
+        params.blobs.push_back(weightsInt8);
+        params.blobs.push_back(biasInt32);
+        params.blobs.push_back(outputMultiplier);
+        params.set("input_scale", inputScale);
+        params.set("input_zeropoint", zeropoints[0][0]);
+        params.set("output_scale", outputScale);
+        params.set("output_zeropoint", zeropoints[1][0]);
+        return true;
+    }
+
     virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
                            const std::vector<MatShape> &outputs) const CV_OVERRIDE
     {
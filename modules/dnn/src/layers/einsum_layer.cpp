@@ -0,0 +1,420 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class EinsumLayerImpl CV_FINAL : public EinsumLayer
+{
+public:
+    // Labels are ASCII codes of letters so implicit output is sorted as in numpy.
+    // Dimensions covered by ellipsis get labels starting from ELLIPSIS_LABEL.
+    enum { ELLIPSIS = -1, ELLIPSIS_LABEL = 128 };
+
+    EinsumLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        equation = params.get<String>("equation");
+
+        std::string lhs = equation, rhs;
+        size_t arrow = equation.find("->");
+        explicitOutput = arrow != std::string::npos;
+        if (explicitOutput)
+        {
+            lhs = equation.substr(0, arrow);
+            rhs = equation.substr(arrow + 2);
+        }
+
+        size_t start = 0;
+        for (;;)
+        {
+            size_t comma = lhs.find(',', start);
+            inputTerms.push_back(parseTerm(lhs.substr(start, comma == std::string::npos ? comma : comma - start)));
+            if (comma == std::string::npos)
+                break;
+            start = comma + 1;
+        }
+        if (explicitOutput)
+            outputTerm = parseTerm(rhs);
+    }
+
+    std::vector<int> parseTerm(const std::string& term) const
+    {
+        std::vector<int> labels;
+        for (size_t i = 0; i < term.size(); i++)
+        {
+            const char c = term[i];
+            if (c == ' ')
+                continue;
+            if (c == '.')
+            {
+                if (term.compare(i, 3, "...") != 0)
+                    CV_Error(Error::StsParseError, "Invalid Einsum equation: " + equation);
+                labels.push_back(ELLIPSIS);
+                i += 2;
+            }
+            else if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'))
+                labels.push_back(c);
+            else
+                CV_Error(Error::StsParseError, "Invalid Einsum equation: " + equation);
+        }
+        return labels;
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    // Replaces ellipsis by labels of dimensions (aligned to the right as in broadcasting)
+    // and collects sizes of all the labels.
+    void resolveLabels(const std::vector<MatShape>& inputs, std::vector<std::vector<int> >& inputLabels,
+                       std::vector<int>& outputLabels, std::map<int, int>& sizes) const
+    {
+        CV_CheckEQ(inputs.size(), inputTerms.size(), "Number of Einsum inputs doesn't match the equation");
+        int numEllipsisDims = 0;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            const std::vector<int>& term = inputTerms[i];
+            bool hasEllipsis = std::find(term.begin(), term.end(), (int)ELLIPSIS) != term.end();
+            const int numExplicit = (int)term.size() - (int)hasEllipsis;
+            if (hasEllipsis)
+                numEllipsisDims = std::max(numEllipsisDims, (int)inputs[i].size() - numExplicit);
+            else
+                CV_CheckEQ((int)inputs[i].size(), numExplicit, "Number of dimensions doesn't match the Einsum equation");
+        }
+
+        inputLabels.resize(inputs.size());
+        sizes.clear();
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            const std::vector<int>& term = inputTerms[i];
+            std::vector<int>& labels = inputLabels[i];
+            labels.clear();
+            const int numCovered = (int)inputs[i].size() - (int)term.size() + 1;
+            for (size_t j = 0; j < term.size(); j++)
+            {
+                if (term[j] != ELLIPSIS)
+                {
+                    labels.push_back(term[j]);
+                    continue;
+                }
+                CV_CheckGE(numCovered, 0, "");
+                for (int k = 0; k < numCovered; k++)
+                    labels.push_back(ELLIPSIS_LABEL + numEllipsisDims - numCovered + k);
+            }
+            for (size_t j = 0; j < labels.size(); j++)
+            {
+                if (std::count(labels.begin(), labels.end(), labels[j]) != 1)
+                    CV_Error(Error::StsNotImplemented, "Repeated labels in Einsum operands are not supported: " + equation);
+                std::map<int, int>::iterator it = sizes.find(labels[j]);
+                if (it == sizes.end())
+                    sizes[labels[j]] = inputs[i][j];
+                else if (it->second != inputs[i][j])
+                    CV_Error(Error::StsBadSize, format("Einsum operands have different sizes of dimension '%c': %d vs %d "
+                                                       "(broadcasting is not supported)",
+                                                       labels[j] < ELLIPSIS_LABEL ? (char)labels[j] : '.',
+                                                       it->second, inputs[i][j]));
+            }
+        }
+
+        outputLabels.clear();
+        if (explicitOutput)
+        {
+            for (size_t j = 0; j < outputTerm.size(); j++)
+            {
+                if (outputTerm[j] == ELLIPSIS)
+                {
+                    for (int k = 0; k < numEllipsisDims; k++)
+                        outputLabels.push_back(ELLIPSIS_LABEL + k);
+                }
+                else
+                {
+                    CV_Assert(sizes.find(outputTerm[j]) != sizes.end());
+                    outputLabels.push_back(outputTerm[j]);
+                }
+            }
+        }
+        else
+        {
+            // broadcasted dimensions and the labels which appear once in alphabetical order
+            for (int k = 0; k < numEllipsisDims; k++)
+                outputLabels.push_back(ELLIPSIS_LABEL + k);
+            for (std::map<int, int>::const_iterator it = sizes.begin(); it != sizes.end(); ++it)
+            {
+                if (it->first >= ELLIPSIS_LABEL)
+                    continue;
+                int count = 0;
+                for (size_t i = 0; i < inputLabels.size(); i++)
+                    count += (int)std::count(inputLabels[i].begin(), inputLabels[i].end(), it->first);
+                if (count == 1)
+                    outputLabels.push_back(it->first);
+            }
+        }
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        std::vector<std::vector<int> > inputLabels;
+        std::vector<int> outputLabels;
+        std::map<int, int> sizes;
+        resolveLabels(inputs, inputLabels, outputLabels, sizes);
+
+        MatShape outShape;
+        for (size_t i = 0; i < outputLabels.size(); i++)
+            outShape.push_back(sizes[outputLabels[i]]);
+        if (outShape.empty())
+            outShape.push_back(1);
+        outputs.assign(1, outShape);
+        return false;
+    }
+
+    // unlike total() returns 1 for scalars
+    static int product(const MatShape& shape, size_t start, size_t end)
+    {
+        int p = 1;
+        for (size_t i = start; i < end; i++)
+            p *= shape[i];
+        return p;
+    }
+
+    // Operand with data stored as a continuous buffer, dimensions are marked by labels
+    struct Operand
+    {
+        Mat data;
+        MatShape shape;
+        std::vector<int> labels;
+    };
+
+    // Transposes operand to the specified order of labels
+    static Operand permute(const Operand& src, const std::vector<int>& labels)
+    {
+        CV_Assert(labels.size() == src.labels.size());
+        const int dims = (int)labels.size();
+        std::vector<int> order(dims);
+        bool identity = true;
+        for (int i = 0; i < dims; i++)
+        {
+            order[i] = (int)(std::find(src.labels.begin(), src.labels.end(), labels[i]) - src.labels.begin());
+            CV_Assert(order[i] < dims);
+            identity &= order[i] == i;
+        }
+
+        Operand dst;
+        dst.labels = labels;
+        for (int i = 0; i < dims; i++)
+            dst.shape.push_back(src.shape[order[i]]);
+        if (identity || src.data.total() <= 1)
+        {
+            dst.data = src.data;
+            return dst;
+        }
+
+        std::vector<size_t> srcSteps(dims);
+        for (int i = dims - 1, step = 1; i >= 0; i--)
+        {
+            srcSteps[i] = step;
+            step *= src.shape[i];
+        }
+
+        dst.data.create(1, (int)src.data.total(), CV_32F);
+        const float* srcData = src.data.ptr<float>();
+        float* dstData = dst.data.ptr<float>();
+        const int width = dst.shape[dims - 1];
+        const size_t innerStep = srcSteps[order[dims - 1]];
+        const int numRows = (int)(dst.data.total() / width);
+        for (int row = 0; row < numRows; row++)
+        {
+            size_t offset = 0;
+            for (int i = dims - 2, idx = row; i >= 0; i--)
+            {
+                offset += (idx % dst.shape[i]) * srcSteps[order[i]];
+                idx /= dst.shape[i];
+            }
+            float* dstRow = dstData + (size_t)row * width;
+            for (int j = 0; j < width; j++)
+                dstRow[j] = srcData[offset + j * innerStep];
+        }
+        return dst;
+    }
+
+    // Sums out the dimensions which labels are not in the list to keep
+    static Operand reduce(const Operand& src, const std::vector<int>& keep)
+    {
+        std::vector<int> kept, reduced;
+        for (size_t i = 0; i < src.labels.size(); i++)
+        {
+            if (std::find(keep.begin(), keep.end(), src.labels[i]) != keep.end())
+                kept.push_back(src.labels[i]);
+            else
+                reduced.push_back(src.labels[i]);
+        }
+        if (reduced.empty())
+            return src;
+
+        std::vector<int> labels = kept;
+        labels.insert(labels.end(), reduced.begin(), reduced.end());
+        Operand tmp = permute(src, labels);
+
+        Operand dst;
+        dst.labels = kept;
+        dst.shape.assign(tmp.shape.begin(), tmp.shape.begin() + kept.size());
+        const int rows = product(dst.shape, 0, dst.shape.size());
+        Mat sums;
+        cv::reduce(tmp.data.reshape(1, rows), sums, 1, REDUCE_SUM, CV_32F);
+        dst.data = sums.reshape(1, 1);
+        return dst;
+    }
+
+    class BatchedGemmInvoker : public ParallelLoopBody
+    {
+    public:
+        enum { BLOCK_M = 16 };
+        const float *a_, *b_;
+        float* c_;
+        int M_, N_, K_, mblocks_;
+
+        BatchedGemmInvoker(const float* a, const float* b, float* c, int M, int N, int K)
+            : a_(a), b_(b), c_(c), M_(M), N_(N), K_(K), mblocks_((M + BLOCK_M - 1) / BLOCK_M) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            for (int task = r.start; task < r.end; task++)
+            {
+                const int batch = task / mblocks_;
+                const int m0 = (task % mblocks_) * BLOCK_M, m1 = std::min(m0 + BLOCK_M, M_);
+                fastGemm(a_ + ((size_t)batch * M_ + m0) * K_, K_, b_ + (size_t)batch * K_ * N_, N_,
+                         c_ + ((size_t)batch * M_ + m0) * N_, N_, m1 - m0, K_, N_);
+            }
+        }
+    };
+
+    // Contracts two operands keeping only the specified labels and the common ones
+    static Operand contract(const Operand& x, const Operand& y, const std::vector<int>& keep)
+    {
+        std::vector<int> xkeep = keep, ykeep = keep;
+        xkeep.insert(xkeep.end(), y.labels.begin(), y.labels.end());
+        ykeep.insert(ykeep.end(), x.labels.begin(), x.labels.end());
+        Operand a = reduce(x, xkeep), b = reduce(y, ykeep);
+
+        // batch dimensions are in both operands and in the result,
+        // inner ones are contracted, the rest belong to a single operand
+        std::vector<int> batchLabels, innerLabels, aLabels, bLabels;
+        for (size_t i = 0; i < a.labels.size(); i++)
+        {
+            const int label = a.labels[i];
+            if (std::find(b.labels.begin(), b.labels.end(), label) == b.labels.end())
+                aLabels.push_back(label);
+            else if (std::find(keep.begin(), keep.end(), label) != keep.end())
+                batchLabels.push_back(label);
+            else
+                innerLabels.push_back(label);
+        }
+        for (size_t i = 0; i < b.labels.size(); i++)
+        {
+            if (std::find(a.labels.begin(), a.labels.end(), b.labels[i]) == a.labels.end())
+                bLabels.push_back(b.labels[i]);
+        }
+
+        std::vector<int> order = batchLabels;
+        order.insert(order.end(), aLabels.begin(), aLabels.end());
+        order.insert(order.end(), innerLabels.begin(), innerLabels.end());
+        a = permute(a, order);
+
+        order = batchLabels;
+        order.insert(order.end(), innerLabels.begin(), innerLabels.end());
+        order.insert(order.end(), bLabels.begin(), bLabels.end());
+        b = permute(b, order);
+
+        const int nbatch = (int)batchLabels.size(), na = (int)aLabels.size(), ninner = (int)innerLabels.size();
+        const int numBatches = product(a.shape, 0, nbatch);
+        const int M = product(a.shape, nbatch, nbatch + na);
+        const int K = product(a.shape, nbatch + na, a.shape.size());
+        const int N = product(b.shape, nbatch + ninner, b.shape.size());
+
+        Operand dst;
+        dst.labels = batchLabels;
+        dst.labels.insert(dst.labels.end(), aLabels.begin(), aLabels.end());
+        dst.labels.insert(dst.labels.end(), bLabels.begin(), bLabels.end());
+        dst.shape.assign(a.shape.begin(), a.shape.begin() + nbatch + na);
+        dst.shape.insert(dst.shape.end(), b.shape.begin() + nbatch + ninner, b.shape.end());
+        dst.data.create(1, numBatches * M * N, CV_32F);
+
+        BatchedGemmInvoker invoker(a.data.ptr<float>(), b.data.ptr<float>(), dst.data.ptr<float>(), M, N, K);
+        parallel_for_(Range(0, numBatches * invoker.mblocks_), invoker);
+        return dst;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        std::vector<MatShape> inpShapes(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_32F, "");
+            CV_Assert(inputs[i].isContinuous());
+            inpShapes[i] = shape(inputs[i]);
+        }
+
+        std::vector<std::vector<int> > inputLabels;
+        std::vector<int> outputLabels;
+        std::map<int, int> sizes;
+        resolveLabels(inpShapes, inputLabels, outputLabels, sizes);
+
+        std::vector<Operand> operands(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            operands[i].data = inputs[i].reshape(1, 1);
+            operands[i].shape = inpShapes[i];
+            operands[i].labels = inputLabels[i];
+        }
+
+        Operand result = operands[0];
+        for (size_t i = 1; i < operands.size(); i++)
+        {
+            // labels are required by the output or by the rest operands
+            std::vector<int> keep = outputLabels;
+            for (size_t j = i + 1; j < operands.size(); j++)
+                keep.insert(keep.end(), operands[j].labels.begin(), operands[j].labels.end());
+            result = contract(result, operands[i], keep);
+        }
+        result = permute(reduce(result, outputLabels), outputLabels);
+
+        CV_Assert(result.data.total() == outputs[0].total());
+        result.data.reshape(1, outputs[0].dims, outputs[0].size.p).copyTo(outputs[0]);
+    }
+
+private:
+    std::vector<std::vector<int> > inputTerms;
+    std::vector<int> outputTerm;
+    bool explicitOutput;
+};
+
+Ptr<EinsumLayer> EinsumLayer::create(const LayerParams& params)
+{
+    return Ptr<EinsumLayer>(new EinsumLayerImpl(params));
+}
+
+}
+}
@@ -851,6 +851,155 @@ struct MishFunctor : public BaseFunctor
     int64 getFLOPSPerElement() const { return 3; }
 };
 
+struct GeluFunctor : public BaseFunctor
+{
+    typedef GeluLayer Layer;
+    bool approximate;
+
+    explicit GeluFunctor(bool approximate_ = false) : approximate(approximate_) {}
+
+    bool supportBackend(int backendId, int)
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    void apply(const float* srcptr, float* dstptr, int len, size_t planeSize, int cn0, int cn1) const
+    {
+        // sqrt(2 / pi) and 1 / sqrt(2)
+        const float tanhScale = 0.7978845608028654f, erfScale = 0.7071067811865476f;
+        for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
+        {
+            if (approximate)
+            {
+                for( int i = 0; i < len; i++ )
+                {
+                    float x = srcptr[i];
+                    dstptr[i] = 0.5f * x * (1.f + tanh(tanhScale * (x + 0.044715f * x * x * x)));
+                }
+            }
+            else
+            {
+                for( int i = 0; i < len; i++ )
+                {
+                    float x = srcptr[i];
+                    dstptr[i] = 0.5f * x * (1.f + std::erf(x * erfScale));
+                }
+            }
+        }
+    }
+
+#ifdef HAVE_OPENCL
+    bool applyOCL(InputArrayOfArrays, OutputArrayOfArrays, OutputArrayOfArrays)
+    {
+        // TODO: add OpenCL implementation
+        return false;
+    }
+#endif
+
+#ifdef HAVE_CUDA
+    Ptr<BackendNode> initCUDA(int target, csl::Stream stream)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif
+
+#ifdef HAVE_HALIDE
+    void attachHalide(const Halide::Expr& input, Halide::Func& top)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_HALIDE
+
+#ifdef HAVE_DNN_IE_NN_BUILDER_2019
+    InferenceEngine::Builder::Layer initInfEngineBuilderAPI()
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_DNN_IE_NN_BUILDER_2019
+
+#ifdef HAVE_DNN_NGRAPH
+    std::shared_ptr<ngraph::Node> initNgraphAPI(const std::shared_ptr<ngraph::Node>& node)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_DNN_NGRAPH
+
+#ifdef HAVE_VULKAN
+    std::shared_ptr<vkcom::OpBase> initVkCom()
+    {
+        // TODO: add vkcom implementation
+        return std::shared_ptr<vkcom::OpBase>();
+    }
+#endif  // HAVE_VULKAN
+
+    int64 getFLOPSPerElement() const { return 6; }
+};
+
+struct ErfFunctor : public BaseFunctor
+{
+    typedef ErfLayer Layer;
+
+    bool supportBackend(int backendId, int)
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    void apply(const float* srcptr, float* dstptr, int len, size_t planeSize, int cn0, int cn1) const
+    {
+        for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
+        {
+            for( int i = 0; i < len; i++ )
+                dstptr[i] = std::erf(srcptr[i]);
+        }
+    }
+
+#ifdef HAVE_OPENCL
+    bool applyOCL(InputArrayOfArrays, OutputArrayOfArrays, OutputArrayOfArrays)
+    {
+        // TODO: add OpenCL implementation
+        return false;
+    }
+#endif
+
+#ifdef HAVE_CUDA
+    Ptr<BackendNode> initCUDA(int target, csl::Stream stream)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif
+
+#ifdef HAVE_HALIDE
+    void attachHalide(const Halide::Expr& input, Halide::Func& top)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_HALIDE
+
+#ifdef HAVE_DNN_IE_NN_BUILDER_2019
+    InferenceEngine::Builder::Layer initInfEngineBuilderAPI()
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_DNN_IE_NN_BUILDER_2019
+
+#ifdef HAVE_DNN_NGRAPH
+    std::shared_ptr<ngraph::Node> initNgraphAPI(const std::shared_ptr<ngraph::Node>& node)
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_DNN_NGRAPH
+
+#ifdef HAVE_VULKAN
+    std::shared_ptr<vkcom::OpBase> initVkCom()
+    {
+        // TODO: add vkcom implementation
+        return std::shared_ptr<vkcom::OpBase>();
+    }
+#endif  // HAVE_VULKAN
+
+    int64 getFLOPSPerElement() const { return 4; }
+};
+
 struct SigmoidFunctor : public BaseFunctor
 {
     typedef SigmoidLayer Layer;
@@ -1706,6 +1855,24 @@ Ptr<MishLayer> MishLayer::create(const LayerParams& params)
     return l;
 }
 
+Ptr<GeluLayer> GeluLayer::create(const LayerParams& params)
+{
+    bool approximate = toLowerCase(params.get<String>("approximate", "none")) == "tanh";
+    Ptr<GeluLayer> l(new ElementWiseLayer<GeluFunctor>(GeluFunctor(approximate)));
+    l->setParamsFrom(params);
+    l->approximate = approximate;
+
+    return l;
+}
+
+Ptr<ErfLayer> ErfLayer::create(const LayerParams& params)
+{
+    Ptr<ErfLayer> l(new ElementWiseLayer<ErfFunctor>());
+    l->setParamsFrom(params);
+
+    return l;
+}
+
 Ptr<SigmoidLayer> SigmoidLayer::create(const LayerParams& params)
 {
     Ptr<SigmoidLayer> l(new ElementWiseLayer<SigmoidFunctor>());
@@ -864,6 +864,30 @@ public:
     }
 #endif  // HAVE_DNN_NGRAPH
 
+    virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                             const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE
+    {
+        if (op != SUM || channelsModeInput != ELTWISE_CHANNNELS_SAME || hasVecInput || scales[1].size() != 1)
+            return false;
+
+        // sum(c[i] * s[i] * (q[i] - z[i])) / s_out + z_out
+        const size_t ninputs = scales[0].size();
+        const float outputScale = scales[1][0];
+        std::vector<float> coeffsInt8(ninputs);
+        float offset = (float)zeropoints[1][0];
+        for (size_t i = 0; i < ninputs; i++)
+        {
+            const float c = coeffs.empty() ? 1.f : coeffs[i];
+            coeffsInt8[i] = c * scales[0][i] / outputScale;
+            offset -= coeffsInt8[i] * zeropoints[0][i];
+        }
+
+        params.type = "EltwiseInt8";
+        params.set("coeff", DictValue::arrayReal(coeffsInt8.begin(), coeffsInt8.size()));
+        params.set("offset", offset);
+        return true;
+    }
+
     virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
                            const std::vector<MatShape> &outputs) const CV_OVERRIDE
     {
@@ -81,6 +81,7 @@ public:
         setParamsFrom(params);
         bias = params.get<bool>("bias_term", true);
         axis = params.get<int>("axis", 1);
+        fusedAdd = false;
         if (!blobs.empty())
         {
             CV_Assert(1 <= blobs.size() && blobs.size() <= 2);
@@ -159,19 +160,34 @@ public:
         if (activ.empty() || layer.empty())
         {
             activ = layer;
+            if (activ.empty())
+                fusedAdd = false;
             return !activ.empty();
         }
         else
             return false;
     }
 
+    virtual bool tryFuse(Ptr<Layer>& top) CV_OVERRIDE
+    {
+        if (preferableTarget == DNN_TARGET_CPU && !top.dynamicCast<EltwiseLayer>().empty())
+        {
+            // the sum is computed before the activation, so the activation can't be fused earlier
+            if (fusedAdd || !activ.empty() || blobs.empty())
+                return false;
+            fusedAdd = true;
+            return true;
+        }
+        return Layer::tryFuse(top);
+    }
+
     class FullyConnected : public ParallelLoopBody
     {
     public:
-        FullyConnected() : srcMat(0), weights(0), biasMat(0), activ(0), dstMat(0), nstripes(0), useAVX(false), useAVX2(false), useAVX512(false) {}
+        FullyConnected() : srcMat(0), weights(0), biasMat(0), resMat(0), activ(0), dstMat(0), nstripes(0), useAVX(false), useAVX2(false), useAVX512(false) {}
 
         static void run(const Mat& srcMat, const Mat& weights, const Mat& biasMat,
-                        Mat& dstMat, const ActivationLayer* activ, int nstripes)
+                        Mat& dstMat, const ActivationLayer* activ, int nstripes, const Mat* resMat = 0)
         {
             CV_Assert( srcMat.dims == 2 && srcMat.cols == weights.cols &&
                        dstMat.rows == srcMat.rows && dstMat.cols == weights.rows &&
@@ -179,6 +195,7 @@ public:
                        srcMat.type() == CV_32F &&
                        (biasMat.empty() || (biasMat.type() == srcMat.type() &&
                                            biasMat.isContinuous() && (int)biasMat.total() == dstMat.cols)) );
+            CV_Assert(!resMat || (resMat->size == dstMat.size && resMat->type() == dstMat.type()));
 
             FullyConnected p;
 
@@ -186,6 +203,7 @@ public:
             p.weights = &weights;
             p.biasMat = &biasMat;
             p.dstMat = &dstMat;
+            p.resMat = resMat;
             p.nstripes = nstripes;
             p.activ = activ;
             p.useAVX = checkHardwareSupport(CPU_AVX);
@@ -279,6 +297,8 @@ public:
                     }
                 }
 
+                if(resMat)
+                    addResidual(dptr, resMat->ptr<float>(sampleIdx) + delta, nw);
                 if(activ)
                     activ->forwardSlice(dptr, dptr, 1, 1, delta, delta + nw);
 
@@ -286,7 +306,7 @@ public:
             }
         }
 
-        const Mat *srcMat, *weights, *biasMat;
+        const Mat *srcMat, *weights, *biasMat, *resMat;
         const ActivationLayer* activ;
         Mat* dstMat;
         int nstripes;
@@ -481,6 +501,17 @@ public:
             int axisCan = normalize_axis(axis, input[0].dims);
             int outerSize = input[0].total(0, axisCan);
 
+            if (fusedAdd)
+            {
+                // the second input is the operand of fused eltwise sum
+                CV_Assert(input.size() == 2 && output.size() == 1);
+                Mat srcMat = input[0].reshape(1, outerSize);
+                Mat dstMat = output[0].reshape(1, outerSize);
+                Mat resMat = input[1].reshape(1, outerSize);
+                FullyConnected::run(srcMat, weightsMat, biasMat, dstMat, activ.get(), getNumThreads(), &resMat);
+                return;
+            }
+
             for (size_t i = 0; i < input.size(); i++)
             {
                 Mat srcMat = input[i].reshape(1, outerSize);
@@ -492,8 +523,8 @@ public:
         }
         else
         {
-            float* inpData = input[0].ptr<float>();
-            float* weightData = input[1].ptr<float>();
+            const float* inpData = input[0].ptr<float>();
+            const float* weightData = input[1].ptr<float>();
             float* outData = output[0].ptr<float>();
 
             int dims = output[0].dims;
@@ -501,17 +532,14 @@ public:
             int m = input[0].size[dims - 2];
             int n = input[0].size[dims - 1];
             int k = input[1].size[dims - 1];
-            for (int i = 0; i < numSlice; i++)
+            parallel_for_(Range(0, numSlice), [&](const Range& r)
             {
-                Mat inpSlice(m, n, CV_32F, inpData);
-                Mat weightSlice(n, k, CV_32F, weightData);
-                Mat outSlice(m, k, CV_32F, outData);
-
-                outSlice = inpSlice * weightSlice;
-                inpData += inpSlice.total();
-                weightData += weightSlice.total();
-                outData += outSlice.total();
-            }
+                for (int i = r.start; i < r.end; i++)
+                {
+                    fastGemm(inpData + (size_t)i * m * n, n, weightData + (size_t)i * n * k, k,
+                             outData + (size_t)i * m * k, k, m, n, k);
+                }
+            });
         }
     }
 
@@ -611,6 +639,38 @@ public:
     }
 #endif  // HAVE_DNN_NGRAPH
 
+    virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                             const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE
+    {
+        if (blobs.empty() || scales[0].size() != 1 || scales[1].size() != 1)
+            return false;
+
+        Mat weightsInt8;
+        std::vector<float> weightsScales;
+        quantizeWeightsPerChannel(blobs[0], weightsInt8, weightsScales);
+
+        const int numOutput = blobs[0].rows;
+        const float inputScale = scales[0][0], outputScale = scales[1][0];
+        Mat biasInt32(1, numOutput, CV_32S), outputMultiplier(1, numOutput, CV_32F);
+        for (int i = 0; i < numOutput; i++)
+        {
+            const float biasScale = inputScale * weightsScales[i];
+            biasInt32.at<int>(i) = cvRound(biasMat.at<float>(i) / biasScale);
+            outputMultiplier.at<float>(i) = biasScale / outputScale;
+        }
+
+        params.type = "InnerProductInt8";
+        params.blobs.clear();
+        params.blobs.push_back(weightsInt8);
+        params.blobs.push_back(biasInt32);
+        params.blobs.push_back(outputMultiplier);
+        params.set("input_scale", inputScale);
+        params.set("input_zeropoint", zeropoints[0][0]);
+        params.set("output_scale", outputScale);
+        params.set("output_zeropoint", zeropoints[1][0]);
+        return true;
+    }
+
     virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
                            const std::vector<MatShape> &outputs) const CV_OVERRIDE
     {
@@ -630,6 +690,8 @@ public:
     bool bias;
     Mat weightsMat, biasMat;
     Ptr<ActivationLayer> activ;
+    // CPU: the second input (eltwise sum operand) is added to the output before the activation
+    bool fusedAdd;
 };
 
 Ptr<InnerProductLayer> InnerProductLayer::create(const LayerParams& params)
@@ -0,0 +1,158 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class LayerNormLayerImpl CV_FINAL : public LayerNormLayer
+{
+public:
+    LayerNormLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        axis = params.get<int>("axis", -1);
+        epsilon = params.get<float>("epsilon", 1e-5f);
+        CV_Assert(!blobs.empty());
+        hasBias = blobs.size() > 1;
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_CheckEQ(inputs.size(), (size_t)1, "");
+        int cAxis = normalize_axis(axis, inputs[0]);
+        CV_CheckEQ((size_t)total(inputs[0], cAxis), blobs[0].total(), "Scale doesn't match the normalized axes");
+        CV_Assert(!hasBias || blobs[1].total() == blobs[0].total());
+        outputs.assign(1, inputs[0]);
+        return true;
+    }
+
+    class LayerNormInvoker : public ParallelLoopBody
+    {
+    public:
+        const Mat* src_;
+        Mat* dst_;
+        const float* scale_;
+        const float* bias_;
+        float epsilon_;
+        int normSize_;
+
+        LayerNormInvoker(const Mat& src, Mat& dst, const Mat& scale, const Mat& bias, float epsilon, int normSize)
+            : src_(&src), dst_(&dst), scale_(scale.ptr<float>()), bias_(bias.empty() ? 0 : bias.ptr<float>()),
+              epsilon_(epsilon), normSize_(normSize) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int n = normSize_;
+            for (int row = r.start; row < r.end; row++)
+            {
+                const float* x = src_->ptr<float>() + (size_t)row * n;
+                float* y = dst_->ptr<float>() + (size_t)row * n;
+
+                int i = 0;
+                float sum = 0.f;
+#if CV_SIMD
+                v_float32 vsum = vx_setzero_f32();
+                for (; i <= n - v_float32::nlanes; i += v_float32::nlanes)
+                    vsum += vx_load(x + i);
+                sum = v_reduce_sum(vsum);
+#endif
+                for (; i < n; i++)
+                    sum += x[i];
+                const float mean = sum / n;
+
+                // the second pass over the cached row is more accurate than E[x^2] - E[x]^2
+                i = 0;
+                float sqsum = 0.f;
+#if CV_SIMD
+                v_float32 vmean = vx_setall_f32(mean), vsqsum = vx_setzero_f32();
+                for (; i <= n - v_float32::nlanes; i += v_float32::nlanes)
+                {
+                    v_float32 d = vx_load(x + i) - vmean;
+                    vsqsum = v_fma(d, d, vsqsum);
+                }
+                sqsum = v_reduce_sum(vsqsum);
+#endif
+                for (; i < n; i++)
+                {
+                    float d = x[i] - mean;
+                    sqsum += d * d;
+                }
+                const float invStd = 1.f / std::sqrt(sqsum / n + epsilon_);
+
+                i = 0;
+#if CV_SIMD
+                v_float32 vinvStd = vx_setall_f32(invStd);
+                for (; i <= n - v_float32::nlanes; i += v_float32::nlanes)
+                {
+                    v_float32 v = (vx_load(x + i) - vmean) * vinvStd * vx_load(scale_ + i);
+                    if (bias_)
+                        v += vx_load(bias_ + i);
+                    v_store(y + i, v);
+                }
+#endif
+                for (; i < n; i++)
+                    y[i] = (x[i] - mean) * invStd * scale_[i] + (bias_ ? bias_[i] : 0.f);
+            }
+#if CV_SIMD
+            vx_cleanup();
+#endif
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        const Mat& src = inputs[0];
+        Mat& dst = outputs[0];
+        CV_CheckTypeEQ(src.type(), CV_32F, "");
+        CV_Assert(src.isContinuous() && dst.isContinuous());
+
+        int cAxis = normalize_axis(axis, src.dims);
+        int numRows = (int)src.total(0, cAxis);
+        int normSize = (int)src.total(cAxis);
+        parallel_for_(Range(0, numRows), LayerNormInvoker(src, dst, blobs[0], hasBias ? blobs[1] : Mat(), epsilon, normSize),
+                      std::max(1., (double)src.total() / (1 << 14)));
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(outputs); // suppress unused variable warning
+        return 6 * total(inputs[0]);
+    }
+};
+
+Ptr<LayerNormLayer> LayerNormLayer::create(const LayerParams& params)
+{
+    return Ptr<LayerNormLayer>(new LayerNormLayerImpl(params));
+}
+
+}
+}
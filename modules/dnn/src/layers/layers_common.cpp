@@ -42,6 +42,7 @@
 
 #include "../precomp.hpp"
 #include "layers_common.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 namespace cv
 {
@@ -250,5 +251,95 @@ void getConvPoolPaddings(const std::vector<int>& inp, const std::vector<size_t>&
     }
 }
 
+void quantizeWeightsPerChannel(const Mat& weights, Mat& weightsInt8, std::vector<float>& scales)
+{
+    CV_Assert(weights.type() == CV_32F);
+    Mat wm = weights.reshape(1, weights.size[0]);
+    weightsInt8.create(wm.size(), CV_8S);
+    scales.resize(wm.rows);
+    for (int i = 0; i < wm.rows; i++)
+    {
+        double absMax = cv::norm(wm.row(i), NORM_INF);
+        scales[i] = absMax > 0 ? (float)(absMax / 127) : 1.f;
+        wm.row(i).convertTo(weightsInt8.row(i), CV_8S, 1.f / scales[i]);
+    }
+    weightsInt8 = weightsInt8.reshape(1, weights.dims, weights.size.p);
+}
+
+bool hasSameQuantizationParams(const std::vector<std::vector<float> >& scales,
+                               const std::vector<std::vector<int> >& zeropoints)
+{
+    CV_Assert(scales.size() == 2 && zeropoints.size() == 2);
+    const size_t ninputs = scales[0].size();
+    if (ninputs == 0)
+        return false;
+    for (size_t i = 0; i < scales[1].size(); i++)
+    {
+        size_t j = std::min(i, ninputs - 1);
+        if (scales[1][i] != scales[0][j] || zeropoints[1][i] != zeropoints[0][j])
+            return false;
+    }
+    return true;
+}
+
+void addResidual(float* dst, const float* src, int len)
+{
+    int i = 0;
+#if CV_SIMD
+    for (; i <= len - v_float32::nlanes; i += v_float32::nlanes)
+        v_store(dst + i, vx_load(dst + i) + vx_load(src + i));
+#endif
+    for (; i < len; i++)
+        dst[i] += src[i];
+}
+
+void fastGemm(const float* aptr, size_t astep, const float* bptr, size_t bstep,
+              float* cptr, size_t cstep, int ma, int na, int nb)
+{
+#if CV_TRY_AVX512_SKX
+    if (CV_CPU_HAS_SUPPORT_AVX512_SKX)
+    {
+        opt_AVX512_SKX::fastGEMM(aptr, astep, bptr, bstep, cptr, cstep, ma, na, nb);
+        return;
+    }
+#endif
+#if CV_TRY_AVX2
+    if (CV_CPU_HAS_SUPPORT_AVX2)
+    {
+        opt_AVX2::fastGEMM(aptr, astep, bptr, bstep, cptr, cstep, ma, na, nb);
+        return;
+    }
+#endif
+#if CV_TRY_AVX
+    if (CV_CPU_HAS_SUPPORT_AVX)
+    {
+        opt_AVX::fastGEMM(aptr, astep, bptr, bstep, cptr, cstep, ma, na, nb);
+        return;
+    }
+#endif
+    for (int m = 0; m < ma; m++)
+    {
+        const float* arow = aptr + astep*m;
+        float* crow = cptr + cstep*m;
+        memset(crow, 0, nb*sizeof(crow[0]));
+        for (int k = 0; k < na; k++)
+        {
+            const float alpha = arow[k];
+            const float* brow = bptr + bstep*k;
+            int n = 0;
+#if CV_SIMD
+            v_float32 valpha = vx_setall_f32(alpha);
+            for (; n <= nb - v_float32::nlanes; n += v_float32::nlanes)
+                v_store(crow + n, v_fma(valpha, vx_load(brow + n), vx_load(crow + n)));
+#endif
+            for (; n < nb; n++)
+                crow[n] += alpha*brow[n];
+        }
+    }
+#if CV_SIMD
+    vx_cleanup();
+#endif
+}
+
 }
 }
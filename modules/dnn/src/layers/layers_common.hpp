@@ -73,6 +73,21 @@ void getConvPoolOutParams(const std::vector<int>& inp, const std::vector<size_t>
  void getConvPoolPaddings(const std::vector<int>& inp, const std::vector<size_t>& kernel,
                           const std::vector<size_t>& strides, const String &padMode,
                           std::vector<size_t>& pads_begin, std::vector<size_t>& pads_end);
+
+// Symmetric per-output-channel quantization of FP32 weights (every channel is a row of `weights`)
+void quantizeWeightsPerChannel(const Mat& weights, Mat& weightsInt8, std::vector<float>& scales);
+
+// Computes C = A * B for row-major matrices A (ma x na) and B (na x nb) by the dispatched fastGEMM kernels
+void fastGemm(const float* aptr, size_t astep, const float* bptr, size_t bstep,
+              float* cptr, size_t cstep, int ma, int na, int nb);
+
+// dst[i] += src[i], used by fused eltwise sum in epilogues of convolution and fully-connected layers
+void addResidual(float* dst, const float* src, int len);
+
+// Returns true if every output has the same quantization parameters as the corresponding
+// (or the last) input, i.e. layers which only move data may process INT8 blobs as is.
+bool hasSameQuantizationParams(const std::vector<std::vector<float> >& scales,
+                               const std::vector<std::vector<int> >& zeropoints);
 }
 }
 
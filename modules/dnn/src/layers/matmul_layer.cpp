@@ -0,0 +1,214 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class MatMulLayerImpl CV_FINAL : public MatMulLayer
+{
+public:
+    MatMulLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        constInput = blobs.empty() ? -1 : params.get<int>("const_input", 1);
+        CV_Assert(constInput == -1 || constInput == 0 || constInput == 1);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    void getOperandShapes(const std::vector<MatShape> &inputs, MatShape& a, MatShape& b) const
+    {
+        if (constInput == -1)
+        {
+            CV_CheckEQ(inputs.size(), (size_t)2, "");
+            a = inputs[0];
+            b = inputs[1];
+        }
+        else
+        {
+            CV_CheckEQ(inputs.size(), (size_t)1, "");
+            a = constInput == 0 ? shape(blobs[0]) : inputs[0];
+            b = constInput == 0 ? inputs[0] : shape(blobs[0]);
+        }
+    }
+
+    // Computes shape of the output and shapes of the operands as batches of matrices
+    // with the same number of dimensions.
+    static MatShape getOutputShape(MatShape a, MatShape b, MatShape* aBatched = 0, MatShape* bBatched = 0)
+    {
+        CV_Assert(!a.empty() && !b.empty());
+        const bool aIsVector = a.size() == 1, bIsVector = b.size() == 1;
+        if (aIsVector)
+            a.insert(a.begin(), 1);
+        if (bIsVector)
+            b.push_back(1);
+        CV_CheckEQ(a.back(), b[b.size() - 2], "Inner dimensions of MatMul operands must be equal");
+
+        const int dims = (int)std::max(a.size(), b.size());
+        a.insert(a.begin(), dims - a.size(), 1);
+        b.insert(b.begin(), dims - b.size(), 1);
+
+        MatShape out(dims);
+        for (int i = 0; i < dims - 2; i++)
+        {
+            if (a[i] != b[i] && a[i] != 1 && b[i] != 1)
+                CV_Error(Error::StsBadSize, format("MatMul operands can't be broadcasted by axis %d: %d vs %d", i, a[i], b[i]));
+            out[i] = std::max(a[i], b[i]);
+        }
+        out[dims - 2] = a[dims - 2];
+        out[dims - 1] = b[dims - 1];
+        if (aBatched)
+            *aBatched = a;
+        if (bBatched)
+            *bBatched = b;
+
+        if (bIsVector)
+            out.pop_back();
+        if (aIsVector)
+            out.erase(out.end() - (bIsVector ? 1 : 2));
+        if (out.empty())
+            out.push_back(1);
+        return out;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        MatShape a, b;
+        getOperandShapes(inputs, a, b);
+        outputs.assign(1, getOutputShape(a, b));
+        return false;
+    }
+
+    class MatMulInvoker : public ParallelLoopBody
+    {
+    public:
+        enum { BLOCK_M = 16, BLOCK_N = 256 };
+
+        const float* a_;
+        const float* b_;
+        float* c_;
+        const std::vector<size_t>* aOffsets_;
+        const std::vector<size_t>* bOffsets_;
+        int M_, N_, K_, mblocks_, nblocks_;
+
+        MatMulInvoker(const float* a, const float* b, float* c,
+                      const std::vector<size_t>& aOffsets, const std::vector<size_t>& bOffsets,
+                      int M, int N, int K)
+            : a_(a), b_(b), c_(c), aOffsets_(&aOffsets), bOffsets_(&bOffsets), M_(M), N_(N), K_(K)
+        {
+            mblocks_ = (M + BLOCK_M - 1) / BLOCK_M;
+            nblocks_ = (N + BLOCK_N - 1) / BLOCK_N;
+        }
+
+        int getNumTasks() const { return (int)aOffsets_->size() * mblocks_ * nblocks_; }
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            for (int task = r.start; task < r.end; task++)
+            {
+                int nb = task % nblocks_;
+                int mb = (task / nblocks_) % mblocks_;
+                int batch = task / (nblocks_ * mblocks_);
+                int m0 = mb * BLOCK_M, m1 = std::min(m0 + BLOCK_M, M_);
+                int n0 = nb * BLOCK_N, n1 = std::min(n0 + BLOCK_N, N_);
+
+                const float* aptr = a_ + (*aOffsets_)[batch] + (size_t)m0 * K_;
+                const float* bptr = b_ + (*bOffsets_)[batch] + n0;
+                float* cptr = c_ + (size_t)batch * M_ * N_ + (size_t)m0 * N_ + n0;
+                fastGemm(aptr, K_, bptr, N_, cptr, N_, m1 - m0, K_, n1 - n0);
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        Mat a, b;
+        if (constInput == -1)
+        {
+            a = inputs[0];
+            b = inputs[1];
+        }
+        else
+        {
+            a = constInput == 0 ? blobs[0] : inputs[0];
+            b = constInput == 0 ? inputs[0] : blobs[0];
+        }
+        CV_CheckTypeEQ(a.type(), CV_32F, "");
+        CV_CheckTypeEQ(b.type(), CV_32F, "");
+        CV_Assert(a.isContinuous() && b.isContinuous() && outputs[0].isContinuous());
+
+        MatShape aShape, bShape;
+        MatShape outShape = getOutputShape(shape(a), shape(b), &aShape, &bShape);
+        CV_Assert(total(outShape) == outputs[0].total());
+
+        const int dims = (int)aShape.size();
+        const int M = aShape[dims - 2], K = aShape[dims - 1], N = bShape[dims - 1];
+
+        // offsets of matrices of every batch with broadcasting
+        int numBatches = 1;
+        std::vector<size_t> aOffsets(1, 0), bOffsets(1, 0);
+        size_t aStep = (size_t)M * K, bStep = (size_t)K * N;
+        for (int i = dims - 3; i >= 0; i--)
+        {
+            const int n = std::max(aShape[i], bShape[i]);
+            std::vector<size_t> aOffsetsNew(numBatches * n), bOffsetsNew(numBatches * n);
+            for (int j = 0; j < n; j++)
+            {
+                for (int k = 0; k < numBatches; k++)
+                {
+                    aOffsetsNew[j * numBatches + k] = aOffsets[k] + (aShape[i] == 1 ? 0 : j * aStep);
+                    bOffsetsNew[j * numBatches + k] = bOffsets[k] + (bShape[i] == 1 ? 0 : j * bStep);
+                }
+            }
+            aOffsets.swap(aOffsetsNew);
+            bOffsets.swap(bOffsetsNew);
+            aStep *= aShape[i];
+            bStep *= bShape[i];
+            numBatches *= n;
+        }
+
+        MatMulInvoker invoker(a.ptr<float>(), b.ptr<float>(), outputs[0].ptr<float>(), aOffsets, bOffsets, M, N, K);
+        parallel_for_(Range(0, invoker.getNumTasks()), invoker);
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        MatShape a, b;
+        getOperandShapes(inputs, a, b);
+        return 2 * total(outputs[0]) * a.back();
+    }
+};
+
+Ptr<MatMulLayer> MatMulLayer::create(const LayerParams& params)
+{
+    return Ptr<MatMulLayer>(new MatMulLayerImpl(params));
+}
+
+}
+}
@@ -1327,6 +1327,22 @@ public:
         return true;
     }
 
+    virtual bool tryQuantize(const std::vector<std::vector<float> > &scales,
+                             const std::vector<std::vector<int> > &zeropoints, LayerParams& params) CV_OVERRIDE
+    {
+        // INT8 max pooling doesn't compute indices, the second output must be unused
+        if ((type != MAX && type != AVE) || kernel_size.size() != 2 ||
+            scales[0].size() != 1 || scales[1].size() != 1)
+            return false;
+
+        params.type = "PoolingInt8";
+        params.set("input_scale", scales[0][0]);
+        params.set("input_zeropoint", zeropoints[0][0]);
+        params.set("output_scale", scales[1][0]);
+        params.set("output_zeropoint", zeropoints[1][0]);
+        return true;
+    }
+
     virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
                            const std::vector<MatShape> &outputs) const CV_OVERRIDE
     {
@@ -0,0 +1,147 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "layers_common.hpp"
+
+namespace cv
+{
+namespace dnn
+{
+
+class WhereLayerImpl CV_FINAL : public WhereLayer
+{
+public:
+    WhereLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    static MatShape broadcastShapes(const std::vector<MatShape>& inputs)
+    {
+        size_t dims = 0;
+        for (size_t i = 0; i < inputs.size(); i++)
+            dims = std::max(dims, inputs[i].size());
+        MatShape out(dims, 1);
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            const size_t shift = dims - inputs[i].size();
+            for (size_t j = 0; j < inputs[i].size(); j++)
+            {
+                int& dst = out[shift + j];
+                const int src = inputs[i][j];
+                if (src != dst && src != 1 && dst != 1)
+                    CV_Error(Error::StsBadSize, format("Inputs of Where can't be broadcasted by axis %d: %d vs %d",
+                                                       (int)(shift + j), src, dst));
+                if (src != 1)
+                    dst = src;
+            }
+        }
+        return out;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_CheckEQ(inputs.size(), (size_t)3, "");
+        outputs.assign(1, broadcastShapes(inputs));
+        return false;
+    }
+
+    class WhereInvoker : public ParallelLoopBody
+    {
+    public:
+        const float* src_[3];
+        // element steps of inputs by every output dimension, zeros for broadcasted ones
+        std::vector<size_t> steps_[3];
+        MatShape outShape_;
+        float* dst_;
+
+        WhereInvoker(const std::vector<Mat>& inputs, Mat& dst)
+            : outShape_(shape(dst)), dst_(dst.ptr<float>())
+        {
+            const int dims = (int)outShape_.size();
+            for (int k = 0; k < 3; k++)
+            {
+                src_[k] = inputs[k].ptr<float>();
+                MatShape inpShape = shape(inputs[k]);
+                inpShape.insert(inpShape.begin(), dims - inpShape.size(), 1);
+                steps_[k].resize(dims);
+                size_t step = 1;
+                for (int i = dims - 1; i >= 0; i--)
+                {
+                    steps_[k][i] = inpShape[i] == 1 ? 0 : step;
+                    step *= inpShape[i];
+                }
+            }
+        }
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int dims = (int)outShape_.size();
+            const int width = outShape_[dims - 1];
+            const size_t cstep = steps_[0][dims - 1], xstep = steps_[1][dims - 1], ystep = steps_[2][dims - 1];
+            for (int row = r.start; row < r.end; row++)
+            {
+                size_t offsets[3] = {0, 0, 0};
+                for (int i = dims - 2, idx = row; i >= 0; i--)
+                {
+                    const int coord = idx % outShape_[i];
+                    idx /= outShape_[i];
+                    for (int k = 0; k < 3; k++)
+                        offsets[k] += coord * steps_[k][i];
+                }
+                const float* cond = src_[0] + offsets[0];
+                const float* x = src_[1] + offsets[1];
+                const float* y = src_[2] + offsets[2];
+                float* dst = dst_ + (size_t)row * width;
+                for (int j = 0; j < width; j++)
+                    dst[j] = cond[j * cstep] != 0.f ? x[j * xstep] : y[j * ystep];
+            }
+        }
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            CV_CheckTypeEQ(inputs[i].type(), CV_32F, "");
+            CV_Assert(inputs[i].isContinuous());
+        }
+        CV_Assert(outputs[0].isContinuous());
+
+        const int dims = outputs[0].dims;
+        const int numRows = (int)outputs[0].total(0, dims - 1);
+        parallel_for_(Range(0, numRows), WhereInvoker(inputs, outputs[0]),
+                      std::max(1., (double)outputs[0].total() / (1 << 14)));
+    }
+};
+
+Ptr<WhereLayer> WhereLayer::create(const LayerParams& params)
+{
+    return Ptr<WhereLayer>(new WhereLayerImpl(params));
+}
+
+}
+}
@@ -105,6 +105,61 @@ public:
         net.mutable_node()->DeleteSubrange(idx - numInputs - numInitializers, 1);
     }
 
+    // Returns a value of the initializer or Constant node, empty Mat for the rest of nodes.
+    Mat getConstant(int nodeId) const
+    {
+        if (nodeId >= numInputs + numInitializers)
+        {
+            const opencv_onnx::NodeProto& node = net.node(nodeId - numInputs - numInitializers);
+            if (node.op_type() != "Constant" || node.attribute_size() != 1 || !node.attribute(0).has_t())
+                return Mat();
+            opencv_onnx::TensorProto tensor = node.attribute(0).t();
+            return getMatFromTensor(tensor);
+        }
+        // Initializers may be listed between graph inputs as well
+        const std::string name = getOutputName(nodeId, 0);
+        for (int i = 0; i < numInitializers; ++i)
+        {
+            if (net.initializer(i).name() == name)
+            {
+                opencv_onnx::TensorProto tensor = net.initializer(i);
+                return getMatFromTensor(tensor);
+            }
+        }
+        return Mat();
+    }
+
+    // Checks that outputs of matched nodes (except the last one, which is replaced by a fused node)
+    // are consumed only by the matched nodes.
+    bool isSubgraphClosed(const std::vector<int>& matchedNodesIds) const
+    {
+        const int offset = numInputs + numInitializers;
+        std::set<std::string> internalOutputs;
+        for (size_t i = 0; i + 1 < matchedNodesIds.size(); ++i)
+        {
+            const opencv_onnx::NodeProto& node = net.node(matchedNodesIds[i] - offset);
+            for (int j = 0; j < node.output_size(); ++j)
+                internalOutputs.insert(node.output(j));
+        }
+        for (int i = 0; i < net.output_size(); ++i)
+        {
+            if (internalOutputs.count(net.output(i).name()))
+                return false;
+        }
+        for (int i = 0; i < net.node_size(); ++i)
+        {
+            if (std::find(matchedNodesIds.begin(), matchedNodesIds.end(), i + offset) != matchedNodesIds.end())
+                continue;
+            const opencv_onnx::NodeProto& node = net.node(i);
+            for (int j = 0; j < node.input_size(); ++j)
+            {
+                if (internalOutputs.count(node.input(j)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
 private:
     int numInputs, numInitializers;
     opencv_onnx::GraphProto& net;
@@ -547,6 +602,308 @@ public:
     }
 };
 
+// Base class for fusions which check values of constant inputs and attributes of matched nodes.
+class CheckedSubgraphBase : public Subgraph
+{
+protected:
+    // Returns id of the origin node matched to the node of pattern
+    static int getMatchedNode(const std::vector<int>& matchedNodesIds,
+                              const std::vector<int>& targetNodesIds, int targetId)
+    {
+        for (size_t i = 0; i < targetNodesIds.size(); ++i)
+        {
+            if (targetNodesIds[i] == targetId)
+                return matchedNodesIds[i];
+        }
+        CV_Error(Error::StsError, "Node of pattern is not matched");
+    }
+
+    // Every node of pattern should be matched to a single origin node and
+    // intermediate results should not be used outside of the subgraph.
+    static bool isFusable(const Ptr<ImportGraphWrapper>& net,
+                          const std::vector<int>& matchedNodesIds,
+                          const std::vector<int>& targetNodesIds)
+    {
+        std::vector<int> targets = targetNodesIds;
+        std::sort(targets.begin(), targets.end());
+        if (std::adjacent_find(targets.begin(), targets.end()) != targets.end())
+            return false;
+        return net.dynamicCast<ONNXGraphWrapper>()->isSubgraphClosed(matchedNodesIds);
+    }
+
+    static opencv_onnx::NodeProto* getONNXNode(const Ptr<ImportGraphWrapper>& net, int nodeId)
+    {
+        return net->getNode(nodeId).dynamicCast<ONNXNodeWrapper>()->node;
+    }
+
+    // Returns a value of constant input of the node or an empty Mat if the input is not a constant.
+    static Mat getConstantInput(const Ptr<ImportGraphWrapper>& net, int nodeId, int inpId)
+    {
+        int inpNodeId = getInputNodeId(net, net->getNode(nodeId), inpId);
+        Mat blob = net.dynamicCast<ONNXGraphWrapper>()->getConstant(inpNodeId);
+        if (!blob.empty() && blob.depth() != CV_32F)
+            blob.convertTo(blob, CV_32F);
+        return blob;
+    }
+
+    static bool getScalarInput(const Ptr<ImportGraphWrapper>& net, int nodeId, int inpId, float& value)
+    {
+        Mat blob = getConstantInput(net, nodeId, inpId);
+        if (blob.total() != 1)
+            return false;
+        value = blob.at<float>(0);
+        return true;
+    }
+
+    static bool isScalarInput(const Ptr<ImportGraphWrapper>& net, int nodeId, int inpId, float expected)
+    {
+        float value;
+        return getScalarInput(net, nodeId, inpId, value) &&
+               std::abs(value - expected) <= 1e-4f * std::max(1.f, std::abs(expected));
+    }
+
+    static const opencv_onnx::AttributeProto* getAttribute(const opencv_onnx::NodeProto* node, const std::string& name)
+    {
+        for (int i = 0; i < node->attribute_size(); ++i)
+        {
+            if (node->attribute(i).name() == name)
+                return &node->attribute(i);
+        }
+        return 0;
+    }
+};
+
+class GeluSubgraph : public CheckedSubgraphBase
+{
+public:
+    // x * 0.5 * (1 + erf(x / sqrt(2))) with both orders of multiplications.
+    // Division by sqrt(2) may be replaced by multiplication by 1 / sqrt(2).
+    GeluSubgraph(bool halfFirst, bool mulByInvSqrt2) : mulByInvSqrt2(mulByInvSqrt2)
+    {
+        int input = addNodeToMatch("");
+        scaleNode = addNodeToMatch(mulByInvSqrt2 ? "Mul" : "Div", input, addNodeToMatch(""));
+        int erf = addNodeToMatch("Erf", scaleNode);
+        addNode = addNodeToMatch("Add", erf, addNodeToMatch(""));
+        if (halfFirst)
+        {
+            halfNode = inputMulNode = addNodeToMatch("Mul", input, addNodeToMatch(""));
+            addNodeToMatch("Mul", halfNode, addNode);
+        }
+        else
+        {
+            inputMulNode = addNodeToMatch("Mul", input, addNode);
+            halfNode = addNodeToMatch("Mul", inputMulNode, addNodeToMatch(""));
+        }
+        setFusedNode("Gelu", input);
+    }
+
+    virtual bool match(const Ptr<ImportGraphWrapper>& net, int nodeId,
+                       std::vector<int>& matchedNodesIds,
+                       std::vector<int>& targetNodesIds) CV_OVERRIDE
+    {
+        if (!Subgraph::match(net, nodeId, matchedNodesIds, targetNodesIds) ||
+            !isFusable(net, matchedNodesIds, targetNodesIds))
+            return false;
+
+        int scale = getMatchedNode(matchedNodesIds, targetNodesIds, scaleNode);
+        int add = getMatchedNode(matchedNodesIds, targetNodesIds, addNode);
+        int half = getMatchedNode(matchedNodesIds, targetNodesIds, halfNode);
+        int inputMul = getMatchedNode(matchedNodesIds, targetNodesIds, inputMulNode);
+        return net->getNode(scale)->getInputName(0) == net->getNode(inputMul)->getInputName(0) &&
+               isScalarInput(net, scale, 1, mulByInvSqrt2 ? 0.70710678f : 1.41421356f) &&
+               isScalarInput(net, add, 1, 1.f) &&
+               isScalarInput(net, half, 1, 0.5f);
+    }
+
+private:
+    bool mulByInvSqrt2;
+    int scaleNode, addNode, halfNode, inputMulNode;
+};
+
+class LayerNormSubgraph : public CheckedSubgraphBase
+{
+public:
+    // (x - mean(x)) / sqrt(mean((x - mean(x))^2) + eps) * weight [+ bias]
+    LayerNormSubgraph(bool hasBias) : axis(-1), epsilon(1e-5f)
+    {
+        int input = addNodeToMatch("");
+        meanNode = addNodeToMatch("ReduceMean", input);
+        subNode = addNodeToMatch("Sub", input, meanNode);
+        powNode = addNodeToMatch("Pow", subNode, addNodeToMatch(""));
+        varNode = addNodeToMatch("ReduceMean", powNode);
+        epsNode = addNodeToMatch("Add", varNode, addNodeToMatch(""));
+        int sqrtNode = addNodeToMatch("Sqrt", epsNode);
+        int div = addNodeToMatch("Div", subNode, sqrtNode);
+        int weight = addNodeToMatch("");
+        scaleNode = addNodeToMatch("Mul", div, weight);
+        biasNode = -1;
+        if (hasBias)
+        {
+            int bias = addNodeToMatch("");
+            biasNode = addNodeToMatch("Add", scaleNode, bias);
+            setFusedNode("LayerNormalization", input, weight, bias);
+        }
+        else
+            setFusedNode("LayerNormalization", input, weight);
+    }
+
+    // Returns the first of normalized axes if they are the trailing ones
+    static bool getNormalizedAxis(const opencv_onnx::NodeProto* reduce, int& axis)
+    {
+        const opencv_onnx::AttributeProto* keepdims = getAttribute(reduce, "keepdims");
+        const opencv_onnx::AttributeProto* axes = getAttribute(reduce, "axes");
+        if ((keepdims && keepdims->i() == 0) || !axes || axes->ints_size() == 0)
+            return false;
+        std::vector<int> values(axes->ints().begin(), axes->ints().end());
+        std::sort(values.begin(), values.end());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] != (int)i - (int)values.size())
+                return false;
+        }
+        axis = values[0];
+        return true;
+    }
+
+    virtual bool match(const Ptr<ImportGraphWrapper>& net, int nodeId,
+                       std::vector<int>& matchedNodesIds,
+                       std::vector<int>& targetNodesIds) CV_OVERRIDE
+    {
+        if (!Subgraph::match(net, nodeId, matchedNodesIds, targetNodesIds) ||
+            !isFusable(net, matchedNodesIds, targetNodesIds))
+            return false;
+
+        int mean = getMatchedNode(matchedNodesIds, targetNodesIds, meanNode);
+        int sub = getMatchedNode(matchedNodesIds, targetNodesIds, subNode);
+        int pow = getMatchedNode(matchedNodesIds, targetNodesIds, powNode);
+        int var = getMatchedNode(matchedNodesIds, targetNodesIds, varNode);
+        int eps = getMatchedNode(matchedNodesIds, targetNodesIds, epsNode);
+        int scale = getMatchedNode(matchedNodesIds, targetNodesIds, scaleNode);
+
+        int varAxis;
+        if (net->getNode(mean)->getInputName(0) != net->getNode(sub)->getInputName(0) ||
+            !getNormalizedAxis(getONNXNode(net, mean), axis) ||
+            !getNormalizedAxis(getONNXNode(net, var), varAxis) || varAxis != axis ||
+            !isScalarInput(net, pow, 1, 2.f) || !getScalarInput(net, eps, 1, epsilon) ||
+            getConstantInput(net, scale, 1).empty())
+            return false;
+        if (biasNode != -1)
+        {
+            int bias = getMatchedNode(matchedNodesIds, targetNodesIds, biasNode);
+            if (getConstantInput(net, bias, 1).empty())
+                return false;
+        }
+        return true;
+    }
+
+    virtual void finalize(const Ptr<ImportGraphWrapper>&,
+                          const Ptr<ImportNodeWrapper>& fusedNode,
+                          std::vector<Ptr<ImportNodeWrapper> >&) CV_OVERRIDE
+    {
+        opencv_onnx::NodeProto* node = fusedNode.dynamicCast<ONNXNodeWrapper>()->node;
+        node->clear_attribute();
+        opencv_onnx::AttributeProto* attrAxis = node->add_attribute();
+        attrAxis->set_name("axis");
+        attrAxis->set_i(axis);
+        opencv_onnx::AttributeProto* attrEps = node->add_attribute();
+        attrEps->set_name("epsilon");
+        attrEps->set_f(epsilon);
+    }
+
+private:
+    int meanNode, subNode, powNode, varNode, epsNode, scaleNode, biasNode;
+    int axis;
+    float epsilon;
+};
+
+class AttentionSubgraph : public CheckedSubgraphBase
+{
+public:
+    // softmax(Q * K^T * scale [+ mask]) * V, where scale is applied by Mul or Div (or omitted).
+    // If keys are not transposed explicitly, the second input of the first MatMul is used as K^T.
+    AttentionSubgraph(bool transposeKey, const std::string& scaleOp, bool hasMask)
+        : scaleOp(scaleOp), transposeNode(-1), scaleNode(-1), scale(1.f), keyTransposed(!transposeKey)
+    {
+        int query = addNodeToMatch("");
+        int key = addNodeToMatch("");
+        int value = addNodeToMatch("");
+        int keyT = transposeKey ? (transposeNode = addNodeToMatch("Transpose", key)) : key;
+        int scores = addNodeToMatch("MatMul", query, keyT);
+        if (!scaleOp.empty())
+            scores = scaleNode = addNodeToMatch(scaleOp, scores, addNodeToMatch(""));
+        int mask = -1;
+        if (hasMask)
+        {
+            mask = addNodeToMatch("");
+            scores = addNodeToMatch("Add", scores, mask);
+        }
+        softmaxNode = addNodeToMatch("Softmax", scores);
+        addNodeToMatch("MatMul", softmaxNode, value);
+        setFusedNode("ScaledDotProductAttention", query, key, value, mask);
+    }
+
+    virtual bool match(const Ptr<ImportGraphWrapper>& net, int nodeId,
+                       std::vector<int>& matchedNodesIds,
+                       std::vector<int>& targetNodesIds) CV_OVERRIDE
+    {
+        if (!Subgraph::match(net, nodeId, matchedNodesIds, targetNodesIds) ||
+            !isFusable(net, matchedNodesIds, targetNodesIds))
+            return false;
+
+        // Softmax should be applied along the last axis
+        int dims = -1;
+        if (transposeNode != -1)
+        {
+            int transpose = getMatchedNode(matchedNodesIds, targetNodesIds, transposeNode);
+            const opencv_onnx::AttributeProto* perm = getAttribute(getONNXNode(net, transpose), "perm");
+            if (!perm || perm->ints_size() < 2)
+                return false;
+            dims = perm->ints_size();
+            for (int i = 0; i < dims; ++i)
+            {
+                int expected = i < dims - 2 ? i : (i == dims - 2 ? dims - 1 : dims - 2);
+                if (perm->ints(i) != expected)
+                    return false;
+            }
+        }
+        int softmax = getMatchedNode(matchedNodesIds, targetNodesIds, softmaxNode);
+        const opencv_onnx::AttributeProto* axis = getAttribute(getONNXNode(net, softmax), "axis");
+        if (!axis || (axis->i() != -1 && axis->i() != dims - 1))
+            return false;
+
+        scale = 1.f;
+        if (scaleNode != -1)
+        {
+            int scaleId = getMatchedNode(matchedNodesIds, targetNodesIds, scaleNode);
+            if (!getScalarInput(net, scaleId, 1, scale) || scale == 0.f)
+                return false;
+            if (scaleOp == "Div")
+                scale = 1.f / scale;
+        }
+        return true;
+    }
+
+    virtual void finalize(const Ptr<ImportGraphWrapper>&,
+                          const Ptr<ImportNodeWrapper>& fusedNode,
+                          std::vector<Ptr<ImportNodeWrapper> >&) CV_OVERRIDE
+    {
+        opencv_onnx::NodeProto* node = fusedNode.dynamicCast<ONNXNodeWrapper>()->node;
+        node->clear_attribute();
+        opencv_onnx::AttributeProto* attrScale = node->add_attribute();
+        attrScale->set_name("scale");
+        attrScale->set_f(scale);
+        opencv_onnx::AttributeProto* attrKeyTransposed = node->add_attribute();
+        attrKeyTransposed->set_name("key_transposed");
+        attrKeyTransposed->set_i(keyTransposed);
+    }
+
+private:
+    std::string scaleOp;
+    int transposeNode, scaleNode, softmaxNode;
+    float scale;
+    bool keyTransposed;
+};
+
 void simplifySubgraphs(opencv_onnx::GraphProto& net)
 {
     std::vector<Ptr<Subgraph> > subgraphs;
@@ -556,6 +913,22 @@ void simplifySubgraphs(opencv_onnx::GraphProto& net)
     subgraphs.push_back(makePtr<ResizeSubgraph1>());
     subgraphs.push_back(makePtr<ResizeSubgraph2>());
     subgraphs.push_back(makePtr<SoftMaxSubgraph>());
+    subgraphs.push_back(makePtr<GeluSubgraph>(false, false));
+    subgraphs.push_back(makePtr<GeluSubgraph>(false, true));
+    subgraphs.push_back(makePtr<GeluSubgraph>(true, false));
+    subgraphs.push_back(makePtr<GeluSubgraph>(true, true));
+    subgraphs.push_back(makePtr<LayerNormSubgraph>(true));
+    subgraphs.push_back(makePtr<LayerNormSubgraph>(false));
+    // Explicitly transposed keys are matched first, otherwise the Transpose node is taken as K^T
+    for (int transposeKey = 1; transposeKey >= 0; --transposeKey)
+    {
+        const char* scaleOps[] = {"Div", "Mul", ""};
+        for (int i = 0; i < 3; ++i)
+        {
+            subgraphs.push_back(makePtr<AttentionSubgraph>(transposeKey != 0, scaleOps[i], true));
+            subgraphs.push_back(makePtr<AttentionSubgraph>(transposeKey != 0, scaleOps[i], false));
+        }
+    }
     subgraphs.push_back(makePtr<NormalizeSubgraph1>());
     subgraphs.push_back(makePtr<NormalizeSubgraph2>());
     subgraphs.push_back(makePtr<NormalizeSubgraph3>());
@@ -572,7 +945,8 @@ void simplifySubgraphs(opencv_onnx::GraphProto& net)
 Mat getMatFromTensor(opencv_onnx::TensorProto& tensor_proto)
 {
     if (tensor_proto.raw_data().empty() && tensor_proto.float_data().empty() &&
-        tensor_proto.double_data().empty() && tensor_proto.int64_data().empty())
+        tensor_proto.double_data().empty() && tensor_proto.int64_data().empty() &&
+        tensor_proto.int32_data().empty())
         return Mat();
 
     opencv_onnx::TensorProto_DataType datatype = tensor_proto.data_type();
@@ -641,6 +1015,19 @@ Mat getMatFromTensor(opencv_onnx::TensorProto& tensor_proto)
             convertInt64ToInt32(src, dst, blob.total());
         }
     }
+    else if (datatype == opencv_onnx::TensorProto_DataType_BOOL)
+    {
+        if (!tensor_proto.int32_data().empty())
+        {
+            const ::google::protobuf::RepeatedField<int32_t> field = tensor_proto.int32_data();
+            Mat(sizes, CV_32SC1, (void*)field.data()).convertTo(blob, CV_8UC1);
+        }
+        else
+        {
+            char* val = const_cast<char*>(tensor_proto.raw_data().c_str());
+            Mat(sizes, CV_8UC1, val).copyTo(blob);
+        }
+    }
     else
     {
         std::string errorMsg = "Unsupported data type: " +
@@ -61,6 +61,7 @@ class ONNXImporter
     void addConstant(const std::string& name, const Mat& blob);
     void addLayer(LayerParams& layerParams,
                   const opencv_onnx::NodeProto& node_proto);
+    void addConstantInputs(const opencv_onnx::NodeProto& node_proto);
     static const std::set<String>& getSupportedTypes();
 
 public:
@@ -69,6 +70,7 @@ public:
         : dstNet(net), utilNet()
     {
         hasDynamicShapes = false;
+        onnx_opset = 0;
         CV_Assert(onnxFile);
         CV_LOG_DEBUG(NULL, "DNN/ONNX: processing ONNX model from file: " << onnxFile);
 
@@ -90,6 +92,7 @@ public:
         : dstNet(net), utilNet()
     {
         hasDynamicShapes = false;
+        onnx_opset = 0;
         CV_LOG_DEBUG(NULL, "DNN/ONNX: processing in-memory ONNX model (" << sizeBuffer << " bytes)");
 
         struct _Buf : public std::streambuf
@@ -118,6 +121,7 @@ protected:
 
     opencv_onnx::GraphProto graph_proto;
     std::string framework_name;
+    int onnx_opset;  // Version of the default operator set, 0 if unknown
 
     std::map<std::string, Mat> constBlobs;
 
@@ -408,11 +412,40 @@ void ONNXImporter::addConstant(const std::string& name, const Mat& blob)
     outShapes.insert(std::make_pair(name, shape(blob)));
 }
 
+void ONNXImporter::addConstantInputs(const opencv_onnx::NodeProto& node_proto)
+{
+    for (int i = 0; i < node_proto.input_size(); i++)
+    {
+        const std::string& input = node_proto.input(i);
+        if (input.empty() || layer_id.find(input) != layer_id.end())
+            continue;
+        Mat blob = getBlob(input);
+        if (blob.depth() != CV_32F)
+            blob.convertTo(blob, CV_32F);
+
+        LayerParams constParams;
+        constParams.name = input;
+        constParams.type = "Const";
+        constParams.blobs.push_back(blob);
+
+        opencv_onnx::NodeProto proto;
+        proto.add_output(constParams.name);
+        addLayer(constParams, proto);
+    }
+}
+
 void ONNXImporter::populateNet()
 {
     CV_Assert(model_proto.has_graph());
     graph_proto = model_proto.graph();
 
+    for (int i = 0; i < model_proto.opset_import_size(); i++)
+    {
+        const opencv_onnx::OperatorSetIdProto& opset = model_proto.opset_import(i);
+        if (opset.domain().empty() || opset.domain() == "ai.onnx")
+            onnx_opset = (int)opset.version();
+    }
+
     std::string framework_version;
     if (model_proto.has_producer_name())
         framework_name = model_proto.producer_name();
@@ -423,6 +456,7 @@ void ONNXImporter::populateNet()
             << (model_proto.has_ir_version() ? cv::format(" v%d", (int)model_proto.ir_version()) : cv::String())
             << " model produced by '" << framework_name << "'"
             << (framework_version.empty() ? cv::String() : cv::format(":%s", framework_version.c_str()))
+            << (onnx_opset ? cv::format(", opset %d", onnx_opset) : cv::String())
             << ". Number of nodes = " << graph_proto.node_size()
             << ", inputs = " << graph_proto.input_size()
             << ", outputs = " << graph_proto.output_size()
@@ -580,7 +614,13 @@ const std::set<String>& ONNXImporter::getSupportedTypes()
         "Dropout",
         "Identity",
         "Crop",
-        "Normalize"
+        "Normalize",
+        "LayerNormalization",
+        "Gelu",
+        "Erf",
+        "Where",
+        "Einsum",
+        "ScaledDotProductAttention"
     };
     return layerTypes;
 }
@@ -605,6 +645,20 @@ void ONNXImporter::handleNode(const opencv_onnx::NodeProto& node_proto_)
         layerParams.type = layer_type;
         layerParams.set("has_dynamic_shapes", hasDynamicShapes);
 
+        // Since opset 13 axes of Squeeze, Unsqueeze, ReduceSum and sizes of Split are passed by an input
+        if ((layer_type == "Squeeze" || layer_type == "Unsqueeze" || layer_type == "ReduceSum" || layer_type == "Split") &&
+            node_proto.input_size() == 2)
+        {
+            if (!node_proto.input(1).empty())
+            {
+                Mat axes = getBlob(node_proto, 1);
+                CV_CheckTypeEQ(axes.type(), CV_32SC1, "");
+                layerParams.set(layer_type == "Split" ? "split" : "axes",
+                                DictValue::arrayInt(axes.ptr<int>(), (int)axes.total()));
+            }
+            node_proto.mutable_input()->RemoveLast();
+        }
+
         if (layer_type == "MaxPool")
         {
             layerParams.type = "Pooling";
@@ -1269,22 +1323,43 @@ void ONNXImporter::handleNode(const opencv_onnx::NodeProto& node_proto_)
         else if (layer_type == "MatMul")
         {
             CV_Assert(node_proto.input_size() == 2);
-            layerParams.type = "InnerProduct";
-            layerParams.set("bias_term", false);
-            CV_Assert(constBlobs.find(node_proto.input(0)) == constBlobs.end());
-            int firstInpDims = outShapes[node_proto.input(0)].size();
-            int secondInpDims;
+            bool isConst0 = constBlobs.find(node_proto.input(0)) != constBlobs.end();
+            bool isConst1 = constBlobs.find(node_proto.input(1)) != constBlobs.end();
+            if (isConst0 && isConst1)
+            {
+                std::vector<Mat> inputs(2), output;
+                inputs[0] = getBlob(node_proto, 0);
+                inputs[1] = getBlob(node_proto, 1);
+                runLayer(layerParams, inputs, output);
+                addConstant(layerParams.name, output[0]);
+                return;
+            }
 
-            if (constBlobs.find(node_proto.input(1)) != constBlobs.end())
+            MatShape firstInpShape = isConst0 ? shape(getBlob(node_proto, 0)) : outShapes[node_proto.input(0)];
+            MatShape secondInpShape = isConst1 ? shape(getBlob(node_proto, 1)) : outShapes[node_proto.input(1)];
+            int firstInpDims = firstInpShape.size();
+            int secondInpDims = secondInpShape.size();
+            // InnerProduct covers multiplication by a constant matrix and batches of the same shape,
+            // any other case (broadcasting, vectors, constant first operand) is handled by MatMul layer
+            bool sameBatches = !isConst0 && !isConst1 && firstInpDims == secondInpDims && firstInpDims >= 2 &&
+                               std::equal(firstInpShape.begin(), firstInpShape.end() - 2, secondInpShape.begin());
+            if ((isConst1 && secondInpDims == 2 && firstInpDims >= 2) || sameBatches)
             {
-                Mat blob = getBlob(node_proto, 1);
-                secondInpDims = blob.dims;
-                layerParams.blobs.push_back(blob.t());
-                layerParams.set("num_output", layerParams.blobs[0].size[0]);
-            } else {
-                secondInpDims = outShapes[node_proto.input(1)].size();
+                layerParams.type = "InnerProduct";
+                layerParams.set("bias_term", false);
+                if (isConst1)
+                {
+                    Mat blob = getBlob(node_proto, 1);
+                    layerParams.blobs.push_back(blob.t());
+                    layerParams.set("num_output", layerParams.blobs[0].size[0]);
+                }
+                layerParams.set("axis", firstInpDims - secondInpDims + 1);
+            }
+            else if (isConst0 || isConst1)
+            {
+                layerParams.blobs.push_back(getBlob(node_proto, isConst0 ? 0 : 1));
+                layerParams.set("const_input", isConst0 ? 0 : 1);
             }
-            layerParams.set("axis", firstInpDims - secondInpDims + 1);
         }
         else if (layer_type == "Mul" || layer_type == "Div")
         {
@@ -2049,10 +2124,56 @@ void ONNXImporter::handleNode(const opencv_onnx::NodeProto& node_proto_)
             }
             replaceLayerParam(layerParams, "mode", "interpolation");
         }
-        else if (layer_type == "SoftMax" || layer_type == "LogSoftmax")
+        else if (layer_type == "Softmax" || layer_type == "SoftMax" || layer_type == "LogSoftmax")
         {
             layerParams.type = "Softmax";
             layerParams.set("log_softmax", layer_type == "LogSoftmax");
+            // default axis is the last one since opset 13
+            if (!layerParams.has("axis") && onnx_opset >= 13)
+                layerParams.set("axis", -1);
+        }
+        else if (layer_type == "LayerNormalization")
+        {
+            CV_CheckGE(node_proto.input_size(), 2, "");
+            layerParams.blobs.push_back(getBlob(node_proto, 1));
+            if (node_proto.input_size() > 2 && !node_proto.input(2).empty())
+                layerParams.blobs.push_back(getBlob(node_proto, 2));
+            // optional mean and inverse standard deviation outputs are used for training only
+            while (node_proto.output_size() > 1)
+                node_proto.mutable_output()->RemoveLast();
+        }
+        else if (layer_type == "Gelu")
+        {
+            layerParams.type = "GELU";
+        }
+        else if (layer_type == "Where")
+        {
+            CV_CheckEQ(node_proto.input_size(), 3, "");
+            bool isConst = true;
+            for (int i = 0; i < 3; i++)
+                isConst &= constBlobs.find(node_proto.input(i)) != constBlobs.end();
+            if (isConst)
+            {
+                std::vector<Mat> inputs(3), output;
+                for (int i = 0; i < 3; i++)
+                    getBlob(node_proto, i).convertTo(inputs[i], CV_32F);
+                runLayer(layerParams, inputs, output);
+                output[0].convertTo(output[0], getBlob(node_proto, 1).depth());
+                addConstant(layerParams.name, output[0]);
+                return;
+            }
+            addConstantInputs(node_proto);
+        }
+        else if (layer_type == "Einsum")
+        {
+            addConstantInputs(node_proto);
+        }
+        else if (layer_type == "ScaledDotProductAttention")
+        {
+            // Fused by the graph simplifier from MatMul -> Scale -> [Add mask] -> Softmax -> MatMul
+            CV_CheckGE(node_proto.input_size(), 3, "");
+            layerParams.type = "Attention";
+            addConstantInputs(node_proto);
         }
         else if (layer_type == "DetectionOutput")
         {
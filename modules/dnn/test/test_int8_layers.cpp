@@ -0,0 +1,207 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+static void testQuantizedNet(Net& net, const std::vector<Mat>& calibData, const Mat& input,
+                             const std::vector<String>& expectedTypes, double maxErrorSteps = 4)
+{
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    Net qnet = net.quantize(calibData);
+    std::vector<String> layerTypes;
+    qnet.getLayerTypes(layerTypes);
+    for (size_t i = 0; i < expectedTypes.size(); i++)
+        EXPECT_NE(std::find(layerTypes.begin(), layerTypes.end(), expectedTypes[i]), layerTypes.end()) << expectedTypes[i];
+
+    qnet.setInput(input);
+    Mat out = qnet.forward();
+
+    ASSERT_EQ(CV_32F, out.type());
+    ASSERT_EQ(ref.size, out.size);
+
+    double minVal, maxVal;
+    cv::minMaxIdx(ref, &minVal, &maxVal);
+    double step = std::max(maxVal, 0.) - std::min(minVal, 0.);
+    step /= 255;
+    EXPECT_LE(cvtest::norm(ref, out, NORM_INF), maxErrorSteps * step + 1e-5);
+    EXPECT_LE(cvtest::norm(ref, out, NORM_L1) / ref.total(), step + 1e-5);
+
+    // the original network is kept untouched
+    net.setInput(input);
+    EXPECT_EQ(0, cvtest::norm(ref, net.forward(), NORM_INF));
+}
+
+static std::vector<Mat> randomBlobs(const std::vector<int>& shape, int n, float lo = -1.f, float hi = 1.f)
+{
+    std::vector<Mat> blobs(n);
+    for (int i = 0; i < n; i++)
+    {
+        blobs[i].create(shape, CV_32F);
+        randu(blobs[i], lo, hi);
+    }
+    return blobs;
+}
+
+static LayerParams convParams(int inpCn, int outCn, int kernel, int groups = 1, bool bias = true)
+{
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.name = "conv";
+    lp.set("kernel_size", kernel);
+    lp.set("num_output", outCn);
+    lp.set("pad", kernel / 2);
+    lp.set("group", groups);
+    lp.set("bias_term", bias);
+    int wshape[] = {outCn, inpCn / groups, kernel, kernel};
+    Mat weights(4, wshape, CV_32F);
+    randu(weights, -1.f, 1.f);
+    lp.blobs.push_back(weights);
+    if (bias)
+    {
+        Mat b(1, outCn, CV_32F);
+        randu(b, -1.f, 1.f);
+        lp.blobs.push_back(b);
+    }
+    return lp;
+}
+
+TEST(Layer_Test_Int8, Convolution_ReLU)
+{
+    Net net;
+    LayerParams conv = convParams(4, 8, 3);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+    LayerParams relu;
+    net.addLayerToPrev("relu", "ReLU", relu);
+
+    std::vector<int> inpShape = {2, 4, 10, 9};
+    std::vector<Mat> calib = randomBlobs(inpShape, 4);
+    testQuantizedNet(net, calib, calib[1], {"ConvolutionInt8", "Quantize"});
+}
+
+TEST(Layer_Test_Int8, Convolution_depthwise)
+{
+    Net net;
+    LayerParams conv = convParams(6, 6, 3, 6);
+    conv.set("stride", 2);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+
+    std::vector<int> inpShape = {1, 6, 11, 12};
+    std::vector<Mat> calib = randomBlobs(inpShape, 3);
+    testQuantizedNet(net, calib, calib[0], {"ConvolutionInt8"});
+}
+
+TEST(Layer_Test_Int8, Pooling)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        Net net;
+        LayerParams conv = convParams(3, 5, 1);
+        net.addLayerToPrev(conv.name, conv.type, conv);
+        LayerParams pool;
+        pool.set("pool", i == 0 ? "max" : "ave");
+        pool.set("kernel_size", 3);
+        pool.set("stride", 2);
+        pool.set("pad", 1);
+        net.addLayerToPrev("pool", "Pooling", pool);
+
+        std::vector<int> inpShape = {1, 3, 9, 10};
+        std::vector<Mat> calib = randomBlobs(inpShape, 2);
+        testQuantizedNet(net, calib, calib[0], {"PoolingInt8"});
+    }
+}
+
+TEST(Layer_Test_Int8, Eltwise_Concat)
+{
+    Net net;
+    LayerParams conv1 = convParams(3, 4, 3), conv2 = convParams(3, 4, 1);
+    int c1 = net.addLayer("conv1", conv1.type, conv1);
+    int c2 = net.addLayer("conv2", conv2.type, conv2);
+    net.connect(0, 0, c1, 0);
+    net.connect(0, 0, c2, 0);
+
+    LayerParams eltwise;
+    eltwise.set("operation", "sum");
+    int sum = net.addLayer("sum", "Eltwise", eltwise);
+    net.connect(c1, 0, sum, 0);
+    net.connect(c2, 0, sum, 1);
+
+    LayerParams concat;
+    concat.set("axis", 1);
+    int cat = net.addLayer("concat", "Concat", concat);
+    net.connect(sum, 0, cat, 0);
+    net.connect(c2, 0, cat, 1);
+
+    std::vector<int> inpShape = {1, 3, 8, 8};
+    std::vector<Mat> calib = randomBlobs(inpShape, 3);
+    testQuantizedNet(net, calib, calib[2], {"EltwiseInt8", "ConcatInt8"});
+}
+
+TEST(Layer_Test_Int8, InnerProduct)
+{
+    Net net;
+    LayerParams conv = convParams(2, 3, 3);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+
+    LayerParams fc;
+    fc.set("num_output", 10);
+    fc.set("bias_term", true);
+    Mat weights(10, 3 * 5 * 5, CV_32F), bias(1, 10, CV_32F);
+    randu(weights, -1.f, 1.f);
+    randu(bias, -1.f, 1.f);
+    fc.blobs.push_back(weights);
+    fc.blobs.push_back(bias);
+    net.addLayerToPrev("fc", "InnerProduct", fc);
+
+    std::vector<int> inpShape = {3, 2, 5, 5};
+    std::vector<Mat> calib = randomBlobs(inpShape, 2);
+    testQuantizedNet(net, calib, calib[0], {"InnerProductInt8"});
+}
+
+TEST(Layer_Test_Int8, forward_intermediate_layer)
+{
+    Net net;
+    LayerParams conv = convParams(2, 4, 3);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+    LayerParams conv2 = convParams(4, 2, 1);
+    conv2.name = "conv2";
+    net.addLayerToPrev(conv2.name, conv2.type, conv2);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    std::vector<int> inpShape = {1, 2, 5, 5};
+    std::vector<Mat> calib = randomBlobs(inpShape, 2);
+    net.setInput(calib[0]);
+    Mat ref = net.forward("conv").clone();
+
+    Net qnet = net.quantize(calib);
+    qnet.setInput(calib[0]);
+    Mat out = qnet.forward("conv");
+
+    ASSERT_EQ(CV_32F, out.type());
+    ASSERT_EQ(ref.size, out.size);
+    double minVal, maxVal;
+    cv::minMaxIdx(ref, &minVal, &maxVal);
+    const double step = (std::max(maxVal, 0.) - std::min(minVal, 0.)) / 255;
+    EXPECT_LE(cvtest::norm(ref, out, NORM_INF), 4 * step + 1e-5);
+}
+
+TEST(Layer_Test_Int8, quantize_twice)
+{
+    Net net;
+    LayerParams conv = convParams(2, 2, 1);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+
+    std::vector<int> inpShape = {1, 2, 4, 4};
+    std::vector<Mat> calib = randomBlobs(inpShape, 1);
+    Net qnet = net.quantize(calib);
+    EXPECT_THROW(qnet.quantize(calib), cv::Exception);
+}
+
+}} // namespace
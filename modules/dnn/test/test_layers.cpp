@@ -1134,6 +1134,87 @@ TEST_P(Layer_Test_DWconv_Prelu, Accuracy)
 }
 INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_DWconv_Prelu, Combine(Values(3, 6), Values(3, 6)));
 
+// Compares CPU implementations of convolution (im2row, Winograd, depth-wise) with a naive one.
+// input: {N, C, H, W}, kernel: {kernel size, stride, pad, dilation}
+typedef testing::TestWithParam<tuple<Vec4i, Vec4i, int, bool> > Layer_Test_Convolution_CPU;
+TEST_P(Layer_Test_Convolution_CPU, Accuracy)
+{
+    Vec4i inpSize = get<0>(GetParam()), params = get<1>(GetParam());
+    const bool depthwise = get<3>(GetParam());
+    const int N = inpSize[0], inpCn = inpSize[1], H = inpSize[2], W = inpSize[3];
+    const int outCn = depthwise ? inpCn : get<2>(GetParam());
+    const int K = params[0], stride = params[1], pad = params[2], dilation = params[3];
+    const int groups = depthwise ? inpCn : 1;
+    const int outH = (H + 2*pad - dilation*(K - 1) - 1) / stride + 1;
+    const int outW = (W + 2*pad - dilation*(K - 1) - 1) / stride + 1;
+    const float slope = 0.1f;
+
+    int wshape[] = {outCn, inpCn / groups, K, K};
+    Mat weights(4, wshape, CV_32F), bias(1, outCn, CV_32F);
+    randu(weights, -1.f, 1.f);
+    randu(bias, -1.f, 1.f);
+    int ishape[] = {N, inpCn, H, W};
+    Mat input(4, ishape, CV_32F);
+    randu(input, -1.f, 1.f);
+
+    LayerParams lp;
+    lp.set("kernel_size", K);
+    lp.set("stride", stride);
+    lp.set("pad", pad);
+    lp.set("dilation", dilation);
+    lp.set("num_output", outCn);
+    lp.set("group", groups);
+    lp.set("bias_term", true);
+    lp.blobs.push_back(weights);
+    lp.blobs.push_back(bias);
+    Net net;
+    net.addLayerToPrev("conv", "Convolution", lp);
+    LayerParams lpRelu;
+    lpRelu.set("negative_slope", slope);
+    net.addLayerToPrev("relu", "ReLU", lpRelu);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setInput(input);
+    Mat out = net.forward();
+
+    int oshape[] = {N, outCn, outH, outW};
+    Mat ref(4, oshape, CV_32F);
+    const int inpGroupCn = inpCn / groups, outGroupCn = outCn / groups;
+    for (int n = 0; n < N; n++)
+    for (int oc = 0; oc < outCn; oc++)
+    for (int y = 0; y < outH; y++)
+    for (int x = 0; x < outW; x++)
+    {
+        double sum = bias.at<float>(oc);
+        for (int ic = 0; ic < inpGroupCn; ic++)
+        {
+            const int c = (oc / outGroupCn)*inpGroupCn + ic;
+            for (int ky = 0; ky < K; ky++)
+            for (int kx = 0; kx < K; kx++)
+            {
+                int iy = y*stride - pad + ky*dilation, ix = x*stride - pad + kx*dilation;
+                if (iy < 0 || iy >= H || ix < 0 || ix >= W)
+                    continue;
+                sum += (double)input.ptr<float>(n, c, iy)[ix] * weights.ptr<float>(oc, ic, ky)[kx];
+            }
+        }
+        ref.ptr<float>(n, oc, y)[x] = (float)(sum > 0 ? sum : sum*slope);
+    }
+    normAssert(ref, out, "", 1e-5 * K * K * inpGroupCn, 1e-4 * K * K * inpGroupCn);
+}
+INSTANTIATE_TEST_CASE_P(Winograd, Layer_Test_Convolution_CPU, Combine(
+/* input */     Values(Vec4i(1, 16, 24, 24), Vec4i(2, 16, 25, 31), Vec4i(1, 32, 40, 13)),
+/* kernel */    Values(Vec4i(3, 1, 1, 1), Vec4i(3, 1, 0, 1)),
+/* outCn */     Values(16, 24),
+/* depthwise */ Values(false)
+));
+INSTANTIATE_TEST_CASE_P(Depthwise, Layer_Test_Convolution_CPU, Combine(
+/* input */     Values(Vec4i(1, 8, 9, 8), Vec4i(2, 5, 15, 31)),
+/* kernel */    Values(Vec4i(3, 1, 1, 1), Vec4i(3, 2, 1, 1), Vec4i(5, 1, 2, 1), Vec4i(5, 2, 2, 1),
+                       Vec4i(7, 1, 3, 1), Vec4i(3, 1, 2, 2), Vec4i(3, 3, 0, 1)),
+/* outCn */     Values(0),  // the same as number of input channels
+/* depthwise */ Values(true)
+));
+
 #ifdef HAVE_INF_ENGINE
 // Using Intel's Model Optimizer generate .xml and .bin files:
 // ./ModelOptimizer -w /path/to/caffemodel -d /path/to/prototxt \
@@ -2359,7 +2440,8 @@ TEST_P(ConvolutionEltwiseFusion, Accuracy)
     Target targetId = get<1>(get<3>(GetParam()));
 
     std::vector<int> expectedFusedLayers;
-    if (backendId == DNN_BACKEND_CUDA && eltwiseOp == "sum" && !weightedEltwise)
+    if ((backendId == DNN_BACKEND_CUDA || (backendId == DNN_BACKEND_OPENCV && targetId == DNN_TARGET_CPU)) &&
+        eltwiseOp == "sum" && !weightedEltwise)
         expectedFusedLayers.push_back(eltwiseId);
     TestLayerFusion::test(input, net, backendId, targetId, expectedFusedLayers);
 }
@@ -2428,7 +2510,11 @@ TEST_P(ConvolutionEltwiseActivationFusion, Accuracy)
     if (backendId == DNN_BACKEND_OPENCV)
     {
         if (targetId == DNN_TARGET_CPU)
-            expectedFusedLayers.push_back(activId); // activation is fused with eltwise layer
+        {
+            if (eltwiseOp == "sum" && !weightedEltwise)
+                expectedFusedLayers.push_back(eltwiseId); // eltwise sum and activation are fused with convolution
+            expectedFusedLayers.push_back(activId); // otherwise activation is fused with eltwise layer
+        }
         else if (targetId == DNN_TARGET_OPENCL || targetId == DNN_TARGET_OPENCL_FP16)
         {
             if (eltwiseOp == "sum" && !weightedEltwise &&
@@ -2544,4 +2630,527 @@ INSTANTIATE_TEST_CASE_P(TestLayerFusion, ConvolutionActivationEltwiseFusion, Com
                         TestLayerFusion::dnnBackendsAndTargetsForFusionTests()
 ));
 
+typedef TestWithParam<tuple<std::string, std::string> > LayerEltwiseActivationFusion_CPU;
+TEST_P(LayerEltwiseActivationFusion_CPU, Accuracy)
+{
+    //                 input
+    //                   |
+    //    -------------------------------
+    //    |                             |
+    //    |                 -------------------------
+    //    |                 | convolution / fc      |
+    //    |                 -------------------------
+    //    |                             |
+    //    |       ----------------      |
+    //    --------| eltwise sum  |-------
+    //            ----------------
+    //                   |
+    //            ----------------
+    //            |  activation  |
+    //            ----------------
+    //                   |
+    //                output
+
+    std::string kind = get<0>(GetParam());
+    std::string actType = get<1>(GetParam());
+    const int batch_size = 2, in_channels = 16;
+    // enough tiles to choose Winograd convolution
+    const int in_size = kind == "Winograd" ? 32 : kind == "InnerProduct" ? 4 : 16;
+    int inputShape[] = {batch_size, in_channels, in_size, in_size};
+    Mat input(4, &inputShape[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    LayerParams lp;
+    if (kind == "InnerProduct")
+    {
+        const int numInputs = in_channels * in_size * in_size, numOutputs = numInputs;
+        input = input.reshape(1, batch_size);
+        lp.type = "InnerProduct";
+        lp.name = "fc";
+        lp.set("num_output", numOutputs);
+        lp.set("bias_term", true);
+        lp.blobs.push_back(Mat(numOutputs, numInputs, CV_32F));
+        lp.blobs.push_back(Mat(1, numOutputs, CV_32F));
+        randu(lp.blobs[0], -1.0f / numInputs, 1.0f / numInputs);
+        randu(lp.blobs[1], -1.0f, 1.0f);
+    }
+    else if (kind == "Depthwise")
+    {
+        // 5x5 kernel to use the generic depthwise implementation
+        lp.type = "Convolution";
+        lp.name = "convolution";
+        lp.set("kernel_size", 5);
+        lp.set("pad", 2);
+        lp.set("group", in_channels);
+        lp.set("num_output", in_channels);
+        lp.set("bias_term", true);
+        int weightsShape[] = {in_channels, 1, 5, 5};
+        lp.blobs.push_back(Mat(4, &weightsShape[0], CV_32F));
+        lp.blobs.push_back(Mat(1, in_channels, CV_32F));
+        randu(lp.blobs[0], -1.0f / 25, 1.0f / 25);
+        randu(lp.blobs[1], -1.0f, 1.0f);
+    }
+    else
+        TestLayerFusion::makeDefaultTestConvolutionLayer(lp, in_channels, in_channels, true);
+
+    LayerParams eltwiseParams;
+    TestLayerFusion::makeDefaultTestEltwiseLayer(eltwiseParams, "sum", false);
+    LayerParams activationParams;
+    TestLayerFusion::makeDefaultTestActivationLayer(activationParams, actType, in_channels);
+
+    Net net;
+    int layerId = net.addLayer(lp.name, lp.type, lp);
+    int eltwiseId = net.addLayer(eltwiseParams.name, eltwiseParams.type, eltwiseParams);
+    int activId = net.addLayer(activationParams.name, activationParams.type, activationParams);
+    net.connect(0, 0, layerId, 0);
+    net.connect(layerId, 0, eltwiseId, 0);
+    net.connect(0, 0, eltwiseId, 1);
+    net.connect(eltwiseId, 0, activId, 0);
+
+    std::vector<int> expectedFusedLayers;
+    expectedFusedLayers.push_back(eltwiseId);
+    expectedFusedLayers.push_back(activId);
+    TestLayerFusion::test(input, net, DNN_BACKEND_OPENCV, DNN_TARGET_CPU, expectedFusedLayers);
+}
+INSTANTIATE_TEST_CASE_P(TestLayerFusion, LayerEltwiseActivationFusion_CPU, Combine(
+/* layer */             Values("Convolution", "Winograd", "Depthwise", "InnerProduct"),
+/* activation */        Values("ReLU", "ReLU6", "TanH", "Swish")
+));
+
+TEST(TestLayerFusion, ResidualBlocks_CPU)
+{
+    // input -> [conv -> relu -> conv -> sum(block input) -> relu] x 3 -> output
+    // the fused sums are computed to their outputs, which must not overlap the blobs used by the convolutions
+    const int channels = 8;
+    int inputShape[] = {1, channels, 16, 16};
+    Mat input(4, &inputShape[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Net net;
+    int blockInputId = 0;
+    std::vector<int> expectedFusedLayers;
+    for (int i = 0; i < 3; i++)
+    {
+        LayerParams conv1Params, conv2Params, relu1Params, sumParams, relu2Params;
+        TestLayerFusion::makeDefaultTestConvolutionLayer(conv1Params, channels, channels, true);
+        TestLayerFusion::makeDefaultTestConvolutionLayer(conv2Params, channels, channels, true);
+        TestLayerFusion::makeDefaultTestActivationLayer(relu1Params, "ReLU", channels);
+        TestLayerFusion::makeDefaultTestEltwiseLayer(sumParams, "sum", false);
+        TestLayerFusion::makeDefaultTestActivationLayer(relu2Params, "ReLU", channels);
+
+        int conv1Id = net.addLayer(format("conv1_%d", i), conv1Params.type, conv1Params);
+        net.connect(blockInputId, 0, conv1Id, 0);
+        int relu1Id = net.addLayerToPrev(format("relu1_%d", i), relu1Params.type, relu1Params);
+        int conv2Id = net.addLayerToPrev(format("conv2_%d", i), conv2Params.type, conv2Params);
+        int sumId = net.addLayer(format("sum_%d", i), sumParams.type, sumParams);
+        net.connect(conv2Id, 0, sumId, 0);
+        net.connect(blockInputId, 0, sumId, 1);
+        blockInputId = net.addLayerToPrev(format("relu2_%d", i), relu2Params.type, relu2Params);
+
+        expectedFusedLayers.push_back(relu1Id);
+        expectedFusedLayers.push_back(sumId);
+        expectedFusedLayers.push_back(blockInputId);
+    }
+    TestLayerFusion::test(input, net, DNN_BACKEND_OPENCV, DNN_TARGET_CPU, expectedFusedLayers);
+}
+
+// Runs a single layer with several inputs on CPU
+static Mat forwardLayer(const std::string& type, LayerParams& lp, const std::vector<Mat>& inputs)
+{
+    Net net;
+    int id = net.addLayer("testLayer", type, lp);
+    std::vector<String> inpNames(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        inpNames[i] = format("input_%d", (int)i);
+        net.connect(0, (int)i, id, (int)i);
+    }
+    net.setInputsNames(inpNames);
+    for (size_t i = 0; i < inputs.size(); ++i)
+        net.setInput(inputs[i], inpNames[i]);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    return net.forward();
+}
+
+// Offset of the element of input broadcasted to the output shape by the linear index of output element
+static size_t broadcastOffset(const MatShape& outShape, const MatShape& inpShape, size_t idx)
+{
+    size_t offset = 0, step = 1;
+    for (int i = (int)outShape.size() - 1, j = (int)inpShape.size() - 1; i >= 0; i--, j--)
+    {
+        size_t coord = idx % outShape[i];
+        idx /= outShape[i];
+        if (j < 0)
+            continue;
+        if (inpShape[j] != 1)
+            offset += coord * step;
+        step *= inpShape[j];
+    }
+    return offset;
+}
+
+static Mat randomMat(const MatShape& shape, float low = -1.f, float high = 1.f)
+{
+    Mat m(shape, CV_32F);
+    randu(m, low, high);
+    return m;
+}
+
+typedef testing::TestWithParam<tuple<int, bool> > Layer_Test_LayerNorm;
+TEST_P(Layer_Test_LayerNorm, Accuracy)
+{
+    const int axis = get<0>(GetParam());
+    const bool hasBias = get<1>(GetParam());
+    int inpShape[] = {2, 3, 5, 17};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -5.f, 10.f);
+
+    const int normSize = (int)input.total(axis + 4);
+    Mat scale = randomMat(MatShape(1, normSize)), bias = randomMat(MatShape(1, normSize));
+    LayerParams lp;
+    lp.set("axis", axis);
+    lp.set("epsilon", 1e-3f);
+    lp.blobs.push_back(scale);
+    if (hasBias)
+        lp.blobs.push_back(bias);
+    Mat out = forwardLayer("LayerNormalization", lp, std::vector<Mat>(1, input));
+
+    Mat ref(4, inpShape, CV_32F);
+    for (size_t i = 0; i < input.total(); i += normSize)
+    {
+        const float* x = input.ptr<float>() + i;
+        double mean = 0, var = 0;
+        for (int j = 0; j < normSize; j++)
+            mean += x[j];
+        mean /= normSize;
+        for (int j = 0; j < normSize; j++)
+            var += (x[j] - mean) * (x[j] - mean);
+        var /= normSize;
+        for (int j = 0; j < normSize; j++)
+            ref.ptr<float>()[i + j] = (float)((x[j] - mean) / std::sqrt(var + 1e-3) * scale.at<float>(j) +
+                                              (hasBias ? bias.at<float>(j) : 0.f));
+    }
+    normAssert(ref, out, "", 1e-5, 1e-4);
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_LayerNorm, Combine(Values(-1, -2, -3), testing::Bool()));
+
+TEST(Layer_Test_GELU, Accuracy)
+{
+    int inpShape[] = {2, 7, 33};
+    Mat input(3, inpShape, CV_32F);
+    randu(input, -6.f, 6.f);
+    for (int approximate = 0; approximate < 2; approximate++)
+    {
+        LayerParams lp;
+        if (approximate)
+            lp.set("approximate", "tanh");
+        Mat out = forwardLayer("GELU", lp, std::vector<Mat>(1, input));
+        Mat ref(3, inpShape, CV_32F);
+        for (size_t i = 0; i < input.total(); i++)
+        {
+            double x = input.ptr<float>()[i];
+            ref.ptr<float>()[i] = (float)(approximate ? 0.5 * x * (1 + std::tanh(std::sqrt(2 / CV_PI) * (x + 0.044715 * x * x * x)))
+                                                      : 0.5 * x * (1 + std::erf(x / std::sqrt(2.))));
+        }
+        normAssert(ref, out, approximate ? "tanh" : "erf", 1e-6, 1e-5);
+    }
+
+    LayerParams lp;
+    Mat out = forwardLayer("Erf", lp, std::vector<Mat>(1, input));
+    Mat ref(3, inpShape, CV_32F);
+    for (size_t i = 0; i < input.total(); i++)
+        ref.ptr<float>()[i] = std::erf(input.ptr<float>()[i]);
+    normAssert(ref, out, "Erf", 1e-6, 1e-5);
+}
+
+TEST(Layer_Test_Where, Broadcasting)
+{
+    MatShape condShape = shape(3, 1, 5), xShape = shape(2, 1, 4, 1), yShape = shape(1, 5), outShape = shape(2, 3, 4, 5);
+    Mat cond = randomMat(condShape), x = randomMat(xShape), y = randomMat(yShape);
+    cond = cond > 0;
+    cond.convertTo(cond, CV_32F);
+
+    std::vector<Mat> inputs;
+    inputs.push_back(cond);
+    inputs.push_back(x);
+    inputs.push_back(y);
+    LayerParams lp;
+    Mat out = forwardLayer("Where", lp, inputs);
+    ASSERT_EQ(shape(out), outShape);
+
+    Mat ref(outShape, CV_32F);
+    for (size_t i = 0; i < ref.total(); i++)
+    {
+        bool c = cond.ptr<float>()[broadcastOffset(outShape, condShape, i)] != 0;
+        ref.ptr<float>()[i] = c ? x.ptr<float>()[broadcastOffset(outShape, xShape, i)]
+                                : y.ptr<float>()[broadcastOffset(outShape, yShape, i)];
+    }
+    normAssert(ref, out);
+}
+
+// a shape, b shape, output shape, constant input (-1 for none)
+typedef testing::TestWithParam<tuple<MatShape, MatShape, MatShape, int> > Layer_Test_MatMul;
+TEST_P(Layer_Test_MatMul, Accuracy)
+{
+    MatShape aShape = get<0>(GetParam()), bShape = get<1>(GetParam()), outShape = get<2>(GetParam());
+    const int constInput = get<3>(GetParam());
+    Mat a = randomMat(aShape), b = randomMat(bShape);
+
+    LayerParams lp;
+    std::vector<Mat> inputs;
+    if (constInput == -1)
+    {
+        inputs.push_back(a);
+        inputs.push_back(b);
+    }
+    else
+    {
+        lp.blobs.push_back(constInput == 0 ? a : b);
+        lp.set("const_input", constInput);
+        inputs.push_back(constInput == 0 ? b : a);
+    }
+    Mat out = forwardLayer("MatMul", lp, inputs);
+    ASSERT_EQ(shape(out), outShape);
+
+    // promote vectors to matrices and compute batches of matrix products
+    MatShape aMat = aShape, bMat = bShape;
+    if (aMat.size() == 1)
+        aMat.insert(aMat.begin(), 1);
+    if (bMat.size() == 1)
+        bMat.push_back(1);
+    const int M = aMat[aMat.size() - 2], K = aMat.back(), N = bMat.back();
+    MatShape aBatch(aMat.begin(), aMat.end() - 2), bBatch(bMat.begin(), bMat.end() - 2);
+    MatShape batch(std::max(aBatch.size(), bBatch.size()), 1);
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        int ai = (int)(i + aBatch.size()) - (int)batch.size(), bi = (int)(i + bBatch.size()) - (int)batch.size();
+        batch[i] = std::max(ai >= 0 ? aBatch[ai] : 1, bi >= 0 ? bBatch[bi] : 1);
+    }
+    const size_t numBatches = total(batch) ? total(batch) : 1;
+    Mat ref(1, (int)(numBatches * M * N), CV_32F);
+    for (size_t n = 0; n < numBatches; n++)
+    {
+        const float* aptr = a.ptr<float>() + (aBatch.empty() ? 0 : broadcastOffset(batch, aBatch, n)) * M * K;
+        const float* bptr = b.ptr<float>() + (bBatch.empty() ? 0 : broadcastOffset(batch, bBatch, n)) * K * N;
+        for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+        {
+            double sum = 0;
+            for (int k = 0; k < K; k++)
+                sum += (double)aptr[i * K + k] * bptr[k * N + j];
+            ref.ptr<float>()[(n * M + i) * N + j] = (float)sum;
+        }
+    }
+    normAssert(ref, out.reshape(1, 1), "", 1e-5 * K, 1e-4 * K);
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_MatMul, Values(
+    make_tuple(shape(2, 3, 4, 5), shape(5, 6), shape(2, 3, 4, 6), -1),
+    make_tuple(shape(2, 3, 4, 5), shape(5, 6), shape(2, 3, 4, 6), 1),
+    make_tuple(shape(4, 5), shape(2, 3, 5, 6), shape(2, 3, 4, 6), 0),
+    make_tuple(shape(3, 1, 17, 37), shape(2, 37, 300), shape(3, 2, 17, 300), -1),
+    make_tuple(shape(2, 1, 4, 5), shape(1, 3, 5, 6), shape(2, 3, 4, 6), -1),
+    make_tuple(shape(1, 5), shape(2, 5, 3), shape(2, 1, 3), -1),
+    make_tuple(shape(2, 3, 5), shape(5, 1), shape(2, 3, 1), 1)
+));
+
+// Multiplication of two variable inputs with the same batch dimensions by InnerProduct
+TEST(Layer_Test_InnerProduct, two_inputs)
+{
+    Mat a = randomMat(shape(3, 2, 7, 19)), b = randomMat(shape(3, 2, 19, 33));
+    std::vector<Mat> inputs;
+    inputs.push_back(a);
+    inputs.push_back(b);
+    LayerParams lp;
+    lp.set("bias_term", false);
+    lp.set("axis", 1);
+    Mat out = forwardLayer("InnerProduct", lp, inputs);
+    ASSERT_EQ(shape(out), shape(3, 2, 7, 33));
+
+    Mat ref(shape(3, 2, 7, 33), CV_32F);
+    for (int n = 0; n < 6; n++)
+    {
+        Mat aSlice(7, 19, CV_32F, a.ptr<float>() + n * 7 * 19);
+        Mat bSlice(19, 33, CV_32F, b.ptr<float>() + n * 19 * 33);
+        Mat refSlice(7, 33, CV_32F, ref.ptr<float>() + n * 7 * 33);
+        Mat(aSlice * bSlice).copyTo(refSlice);
+    }
+    normAssert(ref, out, "", 1e-5, 1e-4);
+}
+
+// Naive implementation of einsum without ellipsis
+static Mat einsumReference(const std::string& equation, const std::vector<Mat>& inputs)
+{
+    size_t arrow = equation.find("->");
+    std::string lhs = equation.substr(0, arrow), outLabels = equation.substr(arrow + 2);
+    std::vector<std::string> inpLabels;
+    for (size_t start = 0;;)
+    {
+        size_t comma = lhs.find(',', start);
+        inpLabels.push_back(lhs.substr(start, comma - start));
+        if (comma == std::string::npos)
+            break;
+        start = comma + 1;
+    }
+    std::map<char, int> sizes;
+    for (size_t i = 0; i < inputs.size(); i++)
+        for (size_t j = 0; j < inpLabels[i].size(); j++)
+            sizes[inpLabels[i][j]] = inputs[i].size[(int)j];
+    std::vector<char> labels;
+    for (std::map<char, int>::iterator it = sizes.begin(); it != sizes.end(); ++it)
+        labels.push_back(it->first);
+
+    MatShape outShape;
+    for (size_t j = 0; j < outLabels.size(); j++)
+        outShape.push_back(sizes[outLabels[j]]);
+    if (outShape.empty())
+        outShape.push_back(1);
+    Mat out(outShape, CV_32F, Scalar(0));
+
+    std::map<char, int> idx;
+    for (size_t i = 0; i < labels.size(); i++)
+        idx[labels[i]] = 0;
+    for (;;)
+    {
+        float prod = 1.f;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            size_t offset = 0;
+            for (size_t j = 0; j < inpLabels[i].size(); j++)
+                offset = offset * inputs[i].size[(int)j] + idx[inpLabels[i][j]];
+            prod *= inputs[i].ptr<float>()[offset];
+        }
+        size_t offset = 0;
+        for (size_t j = 0; j < outLabels.size(); j++)
+            offset = offset * outShape[j] + idx[outLabels[j]];
+        out.ptr<float>()[offset] += prod;
+
+        int i = (int)labels.size() - 1;
+        for (; i >= 0; i--)
+        {
+            if (++idx[labels[i]] < sizes[labels[i]])
+                break;
+            idx[labels[i]] = 0;
+        }
+        if (i < 0)
+            break;
+    }
+    return out;
+}
+
+// equation, equivalent equation without ellipsis and implicit output, shapes of inputs
+typedef testing::TestWithParam<tuple<std::string, std::string, std::vector<MatShape> > > Layer_Test_Einsum;
+TEST_P(Layer_Test_Einsum, Accuracy)
+{
+    const std::string equation = get<0>(GetParam()), refEquation = get<1>(GetParam());
+    const std::vector<MatShape> shapes = get<2>(GetParam());
+    std::vector<Mat> inputs;
+    for (size_t i = 0; i < shapes.size(); i++)
+        inputs.push_back(randomMat(shapes[i]));
+
+    LayerParams lp;
+    lp.set("equation", equation);
+    Mat out = forwardLayer("Einsum", lp, inputs);
+    Mat ref = einsumReference(refEquation, inputs);
+    ASSERT_EQ(shape(out), shape(ref));
+    normAssert(ref, out, "", 1e-5, 1e-4);
+}
+
+static std::vector<MatShape> einsumShapes(const MatShape& a, const MatShape& b = MatShape(), const MatShape& c = MatShape())
+{
+    std::vector<MatShape> shapes(1, a);
+    if (!b.empty())
+        shapes.push_back(b);
+    if (!c.empty())
+        shapes.push_back(c);
+    return shapes;
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_Einsum, Values(
+    make_tuple("ij,jk->ik", "ij,jk->ik", einsumShapes(shape(7, 5), shape(5, 9))),
+    make_tuple("bij,bjk->bik", "bij,bjk->bik", einsumShapes(shape(3, 7, 5), shape(3, 5, 9))),
+    make_tuple("bhqd,bhkd->bhqk", "bhqd,bhkd->bhqk", einsumShapes(shape(2, 3, 7, 8), shape(2, 3, 9, 8))),
+    make_tuple("bhqk,bkhd->bqhd", "bhqk,bkhd->bqhd", einsumShapes(shape(2, 3, 7, 9), shape(2, 9, 3, 8))),
+    make_tuple("ij->ji", "ij->ji", einsumShapes(shape(4, 6))),
+    make_tuple("ijk->j", "ijk->j", einsumShapes(shape(4, 6, 5))),
+    make_tuple("bi,bi->b", "bi,bi->b", einsumShapes(shape(3, 10), shape(3, 10))),
+    make_tuple("bi,bj->bij", "bi,bj->bij", einsumShapes(shape(2, 4), shape(2, 6))),
+    make_tuple("ij,jk,kl->il", "ij,jk,kl->il", einsumShapes(shape(3, 4), shape(4, 5), shape(5, 6))),
+    make_tuple("...ij,...jk->...ik", "aij,ajk->aik", einsumShapes(shape(3, 7, 5), shape(3, 5, 9))),
+    make_tuple("ba,ca", "ba,ca->bc", einsumShapes(shape(4, 6), shape(5, 6))),
+    make_tuple("...i->...", "abi->ab", einsumShapes(shape(2, 3, 5)))
+));
+
+// queries shape, mask shape (empty if not used), transposed keys
+typedef testing::TestWithParam<tuple<MatShape, MatShape, bool> > Layer_Test_Attention;
+TEST_P(Layer_Test_Attention, Accuracy)
+{
+    const MatShape qShape = get<0>(GetParam()), maskShape = get<1>(GetParam());
+    const bool keyTransposed = get<2>(GetParam());
+    const int dims = (int)qShape.size();
+    const int Sq = qShape[dims - 2], D = qShape[dims - 1], Sk = 11, Dv = 6;
+    MatShape kShape = qShape, vShape = qShape, outShape = qShape;
+    kShape[dims - 2] = keyTransposed ? D : Sk;
+    kShape[dims - 1] = keyTransposed ? Sk : D;
+    vShape[dims - 2] = Sk;
+    vShape[dims - 1] = Dv;
+    outShape[dims - 1] = Dv;
+    const float scale = 1.f / std::sqrt((float)D);
+
+    std::vector<Mat> inputs;
+    inputs.push_back(randomMat(qShape));
+    inputs.push_back(randomMat(kShape));
+    inputs.push_back(randomMat(vShape));
+    if (!maskShape.empty())
+        inputs.push_back(randomMat(maskShape, -3.f, 3.f));
+    LayerParams lp;
+    lp.set("scale", scale);
+    lp.set("key_transposed", keyTransposed);
+    Mat out = forwardLayer("Attention", lp, inputs);
+    ASSERT_EQ(shape(out), outShape);
+
+    MatShape scoresShape = qShape;
+    scoresShape[dims - 1] = Sk;
+    Mat ref(outShape, CV_32F);
+    const int numMatrices = (int)total(qShape, 0, dims - 2);
+    std::vector<double> scores(Sk);
+    for (int m = 0; m < numMatrices; m++)
+    for (int i = 0; i < Sq; i++)
+    {
+        const float* q = inputs[0].ptr<float>() + ((size_t)m * Sq + i) * D;
+        const float* k = inputs[1].ptr<float>() + (size_t)m * Sk * D;
+        const float* v = inputs[2].ptr<float>() + (size_t)m * Sk * Dv;
+        double maxScore = -DBL_MAX, sum = 0;
+        for (int j = 0; j < Sk; j++)
+        {
+            double s = 0;
+            for (int d = 0; d < D; d++)
+                s += q[d] * (keyTransposed ? k[d * Sk + j] : k[j * D + d]);
+            s *= scale;
+            if (!maskShape.empty())
+                s += inputs[3].ptr<float>()[broadcastOffset(scoresShape, maskShape, ((size_t)m * Sq + i) * Sk + j)];
+            scores[j] = s;
+            maxScore = std::max(maxScore, s);
+        }
+        for (int j = 0; j < Sk; j++)
+        {
+            scores[j] = std::exp(scores[j] - maxScore);
+            sum += scores[j];
+        }
+        float* dst = ref.ptr<float>() + ((size_t)m * Sq + i) * Dv;
+        for (int d = 0; d < Dv; d++)
+        {
+            double s = 0;
+            for (int j = 0; j < Sk; j++)
+                s += scores[j] / sum * v[j * Dv + d];
+            dst[d] = (float)s;
+        }
+    }
+    normAssert(ref, out, "", 1e-5, 1e-4);
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_Attention, Combine(
+/* queries */   Values(shape(2, 3, 7, 8), shape(7, 20)),
+/* mask */      Values(MatShape(), shape(1, 11), shape(7, 11), shape(7, 1)),
+/* transposed keys */ testing::Bool()
+));
+
 }} // namespace
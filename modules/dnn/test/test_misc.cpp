@@ -10,6 +10,8 @@
 #include <opencv2/core/opencl/ocl_defs.hpp>
 #include <opencv2/dnn/layer.details.hpp>  // CV_DNN_REGISTER_LAYER_CLASS
 
+#include <thread>
+
 namespace opencv_test { namespace {
 
 TEST(blobFromImage_4ch, Regression)
@@ -441,6 +443,238 @@ TEST(Net, forwardAndRetrieve)
     normAssert(outBlobs[0][1], inp.rowRange(2, 4), "second part");
 }
 
+TEST(Net, memory_planner)
+{
+    // conv1 -> relu1 -> conv2 -> conv3 -> sum(relu1, conv3) -> conv4 -> relu4
+    Net net;
+    std::vector<String> names;
+    for (int i = 0; i < 4; i++)
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 3);
+        lp.set("pad", 1);
+        lp.set("num_output", 8);
+        lp.set("bias_term", false);
+        int wshape[] = {8, i == 0 ? 3 : 8, 3, 3};
+        Mat weights(4, wshape, CV_32F);
+        randu(weights, -1.f, 1.f);
+        lp.blobs.push_back(weights);
+        names.push_back(format("conv%d", i + 1));
+        int id = net.addLayerToPrev(names.back(), "Convolution", lp);
+        if (i == 0 || i == 3)
+        {
+            LayerParams lpRelu;
+            names.push_back(format("relu%d", i + 1));
+            net.addLayerToPrev(names.back(), "ReLU", lpRelu);
+        }
+        if (i == 2)
+        {
+            LayerParams lpSum;
+            names.push_back("sum");
+            int sumId = net.addLayer(names.back(), "Eltwise", lpSum);
+            net.connect(net.getLayerId("relu1"), 0, sumId, 0);
+            net.connect(id, 0, sumId, 1);
+        }
+    }
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    int inpShape[] = {1, 3, 16, 16};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -1.f, 1.f);
+    MatShape netInputShape(inpShape, inpShape + 4);
+
+    // at most three blobs are alive at the same time (relu1, conv3 and sum)
+    const size_t inputBytes = inp.total() * sizeof(float);
+    const size_t blobBytes = 8 * 16 * 16 * sizeof(float);
+    size_t weights = 0, blobs = 0;
+    net.getMemoryConsumption(netInputShape, weights, blobs);
+    net.enableFusion(false);
+    size_t peak = net.getMemoryPeak(netInputShape);
+    EXPECT_LE(peak, inputBytes + 3 * blobBytes);
+    EXPECT_LT(peak, blobs);
+
+    // conv3 computes the sum to its output, which is reserved since conv3 (relu1, conv2, conv3 and sum)
+    net.enableFusion(true);
+    peak = net.getMemoryPeak(netInputShape);
+    EXPECT_LE(peak, inputBytes + 4 * blobBytes);
+    EXPECT_LT(peak, blobs);
+
+    // every intermediate blob is kept so memory is not reused
+    net.setInput(inp);
+    std::vector<Mat> outs;
+    net.forward(outs, names);
+    Mat ref = outs.back().clone();
+
+    net.setInput(inp);
+    Mat out = net.forward();
+    normAssert(ref, out);
+}
+
+TEST(Net, dumpProfile)
+{
+    LayerParams lp;
+    lp.set("kernel_size", 3);
+    lp.set("pad", 1);
+    lp.set("num_output", 8);
+    lp.set("bias_term", false);
+    int wshape[] = {8, 3, 3, 3};
+    Mat weights(4, wshape, CV_32F);
+    randu(weights, -1.f, 1.f);
+    lp.blobs.push_back(weights);
+
+    Net net;
+    int convId = net.addLayerToPrev("conv", "Convolution", lp);
+    LayerParams lpRelu;
+    net.addLayerToPrev("relu", "ReLU", lpRelu);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    int inpShape[] = {1, 3, 16, 16};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -1.f, 1.f);
+    MatShape netInputShape(inpShape, inpShape + 4);
+    net.setInput(inp);
+    net.forward();
+
+    FileStorage fs(net.dumpProfile(), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    FileNode layers = fs["layers"];
+    ASSERT_EQ(layers.size(), (size_t)2);
+    FileNode conv = layers[0], relu = layers[1];
+    EXPECT_EQ((std::string)conv["name"], "conv");
+    EXPECT_EQ((int)conv["fused"], 0);
+    EXPECT_GT((double)conv["time_ms"], 0.0);
+    EXPECT_EQ((double)conv["flops"], (double)net.getFLOPS(convId, netInputShape));
+    // input, output and weights
+    EXPECT_EQ((double)conv["bytes"], (double)(inp.total() + 8 * 16 * 16 + weights.total()) * sizeof(float));
+    EXPECT_GT((double)conv["gflops_per_sec"], 0.0);
+    EXPECT_NEAR((double)conv["arithmetic_intensity"], (double)conv["flops"] / (double)conv["bytes"], 1e-5);
+    // activation is fused into convolution
+    EXPECT_EQ((std::string)relu["type"], "ReLU");
+    EXPECT_EQ((int)relu["fused"], 1);
+    EXPECT_EQ((double)relu["time_ms"], 0.0);
+    EXPECT_EQ((double)fs["total"]["flops"], (double)net.getFLOPS(netInputShape));
+
+    FileStorage trace(net.dumpProfile("trace"), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    FileNode events = trace["traceEvents"];
+    ASSERT_EQ(events.size(), (size_t)1);
+    EXPECT_EQ((std::string)events[0]["name"], "conv");
+    EXPECT_EQ((std::string)events[0]["ph"], "X");
+    EXPECT_GT((double)events[0]["dur"], 0.0);
+
+    EXPECT_ANY_THROW(net.dumpProfile("xml"));
+}
+
+static Net createInferenceQueueTestNet()
+{
+    LayerParams lp;
+    lp.set("kernel_size", 3);
+    lp.set("pad", 1);
+    lp.set("num_output", 4);
+    lp.set("bias_term", false);
+    int wshape[] = {4, 3, 3, 3};
+    Mat weights(4, wshape, CV_32F);
+    randu(weights, -1.f, 1.f);
+    lp.blobs.push_back(weights);
+
+    Net net;
+    net.addLayerToPrev("conv", "Convolution", lp);
+    LayerParams lpRelu;
+    net.addLayerToPrev("relu", "ReLU", lpRelu);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    return net;
+}
+
+TEST(InferenceQueue, dynamic_batching)
+{
+    Net net = createInferenceQueueTestNet();
+    const int numRequests = 10;
+    std::vector<Mat> inputs(numRequests), refs(numRequests);
+    for (int i = 0; i < numRequests; i++)
+    {
+        int shape[] = {1, 3, 8, 8};
+        inputs[i].create(4, shape, CV_32F);
+        randu(inputs[i], -1.f, 1.f);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    Ptr<InferenceQueue> queue = InferenceQueue::create(net, 4, 200);
+    std::vector<AsyncArray> results;
+    for (int i = 0; i < numRequests; i++)
+        results.push_back(queue->enqueue(inputs[i]));
+    for (int i = 0; i < numRequests; i++)
+    {
+        Mat out;
+        results[i].get(out);
+        normAssert(refs[i], out, format("request %d", i).c_str());
+    }
+
+    // 4 + 4 + 2 samples
+    int64 numBatches = 0, numSamples = 0;
+    queue->getStatistics(numBatches, numSamples);
+    EXPECT_EQ(numSamples, numRequests);
+    EXPECT_EQ(numBatches, 3);
+    EXPECT_EQ(queue->getNumPendingRequests(), 0);
+}
+
+TEST(InferenceQueue, multiple_threads)
+{
+    Net net = createInferenceQueueTestNet();
+    const int numThreads = 4, numRequests = 6;
+    // requests of different spatial sizes and number of samples are batched separately
+    std::vector<std::vector<Mat> > inputs(numThreads), refs(numThreads);
+    for (int t = 0; t < numThreads; t++)
+    {
+        for (int i = 0; i < numRequests; i++)
+        {
+            int shape[] = {1 + i % 2, 3, 8 + t % 2, 8};
+            Mat input(4, shape, CV_32F);
+            randu(input, -1.f, 1.f);
+            net.setInput(input);
+            inputs[t].push_back(input);
+            refs[t].push_back(net.forward().clone());
+        }
+    }
+
+    Ptr<InferenceQueue> queue = InferenceQueue::create(net, 8, 5);
+    std::vector<std::vector<Mat> > outputs(numThreads, std::vector<Mat>(numRequests));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.push_back(std::thread([&, t]()
+        {
+            std::vector<AsyncArray> results;
+            for (int i = 0; i < numRequests; i++)
+                results.push_back(queue->enqueue(inputs[t][i]));
+            for (int i = 0; i < numRequests; i++)
+                results[i].get(outputs[t][i]);
+        }));
+    }
+    for (int t = 0; t < numThreads; t++)
+        threads[t].join();
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        for (int i = 0; i < numRequests; i++)
+            normAssert(refs[t][i], outputs[t][i], format("thread %d, request %d", t, i).c_str());
+    }
+    int64 numBatches = 0, numSamples = 0;
+    queue->getStatistics(numBatches, numSamples);
+    EXPECT_EQ(numSamples, numThreads * numRequests / 2 * 3);
+}
+
+TEST(InferenceQueue, error)
+{
+    Net net = createInferenceQueueTestNet();
+    Ptr<InferenceQueue> queue = InferenceQueue::create(net, 4, 1);
+    int badShape[] = {1, 5, 8, 8};
+    Mat input(4, badShape, CV_32F, Scalar(1));
+    AsyncArray result = queue->enqueue(input);
+    Mat out;
+    EXPECT_THROW(result.get(out), cv::Exception);
+}
+
 #ifdef HAVE_INF_ENGINE
 static const std::chrono::milliseconds async_timeout(10000);
 
@@ -90,6 +90,7 @@ enum ImwriteFlags {
        IMWRITE_JPEG_RST_INTERVAL   = 4,  //!< JPEG restart interval, 0 - 65535, default is 0 - no restart.
        IMWRITE_JPEG_LUMA_QUALITY   = 5,  //!< Separate luma quality level, 0 - 100, default is 0 - don't use.
        IMWRITE_JPEG_CHROMA_QUALITY = 6,  //!< Separate chroma quality level, 0 - 100, default is 0 - don't use.
+       IMWRITE_JPEG_PARALLEL       = 7,  //!< Encode horizontal stripes of the image in parallel, 0 or 1, default is 0. The stripes are separated by restart markers: 8 MCU rows each or as defined by IMWRITE_JPEG_RST_INTERVAL, if it is a multiple of the number of MCUs in a row. Ignored for progressive and optimized JPEG. Images with such restart intervals are decoded in parallel too.
        IMWRITE_PNG_COMPRESSION     = 16, //!< For PNG, it can be the compression level from 0 to 9. A higher value means a smaller size and longer compression time. If specified, strategy is changed to IMWRITE_PNG_STRATEGY_DEFAULT (Z_DEFAULT_STRATEGY). Default value is 1 (best speed setting).
        IMWRITE_PNG_STRATEGY        = 17, //!< One of cv::ImwritePNGFlags, default is IMWRITE_PNG_STRATEGY_RLE.
        IMWRITE_PNG_BILEVEL         = 18, //!< Binary level PNG, 0 or 1, default is 0.
@@ -205,6 +206,26 @@ Currently, the following file formats are supported:
 */
 CV_EXPORTS_W Mat imread( const String& filename, int flags = IMREAD_COLOR );
 
+/** @brief Loads a rectangular region of an image from a file.
+
+The function returns the same pixels as `imread(filename, flags)(roi)`, but decoders which are able
+to do so decode only the part of the image covering the region, saving time and memory on large images:
+-   TIFF files: only the tiles or strips intersecting the region are decoded.
+-   JPEG files (with libjpeg-turbo): rows above the region are skipped without full decoding, only
+    the columns of the region are decoded and decoding stops after its last row.
+-   PNG files: decoding stops after the last row of the region. Interlaced images are decoded completely.
+
+Other formats, and images loaded with one of IMREAD_REDUCED_* flags in the formats which can't
+reduce the image natively, are decoded completely and then cropped.
+
+@param filename Name of file to be loaded.
+@param roi Region of interest in coordinates of the image returned by imread() with the same flags,
+i.e. after EXIF orientation and reduction are applied. It must lie inside the image, otherwise
+an exception is thrown. An empty rectangle stands for the whole image.
+@param flags Flag that can take values of cv::ImreadModes
+*/
+CV_EXPORTS_W Mat imread( const String& filename, const Rect& roi, int flags = IMREAD_COLOR );
+
 /** @brief Loads a multi-page image from a file.
 
 The function imreadmulti loads a multi-page image from the specified file into a vector of Mat objects.
@@ -235,6 +256,40 @@ The function imcount will return the number of pages in a multi-page image, or 1
 */
 CV_EXPORTS_W size_t imcount(const String& filename, int flags = IMREAD_ANYCOLOR);
 
+/** @brief Image properties read from its header by cv::imreadInfo and cv::imdecodeInfo
+*/
+struct CV_EXPORTS_W_SIMPLE ImageInfo
+{
+    CV_WRAP ImageInfo() : type(-1), pages(0), orientation(1) {}
+
+    CV_PROP_RW Size size;    //!< size of the image as it is stored, i.e. before the EXIF orientation is applied
+    CV_PROP_RW int type;     //!< type of the image read with cv::IMREAD_UNCHANGED flag
+    CV_PROP_RW int pages;    //!< number of pages (images) in the file, see cv::imcount
+    CV_PROP_RW int orientation; //!< EXIF orientation, 1 to 8, or 1 if it is not stored (before the image data)
+};
+
+/** @brief Reads the properties of an image from the header of the specified file.
+
+The function finds the decoder of the file and reads the image header only, no pixels are decoded.
+Pages of multi-page images are counted by their headers too. The orientation is reported by the decoders
+of JPEG and PNG images (unless it is stored after the image data in the latter).
+
+@param filename Name of file to be probed.
+@param info Output properties of the image.
+@return true if the header is read successfully.
+*/
+CV_EXPORTS_W bool imreadInfo( const String& filename, CV_OUT ImageInfo& info );
+
+/** @brief Reads the properties of an image from the header of the image in the memory buffer.
+
+See cv::imreadInfo.
+
+@param buf Input array or vector of bytes.
+@param info Output properties of the image.
+@return true if the header is read successfully.
+*/
+CV_EXPORTS_W bool imdecodeInfo( InputArray buf, CV_OUT ImageInfo& info );
+
 /** @brief Saves an image to a specified file.
 
 The function imwrite saves the image to the specified file. The image format is chosen based on the
@@ -296,6 +351,38 @@ reallocations when the function is called repeatedly for images of the same size
 */
 CV_EXPORTS Mat imdecode( InputArray buf, int flags, Mat* dst);
 
+/** @brief Reads an image from a buffer in memory into the given matrix.
+
+Unlike cv::imdecode, the function doesn't allocate the destination if it is not empty: the decoder writes
+the pixels, converted to the requested color format, directly to it. The destination may be a submatrix
+(e.g. an image of a preallocated batch of images) or UMat, which is mapped to the host memory while decoding.
+If the image is resized because of IMREAD_REDUCED_* flags (for the formats not supporting reduced decoding)
+or rotated according to the EXIF orientation, it is decoded into a temporary buffer and copied then.
+
+@param buf Input array or vector of bytes.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param dst The destination matrix. It must have the size and the type of the decoded image (see cv::imdecodeInfo),
+otherwise an exception is thrown. If it is empty, it is allocated as in cv::imdecode.
+@return true if the image is decoded successfully. The content of the destination is undefined otherwise.
+*/
+CV_EXPORTS_W bool imdecodeInto( InputArray buf, int flags, InputOutputArray dst );
+
+/** @brief Reads several images from buffers in memory in parallel.
+
+The function decodes every buffer as cv::imdecode does, but the images are processed concurrently
+(see cv::parallel_for_) and the decoder objects, including the state of the underlying codec libraries
+where possible, are reused by every thread for the following images of the same format. It makes the
+function much faster than a loop of imdecode calls for a large number of small images like thumbnails.
+
+@param bufs Input vector of buffers (vectors of bytes or single-row 8-bit matrices), one per image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param dst Output vector of decoded images of the same size as bufs. The images which can't be decoded
+are empty. The matrices, which are already in the vector, are reused when they have the size and type
+of the decoded images.
+@return true if all the images are decoded successfully.
+*/
+CV_EXPORTS_W bool imdecodeBatch( InputArrayOfArrays bufs, int flags, CV_OUT std::vector<Mat>& dst );
+
 /** @brief Encodes an image into a memory buffer.
 
 The function imencode compresses the image and stores it in the memory buffer that is resized to fit the
@@ -322,6 +409,102 @@ CV_EXPORTS_W bool haveImageReader( const String& filename );
  */
 CV_EXPORTS_W bool haveImageWriter( const String& filename );
 
+/** @brief Reads an image from a file by bands of rows.
+
+The class allows to process images which don't fit into memory. TIFF (with the default top-left
+orientation), non-interlaced PNG, JPEG and PBM/PGM/PPM/PNM files are decoded by rows, so the memory
+usage is bounded by the size of the band (TIFF strips or tiles intersecting the band are decoded,
+so band heights multiple to the strip height are the most efficient ones). Other files are decoded
+completely on the first read() call and have the same image size limits as imread().
+
+Unlike imread(), EXIF orientation is not applied.
+
+@code
+    Ptr<ImageReader> reader = ImageReader::create("huge.tif");
+    Ptr<ImageWriter> writer = ImageWriter::create("huge.jpg", reader->size(), reader->type());
+    Mat band;
+    while (reader->read(band, 256))
+        writer->write(band);
+    writer->close();
+@endcode
+ */
+class CV_EXPORTS_W ImageReader
+{
+public:
+    virtual ~ImageReader();
+
+    /** @brief Opens the image file and reads its header.
+
+    @param filename Name of file to be loaded.
+    @param flags Flag that can take values of cv::ImreadModes. IMREAD_REDUCED_* modes are not supported.
+    @return The reader or empty pointer if the file can't be decoded.
+    */
+    CV_WRAP static Ptr<ImageReader> create( const String& filename, int flags = IMREAD_COLOR );
+
+    /** @brief Returns the image size. */
+    CV_WRAP virtual Size size() const = 0;
+
+    /** @brief Returns the type of the bands. */
+    CV_WRAP virtual int type() const = 0;
+
+    /** @brief Returns the image row which the next band starts from. */
+    CV_WRAP virtual int nextRow() const = 0;
+
+    /** @brief Decodes the next band of rows.
+
+    @param band Output band of min(maxRows, size().height - nextRow()) rows.
+    @param maxRows Maximum number of rows to read.
+    @return false if all the rows are already read or the decoding failed.
+    */
+    CV_WRAP virtual bool read( OutputArray band, int maxRows ) = 0;
+};
+
+/** @brief Writes an image to a file by bands of rows.
+
+TIFF, PNG, JPEG and PBM/PGM/PPM/PNM files are encoded by rows, so the memory usage doesn't depend on
+the image height. Images of other formats are collected in memory and saved by close().
+
+@sa ImageReader
+ */
+class CV_EXPORTS_W ImageWriter
+{
+public:
+    /** @brief Closes the file. */
+    virtual ~ImageWriter();
+
+    /** @brief Creates the file and writes its header.
+
+    @param filename Name of the file, the format is chosen by the extension as in imwrite().
+    @param size Size of the image.
+    @param type Type of the bands, with 1, 3 or 4 channels. The bands are converted to 8-bit
+    if the format doesn't support the depth.
+    @param params Format-specific parameters, see cv::imwrite.
+    */
+    CV_WRAP static Ptr<ImageWriter> create( const String& filename, Size size, int type,
+                                            const std::vector<int>& params = std::vector<int>() );
+
+    /** @brief Returns the image size. */
+    CV_WRAP virtual Size size() const = 0;
+
+    /** @brief Returns the image row which the next band is written to. */
+    CV_WRAP virtual int nextRow() const = 0;
+
+    /** @brief Writes the next band of rows.
+
+    @param band Band of the image width and the type passed to create().
+    It must not exceed the image height.
+    @return false if the encoding failed.
+    */
+    CV_WRAP virtual bool write( InputArray band ) = 0;
+
+    /** @brief Completes the file.
+
+    @return false if the encoding failed or not all the image rows were written, the file is
+    incomplete then.
+    */
+    CV_WRAP virtual bool close() = 0;
+};
+
 
 //! @} imgcodecs
 
@@ -64,6 +64,7 @@ bool BaseImageDecoder::setSource( const String& filename )
 {
     m_filename = filename;
     m_buf.release();
+    m_exif = ExifReader(); // the decoder may be reused for several images
     return true;
 }
 
@@ -73,6 +74,7 @@ bool BaseImageDecoder::setSource( const Mat& buf )
         return false;
     m_filename = String();
     m_buf = buf;
+    m_exif = ExifReader();
     return true;
 }
 
@@ -94,6 +96,22 @@ int BaseImageDecoder::setScale( const int& scale_denom )
     return temp;
 }
 
+bool BaseImageDecoder::readRegion( Mat& img, const Rect& roi )
+{
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    CV_Assert(img.size() == roi.size());
+    Mat full(m_height, m_width, img.type());
+    if (!readData(full))
+        return false;
+    full(roi).copyTo(img);
+    return true;
+}
+
+bool BaseImageDecoder::readRows( Mat& )
+{
+    return false;
+}
+
 ImageDecoder BaseImageDecoder::newDecoder() const
 {
     return ImageDecoder();
@@ -137,6 +155,21 @@ bool BaseImageEncoder::writemulti(const std::vector<Mat>&, const std::vector<int
     return false;
 }
 
+bool BaseImageEncoder::startRows( Size, int, const std::vector<int>& )
+{
+    return false;
+}
+
+bool BaseImageEncoder::writeRows( const Mat& )
+{
+    return false;
+}
+
+bool BaseImageEncoder::finishRows()
+{
+    return false;
+}
+
 ImageEncoder BaseImageEncoder::newEncoder() const
 {
     return ImageEncoder();
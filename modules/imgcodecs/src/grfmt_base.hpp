@@ -73,6 +73,15 @@ public:
     virtual bool readHeader() = 0;
     virtual bool readData( Mat& img ) = 0;
 
+    /// Decodes the rectangular part of the image into img, which is allocated by the caller
+    /// with roi.size(). The default implementation decodes the whole image and crops it.
+    virtual bool readRegion( Mat& img, const Rect& roi );
+
+    /// Streaming decoding: every call after readHeader() decodes the next img.rows rows of the image
+    /// into img (of the same type for all the calls). Returns false from the first call without consuming
+    /// any data if the decoder can't decode the image by rows, so readData() may be used instead.
+    virtual bool readRows( Mat& img );
+
     /// Called after readData to advance to the next page, if any.
     virtual bool nextPage() { return false; }
 
@@ -106,6 +115,13 @@ public:
     virtual bool write( const Mat& img, const std::vector<int>& params ) = 0;
     virtual bool writemulti(const std::vector<Mat>& img_vec, const std::vector<int>& params);
 
+    /// Streaming encoding: startRows() writes the header of the image with the given size and type,
+    /// writeRows() appends the consecutive bands of rows and finishRows() completes the file.
+    /// Encoders which can't write images by rows return false from startRows().
+    virtual bool startRows( Size size, int type, const std::vector<int>& params );
+    virtual bool writeRows( const Mat& rows );
+    virtual bool finishRows();
+
     virtual String getDescription() const;
     virtual ImageEncoder newEncoder() const;
 
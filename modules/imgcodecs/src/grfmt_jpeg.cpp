@@ -86,6 +86,17 @@ extern "C" {
   #undef CV_MANUAL_JPEG_STD_HUFF_TABLES
 #endif
 
+#ifndef CV_JPEG_PARTIAL_DECODE
+  #if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+    #define CV_JPEG_PARTIAL_DECODE 1  // jpeg_skip_scanlines() / jpeg_crop_scanline() are available
+  #else
+    #define CV_JPEG_PARTIAL_DECODE 0
+  #endif
+#endif
+#if CV_JPEG_PARTIAL_DECODE == 0
+  #undef CV_JPEG_PARTIAL_DECODE
+#endif
+
 namespace cv
 {
 
@@ -106,8 +117,21 @@ struct JpegState
     jpeg_decompress_struct cinfo; // IJG JPEG codec structure
     JpegErrorMgr jerr; // error processing manager state
     JpegSource source; // memory buffer source
+    JSAMPARRAY rowBuffer; // scanline buffer of streaming decoding (JpegDecoder::readRows)
+    bool memSource; // the source is a memory buffer, the state may be reused for the next image
 };
 
+static void destroyJpegState( void*& _state )
+{
+    JpegState* state = (JpegState*)_state;
+    if( state )
+    {
+        jpeg_destroy_decompress( &state->cinfo );
+        delete state;
+        _state = 0;
+    }
+}
+
 /////////////////////// Error processing /////////////////////
 
 METHODDEF(void)
@@ -172,6 +196,44 @@ error_exit( j_common_ptr cinfo )
 }
 
 
+/////////////////////// Restart interval stripes ///////////////////
+
+// Finds the frame header (SOF marker), the first scan header (SOS marker) and the end of the latter in the stream
+static bool findJpegHeaders( const uchar* data, size_t size, size_t& sofPos, size_t& sosPos, size_t& sosEnd )
+{
+    if( size < 4 || data[0] != 0xFF || data[1] != 0xD8 )
+        return false;
+
+    sofPos = 0;
+    size_t pos = 2;
+    while( pos + 4 <= size )
+    {
+        if( data[pos] != 0xFF )
+            return false;
+        const int marker = data[pos + 1];
+        if( marker == 0xFF ) // fill byte
+        {
+            pos++;
+            continue;
+        }
+        const size_t length = ((size_t)data[pos + 2] << 8) | data[pos + 3];
+        if( marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC )
+            sofPos = pos;
+        if( marker == 0xDA )
+        {
+            sosPos = pos;
+            sosEnd = pos + 2 + length;
+            return sofPos != 0 && sosEnd <= size;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+// Restart intervals of images with at least this number of pixels are decoded in parallel
+static const int64 PARALLEL_DECODE_MIN_PIXELS = 1 << 20;
+
+
 /////////////////////// JpegDecoder ///////////////////
 
 
@@ -187,6 +249,7 @@ JpegDecoder::JpegDecoder()
 JpegDecoder::~JpegDecoder()
 {
     close();
+    destroyJpegState( m_state );
 }
 
 
@@ -195,9 +258,15 @@ void  JpegDecoder::close()
     if( m_state )
     {
         JpegState* state = (JpegState*)m_state;
-        jpeg_destroy_decompress( &state->cinfo );
-        delete state;
-        m_state = 0;
+        if( state->memSource )
+        {
+            // keep the decompressor with its permanent memory pool for the next image
+            // decoded by the same decoder object (see imdecodeBatch)
+            jpeg_abort_decompress( &state->cinfo );
+            state->rowBuffer = 0;
+        }
+        else
+            destroyJpegState( m_state );
     }
 
     if( m_f )
@@ -219,19 +288,30 @@ bool  JpegDecoder::readHeader()
 {
     volatile bool result = false;
     close();
+    if( m_buf.empty() )
+        destroyJpegState( m_state ); // libjpeg doesn't allow to switch the source manager of the existing state
 
-    JpegState* state = new JpegState;
-    m_state = state;
-    state->cinfo.err = jpeg_std_error(&state->jerr.pub);
-    state->jerr.pub.error_exit = error_exit;
+    JpegState* state = (JpegState*)m_state;
+    const bool reuse = state != 0;
+    if( !reuse )
+    {
+        state = new JpegState;
+        m_state = state;
+        state->rowBuffer = 0;
+        state->memSource = false;
+        state->cinfo.err = jpeg_std_error(&state->jerr.pub);
+        state->jerr.pub.error_exit = error_exit;
+    }
 
     if( setjmp( state->jerr.setjmp_buffer ) == 0 )
     {
-        jpeg_create_decompress( &state->cinfo );
+        if( !reuse )
+            jpeg_create_decompress( &state->cinfo );
 
         if( !m_buf.empty() )
         {
             jpeg_buffer_src(&state->cinfo, &state->source);
+            state->memSource = true;
             state->source.pub.next_input_byte = m_buf.ptr();
             state->source.pub.bytes_in_buffer = m_buf.cols*m_buf.rows*m_buf.elemSize();
         }
@@ -254,6 +334,28 @@ bool  JpegDecoder::readHeader()
             m_width = state->cinfo.output_width;
             m_height = state->cinfo.output_height;
             m_type = state->cinfo.num_components > 1 ? CV_8UC3 : CV_8UC1;
+
+            // Check for Exif marker APP1
+            jpeg_saved_marker_ptr exif_marker = NULL;
+            jpeg_saved_marker_ptr cmarker = state->cinfo.marker_list;
+            while( cmarker && exif_marker == NULL )
+            {
+                if (cmarker->marker == APP1)
+                    exif_marker = cmarker;
+
+                cmarker = cmarker->next;
+            }
+
+            // Parse Exif data. It is done here, so the orientation is known before decoding of a region
+            if( exif_marker )
+            {
+                const std::streamsize offsetToTiffHeader = 6; //bytes from Exif size field to the first TIFF header
+
+                if (exif_marker->data_length > offsetToTiffHeader)
+                {
+                    m_exif.parseExif(exif_marker->data + offsetToTiffHeader, exif_marker->data_length - offsetToTiffHeader);
+                }
+            }
             result = true;
         }
     }
@@ -400,113 +502,303 @@ int my_jpeg_load_dht (struct jpeg_decompress_struct *info, unsigned char *dht,
  ***************************************************************************/
 #endif  // CV_MANUAL_JPEG_STD_HUFF_TABLES
 
+// Sets up decoding of the image with given number of channels after the header is read
+static void prepareDecompress( jpeg_decompress_struct* cinfo, bool color )
+{
+#ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
+    /* check if this is a mjpeg image format */
+    if ( cinfo->ac_huff_tbl_ptrs[0] == NULL &&
+        cinfo->ac_huff_tbl_ptrs[1] == NULL &&
+        cinfo->dc_huff_tbl_ptrs[0] == NULL &&
+        cinfo->dc_huff_tbl_ptrs[1] == NULL )
+    {
+        /* yes, this is a mjpeg image format, so load the correct
+        huffman table */
+        my_jpeg_load_dht( cinfo,
+            my_jpeg_odml_dht,
+            cinfo->ac_huff_tbl_ptrs,
+            cinfo->dc_huff_tbl_ptrs );
+    }
+#endif
+
+    if( color )
+    {
+        if( cinfo->num_components != 4 )
+        {
+            cinfo->out_color_space = JCS_RGB;
+            cinfo->out_color_components = 3;
+        }
+        else
+        {
+            cinfo->out_color_space = JCS_CMYK;
+            cinfo->out_color_components = 4;
+        }
+    }
+    else
+    {
+        if( cinfo->num_components != 4 )
+        {
+            cinfo->out_color_space = JCS_GRAYSCALE;
+            cinfo->out_color_components = 1;
+        }
+        else
+        {
+            cinfo->out_color_space = JCS_CMYK;
+            cinfo->out_color_components = 4;
+        }
+    }
+}
+
+// Converts the decoded scanline to BGR or grayscale
+static void convertRow( const jpeg_decompress_struct* cinfo, const uchar* src, uchar* dst, int width, bool color )
+{
+    if( color )
+    {
+        if( cinfo->out_color_components == 3 )
+            icvCvt_RGB2BGR_8u_C3R( src, 0, dst, 0, Size(width,1) );
+        else
+            icvCvt_CMYK2BGR_8u_C4C3R( src, 0, dst, 0, Size(width,1) );
+    }
+    else
+    {
+        if( cinfo->out_color_components == 1 )
+            memcpy( dst, src, width );
+        else
+            icvCvt_CMYK2Gray_8u_C4C1R( src, 0, dst, 0, Size(width,1) );
+    }
+}
+
 bool  JpegDecoder::readData( Mat& img )
 {
+    if( readStripes( img ) )
+        return true;
+    return readRegion(img, Rect(0, 0, m_width, m_height));
+}
+
+// Decodes rows [skip, skip + img.rows) of the standalone JPEG stream into img
+static bool decodeJpegRows( const uchar* data, size_t size, int scale_denom, int skip, Mat& img )
+{
+    JpegState state;
     volatile bool result = false;
-    size_t step = img.step;
+    jpeg_decompress_struct* cinfo = &state.cinfo;
     bool color = img.channels() > 1;
 
-    if( m_state && m_width && m_height )
+    cinfo->err = jpeg_std_error(&state.jerr.pub);
+    state.jerr.pub.error_exit = error_exit;
+    jpeg_create_decompress( cinfo );
+
+    if( setjmp( state.jerr.setjmp_buffer ) == 0 )
     {
-        jpeg_decompress_struct* cinfo = &((JpegState*)m_state)->cinfo;
-        JpegErrorMgr* jerr = &((JpegState*)m_state)->jerr;
-        JSAMPARRAY buffer = 0;
+        jpeg_buffer_src( cinfo, &state.source );
+        state.source.pub.next_input_byte = data;
+        state.source.pub.bytes_in_buffer = size;
+        jpeg_read_header( cinfo, TRUE );
+
+        cinfo->scale_num = 1;
+        cinfo->scale_denom = scale_denom;
+        prepareDecompress( cinfo, color );
+        jpeg_start_decompress( cinfo );
+
+        JSAMPARRAY buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
+                                                        JPOOL_IMAGE, cinfo->output_width*4, 1 );
+        // the context rows are decoded entirely to get the same chroma upsampling as in the whole image
+        for( int y = 0; y < skip; y++ )
+            jpeg_read_scanlines( cinfo, buffer, 1 );
+
+        for( int y = 0; y < img.rows; y++ )
+        {
+            jpeg_read_scanlines( cinfo, buffer, 1 );
+            convertRow( cinfo, buffer[0], img.ptr(y), img.cols, color );
+        }
+        result = true;
+    }
 
-        if( setjmp( jerr->setjmp_buffer ) == 0 )
+    jpeg_destroy_decompress( cinfo );
+    return result;
+}
+
+// Restart intervals consisting of whole MCU rows are decoded in parallel as standalone images
+// built from the headers of the image and the entropy-coded segments of the stripe.
+// Returns false without decoding anything if the image can't be decoded this way.
+bool  JpegDecoder::readStripes( Mat& img )
+{
+    JpegState* state = (JpegState*)m_state;
+    const int nthreads = getNumThreads();
+    if( !state || !m_width || !m_height || nthreads < 2 ||
+        (int64)m_width*m_height < PARALLEL_DECODE_MIN_PIXELS )
+        return false;
+
+    const jpeg_decompress_struct* cinfo = &state->cinfo;
+    if( cinfo->restart_interval == 0 || cinfo->progressive_mode || cinfo->arith_code ||
+        cinfo->comps_in_scan != cinfo->num_components )
+        return false;
+
+    int max_h_samp = 1, max_v_samp = 1;
+    for( int ci = 0; ci < cinfo->num_components; ci++ )
+    {
+        max_h_samp = std::max(max_h_samp, cinfo->comp_info[ci].h_samp_factor);
+        max_v_samp = std::max(max_v_samp, cinfo->comp_info[ci].v_samp_factor);
+    }
+    // fancy upsampling of vertically subsampled components uses the rows of the neighbor MCU rows
+    bool context = false;
+    for( int ci = 0; ci < cinfo->num_components; ci++ )
+        context |= cinfo->do_fancy_upsampling && cinfo->comp_info[ci].v_samp_factor < max_v_samp;
+
+    // single-component scan consists of 8x8 blocks, an interleaved one - of the MCUs of all the components
+    const int mcuWidth = cinfo->comps_in_scan > 1 ? max_h_samp*DCTSIZE : DCTSIZE;
+    const int mcuHeight = cinfo->comps_in_scan > 1 ? max_v_samp*DCTSIZE : DCTSIZE;
+    const int mcuCols = ((int)cinfo->image_width + mcuWidth - 1) / mcuWidth;
+    if( (int)cinfo->restart_interval % mcuCols != 0 )
+        return false;
+    const int segHeight = (int)cinfo->restart_interval / mcuCols * mcuHeight;
+    const int scale_denom = (int)cinfo->scale_denom;
+    if( cinfo->scale_num != 1 || segHeight % scale_denom != 0 )
+        return false;
+    const int outSegHeight = segHeight / scale_denom;
+    const int nsegs = ((int)cinfo->image_height + segHeight - 1) / segHeight;
+    if( nsegs < 2 )
+        return false;
+
+    std::vector<uchar> fileData;
+    const uchar* data = m_buf.ptr();
+    size_t size = m_buf.total()*m_buf.elemSize();
+    if( m_buf.empty() )
+    {
+        FILE* f = fopen( m_filename.c_str(), "rb" );
+        if( !f )
+            return false;
+        fseek( f, 0, SEEK_END );
+        long fsize = ftell( f );
+        fseek( f, 0, SEEK_SET );
+        if( fsize > 0 )
         {
-#ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
-            /* check if this is a mjpeg image format */
-            if ( cinfo->ac_huff_tbl_ptrs[0] == NULL &&
-                cinfo->ac_huff_tbl_ptrs[1] == NULL &&
-                cinfo->dc_huff_tbl_ptrs[0] == NULL &&
-                cinfo->dc_huff_tbl_ptrs[1] == NULL )
-            {
-                /* yes, this is a mjpeg image format, so load the correct
-                huffman table */
-                my_jpeg_load_dht( cinfo,
-                    my_jpeg_odml_dht,
-                    cinfo->ac_huff_tbl_ptrs,
-                    cinfo->dc_huff_tbl_ptrs );
-            }
-#endif
+            fileData.resize(fsize);
+            if( fread( &fileData[0], 1, fileData.size(), f ) != fileData.size() )
+                fileData.clear();
+        }
+        fclose( f );
+        if( fileData.empty() )
+            return false;
+        data = &fileData[0];
+        size = fileData.size();
+    }
 
-            if( color )
-            {
-                if( cinfo->num_components != 4 )
-                {
-                    cinfo->out_color_space = JCS_RGB;
-                    cinfo->out_color_components = 3;
-                }
-                else
-                {
-                    cinfo->out_color_space = JCS_CMYK;
-                    cinfo->out_color_components = 4;
-                }
-            }
-            else
+    size_t sofPos = 0, sosPos = 0, sosEnd = 0;
+    if( !findJpegHeaders( data, size, sofPos, sosPos, sosEnd ) )
+        return false;
+
+    // entropy-coded segments separated by the restart markers
+    std::vector<size_t> segStart(1, sosEnd), segEnd;
+    for( size_t i = sosEnd; i + 1 < size; i++ )
+    {
+        if( data[i] != 0xFF || data[i + 1] == 0 || data[i + 1] == 0xFF )
+            continue;
+        segEnd.push_back(i);
+        if( data[i + 1] < 0xD0 || data[i + 1] > 0xD7 )
+            break;
+        segStart.push_back(i + 2);
+        i++;
+    }
+    if( (int)segStart.size() != nsegs || segEnd.size() != segStart.size() )
+        return false;
+
+    const int nstripes = std::min(nsegs, nthreads);
+    std::vector<uchar> success(nstripes, (uchar)0);
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
+    {
+        std::vector<uchar> stripe;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const int s0 = (int)((int64)i*nsegs/nstripes), s1 = (int)((int64)(i + 1)*nsegs/nstripes);
+            const int c0 = context ? std::max(s0 - 1, 0) : s0, c1 = context ? std::min(s1 + 1, nsegs) : s1;
+            const int height = std::min(c1*segHeight, (int)cinfo->image_height) - c0*segHeight;
+
+            stripe.assign(data, data + sosEnd);
+            stripe[sofPos + 5] = (uchar)(height >> 8);
+            stripe[sofPos + 6] = (uchar)height;
+            for( int j = c0; j < c1; j++ )
             {
-                if( cinfo->num_components != 4 )
-                {
-                    cinfo->out_color_space = JCS_GRAYSCALE;
-                    cinfo->out_color_components = 1;
-                }
-                else
+                if( j > c0 )
                 {
-                    cinfo->out_color_space = JCS_CMYK;
-                    cinfo->out_color_components = 4;
+                    stripe.push_back(0xFF);
+                    stripe.push_back((uchar)(0xD0 + ((j - c0 - 1) & 7)));
                 }
+                stripe.insert(stripe.end(), data + segStart[j], data + segEnd[j]);
             }
+            stripe.push_back(0xFF);
+            stripe.push_back(0xD9);
 
-            // Check for Exif marker APP1
-            jpeg_saved_marker_ptr exif_marker = NULL;
-            jpeg_saved_marker_ptr cmarker = cinfo->marker_list;
-            while( cmarker && exif_marker == NULL )
-            {
-                if (cmarker->marker == APP1)
-                    exif_marker = cmarker;
+            const int y0 = s0*outSegHeight, y1 = std::min(s1*outSegHeight, m_height);
+            Mat rows = img.rowRange(y0, y1);
+            success[i] = decodeJpegRows( &stripe[0], stripe.size(), scale_denom, (s0 - c0)*outSegHeight, rows );
+        }
+    });
 
-                cmarker = cmarker->next;
-            }
+    if( std::find(success.begin(), success.end(), (uchar)0) != success.end() )
+        return false;
+    close();
+    return true;
+}
 
-            // Parse Exif data
-            if( exif_marker )
-            {
-                const std::streamsize offsetToTiffHeader = 6; //bytes from Exif size field to the first TIFF header
+bool  JpegDecoder::readRegion( Mat& img, const Rect& roi )
+{
+    volatile bool result = false;
+    size_t step = img.step;
+    bool color = img.channels() > 1;
 
-                if (exif_marker->data_length > offsetToTiffHeader)
-                {
-                    m_exif.parseExif(exif_marker->data + offsetToTiffHeader, exif_marker->data_length - offsetToTiffHeader);
-                }
-            }
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    CV_Assert(img.size() == roi.size());
 
+    if( m_state && m_width && m_height )
+    {
+        jpeg_decompress_struct* cinfo = &((JpegState*)m_state)->cinfo;
+        JpegErrorMgr* jerr = &((JpegState*)m_state)->jerr;
+        JSAMPARRAY buffer = 0;
+
+        if( setjmp( jerr->setjmp_buffer ) == 0 )
+        {
+            prepareDecompress( cinfo, color );
 
             jpeg_start_decompress( cinfo );
 
+            // horizontal offset of the decoded part of scanlines
+            JDIMENSION xoffset = 0;
+#ifdef CV_JPEG_PARTIAL_DECODE
+            if( roi.width < m_width )
+            {
+                // The cropped region is aligned to iMCU boundary by libjpeg, so it may be wider than requested.
+                // It is extended by one more iMCU (16 pixels max) on both sides, as the chroma upsampling
+                // replicates the edge samples of the cropped region instead of using the neighbor ones.
+                const int margin = 16;
+                const int x0 = std::max(roi.x - margin, 0), x1 = std::min(roi.x + roi.width + margin, m_width);
+                JDIMENSION cropWidth = x1 - x0;
+                xoffset = x0;
+                jpeg_crop_scanline( cinfo, &xoffset, &cropWidth );
+            }
+            if( roi.y > 0 )
+                jpeg_skip_scanlines( cinfo, roi.y );
+#endif
+
             buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
                                               JPOOL_IMAGE, m_width*4, 1 );
 
+#ifndef CV_JPEG_PARTIAL_DECODE
+            for( int y = 0; y < roi.y; y++ )
+                jpeg_read_scanlines( cinfo, buffer, 1 );
+#endif
+
             uchar* data = img.ptr();
-            for( ; m_height--; data += step )
+            for( int y = 0; y < roi.height; y++, data += step )
             {
                 jpeg_read_scanlines( cinfo, buffer, 1 );
-                if( color )
-                {
-                    if( cinfo->out_color_components == 3 )
-                        icvCvt_RGB2BGR_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
-                    else
-                        icvCvt_CMYK2BGR_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
-                }
-                else
-                {
-                    if( cinfo->out_color_components == 1 )
-                        memcpy( data, buffer[0], m_width );
-                    else
-                        icvCvt_CMYK2Gray_8u_C4C1R( buffer[0], 0, data, 0, Size(m_width,1) );
-                }
+                convertRow( cinfo, buffer[0] + (roi.x - xoffset)*cinfo->out_color_components, data, roi.width, color );
             }
 
             result = true;
-            jpeg_finish_decompress( cinfo );
+            if( cinfo->output_scanline < cinfo->output_height )
+                jpeg_abort_decompress( cinfo );
+            else
+                jpeg_finish_decompress( cinfo );
         }
     }
 
@@ -515,6 +807,48 @@ bool  JpegDecoder::readData( Mat& img )
 }
 
 
+bool  JpegDecoder::readRows( Mat& img )
+{
+    JpegState* state = (JpegState*)m_state;
+    if( !state || !m_width || !m_height )
+        return false;
+
+    volatile bool result = false;
+    jpeg_decompress_struct* cinfo = &state->cinfo;
+    bool color = img.channels() > 1;
+
+    CV_Assert(img.cols == m_width && (int)cinfo->output_scanline + img.rows <= m_height);
+
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        if( !state->rowBuffer )
+        {
+            prepareDecompress( cinfo, color );
+            jpeg_start_decompress( cinfo );
+            state->rowBuffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
+                                                           JPOOL_IMAGE, m_width*4, 1 );
+        }
+
+        for( int y = 0; y < img.rows; y++ )
+        {
+            jpeg_read_scanlines( cinfo, state->rowBuffer, 1 );
+            convertRow( cinfo, state->rowBuffer[0], img.ptr(y), m_width, color );
+        }
+
+        if( cinfo->output_scanline == cinfo->output_height )
+        {
+            jpeg_finish_decompress( cinfo );
+            close();
+        }
+        result = true;
+    }
+
+    if( !result )
+        close();
+    return result;
+}
+
+
 /////////////////////// JpegEncoder ///////////////////
 
 struct JpegDestination
@@ -563,199 +897,441 @@ static void jpeg_buffer_dest(j_compress_ptr cinfo, JpegDestination* destination)
 }
 
 
-JpegEncoder::JpegEncoder()
+struct JpegEncoderState
 {
-    m_description = "JPEG files (*.jpeg;*.jpg;*.jpe)";
-    m_buf_supported = true;
-}
+    jpeg_compress_struct cinfo; // IJG JPEG codec structure
+    JpegErrorMgr jerr; // error processing manager state
+    JpegDestination dest; // memory buffer destination
+    std::vector<uchar> out_buf;
+    FILE* f;
+    AutoBuffer<uchar> buffer; // converted scanline
+    int channels; // of the source image
+};
 
 
-JpegEncoder::~JpegEncoder()
+// Sets up compression of the image with given size and type, parses the encoder parameters
+static void setupCompress( jpeg_compress_struct* cinfo, Size size, int type, const std::vector<int>& params )
 {
+    cinfo->image_width = size.width;
+    cinfo->image_height = size.height;
+
+    int _channels = CV_MAT_CN(type);
+    int channels = _channels > 1 ? 3 : 1;
+    cinfo->input_components = channels;
+    cinfo->in_color_space = channels > 1 ? JCS_RGB : JCS_GRAYSCALE;
+
+    int quality = 95;
+    int progressive = 0;
+    int optimize = 0;
+    int rst_interval = 0;
+    int luma_quality = -1;
+    int chroma_quality = -1;
+
+    for( size_t i = 0; i < params.size(); i += 2 )
+    {
+        if( params[i] == CV_IMWRITE_JPEG_QUALITY )
+        {
+            quality = params[i+1];
+            quality = MIN(MAX(quality, 0), 100);
+        }
+
+        if( params[i] == CV_IMWRITE_JPEG_PROGRESSIVE )
+        {
+            progressive = params[i+1];
+        }
+
+        if( params[i] == CV_IMWRITE_JPEG_OPTIMIZE )
+        {
+            optimize = params[i+1];
+        }
+
+        if( params[i] == CV_IMWRITE_JPEG_LUMA_QUALITY )
+        {
+            if (params[i+1] >= 0)
+            {
+                luma_quality = MIN(MAX(params[i+1], 0), 100);
+
+                quality = luma_quality;
+
+                if (chroma_quality < 0)
+                {
+                    chroma_quality = luma_quality;
+                }
+            }
+        }
+
+        if( params[i] == CV_IMWRITE_JPEG_CHROMA_QUALITY )
+        {
+            if (params[i+1] >= 0)
+            {
+                chroma_quality = MIN(MAX(params[i+1], 0), 100);
+            }
+        }
+
+        if( params[i] == CV_IMWRITE_JPEG_RST_INTERVAL )
+        {
+            rst_interval = params[i+1];
+            rst_interval = MIN(MAX(rst_interval, 0), 65535L);
+        }
+    }
+
+    jpeg_set_defaults( cinfo );
+    cinfo->restart_interval = rst_interval;
+
+    jpeg_set_quality( cinfo, quality,
+                      TRUE /* limit to baseline-JPEG values */ );
+    if( progressive )
+        jpeg_simple_progression( cinfo );
+    if( optimize )
+        cinfo->optimize_coding = TRUE;
+
+#if JPEG_LIB_VERSION >= 70
+    if (luma_quality >= 0 && chroma_quality >= 0)
+    {
+        cinfo->q_scale_factor[0] = jpeg_quality_scaling(luma_quality);
+        cinfo->q_scale_factor[1] = jpeg_quality_scaling(chroma_quality);
+        if ( luma_quality != chroma_quality )
+        {
+            /* disable subsampling - ref. Libjpeg.txt */
+            cinfo->comp_info[0].v_samp_factor = 1;
+            cinfo->comp_info[0].h_samp_factor = 1;
+            cinfo->comp_info[1].v_samp_factor = 1;
+            cinfo->comp_info[1].h_samp_factor = 1;
+        }
+        jpeg_default_qtables( cinfo, TRUE );
+    }
+#endif // #if JPEG_LIB_VERSION >= 70
 }
 
-ImageEncoder JpegEncoder::newEncoder() const
+// Converts the rows of the image to RGB or grayscale and passes them to the compressor
+static void writeScanlines( jpeg_compress_struct* cinfo, const Mat& img, uchar* buffer )
 {
-    return makePtr<JpegEncoder>();
+    int width = img.cols, _channels = img.channels();
+
+    for( int y = 0; y < img.rows; y++ )
+    {
+        uchar *data = img.data + img.step*y, *ptr = data;
+
+        if( _channels == 3 )
+        {
+            icvCvt_BGR2RGB_8u_C3R( data, 0, buffer, 0, Size(width,1) );
+            ptr = buffer;
+        }
+        else if( _channels == 4 )
+        {
+            icvCvt_BGRA2BGR_8u_C4C3R( data, 0, buffer, 0, Size(width,1), 2 );
+            ptr = buffer;
+        }
+
+        jpeg_write_scanlines( cinfo, &ptr, 1 );
+    }
 }
 
-bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+// Returns the height of the stripes of the image encoded in parallel (IMWRITE_JPEG_PARALLEL) and the restart
+// interval separating them, or 0 if the image must be encoded sequentially. Progressive JPEG consists of
+// several scans and the optimized Huffman tables are computed from the whole image, so they are not split.
+static int getStripeHeight( Size size, int type, const std::vector<int>& params, int& restartInterval )
 {
-    m_last_error.clear();
-
-    struct fileWrapper
+    bool parallel = false;
+    for( size_t i = 0; i < params.size(); i += 2 )
     {
-        FILE* f;
+        if( params[i] == IMWRITE_JPEG_PARALLEL )
+            parallel = params[i+1] != 0;
+    }
+    if( !parallel || size.width > JPEG_MAX_DIMENSION || size.height > JPEG_MAX_DIMENSION )
+        return 0;
 
-        fileWrapper() : f(0) {}
-        ~fileWrapper() { if(f) fclose(f); }
-    };
-    volatile bool result = false;
-    fileWrapper fw;
-    int width = img.cols, height = img.rows;
+    jpeg_compress_struct cinfo;
+    JpegErrorMgr jerr;
+    volatile int stripeHeight = 0;
 
-    std::vector<uchar> out_buf(1 << 12);
-    AutoBuffer<uchar> _buffer;
-    uchar* buffer;
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = error_exit;
+    jpeg_create_compress( &cinfo );
+
+    if( setjmp( jerr.setjmp_buffer ) == 0 )
+    {
+        setupCompress( &cinfo, size, type, params );
+        if( cinfo.num_scans == 0 && !cinfo.optimize_coding && !cinfo.arith_code )
+        {
+            int max_h_samp = 1, max_v_samp = 1;
+            for( int ci = 0; ci < cinfo.num_components; ci++ )
+            {
+                max_h_samp = std::max(max_h_samp, cinfo.comp_info[ci].h_samp_factor);
+                max_v_samp = std::max(max_v_samp, cinfo.comp_info[ci].v_samp_factor);
+            }
+            const int mcuWidth = cinfo.num_components > 1 ? max_h_samp*DCTSIZE : DCTSIZE;
+            const int mcuHeight = cinfo.num_components > 1 ? max_v_samp*DCTSIZE : DCTSIZE;
+            const int mcuCols = (size.width + mcuWidth - 1) / mcuWidth;
+
+            // the stripes of 8 MCU rows by default, or the ones defined by IMWRITE_JPEG_RST_INTERVAL
+            int mcuRows = std::min(8, 65535 / mcuCols);
+            if( cinfo.restart_interval > 0 )
+                mcuRows = (int)cinfo.restart_interval % mcuCols == 0 ? (int)cinfo.restart_interval / mcuCols : 0;
+            if( mcuRows > 0 && mcuRows*mcuHeight < size.height )
+            {
+                stripeHeight = mcuRows*mcuHeight;
+                restartInterval = mcuRows*mcuCols;
+            }
+        }
+    }
 
-    struct jpeg_compress_struct cinfo;
+    jpeg_destroy_compress( &cinfo );
+    return stripeHeight;
+}
+
+// Encodes the image as a standalone JPEG stream without restart markers
+static bool encodeStripe( const Mat& img, const std::vector<int>& params, std::vector<uchar>& dst, String& error )
+{
+    jpeg_compress_struct cinfo;
     JpegErrorMgr jerr;
     JpegDestination dest;
+    std::vector<uchar> out_buf(1 << 12);
+    AutoBuffer<uchar> buffer(img.cols*3);
+    volatile bool result = false;
 
-    jpeg_create_compress(&cinfo);
     cinfo.err = jpeg_std_error(&jerr.pub);
     jerr.pub.error_exit = error_exit;
+    jpeg_create_compress( &cinfo );
 
-    if( !m_buf )
+    dest.dst = &dst;
+    dest.buf = &out_buf;
+    jpeg_buffer_dest( &cinfo, &dest );
+    dest.pub.next_output_byte = &out_buf[0];
+    dest.pub.free_in_buffer = out_buf.size();
+
+    if( setjmp( jerr.setjmp_buffer ) == 0 )
     {
-        fw.f = fopen( m_filename.c_str(), "wb" );
-        if( !fw.f )
-            goto _exit_;
-        jpeg_stdio_dest( &cinfo, fw.f );
+        setupCompress( &cinfo, img.size(), img.type(), params );
+        cinfo.restart_interval = 0;
+        jpeg_start_compress( &cinfo, TRUE );
+        writeScanlines( &cinfo, img, buffer.data() );
+        jpeg_finish_compress( &cinfo );
+        result = true;
     }
     else
     {
-        dest.dst = m_buf;
-        dest.buf = &out_buf;
+        char jmsg_buf[JMSG_LENGTH_MAX];
+        jerr.pub.format_message((j_common_ptr)&cinfo, jmsg_buf);
+        error = jmsg_buf;
+    }
 
-        jpeg_buffer_dest( &cinfo, &dest );
+    jpeg_destroy_compress( &cinfo );
+    return result;
+}
 
-        dest.pub.next_output_byte = &out_buf[0];
-        dest.pub.free_in_buffer = out_buf.size();
+JpegEncoder::JpegEncoder()
+{
+    m_description = "JPEG files (*.jpeg;*.jpg;*.jpe)";
+    m_buf_supported = true;
+    m_state = 0;
+}
+
+
+JpegEncoder::~JpegEncoder()
+{
+    close();
+}
+
+ImageEncoder JpegEncoder::newEncoder() const
+{
+    return makePtr<JpegEncoder>();
+}
+
+void JpegEncoder::close()
+{
+    if( m_state )
+    {
+        JpegEncoderState* state = (JpegEncoderState*)m_state;
+        jpeg_destroy_compress( &state->cinfo );
+        if( state->f )
+            fclose( state->f );
+        delete state;
+        m_state = 0;
     }
+}
 
-    if( setjmp( jerr.setjmp_buffer ) == 0 )
+void JpegEncoder::fail()
+{
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( state )
     {
-        cinfo.image_width = width;
-        cinfo.image_height = height;
+        char jmsg_buf[JMSG_LENGTH_MAX];
+        state->jerr.pub.format_message((j_common_ptr)&state->cinfo, jmsg_buf);
+        m_last_error = jmsg_buf;
+    }
+    close();
+}
 
-        int _channels = img.channels();
-        int channels = _channels > 1 ? 3 : 1;
-        cinfo.input_components = channels;
-        cinfo.in_color_space = channels > 1 ? JCS_RGB : JCS_GRAYSCALE;
+bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+{
+    int restartInterval = 0;
+    const int stripeHeight = getStripeHeight( img.size(), img.type(), params, restartInterval );
+    if( stripeHeight > 0 )
+        return writeStripes( img, params, stripeHeight, restartInterval );
+
+    if( !startRows( img.size(), img.type(), params ) )
+        return false;
+    if( !writeRows( img ) )
+        return false;
+    return finishRows();
+}
 
-        int quality = 95;
-        int progressive = 0;
-        int optimize = 0;
-        int rst_interval = 0;
-        int luma_quality = -1;
-        int chroma_quality = -1;
+// The stripes are encoded in parallel as standalone images, then the stream is composed from the headers
+// of the first stripe with the height of the whole image and the restart interval, and the entropy-coded
+// data of all the stripes separated by the restart markers. It is the same as encoding the image sequentially
+// with the restart interval of the stripe size, as the encoder resets its state at every restart marker.
+bool JpegEncoder::writeStripes( const Mat& img, const std::vector<int>& params, int stripeHeight, int restartInterval )
+{
+    m_last_error.clear();
+    close();
 
-        for( size_t i = 0; i < params.size(); i += 2 )
+    const int nstripes = (img.rows + stripeHeight - 1) / stripeHeight;
+    std::vector<std::vector<uchar> > stripes(nstripes);
+    std::vector<String> errors(nstripes);
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
+    {
+        for( int i = range.start; i < range.end; i++ )
         {
-            if( params[i] == CV_IMWRITE_JPEG_QUALITY )
-            {
-                quality = params[i+1];
-                quality = MIN(MAX(quality, 0), 100);
-            }
+            const int y0 = i*stripeHeight, y1 = std::min(y0 + stripeHeight, img.rows);
+            if( !encodeStripe( img.rowRange(y0, y1), params, stripes[i], errors[i] ) && errors[i].empty() )
+                errors[i] = "failed to encode the stripe";
+        }
+    });
 
-            if( params[i] == CV_IMWRITE_JPEG_PROGRESSIVE )
-            {
-                progressive = params[i+1];
-            }
+    std::vector<uchar> out;
+    for( int i = 0; i < nstripes; i++ )
+    {
+        if( !errors[i].empty() )
+        {
+            m_last_error = errors[i];
+            return false;
+        }
+        const std::vector<uchar>& stripe = stripes[i];
+        size_t sofPos = 0, sosPos = 0, sosEnd = 0;
+        CV_Assert(findJpegHeaders( &stripe[0], stripe.size(), sofPos, sosPos, sosEnd ));
+        CV_Assert(stripe.size() >= sosEnd + 2 && stripe[stripe.size() - 2] == 0xFF && stripe.back() == 0xD9);
+        if( i == 0 )
+        {
+            out.reserve(stripe.size()*nstripes);
+            out.assign(stripe.begin(), stripe.begin() + sosPos);
+            out[sofPos + 5] = (uchar)(img.rows >> 8);
+            out[sofPos + 6] = (uchar)img.rows;
+            const uchar dri[] = { 0xFF, 0xDD, 0, 4, (uchar)(restartInterval >> 8), (uchar)restartInterval };
+            out.insert(out.end(), dri, dri + sizeof(dri));
+            out.insert(out.end(), stripe.begin() + sosPos, stripe.begin() + sosEnd);
+        }
+        else
+        {
+            out.push_back(0xFF);
+            out.push_back((uchar)(0xD0 + ((i - 1) & 7)));
+        }
+        out.insert(out.end(), stripe.begin() + sosEnd, stripe.end() - 2);
+    }
+    out.push_back(0xFF);
+    out.push_back(0xD9);
 
-            if( params[i] == CV_IMWRITE_JPEG_OPTIMIZE )
-            {
-                optimize = params[i+1];
-            }
+    if( m_buf )
+    {
+        m_buf->swap(out);
+        return true;
+    }
 
-            if( params[i] == CV_IMWRITE_JPEG_LUMA_QUALITY )
-            {
-                if (params[i+1] >= 0)
-                {
-                    luma_quality = MIN(MAX(params[i+1], 0), 100);
+    FILE* f = fopen( m_filename.c_str(), "wb" );
+    if( !f )
+        return false;
+    bool result = fwrite( &out[0], 1, out.size(), f ) == out.size();
+    result = fclose( f ) == 0 && result;
+    return result;
+}
 
-                    quality = luma_quality;
+bool JpegEncoder::startRows( Size size, int type, const std::vector<int>& params )
+{
+    m_last_error.clear();
+    close();
 
-                    if (chroma_quality < 0)
-                    {
-                        chroma_quality = luma_quality;
-                    }
-                }
-            }
+    JpegEncoderState* state = new JpegEncoderState;
+    m_state = state;
+    state->f = 0;
+    state->out_buf.resize(1 << 12);
 
-            if( params[i] == CV_IMWRITE_JPEG_CHROMA_QUALITY )
-            {
-                if (params[i+1] >= 0)
-                {
-                    chroma_quality = MIN(MAX(params[i+1], 0), 100);
-                }
-            }
+    jpeg_compress_struct& cinfo = state->cinfo;
+    JpegDestination& dest = state->dest;
 
-            if( params[i] == CV_IMWRITE_JPEG_RST_INTERVAL )
-            {
-                rst_interval = params[i+1];
-                rst_interval = MIN(MAX(rst_interval, 0), 65535L);
-            }
+    cinfo.err = jpeg_std_error(&state->jerr.pub);
+    state->jerr.pub.error_exit = error_exit;
+    jpeg_create_compress(&cinfo);
+
+    if( !m_buf )
+    {
+        state->f = fopen( m_filename.c_str(), "wb" );
+        if( !state->f )
+        {
+            fail();
+            return false;
         }
+        jpeg_stdio_dest( &cinfo, state->f );
+    }
+    else
+    {
+        dest.dst = m_buf;
+        dest.buf = &state->out_buf;
 
-        jpeg_set_defaults( &cinfo );
-        cinfo.restart_interval = rst_interval;
+        jpeg_buffer_dest( &cinfo, &dest );
 
-        jpeg_set_quality( &cinfo, quality,
-                          TRUE /* limit to baseline-JPEG values */ );
-        if( progressive )
-            jpeg_simple_progression( &cinfo );
-        if( optimize )
-            cinfo.optimize_coding = TRUE;
+        dest.pub.next_output_byte = &state->out_buf[0];
+        dest.pub.free_in_buffer = state->out_buf.size();
+    }
 
-#if JPEG_LIB_VERSION >= 70
-        if (luma_quality >= 0 && chroma_quality >= 0)
-        {
-            cinfo.q_scale_factor[0] = jpeg_quality_scaling(luma_quality);
-            cinfo.q_scale_factor[1] = jpeg_quality_scaling(chroma_quality);
-            if ( luma_quality != chroma_quality )
-            {
-                /* disable subsampling - ref. Libjpeg.txt */
-                cinfo.comp_info[0].v_samp_factor = 1;
-                cinfo.comp_info[0].h_samp_factor = 1;
-                cinfo.comp_info[1].v_samp_factor = 1;
-                cinfo.comp_info[1].h_samp_factor = 1;
-            }
-            jpeg_default_qtables( &cinfo, TRUE );
-        }
-#endif // #if JPEG_LIB_VERSION >= 70
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        setupCompress( &cinfo, size, type, params );
+        state->channels = CV_MAT_CN(type);
 
         jpeg_start_compress( &cinfo, TRUE );
 
-        if( channels > 1 )
-            _buffer.allocate(width*channels);
-        buffer = _buffer.data();
+        if( cinfo.input_components > 1 )
+            state->buffer.allocate(size.width*cinfo.input_components);
+        return true;
+    }
 
-        for( int y = 0; y < height; y++ )
-        {
-            uchar *data = img.data + img.step*y, *ptr = data;
+    fail();
+    return false;
+}
 
-            if( _channels == 3 )
-            {
-                icvCvt_BGR2RGB_8u_C3R( data, 0, buffer, 0, Size(width,1) );
-                ptr = buffer;
-            }
-            else if( _channels == 4 )
-            {
-                icvCvt_BGRA2BGR_8u_C4C3R( data, 0, buffer, 0, Size(width,1), 2 );
-                ptr = buffer;
-            }
+bool JpegEncoder::writeRows( const Mat& img )
+{
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( !state )
+        return false;
 
-            jpeg_write_scanlines( &cinfo, &ptr, 1 );
-        }
+    CV_Assert(img.cols == (int)state->cinfo.image_width && img.channels() == state->channels);
 
-        jpeg_finish_compress( &cinfo );
-        result = true;
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        writeScanlines( &state->cinfo, img, state->buffer.data() );
+        return true;
     }
 
-_exit_:
+    fail();
+    return false;
+}
+
+bool JpegEncoder::finishRows()
+{
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( !state )
+        return false;
 
-    if(!result)
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
     {
-        char jmsg_buf[JMSG_LENGTH_MAX];
-        jerr.pub.format_message((j_common_ptr)&cinfo, jmsg_buf);
-        m_last_error = jmsg_buf;
+        jpeg_finish_compress( &state->cinfo );
+        close();
+        return true;
     }
 
-    jpeg_destroy_compress( &cinfo );
-
-    return result;
+    fail();
+    return false;
 }
 
 }
@@ -80,6 +80,8 @@ public:
     virtual ~JpegDecoder();
 
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  readRegion( Mat& img, const Rect& roi ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
     void  close();
 
@@ -87,6 +89,8 @@ public:
 
 protected:
 
+    bool  readStripes( Mat& img );
+
     FILE* m_f;
     void* m_state;
 
@@ -103,7 +107,21 @@ public:
     virtual ~JpegEncoder();
 
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  startRows( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& img ) CV_OVERRIDE;
+    bool  finishRows() CV_OVERRIDE;
     ImageEncoder newEncoder() const CV_OVERRIDE;
+
+protected:
+    void  close();
+    void  fail();
+    bool  writeStripes( const Mat& img, const std::vector<int>& params, int stripeHeight, int restartInterval );
+
+    void* m_state;
+
+private:
+    JpegEncoder(const JpegEncoder &); // copy disabled
+    JpegEncoder& operator=(const JpegEncoder &); // assign disabled
 };
 
 }
@@ -92,6 +92,7 @@ PngDecoder::PngDecoder()
     m_buf_supported = true;
     m_buf_pos = 0;
     m_bit_depth = 0;
+    m_rows_read = 0;
 }
 
 
@@ -155,6 +156,7 @@ bool  PngDecoder::readHeader()
         m_info_ptr = info_ptr;
         m_end_info = end_info;
         m_buf_pos = 0;
+        m_rows_read = 0;
 
         if( info_ptr && end_info )
         {
@@ -186,6 +188,19 @@ bool  PngDecoder::readHeader()
                     m_color_type = color_type;
                     m_bit_depth = bit_depth;
 
+#ifdef PNG_eXIf_SUPPORTED
+                    // Exif info placed before the image data is available without decoding,
+                    // the one from end_info is parsed by readData()
+                    if( png_get_valid(png_ptr, info_ptr, PNG_INFO_eXIf) )
+                    {
+                        png_uint_32 num_exif = 0;
+                        png_bytep exif = 0;
+                        png_get_eXIf_1(png_ptr, info_ptr, &num_exif, &exif);
+                        if( exif && num_exif > 0 )
+                            m_exif.parseExif(exif, num_exif);
+                    }
+#endif
+
                     if( bit_depth <= 8 || bit_depth == 16 )
                     {
                         switch(color_type)
@@ -221,12 +236,64 @@ bool  PngDecoder::readHeader()
 }
 
 
+void  PngDecoder::setReadTransforms( const Mat& img )
+{
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    bool color = img.channels() > 1;
+
+    if( img.depth() == CV_8U && m_bit_depth == 16 )
+        png_set_strip_16( png_ptr );
+    else if( !isBigEndian() )
+        png_set_swap( png_ptr );
+
+    if(img.channels() < 4)
+    {
+        /* observation: png_read_image() writes 400 bytes beyond
+         * end of data when reading a 400x118 color png
+         * "mpplus_sand.png".  OpenCV crashes even with demo
+         * programs.  Looking at the loaded image I'd say we get 4
+         * bytes per pixel instead of 3 bytes per pixel.  Test
+         * indicate that it is a good idea to always ask for
+         * stripping alpha..  18.11.2004 Axel Walthelm
+         */
+         png_set_strip_alpha( png_ptr );
+    } else
+        png_set_tRNS_to_alpha( png_ptr );
+
+    if( m_color_type == PNG_COLOR_TYPE_PALETTE )
+        png_set_palette_to_rgb( png_ptr );
+
+    if( (m_color_type & PNG_COLOR_MASK_COLOR) == 0 && m_bit_depth < 8 )
+#if (PNG_LIBPNG_VER_MAJOR*10000 + PNG_LIBPNG_VER_MINOR*100 + PNG_LIBPNG_VER_RELEASE >= 10209) || \
+    (PNG_LIBPNG_VER_MAJOR == 1 && PNG_LIBPNG_VER_MINOR == 0 && PNG_LIBPNG_VER_RELEASE >= 18)
+        png_set_expand_gray_1_2_4_to_8( png_ptr );
+#else
+        png_set_gray_1_2_4_to_8( png_ptr );
+#endif
+
+    if( (m_color_type & PNG_COLOR_MASK_COLOR) && color )
+        png_set_bgr( png_ptr ); // convert RGB to BGR
+    else if( color )
+        png_set_gray_to_rgb( png_ptr ); // Gray->RGB
+    else
+        png_set_rgb_to_gray( png_ptr, 1, 0.299, 0.587 ); // RGB->Gray
+}
+
 bool  PngDecoder::readData( Mat& img )
+{
+    return readRegion(img, Rect(0, 0, m_width, m_height));
+}
+
+bool  PngDecoder::readRegion( Mat& img, const Rect& roi )
 {
     volatile bool result = false;
-    AutoBuffer<uchar*> _buffer(m_height);
-    uchar** buffer = _buffer.data();
-    bool color = img.channels() > 1;
+    AutoBuffer<uchar*> _buffer;
+    AutoBuffer<uchar> _row;
+    Mat full;
+    const bool fullImage = roi == Rect(0, 0, m_width, m_height);
+
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    CV_Assert(img.size() == roi.size());
 
     png_structp png_ptr = (png_structp)m_png_ptr;
     png_infop info_ptr = (png_infop)m_info_ptr;
@@ -238,67 +305,59 @@ bool  PngDecoder::readData( Mat& img )
         {
             int y;
 
-            if( img.depth() == CV_8U && m_bit_depth == 16 )
-                png_set_strip_16( png_ptr );
-            else if( !isBigEndian() )
-                png_set_swap( png_ptr );
-
-            if(img.channels() < 4)
-            {
-                /* observation: png_read_image() writes 400 bytes beyond
-                 * end of data when reading a 400x118 color png
-                 * "mpplus_sand.png".  OpenCV crashes even with demo
-                 * programs.  Looking at the loaded image I'd say we get 4
-                 * bytes per pixel instead of 3 bytes per pixel.  Test
-                 * indicate that it is a good idea to always ask for
-                 * stripping alpha..  18.11.2004 Axel Walthelm
-                 */
-                 png_set_strip_alpha( png_ptr );
-            } else
-                png_set_tRNS_to_alpha( png_ptr );
-
-            if( m_color_type == PNG_COLOR_TYPE_PALETTE )
-                png_set_palette_to_rgb( png_ptr );
-
-            if( (m_color_type & PNG_COLOR_MASK_COLOR) == 0 && m_bit_depth < 8 )
-#if (PNG_LIBPNG_VER_MAJOR*10000 + PNG_LIBPNG_VER_MINOR*100 + PNG_LIBPNG_VER_RELEASE >= 10209) || \
-    (PNG_LIBPNG_VER_MAJOR == 1 && PNG_LIBPNG_VER_MINOR == 0 && PNG_LIBPNG_VER_RELEASE >= 18)
-                png_set_expand_gray_1_2_4_to_8( png_ptr );
-#else
-                png_set_gray_1_2_4_to_8( png_ptr );
-#endif
-
-            if( (m_color_type & PNG_COLOR_MASK_COLOR) && color )
-                png_set_bgr( png_ptr ); // convert RGB to BGR
-            else if( color )
-                png_set_gray_to_rgb( png_ptr ); // Gray->RGB
-            else
-                png_set_rgb_to_gray( png_ptr, 1, 0.299, 0.587 ); // RGB->Gray
+            setReadTransforms( img );
 
+            // all the passes of interlaced image are needed to get any row
+            const bool interlaced = png_get_interlace_type( png_ptr, info_ptr ) != PNG_INTERLACE_NONE;
             png_set_interlace_handling( png_ptr );
             png_read_update_info( png_ptr, info_ptr );
 
-            for( y = 0; y < m_height; y++ )
-                buffer[y] = img.data + y*img.step;
+            if( fullImage || interlaced )
+            {
+                if( fullImage )
+                    full = img;
+                else
+                    full.create( m_height, m_width, img.type() );
+
+                _buffer.allocate(m_height);
+                uchar** buffer = _buffer.data();
+                for( y = 0; y < m_height; y++ )
+                    buffer[y] = full.data + y*full.step;
 
-            png_read_image( png_ptr, buffer );
-            png_read_end( png_ptr, end_info );
+                png_read_image( png_ptr, buffer );
+                png_read_end( png_ptr, end_info );
 
 #ifdef PNG_eXIf_SUPPORTED
-            png_uint_32 num_exif = 0;
-            png_bytep exif = 0;
+                png_uint_32 num_exif = 0;
+                png_bytep exif = 0;
 
-            // Exif info could be in info_ptr (intro_info) or end_info per specification
-            if( png_get_valid(png_ptr, info_ptr, PNG_INFO_eXIf) )
-                png_get_eXIf_1(png_ptr, info_ptr, &num_exif, &exif);
-            else if( png_get_valid(png_ptr, end_info, PNG_INFO_eXIf) )
-                png_get_eXIf_1(png_ptr, end_info, &num_exif, &exif);
+                // Exif info could be in info_ptr (intro_info) or end_info per specification.
+                // The former one is parsed by readHeader()
+                if( !png_get_valid(png_ptr, info_ptr, PNG_INFO_eXIf) &&
+                    png_get_valid(png_ptr, end_info, PNG_INFO_eXIf) )
+                    png_get_eXIf_1(png_ptr, end_info, &num_exif, &exif);
 
-            if( exif && num_exif > 0 )
+                if( exif && num_exif > 0 )
+                {
+                    m_exif.parseExif(exif, num_exif);
+                }
+#endif
+                if( !fullImage )
+                    full(roi).copyTo(img);
+            }
+            else
             {
-                m_exif.parseExif(exif, num_exif);
+                // rows below the region are not decoded at all
+                _row.allocate(png_get_rowbytes( png_ptr, info_ptr ));
+                uchar* row = _row.data();
+                const size_t offset = roi.x*img.elemSize(), size = roi.width*img.elemSize();
+                for( y = 0; y < roi.y + roi.height; y++ )
+                {
+                    png_read_row( png_ptr, row, NULL );
+                    if( y >= roi.y )
+                        memcpy( img.ptr(y - roi.y), row + offset, size );
+                }
             }
-#endif
 
             result = true;
         }
@@ -309,6 +368,48 @@ bool  PngDecoder::readData( Mat& img )
 }
 
 
+bool  PngDecoder::readRows( Mat& img )
+{
+    volatile bool result = false;
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    png_infop info_ptr = (png_infop)m_info_ptr;
+    png_infop end_info = (png_infop)m_end_info;
+
+    if( !m_png_ptr || !m_info_ptr || !m_end_info || !m_width || !m_height )
+        return false;
+
+    // all the passes of interlaced image are needed to get any row
+    if( m_rows_read == 0 && png_get_interlace_type( png_ptr, info_ptr ) != PNG_INTERLACE_NONE )
+        return false;
+
+    CV_Assert(img.cols == m_width && m_rows_read + img.rows <= m_height);
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        if( m_rows_read == 0 )
+        {
+            setReadTransforms( img );
+            png_read_update_info( png_ptr, info_ptr );
+        }
+
+        for( int y = 0; y < img.rows; y++ )
+            png_read_row( png_ptr, img.ptr(y), NULL );
+        m_rows_read += img.rows;
+
+        if( m_rows_read == m_height )
+        {
+            png_read_end( png_ptr, end_info );
+            close();
+        }
+        result = true;
+    }
+
+    if( !result )
+        close();
+    return result;
+}
+
+
 /////////////////////// PngEncoder ///////////////////
 
 
@@ -316,11 +417,14 @@ PngEncoder::PngEncoder()
 {
     m_description = "Portable Network Graphics files (*.png)";
     m_buf_supported = true;
+    m_png_ptr = m_info_ptr = 0;
+    m_f = 0;
 }
 
 
 PngEncoder::~PngEncoder()
 {
+    close();
 }
 
 
@@ -352,22 +456,50 @@ void PngEncoder::flushBuf(void*)
 {
 }
 
+void PngEncoder::close()
+{
+    if( m_png_ptr )
+    {
+        png_structp png_ptr = (png_structp)m_png_ptr;
+        png_infop info_ptr = (png_infop)m_info_ptr;
+        png_destroy_write_struct( &png_ptr, &info_ptr );
+        m_png_ptr = m_info_ptr = 0;
+    }
+    if( m_f )
+    {
+        fclose( m_f );
+        m_f = 0;
+    }
+}
+
 bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
 {
-    png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
-    png_infop info_ptr = 0;
-    FILE * volatile f = 0;
-    int y, width = img.cols, height = img.rows;
-    int depth = img.depth(), channels = img.channels();
+    if( !startRows( img.size(), img.type(), params ) )
+        return false;
+    if( !writeRows( img ) )
+        return false;
+    return finishRows();
+}
+
+bool  PngEncoder::startRows( Size size, int type, const std::vector<int>& params )
+{
+    int width = size.width, height = size.height;
+    int depth = CV_MAT_DEPTH(type), channels = CV_MAT_CN(type);
     volatile bool result = false;
-    AutoBuffer<uchar*> buffer;
+
+    close();
 
     if( depth != CV_8U && depth != CV_16U )
         return false;
 
+    png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
+    png_infop info_ptr = 0;
+
     if( png_ptr )
     {
+        m_png_ptr = png_ptr;
         info_ptr = png_create_info_struct( png_ptr );
+        m_info_ptr = info_ptr;
 
         if( info_ptr )
         {
@@ -380,9 +512,9 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                 }
                 else
                 {
-                    f = fopen( m_filename.c_str(), "wb" );
-                    if( f )
-                        png_init_io( png_ptr, (png_FILE_p)f );
+                    m_f = fopen( m_filename.c_str(), "wb" );
+                    if( m_f )
+                        png_init_io( png_ptr, (png_FILE_p)m_f );
                 }
 
                 int compression_level = -1; // Invalid value to allow setting 0-9 as valid
@@ -408,7 +540,7 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                     }
                 }
 
-                if( m_buf || f )
+                if( m_buf || m_f )
                 {
                     if( compression_level >= 0 )
                     {
@@ -438,22 +570,52 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                     if( !isBigEndian() )
                         png_set_swap( png_ptr );
 
-                    buffer.allocate(height);
-                    for( y = 0; y < height; y++ )
-                        buffer[y] = img.data + y*img.step;
-
-                    png_write_image( png_ptr, buffer.data() );
-                    png_write_end( png_ptr, info_ptr );
-
                     result = true;
                 }
             }
         }
     }
 
-    png_destroy_write_struct( &png_ptr, &info_ptr );
-    if(f) fclose( (FILE*)f );
+    if( !result )
+        close();
+    return result;
+}
+
+bool  PngEncoder::writeRows( const Mat& img )
+{
+    volatile bool result = false;
+    png_structp png_ptr = (png_structp)m_png_ptr;
+
+    if( !png_ptr )
+        return false;
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        for( int y = 0; y < img.rows; y++ )
+            png_write_row( png_ptr, img.ptr(y) );
+        result = true;
+    }
+
+    if( !result )
+        close();
+    return result;
+}
+
+bool  PngEncoder::finishRows()
+{
+    volatile bool result = false;
+    png_structp png_ptr = (png_structp)m_png_ptr;
+
+    if( !png_ptr )
+        return false;
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        png_write_end( png_ptr, (png_infop)m_info_ptr );
+        result = true;
+    }
 
+    close();
     return result;
 }
 
@@ -59,6 +59,8 @@ public:
     virtual ~PngDecoder();
 
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  readRegion( Mat& img, const Rect& roi ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
     void  close();
 
@@ -67,6 +69,7 @@ public:
 protected:
 
     static void readDataFromBuf(void* png_ptr, uchar* dst, size_t size);
+    void  setReadTransforms( const Mat& img );
 
     int   m_bit_depth;
     void* m_png_ptr;  // pointer to decompression structure
@@ -75,6 +78,7 @@ protected:
     FILE* m_f;
     int   m_color_type;
     size_t m_buf_pos;
+    int   m_rows_read; // by readRows()
 };
 
 
@@ -86,12 +90,20 @@ public:
 
     bool  isFormatSupported( int depth ) const CV_OVERRIDE;
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  startRows( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& img ) CV_OVERRIDE;
+    bool  finishRows() CV_OVERRIDE;
 
     ImageEncoder newEncoder() const CV_OVERRIDE;
 
 protected:
     static void writeDataToBuf(void* png_ptr, uchar* src, size_t size);
     static void flushBuf(void* png_ptr);
+    void  close();
+
+    void* m_png_ptr;  // pointer to compression structure
+    void* m_info_ptr; // pointer to image information structure
+    FILE* m_f;
 };
 
 }
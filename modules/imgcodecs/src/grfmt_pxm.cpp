@@ -103,6 +103,7 @@ static int ReadNumber(RLByteStream& strm, int maxdigits = 0)
 PxMDecoder::PxMDecoder()
 {
     m_offset = -1;
+    m_rows_read = 0;
     m_buf_supported = true;
     m_bpp = 0;
     m_binary = false;
@@ -182,6 +183,7 @@ bool PxMDecoder::readHeader()
         if( m_width > 0 && m_height > 0 && m_maxval > 0 && m_maxval < (1 << 16))
         {
             m_offset = m_strm.getPos();
+            m_rows_read = 0;
             result = true;
         }
     }
@@ -206,6 +208,12 @@ bool PxMDecoder::readHeader()
 
 
 bool PxMDecoder::readData( Mat& img )
+{
+    m_rows_read = 0;
+    return readRows( img );
+}
+
+bool PxMDecoder::readRows( Mat& img )
 {
     bool color = img.channels() > 1;
     uchar* data = img.ptr();
@@ -219,6 +227,8 @@ bool PxMDecoder::readData( Mat& img )
     if( m_offset < 0 || !m_strm.isOpened())
         return false;
 
+    CV_Assert(img.cols == m_width && m_rows_read + img.rows <= m_height);
+
     uchar gray_palette[256] = {0};
 
     // create LUT for converting colors
@@ -234,7 +244,9 @@ bool PxMDecoder::readData( Mat& img )
 
     try
     {
-        m_strm.setPos( m_offset );
+        // rows are read sequentially, so the stream is positioned to the image data only once
+        if( m_rows_read == 0 )
+            m_strm.setPos( m_offset );
 
         switch( m_bpp )
         {
@@ -246,7 +258,7 @@ bool PxMDecoder::readData( Mat& img )
                 AutoBuffer<uchar> _src(m_width);
                 uchar* src = _src.data();
 
-                for (int y = 0; y < m_height; y++, data += img.step)
+                for (int y = 0; y < img.rows; y++, data += img.step)
                 {
                     for (int x = 0; x < m_width; x++)
                         src[x] = ReadNumber(m_strm, 1) != 0;
@@ -262,7 +274,7 @@ bool PxMDecoder::readData( Mat& img )
                 AutoBuffer<uchar> _src(src_pitch);
                 uchar* src = _src.data();
 
-                for (int y = 0; y < m_height; y++, data += img.step)
+                for (int y = 0; y < img.rows; y++, data += img.step)
                 {
                     m_strm.getBytes( src, src_pitch );
 
@@ -282,7 +294,7 @@ bool PxMDecoder::readData( Mat& img )
             AutoBuffer<uchar> _src(std::max<size_t>(width3*2, src_pitch));
             uchar* src = _src.data();
 
-            for (int y = 0; y < m_height; y++, data += img.step)
+            for (int y = 0; y < img.rows; y++, data += img.step)
             {
                 if( !m_binary )
                 {
@@ -357,6 +369,7 @@ bool PxMDecoder::readData( Mat& img )
         default:
             CV_Error(Error::StsError, "m_bpp is not supported");
         }
+        m_rows_read += img.rows;
     }
     catch (const cv::Exception&)
     {
@@ -375,7 +388,7 @@ bool PxMDecoder::readData( Mat& img )
 //////////////////////////////////////////////////////////////////////////////////////////
 
 PxMEncoder::PxMEncoder(PxMMode mode) :
-    mode_(mode)
+    mode_(mode), m_binary(true), m_mode(mode)
 {
     switch (mode)
     {
@@ -401,14 +414,22 @@ bool PxMEncoder::isFormatSupported(int depth) const
 }
 
 bool PxMEncoder::write(const Mat& img, const std::vector<int>& params)
+{
+    if( !startRows(img.size(), img.type(), params) )
+        return false;
+    if( !writeRows(img) )
+        return false;
+    return finishRows();
+}
+
+bool PxMEncoder::startRows(Size size, int type, const std::vector<int>& params)
 {
     bool isBinary = true;
 
-    int  width = img.cols, height = img.rows;
-    int  _channels = img.channels(), depth = (int)img.elemSize1()*8;
+    int  width = size.width, height = size.height;
+    int  _channels = CV_MAT_CN(type), depth = CV_ELEM_SIZE1(type)*8;
     int  channels = _channels > 1 ? 3 : 1;
-    int  fileStep = width*(int)img.elemSize();
-    int  x, y;
+    int  fileStep = width*CV_ELEM_SIZE(type);
 
     for( size_t i = 0; i < params.size(); i += 2 )
     {
@@ -419,29 +440,30 @@ bool PxMEncoder::write(const Mat& img, const std::vector<int>& params)
     int mode = mode_;
     if (mode == PXM_TYPE_AUTO)
     {
-        mode = img.channels() == 1 ? PXM_TYPE_PGM : PXM_TYPE_PPM;
+        mode = _channels == 1 ? PXM_TYPE_PGM : PXM_TYPE_PPM;
     }
 
-    if (mode == PXM_TYPE_PGM && img.channels() > 1)
+    if (mode == PXM_TYPE_PGM && _channels > 1)
     {
         CV_Error(Error::StsBadArg, "Portable bitmap(.pgm) expects gray image");
     }
-    if (mode == PXM_TYPE_PPM && img.channels() != 3)
+    if (mode == PXM_TYPE_PPM && _channels != 3)
     {
         CV_Error(Error::StsBadArg, "Portable bitmap(.ppm) expects BGR image");
     }
-    if (mode == PXM_TYPE_PBM && img.type() != CV_8UC1)
+    if (mode == PXM_TYPE_PBM && type != CV_8UC1)
     {
         CV_Error(Error::StsBadArg, "For portable bitmap(.pbm) type must be CV_8UC1");
     }
 
-    WLByteStream strm;
+    WLByteStream& strm = m_strm;
+    strm.close();
 
     if( m_buf )
     {
         if( !strm.open(*m_buf) )
             return false;
-        int t = CV_MAKETYPE(img.depth(), channels);
+        int t = CV_MAKETYPE(CV_MAT_DEPTH(type), channels);
         m_buf->reserve( alignSize(256 + (isBinary ? fileStep*height :
             ((t == CV_8UC1 ? 4 : t == CV_8UC3 ? 4*3+2 :
             t == CV_16UC1 ? 6 : 6*3+2)*width+1)*height), 256));
@@ -453,15 +475,15 @@ bool PxMEncoder::write(const Mat& img, const std::vector<int>& params)
     int  bufferSize = 128; // buffer that should fit a header
 
     if( isBinary )
-        lineLength = width * (int)img.elemSize();
+        lineLength = width * CV_ELEM_SIZE(type);
     else
         lineLength = (6 * channels + (channels > 1 ? 2 : 0)) * width + 32;
 
     if( bufferSize < lineLength )
         bufferSize = lineLength;
 
-    AutoBuffer<char> _buffer(bufferSize);
-    char* buffer = _buffer.data();
+    m_buffer.allocate(bufferSize);
+    char* buffer = m_buffer.data();
 
     // write header;
     const int code = ((mode == PXM_TYPE_PBM) ? 1 : (mode == PXM_TYPE_PGM) ? 2 : 3)
@@ -479,6 +501,26 @@ bool PxMEncoder::write(const Mat& img, const std::vector<int>& params)
 
     strm.putBytes(buffer, header_sz);
 
+    m_binary = isBinary;
+    m_mode = mode;
+    return true;
+}
+
+bool PxMEncoder::writeRows(const Mat& img)
+{
+    if( !m_strm.isOpened() )
+        return false;
+
+    WLByteStream& strm = m_strm;
+    const bool isBinary = m_binary;
+    const int  mode = m_mode;
+    int  width = img.cols, height = img.rows;
+    int  _channels = img.channels(), depth = (int)img.elemSize1()*8;
+    int  channels = _channels > 1 ? 3 : 1;
+    int  fileStep = width*(int)img.elemSize();
+    int  x, y;
+    char* buffer = m_buffer.data();
+
     for( y = 0; y < height; y++ )
     {
         const uchar* const data = img.ptr(y);
@@ -612,7 +654,14 @@ bool PxMEncoder::write(const Mat& img, const std::vector<int>& params)
         }
     }
 
-    strm.close();
+    return true;
+}
+
+bool PxMEncoder::finishRows()
+{
+    if( !m_strm.isOpened() )
+        return false;
+    m_strm.close();
     return true;
 }
 
@@ -67,6 +67,7 @@ public:
     virtual ~PxMDecoder() CV_OVERRIDE;
 
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
     void  close();
 
@@ -82,6 +83,7 @@ protected:
     int             m_offset;
     bool            m_binary;
     int             m_maxval;
+    int             m_rows_read; // by readRows()
 };
 
 class PxMEncoder CV_FINAL : public BaseImageEncoder
@@ -92,6 +94,9 @@ public:
 
     bool  isFormatSupported( int depth ) const CV_OVERRIDE;
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  startRows( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& img ) CV_OVERRIDE;
+    bool  finishRows() CV_OVERRIDE;
 
     ImageEncoder newEncoder() const CV_OVERRIDE
     {
@@ -99,6 +104,12 @@ public:
     }
 
     const PxMMode mode_;
+
+protected:
+    WLByteStream     m_strm;
+    AutoBuffer<char> m_buffer; // row buffer
+    bool             m_binary;
+    int              m_mode;
 };
 
 }
@@ -118,6 +118,7 @@ TiffDecoder::TiffDecoder()
     m_hdr = false;
     m_buf_supported = true;
     m_buf_pos = 0;
+    m_rows_read = 0;
 }
 
 
@@ -234,6 +235,7 @@ public:
 bool TiffDecoder::readHeader()
 {
     bool result = false;
+    m_rows_read = 0;
 
     TIFF* tif = static_cast<TIFF*>(m_tif.get());
     if (!tif)
@@ -410,6 +412,11 @@ static void fixOrientation(Mat &img, uint16 orientation, int dst_bpp)
 }
 
 bool  TiffDecoder::readData( Mat& img )
+{
+    return readRegion(img, Rect(0, 0, m_width, m_height));
+}
+
+bool  TiffDecoder::readRegion( Mat& img, const Rect& roi )
 {
     int type = img.type();
     int depth = CV_MAT_DEPTH(type);
@@ -428,6 +435,8 @@ bool  TiffDecoder::readData( Mat& img )
     bool color = img.channels() > 1;
 
     CV_CheckType(type, depth == CV_8U || depth == CV_16U || depth == CV_32F || depth == CV_64F, "");
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    CV_Assert(img.size() == roi.size());
 
     if (m_width && m_height)
     {
@@ -442,6 +451,11 @@ bool  TiffDecoder::readData( Mat& img )
         CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &ncn));
         uint16 img_orientation = ORIENTATION_TOPLEFT;
         CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField(tif, TIFFTAG_ORIENTATION, &img_orientation));
+        if (img_orientation != ORIENTATION_TOPLEFT && roi != Rect(0, 0, m_width, m_height))
+        {
+            // region of the stored image doesn't match the requested one after orientation fix
+            return BaseImageDecoder::readRegion(img, roi);
+        }
         const int bitsPerByte = 8;
         int dst_bpp = (int)(img.elemSize1() * bitsPerByte);
         bool vert_flip = dst_bpp == 8 &&
@@ -506,6 +520,7 @@ bool  TiffDecoder::readData( Mat& img )
             uchar* buffer = _buffer.data();
             ushort* buffer16 = (ushort*)buffer;
             int tileidx = 0;
+            Mat tileBuf;
 
             for (int y = 0; y < m_height; y += (int)tile_height0)
             {
@@ -517,6 +532,20 @@ bool  TiffDecoder::readData( Mat& img )
                 {
                     int tile_width = std::min((int)tile_width0, m_width - x);
 
+                    // tiles and strips outside of the requested region are not decoded
+                    const Rect tileRect(x, img_y, tile_width, tile_height);
+                    const Rect dstRect = tileRect & roi;
+                    if (dstRect.empty())
+                        continue;
+                    Mat dstTile;
+                    if (dstRect == tileRect)
+                        dstTile = img(tileRect - roi.tl());
+                    else
+                    {
+                        tileBuf.create(tile_height, tile_width, type);
+                        dstTile = tileBuf;
+                    }
+
                     switch (dst_bpp)
                     {
                         case 8:
@@ -540,14 +569,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     if (wanted_channels == 4)
                                     {
                                         icvCvt_BGRA2RGBA_8u_C4R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                dstTile.ptr(tile_height - i - 1), 0,
                                                 Size(tile_width, 1) );
                                     }
                                     else
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "TIFF-8bpp: BGR/BGRA images are supported only");
                                         icvCvt_BGRA2BGR_8u_C4C3R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                dstTile.ptr(tile_height - i - 1), 0,
                                                 Size(tile_width, 1), 2);
                                     }
                                 }
@@ -555,7 +584,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 {
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     icvCvt_BGRA2Gray_8u_C4C1R( bstart + i*tile_width0*4, 0,
-                                            img.ptr(img_y + tile_height - i - 1, x), 0,
+                                            dstTile.ptr(tile_height - i - 1), 0,
                                             Size(tile_width, 1), 2);
                                 }
                             }
@@ -581,14 +610,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_Gray2BGR_16u_C1C3R(buffer16 + i*tile_width0*ncn, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dstTile.ptr<ushort>(i), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 3)
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_RGB2BGR_16u_C3R(buffer16 + i*tile_width0*ncn, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dstTile.ptr<ushort>(i), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 4)
@@ -596,14 +625,14 @@ bool  TiffDecoder::readData( Mat& img )
                                         if (wanted_channels == 4)
                                         {
                                             icvCvt_BGRA2RGBA_16u_C4R(buffer16 + i*tile_width0*ncn, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dstTile.ptr<ushort>(i), 0,
                                                 Size(tile_width, 1));
                                         }
                                         else
                                         {
                                             CV_CheckEQ(wanted_channels, 3, "TIFF-16bpp: BGR/BGRA images are supported only");
                                             icvCvt_BGRA2BGR_16u_C4C3R(buffer16 + i*tile_width0*ncn, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dstTile.ptr<ushort>(i), 0,
                                                 Size(tile_width, 1), 2);
                                         }
                                     }
@@ -617,14 +646,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     if( ncn == 1 )
                                     {
-                                        memcpy(img.ptr<ushort>(img_y + i, x),
+                                        memcpy(dstTile.ptr<ushort>(i),
                                                buffer16 + i*tile_width0*ncn,
                                                tile_width*sizeof(ushort));
                                     }
                                     else
                                     {
                                         icvCvt_BGRA2Gray_16u_CnC1R(buffer16 + i*tile_width0*ncn, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dstTile.ptr<ushort>(i), 0,
                                                 Size(tile_width, 1), ncn, 2);
                                     }
                                 }
@@ -646,13 +675,12 @@ bool  TiffDecoder::readData( Mat& img )
 
                             Mat m_tile(Size(tile_width0, tile_height0), CV_MAKETYPE((dst_bpp == 32) ? CV_32F : CV_64F, ncn), buffer);
                             Rect roi_tile(0, 0, tile_width, tile_height);
-                            Rect roi_img(x, img_y, tile_width, tile_height);
                             if (!m_hdr && ncn == 3)
-                                cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGB2BGR);
+                                cvtColor(m_tile(roi_tile), dstTile, COLOR_RGB2BGR);
                             else if (!m_hdr && ncn == 4)
-                                cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGBA2BGRA);
+                                cvtColor(m_tile(roi_tile), dstTile, COLOR_RGBA2BGRA);
                             else
-                                m_tile(roi_tile).copyTo(img(roi_img));
+                                m_tile(roi_tile).copyTo(dstTile);
                             break;
                         }
                         default:
@@ -660,6 +688,8 @@ bool  TiffDecoder::readData( Mat& img )
                             CV_Assert(0 && "OpenCV TIFF: unsupported depth");
                         }
                     }  // switch (dst_bpp)
+                    if (dstRect != tileRect)
+                        dstTile(dstRect - tileRect.tl()).copyTo(img(dstRect - roi.tl()));
                 }  // for x
             }  // for y
         }
@@ -674,6 +704,27 @@ bool  TiffDecoder::readData( Mat& img )
     return true;
 }
 
+bool  TiffDecoder::readRows( Mat& img )
+{
+    if (m_tif.empty() || !m_width || !m_height)
+        return false;
+
+    if (m_rows_read == 0)
+    {
+        uint16 img_orientation = ORIENTATION_TOPLEFT;
+        CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField((TIFF*)m_tif.get(), TIFFTAG_ORIENTATION, &img_orientation));
+        // rows of the stored image don't match the rows of the resulting one
+        if (img_orientation != ORIENTATION_TOPLEFT)
+            return false;
+    }
+
+    CV_Assert(img.cols == m_width && m_rows_read + img.rows <= m_height);
+    if (!readRegion(img, Rect(0, m_rows_read, m_width, img.rows)))
+        return false;
+    m_rows_read += img.rows;
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 TiffEncoder::TiffEncoder()
@@ -796,6 +847,166 @@ static bool readParam(const std::vector<int>& params, int key, int& value)
     return false;
 }
 
+// Sets the fields of the page written by scanlines, the page size is set by caller
+static void setScanlineFields(TIFF* tif, int width, int height, int type, const std::vector<int>& params)
+{
+    int channels = CV_MAT_CN(type);
+    int depth = CV_MAT_DEPTH(type);
+
+    int compression = COMPRESSION_LZW;
+    int predictor = PREDICTOR_HORIZONTAL;
+    int resUnit = -1, dpiX = -1, dpiY = -1;
+
+    readParam(params, IMWRITE_TIFF_COMPRESSION, compression);
+    readParam(params, TIFFTAG_PREDICTOR, predictor);
+    readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
+    readParam(params, IMWRITE_TIFF_XDPI, dpiX);
+    readParam(params, IMWRITE_TIFF_YDPI, dpiY);
+
+    int page_compression = compression;
+
+    int bitsPerChannel = -1;
+    switch (depth)
+    {
+        case CV_8U:
+        {
+            bitsPerChannel = 8;
+            break;
+        }
+        case CV_16U:
+        {
+            bitsPerChannel = 16;
+            break;
+        }
+        case CV_32F:
+        {
+            bitsPerChannel = 32;
+            page_compression = COMPRESSION_NONE;
+            break;
+        }
+        case CV_64F:
+        {
+            bitsPerChannel = 64;
+            page_compression = COMPRESSION_NONE;
+            break;
+        }
+        default:
+        {
+            CV_Error(Error::StsNotImplemented, "OpenCV TIFF: unsupported depth");
+        }
+    }
+
+    const int bitsPerByte = 8;
+    size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
+    CV_Assert(fileStep > 0);
+
+    int rowsPerStrip = (int)((1 << 13) / fileStep);
+    readParam(params, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+    rowsPerStrip = std::max(1, std::min(height, rowsPerStrip));
+
+    int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, page_compression));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip));
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, depth >= CV_32F ? SAMPLEFORMAT_IEEEFP : SAMPLEFORMAT_UINT));
+
+    if (page_compression != COMPRESSION_NONE)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
+    }
+
+    if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
+    }
+    if (dpiX >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
+    }
+    if (dpiY >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
+    }
+}
+
+// Writes the rows starting from the row y0 of the page. The buffer must fit the scanline,
+// because TIFFWriteScanline modifies the original data!
+static void writeScanlines(TIFF* tif, const Mat& img, int y0, uchar* buffer)
+{
+    int width = img.cols;
+    int channels = img.channels();
+    size_t scanlineSize = TIFFScanlineSize(tif);
+    Mat m_buffer(Size(width, 1), img.type(), buffer, (size_t)scanlineSize);
+
+    for (int y = 0; y < img.rows; ++y)
+    {
+        switch (channels)
+        {
+            case 1:
+            {
+                memcpy(buffer, img.ptr(y), scanlineSize);
+                break;
+            }
+
+            case 3:
+            {
+                cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
+                break;
+            }
+
+            case 4:
+            {
+                cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
+                break;
+            }
+
+            default:
+            {
+                CV_Assert(0);
+            }
+        }
+
+        CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y0 + y, 0) == 1);
+    }
+}
+
+static void setSGILOGFields(TIFF* tif)
+{
+    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, img.cols));
+    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, img.rows));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 3));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 32));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_SGILOG));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_LOGLUV));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SGILOGDATAFMT, SGILOGDATAFMT_FLOAT));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, 1));
+}
+
+// Writes the rows starting from the row y0 of the page, one row per strip
+static void writeSGILOGStrips(TIFF* tif, const Mat& _img, int y0)
+{
+    Mat img;
+    cvtColor(_img, img, COLOR_BGR2XYZ);
+
+    const int strip_size = 3 * img.cols;
+    for (int i = 0; i < img.rows; i++)
+    {
+        CV_TIFF_CHECK_CALL(TIFFWriteEncodedStrip(tif, y0 + i, (tdata_t)img.ptr<float>(i), strip_size * sizeof(float)) != (tsize_t)-1);
+    }
+}
+
+static bool isSGILOG(int type, const std::vector<int>& params)
+{
+    int compression_param = -1;  // OPENCV_FUTURE
+    return type == CV_32FC3 && (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) || compression_param == COMPRESSION_SGILOG);
+}
+
 bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params)
 {
     // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
@@ -817,17 +1028,6 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
     }
     cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
 
-    //Settings that matter to all images
-    int compression = COMPRESSION_LZW;
-    int predictor = PREDICTOR_HORIZONTAL;
-    int resUnit = -1, dpiX = -1, dpiY = -1;
-
-    readParam(params, IMWRITE_TIFF_COMPRESSION, compression);
-    readParam(params, TIFFTAG_PREDICTOR, predictor);
-    readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
-    readParam(params, IMWRITE_TIFF_XDPI, dpiX);
-    readParam(params, IMWRITE_TIFF_YDPI, dpiY);
-
     //Iterate through each image in the vector and write them out as Tiff directories
     for (size_t page = 0; page < img_vec.size(); page++)
     {
@@ -849,120 +1049,21 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
             CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PAGENUMBER, page, img_vec.size()));
         }
 
-        int compression_param = -1;  // OPENCV_FUTURE
-        if (type == CV_32FC3 && (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) || compression_param == COMPRESSION_SGILOG))
+        if (isSGILOG(type, params))
         {
             if (!write_32FC3_SGILOG(img, tif))
                 return false;
             continue;
         }
 
-        int page_compression = compression;
-
-        int bitsPerChannel = -1;
-        switch (depth)
-        {
-            case CV_8U:
-            {
-                bitsPerChannel = 8;
-                break;
-            }
-            case CV_16U:
-            {
-                bitsPerChannel = 16;
-                break;
-            }
-            case CV_32F:
-            {
-                bitsPerChannel = 32;
-                page_compression = COMPRESSION_NONE;
-                break;
-            }
-            case CV_64F:
-            {
-                bitsPerChannel = 64;
-                page_compression = COMPRESSION_NONE;
-                break;
-            }
-            default:
-            {
-                return false;
-            }
-        }
-
-        const int bitsPerByte = 8;
-        size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
-        CV_Assert(fileStep > 0);
-
-        int rowsPerStrip = (int)((1 << 13) / fileStep);
-        readParam(params, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
-        rowsPerStrip = std::max(1, std::min(height, rowsPerStrip));
-
-        int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
-
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, page_compression));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip));
-
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, depth >= CV_32F ? SAMPLEFORMAT_IEEEFP : SAMPLEFORMAT_UINT));
-
-        if (page_compression != COMPRESSION_NONE)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
-        }
-
-        if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
-        }
-        if (dpiX >= 0)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
-        }
-        if (dpiY >= 0)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
-        }
+        setScanlineFields(tif, width, height, type, params);
 
         // row buffer, because TIFFWriteScanline modifies the original data!
         size_t scanlineSize = TIFFScanlineSize(tif);
         AutoBuffer<uchar> _buffer(scanlineSize + 32);
         uchar* buffer = _buffer.data(); CV_DbgAssert(buffer);
-        Mat m_buffer(Size(width, 1), CV_MAKETYPE(depth, channels), buffer, (size_t)scanlineSize);
-
-        for (int y = 0; y < height; ++y)
-        {
-            switch (channels)
-            {
-                case 1:
-                {
-                    memcpy(buffer, img.ptr(y), scanlineSize);
-                    break;
-                }
 
-                case 3:
-                {
-                    cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
-                    break;
-                }
-
-                case 4:
-                {
-                    cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
-                    break;
-                }
-
-                default:
-                {
-                    CV_Assert(0);
-                }
-            }
-
-            CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y, 0) == 1);
-        }
+        writeScanlines(tif, img, 0, buffer);
 
         CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
     }
@@ -970,28 +1071,13 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
     return true;
 }
 
-bool TiffEncoder::write_32FC3_SGILOG(const Mat& _img, void* tif_)
+bool TiffEncoder::write_32FC3_SGILOG(const Mat& img, void* tif_)
 {
     TIFF* tif = (TIFF*)tif_;
     CV_Assert(tif);
 
-    Mat img;
-    cvtColor(_img, img, COLOR_BGR2XYZ);
-
-    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, img.cols));
-    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, img.rows));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 3));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 32));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_SGILOG));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_LOGLUV));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SGILOGDATAFMT, SGILOGDATAFMT_FLOAT));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, 1));
-    const int strip_size = 3 * img.cols;
-    for (int i = 0; i < img.rows; i++)
-    {
-        CV_TIFF_CHECK_CALL(TIFFWriteEncodedStrip(tif, i, (tdata_t)img.ptr<float>(i), strip_size * sizeof(float)) != (tsize_t)-1);
-    }
+    setSGILOGFields(tif);
+    writeSGILOGStrips(tif, img, 0);
     CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
     return true;
 }
@@ -1013,6 +1099,84 @@ bool  TiffEncoder::write( const Mat& img, const std::vector<int>& params)
     return writeLibTiff(img_vec, params);
 }
 
+struct TiffEncoderState
+{
+    TiffEncoderState(std::vector<uchar>* buf) : bufHelper(buf), sgilog(false) {}
+
+    TiffEncoderBufHelper bufHelper;
+    Ptr<void> tif;
+    Size size;
+    int type;
+    int row;  // next row to write
+    bool sgilog;
+    AutoBuffer<uchar> buffer;
+};
+
+bool TiffEncoder::startRows( Size size, int type, const std::vector<int>& params )
+{
+    int channels = CV_MAT_CN(type);
+    int depth = CV_MAT_DEPTH(type);
+    CV_CheckType(type, depth == CV_8U || depth == CV_16U || depth == CV_32F || depth == CV_64F, "");
+    CV_CheckType(type, channels >= 1 && channels <= 4, "");
+
+    m_state.release();
+    Ptr<TiffEncoderState> state = makePtr<TiffEncoderState>(m_buf);
+    TIFF* tif = m_buf ? state->bufHelper.open() : TIFFOpen(m_filename.c_str(), "w");
+    if (!tif)
+    {
+        return false;
+    }
+    state->tif.reset(tif, cv_tiffCloseHandle);
+    state->size = size;
+    state->type = type;
+    state->row = 0;
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, size.width));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, size.height));
+
+    state->sgilog = isSGILOG(type, params);
+    if (state->sgilog)
+    {
+        setSGILOGFields(tif);
+    }
+    else
+    {
+        setScanlineFields(tif, size.width, size.height, type, params);
+        state->buffer.allocate(TIFFScanlineSize(tif) + 32);
+    }
+    m_state = state;
+    return true;
+}
+
+bool TiffEncoder::writeRows( const Mat& img )
+{
+    if (!m_state)
+        return false;
+
+    TiffEncoderState& state = *m_state;
+    CV_CheckTypeEQ(img.type(), state.type, "");
+    CV_Assert(img.cols == state.size.width && state.row + img.rows <= state.size.height);
+
+    TIFF* tif = (TIFF*)state.tif.get();
+    if (state.sgilog)
+        writeSGILOGStrips(tif, img, state.row);
+    else
+        writeScanlines(tif, img, state.row, state.buffer.data());
+    state.row += img.rows;
+    return true;
+}
+
+bool TiffEncoder::finishRows()
+{
+    if (!m_state)
+        return false;
+
+    Ptr<TiffEncoderState> state = m_state;
+    m_state.release();
+    CV_TIFF_CHECK_CALL(TIFFWriteDirectory((TIFF*)state->tif.get()));
+    return true;
+}
+
 } // namespace
 
 #endif
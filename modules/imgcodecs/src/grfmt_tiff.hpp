@@ -98,6 +98,8 @@ public:
 
     bool  readHeader() CV_OVERRIDE;
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  readRegion( Mat& img, const Rect& roi ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     void  close();
     bool  nextPage() CV_OVERRIDE;
 
@@ -110,12 +112,15 @@ protected:
     int normalizeChannelsNumber(int channels) const;
     bool m_hdr;
     size_t m_buf_pos;
+    int m_rows_read; // by readRows()
 
 private:
     TiffDecoder(const TiffDecoder &); // copy disabled
     TiffDecoder& operator=(const TiffDecoder &); // assign disabled
 };
 
+struct TiffEncoderState;
+
 // ... and writer
 class TiffEncoder CV_FINAL : public BaseImageEncoder
 {
@@ -129,6 +134,10 @@ public:
 
     bool writemulti(const std::vector<Mat>& img_vec, const std::vector<int>& params) CV_OVERRIDE;
 
+    bool  startRows( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& img ) CV_OVERRIDE;
+    bool  finishRows() CV_OVERRIDE;
+
     ImageEncoder newEncoder() const CV_OVERRIDE;
 
 protected:
@@ -139,6 +148,8 @@ protected:
     bool writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params );
     bool write_32FC3_SGILOG(const Mat& img, void* tif);
 
+    Ptr<TiffEncoderState> m_state; // of writing by rows
+
 private:
     TiffEncoder(const TiffEncoder &); // copy disabled
     TiffEncoder& operator=(const TiffEncoder &); // assign disabled
@@ -54,6 +54,7 @@
 #include <cerrno>
 #include <opencv2/core/utils/logger.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
 
 
 /****************************************************************************************\
@@ -255,12 +256,13 @@ static ImageDecoder findDecoder( const String& filename ) {
     return ImageDecoder();
 }
 
-static ImageDecoder findDecoder( const Mat& buf )
+/// returns the index of the codec in ImageCodecInitializer::decoders or -1 if the format is unknown
+static int findDecoderIndex( const Mat& buf )
 {
     size_t i, maxlen = 0;
 
     if( buf.rows*buf.cols < 1 || !buf.isContinuous() )
-        return ImageDecoder();
+        return -1;
 
     ImageCodecInitializer& codecs = getCodecs();
     for( i = 0; i < codecs.decoders.size(); i++ )
@@ -277,10 +279,18 @@ static ImageDecoder findDecoder( const Mat& buf )
     for( i = 0; i < codecs.decoders.size(); i++ )
     {
         if( codecs.decoders[i]->checkSignature(signature) )
-            return codecs.decoders[i]->newDecoder();
+            return (int)i;
     }
 
-    return ImageDecoder();
+    return -1;
+}
+
+static ImageDecoder findDecoder( const Mat& buf )
+{
+    int idx = findDecoderIndex(buf);
+    if( idx < 0 )
+        return ImageDecoder();
+    return getCodecs().decoders[idx]->newDecoder();
 }
 
 static ImageEncoder findEncoder( const String& _ext )
@@ -372,6 +382,61 @@ static void ApplyExifOrientation(ExifEntry_t orientationTag, Mat& img)
     }
 }
 
+static int GetExifOrientation(const ImageDecoder& decoder)
+{
+    ExifEntry_t orientationTag = decoder->getExifTag(ORIENTATION);
+    return orientationTag.tag != INVALID_TAG ? (int)orientationTag.field_u16 : (int)IMAGE_ORIENTATION_TL;
+}
+
+static void CheckRegion(const Rect& roi, const Size& size)
+{
+    if ((roi & Rect(Point(), size)) != roi)
+        CV_Error_(Error::StsOutOfRange, ("ROI (x=%d, y=%d, w=%d, h=%d) is outside of the image (%dx%d)",
+                  roi.x, roi.y, roi.width, roi.height, size.width, size.height));
+}
+
+/**
+ * Maps the region of the image after ExifTransform() into coordinates of the stored image
+ */
+static Rect ExifRegionToStored(int orientation, const Rect& roi, const Size& storedSize)
+{
+    const bool transposed = orientation >= IMAGE_ORIENTATION_LT && orientation <= IMAGE_ORIENTATION_LB;
+    const bool flipX = orientation == IMAGE_ORIENTATION_TR || orientation == IMAGE_ORIENTATION_BR ||
+                       orientation == IMAGE_ORIENTATION_RT || orientation == IMAGE_ORIENTATION_RB;
+    const bool flipY = orientation == IMAGE_ORIENTATION_BR || orientation == IMAGE_ORIENTATION_BL ||
+                       orientation == IMAGE_ORIENTATION_RB || orientation == IMAGE_ORIENTATION_LB;
+    const Size size = transposed ? Size(storedSize.height, storedSize.width) : storedSize;
+    CheckRegion(roi, size);
+
+    Rect r = roi;
+    if (flipX)
+        r.x = size.width - r.x - r.width;
+    if (flipY)
+        r.y = size.height - r.y - r.height;
+    if (transposed)
+        r = Rect(r.y, r.x, r.height, r.width);
+    return r;
+}
+
+/**
+ * Type of the image returned by imread() for the decoded type and the flags
+ */
+static int getReadType( int type, int flags )
+{
+    if( (flags & IMREAD_LOAD_GDAL) != IMREAD_LOAD_GDAL && flags != IMREAD_UNCHANGED )
+    {
+        if( (flags & IMREAD_ANYDEPTH) == 0 )
+            type = CV_MAKETYPE(CV_8U, CV_MAT_CN(type));
+
+        if( (flags & IMREAD_COLOR) != 0 ||
+           ((flags & IMREAD_ANYCOLOR) != 0 && CV_MAT_CN(type) > 1) )
+            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 3);
+        else
+            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
+    }
+    return type;
+}
+
 /**
  * Read an image into memory and return the information
  *
@@ -382,10 +447,11 @@ static void ApplyExifOrientation(ExifEntry_t orientationTag, Mat& img)
  *                      LOAD_MAT=2
  *                    }
  * @param[in] mat Reference to C++ Mat object (If LOAD_MAT)
+ * @param[in] roi Region of the resulting image to load, empty for the whole image
  *
 */
 static bool
-imread_( const String& filename, int flags, Mat& mat )
+imread_( const String& filename, int flags, Mat& mat, const Rect& roi = Rect() )
 {
     /// Search for the relevant decoder to handle the imagery
     ImageDecoder decoder;
@@ -444,26 +510,30 @@ imread_( const String& filename, int flags, Mat& mat )
     Size size = validateInputImageSize(Size(decoder->width(), decoder->height()));
 
     // grab the decoded type
-    int type = decoder->type();
-    if( (flags & IMREAD_LOAD_GDAL) != IMREAD_LOAD_GDAL && flags != IMREAD_UNCHANGED )
-    {
-        if( (flags & IMREAD_ANYDEPTH) == 0 )
-            type = CV_MAKETYPE(CV_8U, CV_MAT_CN(type));
+    int type = getReadType( decoder->type(), flags );
 
-        if( (flags & IMREAD_COLOR) != 0 ||
-           ((flags & IMREAD_ANYCOLOR) != 0 && CV_MAT_CN(type) > 1) )
-            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 3);
-        else
-            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
+    // if decoder is JpegDecoder then decoder->setScale always returns 1
+    const bool resized = decoder->setScale( scale_denom ) > 1;
+    const bool applyOrientation = (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED;
+
+    // the region is decoded natively unless the image has to be resized after decoding
+    const bool decodeRegion = !roi.empty() && !resized;
+    int orientation = IMAGE_ORIENTATION_TL;
+    Rect region(Point(), size);
+    if( decodeRegion )
+    {
+        if( applyOrientation )
+            orientation = GetExifOrientation(decoder);
+        region = ExifRegionToStored(orientation, roi, size);
     }
 
-    mat.create( size.height, size.width, type );
+    mat.create( region.height, region.width, type );
 
     // read the image data
     bool success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (region.size() == size ? decoder->readData(mat) : decoder->readRegion(mat, region))
             success = true;
     }
     catch (const cv::Exception& e)
@@ -480,17 +550,32 @@ imread_( const String& filename, int flags, Mat& mat )
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( resized )
     {
         resize( mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
     }
 
     /// optionally rotate the data if EXIF orientation flag says so
-    if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED )
+    if (!mat.empty() && applyOrientation)
     {
+        if (decodeRegion && GetExifOrientation(decoder) != orientation)
+        {
+            // EXIF data is located after the image data, so the region was mapped incorrectly
+            if (!imread_(filename, flags, mat))
+                return false;
+            CheckRegion(roi, mat.size());
+            mat = mat(roi).clone();
+            return true;
+        }
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
     }
 
+    if (!roi.empty() && !decodeRegion)
+    {
+        CheckRegion(roi, mat.size());
+        mat = mat(roi).clone();
+    }
+
     return true;
 }
 
@@ -632,6 +717,15 @@ Mat imread( const String& filename, int flags )
     return img;
 }
 
+Mat imread( const String& filename, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat img;
+    imread_( filename, flags, img, roi );
+    return img;
+}
+
 /**
 * Read a multi-page image
 *
@@ -721,6 +815,89 @@ size_t imcount(const String& filename, int flags)
 }
 
 
+static bool imreadInfo_( const ImageDecoder& decoder, const String& source, ImageInfo& info )
+{
+    try
+    {
+        if( !decoder->readHeader() )
+            return false;
+        info.size = Size(decoder->width(), decoder->height());
+        info.type = decoder->type();
+        info.orientation = GetExifOrientation(decoder);
+        info.pages = 1;
+        while( decoder->nextPage() )
+            info.pages++;
+    }
+    catch (const cv::Exception& e)
+    {
+        std::cerr << "imreadInfo_('" << source << "'): can't read header: " << e.what() << std::endl << std::flush;
+        return false;
+    }
+    catch (...)
+    {
+        std::cerr << "imreadInfo_('" << source << "'): can't read header: unknown exception" << std::endl << std::flush;
+        return false;
+    }
+    return true;
+}
+
+bool imreadInfo( const String& filename, ImageInfo& info )
+{
+    CV_TRACE_FUNCTION();
+
+    info = ImageInfo();
+    ImageDecoder decoder = findDecoder(filename);
+    if( !decoder )
+        return false;
+    decoder->setSource(filename);
+    if( imreadInfo_(decoder, filename, info) )
+        return true;
+    info = ImageInfo();
+    return false;
+}
+
+bool imdecodeInfo( InputArray _buf, ImageInfo& info )
+{
+    CV_TRACE_FUNCTION();
+
+    info = ImageInfo();
+    Mat buf = _buf.getMat();
+    CV_Assert(!buf.empty());
+    CV_Assert(buf.isContinuous());
+    CV_Assert(buf.checkVector(1, CV_8U) > 0);
+    Mat buf_row = buf.reshape(1, 1);  // decoders expects single row, avoid issues with vector columns
+
+    ImageDecoder decoder = findDecoder(buf_row);
+    if( !decoder )
+        return false;
+
+    String filename;
+    if( !decoder->setSource(buf_row) )
+    {
+        filename = tempfile();
+        FILE* f = fopen( filename.c_str(), "wb" );
+        if( !f )
+            return false;
+        size_t bufSize = buf_row.total()*buf_row.elemSize();
+        bool written = fwrite(buf_row.ptr(), 1, bufSize, f) == bufSize;
+        written = fclose(f) == 0 && written;
+        if( !written )
+        {
+            remove(filename.c_str());
+            CV_Error( Error::StsError, "failed to write image data to temporary file" );
+        }
+        decoder->setSource(filename);
+    }
+
+    bool result = imreadInfo_(decoder, filename, info);
+    decoder.release();  // close the temporary file
+    if( !filename.empty() && 0 != remove(filename.c_str()) )
+        std::cerr << "unable to remove temporary file:" << filename << std::endl << std::flush;
+    if( !result )
+        info = ImageInfo();
+    return result;
+}
+
 static bool imwrite_( const String& filename, const std::vector<Mat>& img_vec,
                       const std::vector<int>& params, bool flipv )
 {
@@ -812,20 +989,13 @@ bool imwrite( const String& filename, InputArray _img,
     return imwrite_(filename, img_vec, params, false);
 }
 
+/// decodes the image of buf_row by the decoder, which may be reused for several images.
+/// If preallocated, the image is written to mat, which must have the size and type of the decoded image.
 static bool
-imdecode_( const Mat& buf, int flags, Mat& mat )
+imdecodeWith_( const ImageDecoder& decoder, const Mat& buf_row, int flags, Mat& mat, bool preallocated = false )
 {
-    CV_Assert(!buf.empty());
-    CV_Assert(buf.isContinuous());
-    CV_Assert(buf.checkVector(1, CV_8U) > 0);
-    Mat buf_row = buf.reshape(1, 1);  // decoders expects single row, avoid issues with vector columns
-
     String filename;
 
-    ImageDecoder decoder = findDecoder(buf_row);
-    if( !decoder )
-        return 0;
-
     int scale_denom = 1;
     if( flags > IMREAD_LOAD_GDAL )
     {
@@ -845,8 +1015,12 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
         filename = tempfile();
         FILE* f = fopen( filename.c_str(), "wb" );
         if( !f )
+        {
+            if( !preallocated )
+                mat.release();
             return 0;
-        size_t bufSize = buf_row.total()*buf.elemSize();
+        }
+        size_t bufSize = buf_row.total()*buf_row.elemSize();
         if (fwrite(buf_row.ptr(), 1, bufSize, f) != bufSize)
         {
             fclose( f );
@@ -875,7 +1049,6 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
     }
     if (!success)
     {
-        decoder.release();
         if (!filename.empty())
         {
             if (0 != remove(filename.c_str()))
@@ -883,31 +1056,48 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
                 std::cerr << "unable to remove temporary file:" << filename << std::endl << std::flush;
             }
         }
+        // the output may be reused by imdecodeBatch(), the images which can't be decoded are empty
+        if( !preallocated )
+            mat.release();
         return 0;
     }
 
     // established the required input image size
     Size size = validateInputImageSize(Size(decoder->width(), decoder->height()));
 
-    int type = decoder->type();
-    if( (flags & IMREAD_LOAD_GDAL) != IMREAD_LOAD_GDAL && flags != IMREAD_UNCHANGED )
-    {
-        if( (flags & IMREAD_ANYDEPTH) == 0 )
-            type = CV_MAKETYPE(CV_8U, CV_MAT_CN(type));
+    int type = getReadType(decoder->type(), flags);
 
-        if( (flags & IMREAD_COLOR) != 0 ||
-           ((flags & IMREAD_ANYCOLOR) != 0 && CV_MAT_CN(type) > 1) )
-            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 3);
-        else
-            type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
+    // the decoders, which don't support reduced decoding, don't reset the scale (see JpegDecoder)
+    const bool needResize = decoder->setScale( scale_denom ) > 1;
+    const bool applyOrientation = (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED;
+    const int orientation = applyOrientation ? GetExifOrientation(decoder) : (int)IMAGE_ORIENTATION_TL;
+
+    Mat tmp;
+    Mat* img = &mat;
+    if( preallocated )
+    {
+        Size dstSize = needResize ? Size( size.width / scale_denom, size.height / scale_denom ) : size;
+        if( orientation >= IMAGE_ORIENTATION_LT )
+            std::swap(dstSize.width, dstSize.height);
+        if( mat.type() != type || mat.size() != dstSize )
+        {
+            if( !filename.empty() )
+                remove(filename.c_str());
+            CV_Error(Error::StsUnmatchedSizes, cv::format("The destination %s %dx%d doesn't match the decoded image %s %dx%d",
+                                                          typeToString(mat.type()).c_str(), mat.cols, mat.rows,
+                                                          typeToString(type).c_str(), dstSize.width, dstSize.height));
+        }
+        // the image is written by the decoder directly to the destination unless it is resized or rotated then
+        if( needResize || orientation != IMAGE_ORIENTATION_TL )
+            img = &tmp;
     }
 
-    mat.create( size.height, size.width, type );
+    img->create( size.height, size.width, type );
 
     success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (decoder->readData(*img))
             success = true;
     }
     catch (const cv::Exception& e)
@@ -929,24 +1119,52 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
 
     if (!success)
     {
-        mat.release();
+        if (!preallocated)
+            mat.release();
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( needResize )
     {
-        resize(mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+        resize(*img, *img, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
     }
 
     /// optionally rotate the data if EXIF' orientation flag says so
-    if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
+    if (!img->empty() && applyOrientation)
     {
-        ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
+        // some decoders read the orientation with the image data
+        if (img == &mat && preallocated && GetExifOrientation(decoder) != IMAGE_ORIENTATION_TL)
+        {
+            tmp = mat.clone();
+            img = &tmp;
+        }
+        ApplyExifOrientation(decoder->getExifTag(ORIENTATION), *img);
+    }
+
+    if (img != &mat)
+    {
+        CV_Assert(img->size() == mat.size());
+        img->copyTo(mat);
     }
 
     return true;
 }
 
+static bool
+imdecode_( const Mat& buf, int flags, Mat& mat, bool preallocated = false )
+{
+    CV_Assert(!buf.empty());
+    CV_Assert(buf.isContinuous());
+    CV_Assert(buf.checkVector(1, CV_8U) > 0);
+    Mat buf_row = buf.reshape(1, 1);  // decoders expects single row, avoid issues with vector columns
+
+    ImageDecoder decoder = findDecoder(buf_row);
+    if( !decoder )
+        return 0;
+
+    return imdecodeWith_(decoder, buf_row, flags, mat, preallocated);
+}
+
 
 Mat imdecode( InputArray _buf, int flags )
 {
@@ -969,6 +1187,85 @@ Mat imdecode( InputArray _buf, int flags, Mat* dst )
     return *dst;
 }
 
+bool imdecodeInto( InputArray _buf, int flags, InputOutputArray dst )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat buf = _buf.getMat();
+    if( dst.empty() )
+    {
+        if( dst.isMat() )
+            return imdecode_( buf, flags, dst.getMatRef() );
+        Mat img;
+        bool result = imdecode_( buf, flags, img );
+        img.copyTo(dst);
+        return result;
+    }
+
+    CV_CheckLE(dst.dims(), 2, "");
+    Mat mat = dst.getMat();  // UMat is mapped to the host memory till the end of the function
+    return imdecode_( buf, flags, mat, true );
+}
+
+class ImdecodeBatchInvoker : public ParallelLoopBody
+{
+public:
+    ImdecodeBatchInvoker(const std::vector<Mat>& bufs_, int flags_, std::vector<Mat>& dst_, std::vector<uchar>& success_)
+        : bufs(bufs_), flags(flags_), dst(dst_), success(success_)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        ImageCodecInitializer& codecs = getCodecs();
+        // decoders of the thread, one per format, are created on demand and reused for the following images
+        std::vector<ImageDecoder>& decoders = tlsDecoders.getRef();
+        if( decoders.empty() )
+            decoders.resize(codecs.decoders.size());
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int idx = findDecoderIndex(bufs[i]);
+            if( idx < 0 )
+            {
+                dst[i].release();
+                continue;
+            }
+            if( !decoders[idx] )
+                decoders[idx] = codecs.decoders[idx]->newDecoder();
+            success[i] = imdecodeWith_(decoders[idx], bufs[i], flags, dst[i]);
+        }
+    }
+
+private:
+    const std::vector<Mat>& bufs;
+    const int flags;
+    std::vector<Mat>& dst;
+    std::vector<uchar>& success;
+    mutable TLSData<std::vector<ImageDecoder> > tlsDecoders;
+};
+
+bool imdecodeBatch( InputArrayOfArrays _bufs, int flags, std::vector<Mat>& dst )
+{
+    CV_TRACE_FUNCTION();
+
+    const int n = (int)_bufs.total();
+    std::vector<Mat> bufs(n);
+    for( int i = 0; i < n; i++ )
+    {
+        Mat buf = _bufs.getMat(i);
+        CV_Assert(!buf.empty());
+        CV_Assert(buf.isContinuous());
+        CV_Assert(buf.checkVector(1, CV_8U) > 0);
+        bufs[i] = buf.reshape(1, 1);  // decoders expects single row, avoid issues with vector columns
+    }
+
+    dst.resize(n);
+    std::vector<uchar> success(n, (uchar)0);
+    parallel_for_(Range(0, n), ImdecodeBatchInvoker(bufs, flags, dst, success));
+
+    return std::find(success.begin(), success.end(), (uchar)0) == success.end();
+}
+
 bool imencode( const String& ext, InputArray _image,
                std::vector<uchar>& buf, const std::vector<int>& params )
 {
@@ -1034,6 +1331,191 @@ bool haveImageWriter( const String& filename )
     return !encoder.empty();
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+
+ImageReader::~ImageReader() {}
+
+class ImageReaderImpl CV_FINAL : public ImageReader
+{
+public:
+    ImageReaderImpl(const ImageDecoder& decoder_, int type_)
+        : decoder(decoder_), imageSize(decoder_->width(), decoder_->height()), imageType(type_),
+          row(0), mode(MODE_UNKNOWN)
+    {}
+
+    Size size() const CV_OVERRIDE { return imageSize; }
+    int type() const CV_OVERRIDE { return imageType; }
+    int nextRow() const CV_OVERRIDE { return row; }
+
+    bool read(OutputArray _band, int maxRows) CV_OVERRIDE
+    {
+        CV_CheckGT(maxRows, 0, "");
+        const int rows = std::min(maxRows, imageSize.height - row);
+        if (rows <= 0 || mode == MODE_FAILED)
+            return false;
+
+        _band.create(rows, imageSize.width, imageType);
+        Mat band = _band.getMat();
+
+        if (mode != MODE_FULL)
+        {
+            if (decoder->readRows(band))
+            {
+                mode = MODE_ROWS;
+                row += rows;
+                return true;
+            }
+            if (mode == MODE_ROWS)
+            {
+                mode = MODE_FAILED;
+                return false;
+            }
+
+            // the decoder can't decode this image by rows
+            full.create(validateInputImageSize(imageSize), imageType);
+            if (!decoder->readData(full))
+            {
+                full.release();
+                mode = MODE_FAILED;
+                return false;
+            }
+            mode = MODE_FULL;
+        }
+
+        full.rowRange(row, row + rows).copyTo(band);
+        row += rows;
+        if (row == imageSize.height)
+            full.release();
+        return true;
+    }
+
+private:
+    enum Mode { MODE_UNKNOWN, MODE_ROWS, MODE_FULL, MODE_FAILED };
+
+    ImageDecoder decoder;
+    Size imageSize;
+    int imageType;
+    int row;
+    Mode mode;
+    Mat full;  // the whole image if the decoder can't decode it by rows
+};
+
+Ptr<ImageReader> ImageReader::create( const String& filename, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    if( flags != IMREAD_UNCHANGED && (flags & (IMREAD_REDUCED_GRAYSCALE_2 | IMREAD_REDUCED_GRAYSCALE_4 | IMREAD_REDUCED_GRAYSCALE_8)) != 0 )
+        CV_Error( Error::StsBadArg, "ImageReader: IMREAD_REDUCED_* modes are not supported" );
+
+    ImageDecoder decoder = findDecoder( filename );
+    if( !decoder )
+        return Ptr<ImageReader>();
+
+    decoder->setSource( filename );
+    if( !decoder->readHeader() || decoder->width() <= 0 || decoder->height() <= 0 )
+        return Ptr<ImageReader>();
+
+    return makePtr<ImageReaderImpl>(decoder, getReadType(decoder->type(), flags));
+}
+
+ImageWriter::~ImageWriter() {}
+
+class ImageWriterImpl CV_FINAL : public ImageWriter
+{
+public:
+    ImageWriterImpl(const ImageEncoder& encoder_, Size size_, int type_, const std::vector<int>& params_)
+        : encoder(encoder_), imageSize(size_), imageType(type_), params(params_), row(0),
+          closed(false), result(true)
+    {
+        encodedType = imageType;
+        if( !encoder->isFormatSupported(CV_MAT_DEPTH(imageType)) )
+        {
+            CV_Assert( encoder->isFormatSupported(CV_8U) );
+            encodedType = CV_MAKETYPE(CV_8U, CV_MAT_CN(imageType));
+        }
+
+        streaming = encoder->startRows(imageSize, encodedType, params);
+        if( !streaming )
+            full.create(imageSize, encodedType);
+    }
+
+    ~ImageWriterImpl()
+    {
+        try
+        {
+            close();
+        }
+        catch (...) {}
+    }
+
+    Size size() const CV_OVERRIDE { return imageSize; }
+    int nextRow() const CV_OVERRIDE { return row; }
+
+    bool write(InputArray _band) CV_OVERRIDE
+    {
+        CV_Assert(!closed);
+        Mat band = _band.getMat();
+        CV_CheckTypeEQ(band.type(), imageType, "");
+        CV_CheckEQ(band.cols, imageSize.width, "");
+        CV_CheckLE(row + band.rows, imageSize.height, "The band exceeds the image");
+
+        if( band.type() != encodedType )
+        {
+            Mat temp;
+            band.convertTo(temp, CV_MAT_DEPTH(encodedType));
+            band = temp;
+        }
+
+        if( streaming )
+            result = encoder->writeRows(band) && result;
+        else
+            band.copyTo(full.rowRange(row, row + band.rows));
+        row += band.rows;
+        return result;
+    }
+
+    bool close() CV_OVERRIDE
+    {
+        if( closed )
+            return result;
+        closed = true;
+
+        if( streaming )
+            result = encoder->finishRows() && result;
+        else
+            result = row == imageSize.height && encoder->write(full, params) && result;
+        full.release();
+        result = result && row == imageSize.height;
+        return result;
+    }
+
+private:
+    ImageEncoder encoder;
+    Size imageSize;
+    int imageType, encodedType;
+    std::vector<int> params;
+    int row;
+    bool streaming, closed, result;
+    Mat full;  // the whole image if the encoder can't encode it by rows
+};
+
+Ptr<ImageWriter> ImageWriter::create( const String& filename, Size size, int type, const std::vector<int>& params )
+{
+    CV_TRACE_FUNCTION();
+
+    CV_Assert( size.width > 0 && size.height > 0 );
+    const int channels = CV_MAT_CN(type);
+    CV_Assert( channels == 1 || channels == 3 || channels == 4 );
+    CV_Assert( params.size() <= CV_IO_MAX_IMAGE_PARAMS*2 );
+
+    ImageEncoder encoder = findEncoder( filename );
+    if( !encoder )
+        CV_Error( Error::StsError, "could not find a writer for the specified extension" );
+    encoder->setDestination( filename );
+
+    return makePtr<ImageWriterImpl>(encoder, size, type, params);
+}
+
 }
 
 /* End of file. */
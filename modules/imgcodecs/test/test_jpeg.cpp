@@ -178,6 +178,95 @@ TEST(Imgcodecs_Jpeg, encode_decode_rst_jpeg)
     EXPECT_EQ(0, remove(output_normal.c_str()));
 }
 
+static std::vector<int> jpegParams(int id1, int value1, int id2 = -1, int value2 = 0)
+{
+    std::vector<int> params;
+    params.push_back(id1);
+    params.push_back(value1);
+    if (id2 >= 0)
+    {
+        params.push_back(id2);
+        params.push_back(value2);
+    }
+    return params;
+}
+
+TEST(Imgcodecs_Jpeg, encode_parallel)
+{
+    Mat img(1050, 1030, CV_8UC3);
+    randu(img, 0, 256);
+    Mat gray;
+    cvtColor(img, gray, COLOR_BGR2GRAY);
+
+    std::vector<uchar> parallel, sequential;
+    // 4:2:0 subsampling, 16x16 MCU
+    ASSERT_TRUE(imencode(".jpg", img, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    ASSERT_TRUE(imencode(".jpg", img, sequential, jpegParams(IMWRITE_JPEG_RST_INTERVAL, 65*8)));
+    EXPECT_TRUE(parallel == sequential);
+    // 8x8 MCU
+    ASSERT_TRUE(imencode(".jpg", gray, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    ASSERT_TRUE(imencode(".jpg", gray, sequential, jpegParams(IMWRITE_JPEG_RST_INTERVAL, 129*8)));
+    EXPECT_TRUE(parallel == sequential);
+    // the restart interval of the user
+    ASSERT_TRUE(imencode(".jpg", img, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1, IMWRITE_JPEG_RST_INTERVAL, 65*3)));
+    ASSERT_TRUE(imencode(".jpg", img, sequential, jpegParams(IMWRITE_JPEG_RST_INTERVAL, 65*3)));
+    EXPECT_TRUE(parallel == sequential);
+    // not supported, encoded sequentially
+    ASSERT_TRUE(imencode(".jpg", img, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1, IMWRITE_JPEG_PROGRESSIVE, 1)));
+    ASSERT_TRUE(imencode(".jpg", img, sequential, jpegParams(IMWRITE_JPEG_PROGRESSIVE, 1)));
+    EXPECT_TRUE(parallel == sequential);
+    ASSERT_TRUE(imencode(".jpg", img, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1, IMWRITE_JPEG_RST_INTERVAL, 100)));
+    ASSERT_TRUE(imencode(".jpg", img, sequential, jpegParams(IMWRITE_JPEG_RST_INTERVAL, 100)));
+    EXPECT_TRUE(parallel == sequential);
+
+    const string fname = cv::tempfile(".jpg");
+    ASSERT_TRUE(imwrite(fname, img, jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    ASSERT_TRUE(imencode(".jpg", img, parallel, jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    EXPECT_EQ(0, cvtest::norm(imdecode(parallel, IMREAD_COLOR), imread(fname), NORM_INF));
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Imgcodecs_Jpeg, decode_parallel)
+{
+    const int threads = getNumThreads();
+    Mat img(1050, 1030, CV_8UC3);
+    randu(img, 0, 256);
+    Mat gray;
+    cvtColor(img, gray, COLOR_BGR2GRAY);
+
+    std::vector<std::vector<uchar> > bufs(5);
+    ASSERT_TRUE(imencode(".jpg", img, bufs[0], jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    ASSERT_TRUE(imencode(".jpg", gray, bufs[1], jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    ASSERT_TRUE(imencode(".jpg", img, bufs[2], jpegParams(IMWRITE_JPEG_LUMA_QUALITY, 90, IMWRITE_JPEG_CHROMA_QUALITY, 70)));
+    ASSERT_TRUE(imencode(".jpg", img, bufs[3], jpegParams(IMWRITE_JPEG_RST_INTERVAL, 65)));
+    ASSERT_TRUE(imencode(".jpg", img, bufs[4], jpegParams(IMWRITE_JPEG_RST_INTERVAL, 100)));
+
+    const int modes[] = { IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_REDUCED_COLOR_2, IMREAD_REDUCED_GRAYSCALE_8 };
+    for (size_t i = 0; i < bufs.size(); i++)
+    {
+        for (size_t m = 0; m < sizeof(modes)/sizeof(modes[0]); m++)
+        {
+            setNumThreads(1);
+            Mat ref = imdecode(bufs[i], modes[m]);
+            setNumThreads(4);
+            Mat dst = imdecode(bufs[i], modes[m]);
+            setNumThreads(threads);
+            ASSERT_FALSE(ref.empty());
+            ASSERT_EQ(ref.size(), dst.size());
+            ASSERT_EQ(ref.type(), dst.type());
+            EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "i=" << i << " mode=" << modes[m];
+        }
+    }
+
+    const string fname = cv::tempfile(".jpg");
+    ASSERT_TRUE(imwrite(fname, img, jpegParams(IMWRITE_JPEG_PARALLEL, 1)));
+    setNumThreads(4);
+    Mat dst = imread(fname);
+    setNumThreads(threads);
+    EXPECT_EQ(0, cvtest::norm(imdecode(bufs[0], IMREAD_COLOR), dst, NORM_INF));
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
 #endif // HAVE_JPEG
 
 }} // namespace
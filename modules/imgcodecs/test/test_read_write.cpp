@@ -303,4 +303,436 @@ TEST(Imgcodecs_Image, write_umat)
     EXPECT_EQ(0, remove(dst_name.c_str()));
 }
 
+//==================================================================================================
+
+typedef tuple<string, ImreadModes> Imgcodecs_ImreadROI_t;
+typedef testing::TestWithParam<Imgcodecs_ImreadROI_t> Imgcodecs_ImreadROI_Modes;
+
+TEST_P(Imgcodecs_ImreadROI_Modes, accuracy)
+{
+    const string ext = get<0>(GetParam());
+    const ImreadModes mode = get<1>(GetParam());
+    const string fname = cv::tempfile(ext.c_str());
+
+    Mat image(253, 317, CV_8UC3);
+    randu(image, 0, 256);
+    GaussianBlur(image, image, Size(5, 5), 0);
+    ASSERT_TRUE(imwrite(fname, image));
+
+    const Mat full = imread(fname, mode);
+    ASSERT_FALSE(full.empty());
+
+    const Rect rois[] = {
+        Rect(0, 0, full.cols, full.rows), Rect(0, 0, 17, 9), Rect(41, 37, 64, 60),
+        Rect(13, full.rows - 52, full.cols - 13, 52), Rect(full.cols - 1, full.rows - 1, 1, 1),
+        Rect(33, 0, 1, full.rows), Rect(0, 75, full.cols, 20)
+    };
+    for (size_t i = 0; i < sizeof(rois)/sizeof(rois[0]); i++)
+    {
+        const Rect& roi = rois[i];
+        Mat part = imread(fname, roi, mode);
+        ASSERT_EQ(roi.size(), part.size()) << roi;
+        ASSERT_EQ(full.type(), part.type());
+        EXPECT_EQ(0, cvtest::norm(full(roi), part, NORM_INF)) << roi;
+    }
+    EXPECT_EQ(0, cvtest::norm(full, imread(fname, Rect(), mode), NORM_INF));
+
+    EXPECT_THROW(imread(fname, Rect(-1, 0, 10, 10), mode), cv::Exception);
+    EXPECT_THROW(imread(fname, Rect(full.cols - 10, 0, 11, 10), mode), cv::Exception);
+    EXPECT_THROW(imread(fname, Rect(0, full.rows, 10, 1), mode), cv::Exception);
+
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+const string roi_exts[] = {
+#ifdef HAVE_PNG
+    ".png",
+#endif
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+    ".bmp",  // decoded completely
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_ImreadROI_Modes, testing::Combine(
+    testing::ValuesIn(roi_exts),
+    testing::Values(IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_REDUCED_COLOR_2)));
+
+#ifdef HAVE_TIFF
+TEST(Imgcodecs_ImreadROI, tiff_depths)
+{
+    const int types[] = { CV_16UC1, CV_16UC3, CV_32FC3, CV_64FC1 };
+    for (size_t i = 0; i < sizeof(types)/sizeof(types[0]); i++)
+    {
+        const string fname = cv::tempfile(".tiff");
+        Mat image(150, 70, types[i]);
+        randu(image, 0, 1000);
+        ASSERT_TRUE(imwrite(fname, image));
+
+        const Rect roi(5, 60, 50, 33);
+        Mat part = imread(fname, roi, IMREAD_UNCHANGED);
+        ASSERT_EQ(image.type(), part.type());
+        // 32F images are saved with lossy SGILOG compression and converted from XYZ on reading
+        EXPECT_LE(cvtest::norm(imread(fname, IMREAD_UNCHANGED)(roi), part, NORM_INF), 1e-3) << typeToString(types[i]);
+
+        EXPECT_EQ(0, remove(fname.c_str()));
+    }
+}
+#endif
+
+#ifdef HAVE_JPEG
+TEST(Imgcodecs_ImreadROI, jpeg_exif_orientation)
+{
+    Mat image(120, 90, CV_8UC3);
+    randu(image, 0, 256);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".jpg", image, buf));
+    ASSERT_EQ(0xD8, buf[1]);
+
+    for (int orientation = 1; orientation <= 8; orientation++)
+    {
+        // APP1 segment with Exif header and TIFF IFD holding the orientation tag only
+        const uchar app1[] = {
+            0xFF, 0xE1, 0x00, 34, 'E', 'x', 'i', 'f', 0, 0,
+            'I', 'I', 42, 0, 8, 0, 0, 0,
+            1, 0, 0x12, 0x01, 3, 0, 1, 0, 0, 0, (uchar)orientation, 0, 0, 0,
+            0, 0, 0, 0
+        };
+        std::vector<uchar> data(buf.begin(), buf.begin() + 2);
+        data.insert(data.end(), app1, app1 + sizeof(app1));
+        data.insert(data.end(), buf.begin() + 2, buf.end());
+
+        const string fname = cv::tempfile(".jpg");
+        {
+            std::ofstream f(fname.c_str(), std::ios::binary);
+            f.write((const char*)&data[0], data.size());
+        }
+
+        const Mat full = imread(fname);
+        ASSERT_EQ(orientation <= 4 ? image.size() : Size(image.rows, image.cols), full.size()) << orientation;
+        const Rect roi(7, 11, 40, 50);
+        Mat part = imread(fname, roi);
+        EXPECT_EQ(0, cvtest::norm(full(roi), part, NORM_INF)) << "orientation=" << orientation;
+        const int noOrientation = IMREAD_COLOR | IMREAD_IGNORE_ORIENTATION;
+        EXPECT_EQ(0, cvtest::norm(imread(fname, noOrientation)(roi), imread(fname, roi, noOrientation), NORM_INF));
+
+        EXPECT_EQ(0, remove(fname.c_str()));
+    }
+}
+#endif
+
+TEST(Imgcodecs_Image, imreadInfo)
+{
+    std::vector<uchar> buf;
+    ImageInfo info;
+#ifdef HAVE_PNG
+    Mat image16(31, 47, CV_16UC4);
+    randu(image16, 0, 65536);
+    ASSERT_TRUE(imencode(".png", image16, buf));
+    ASSERT_TRUE(imdecodeInfo(buf, info));
+    EXPECT_EQ(image16.size(), info.size);
+    EXPECT_EQ(CV_16UC4, info.type);
+    EXPECT_EQ(1, info.pages);
+    EXPECT_EQ(1, info.orientation);
+#endif
+#ifdef HAVE_JPEG
+    Mat image(40, 50, CV_8UC3);
+    randu(image, 0, 256);
+    ASSERT_TRUE(imencode(".jpg", image, buf));
+    const uchar app1[] = {
+        0xFF, 0xE1, 0x00, 34, 'E', 'x', 'i', 'f', 0, 0,
+        'I', 'I', 42, 0, 8, 0, 0, 0,
+        1, 0, 0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+        0, 0, 0, 0
+    };
+    buf.insert(buf.begin() + 2, app1, app1 + sizeof(app1));
+    const string jpgname = cv::tempfile(".jpg");
+    {
+        std::ofstream f(jpgname.c_str(), std::ios::binary);
+        f.write((const char*)&buf[0], buf.size());
+    }
+    ASSERT_TRUE(imreadInfo(jpgname, info));
+    EXPECT_EQ(image.size(), info.size);
+    EXPECT_EQ(CV_8UC3, info.type);
+    EXPECT_EQ(1, info.pages);
+    EXPECT_EQ(6, info.orientation);
+    EXPECT_EQ(Size(info.size.height, info.size.width), imread(jpgname).size());
+    EXPECT_EQ(0, remove(jpgname.c_str()));
+#endif
+#ifdef HAVE_TIFF
+    std::vector<Mat> pages(3, Mat(20, 30, CV_8UC1, Scalar::all(5)));
+    const string tiffname = cv::tempfile(".tiff");
+    ASSERT_TRUE(imwrite(tiffname, pages));
+    ASSERT_TRUE(imreadInfo(tiffname, info));
+    EXPECT_EQ(Size(30, 20), info.size);
+    EXPECT_EQ(CV_8UC1, info.type);
+    EXPECT_EQ(3, info.pages);
+    EXPECT_EQ(0, remove(tiffname.c_str()));
+#endif
+
+    EXPECT_FALSE(imdecodeInfo(std::vector<uchar>(100, (uchar)'x'), info));
+    EXPECT_EQ(0, info.pages);
+    EXPECT_FALSE(imreadInfo(cv::tempfile(".png"), info));
+}
+
+TEST(Imgcodecs_Image, imdecodeInto)
+{
+    const string decodeExts[] = {
+#ifdef HAVE_JPEG
+        ".jpg",
+#endif
+#ifdef HAVE_PNG
+        ".png",
+#endif
+#ifdef HAVE_TIFF
+        ".tiff",
+#endif
+#ifdef HAVE_IMGCODEC_PXM
+        ".ppm",
+#endif
+        ".bmp"
+    };
+    const int modes[] = { IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_REDUCED_COLOR_2 };
+
+    Mat image(61, 83, CV_8UC3);
+    randu(image, 0, 256);
+    for (size_t i = 0; i < sizeof(decodeExts)/sizeof(decodeExts[0]); i++)
+    {
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode(decodeExts[i], image, buf));
+        for (size_t m = 0; m < sizeof(modes)/sizeof(modes[0]); m++)
+        {
+            const Mat ref = imdecode(buf, modes[m]);
+            ASSERT_FALSE(ref.empty());
+
+            // the image of a batch
+            Mat batch(ref.rows*3, ref.cols + 10, ref.type(), Scalar::all(7));
+            Mat dst = batch(Rect(5, ref.rows, ref.cols, ref.rows));
+            const uchar* data = dst.data;
+            ASSERT_TRUE(imdecodeInto(buf, modes[m], dst)) << decodeExts[i] << " mode=" << modes[m];
+            EXPECT_EQ(data, dst.data);
+            EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << decodeExts[i] << " mode=" << modes[m];
+            dst.setTo(Scalar::all(7));
+            EXPECT_EQ(0, countNonZero(batch.reshape(1) != 7)) << decodeExts[i] << " mode=" << modes[m];
+
+            UMat udst(ref.size(), ref.type());
+            ASSERT_TRUE(imdecodeInto(buf, modes[m], udst));
+            EXPECT_EQ(0, cvtest::norm(ref, udst.getMat(ACCESS_READ), NORM_INF)) << decodeExts[i] << " mode=" << modes[m];
+
+            Mat wrong(ref.rows + 1, ref.cols, ref.type());
+            EXPECT_THROW(imdecodeInto(buf, modes[m], wrong), cv::Exception);
+            wrong.create(ref.size(), CV_MAKETYPE(CV_16U, ref.channels()));
+            EXPECT_THROW(imdecodeInto(buf, modes[m], wrong), cv::Exception);
+        }
+
+        Mat empty;
+        ASSERT_TRUE(imdecodeInto(buf, IMREAD_COLOR, empty));
+        EXPECT_EQ(0, cvtest::norm(imdecode(buf, IMREAD_COLOR), empty, NORM_INF));
+    }
+
+#ifdef HAVE_JPEG
+    // rotated image
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".jpg", image, buf));
+    const uchar app1[] = {
+        0xFF, 0xE1, 0x00, 34, 'E', 'x', 'i', 'f', 0, 0,
+        'I', 'I', 42, 0, 8, 0, 0, 0,
+        1, 0, 0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+        0, 0, 0, 0
+    };
+    buf.insert(buf.begin() + 2, app1, app1 + sizeof(app1));
+    const Mat ref = imdecode(buf, IMREAD_COLOR);
+    ASSERT_EQ(Size(image.rows, image.cols), ref.size());
+    Mat batch(ref.rows, ref.cols*2, CV_8UC3, Scalar::all(0));
+    Mat dst = batch.colRange(ref.cols, ref.cols*2);
+    ASSERT_TRUE(imdecodeInto(buf, IMREAD_COLOR, dst));
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(batch.colRange(0, ref.cols), NORM_INF));
+#endif
+
+    Mat garbage(10, 10, CV_8UC3);
+    EXPECT_FALSE(imdecodeInto(std::vector<uchar>(100, (uchar)'x'), IMREAD_COLOR, garbage));
+}
+
+TEST(Imgcodecs_Image, imdecodeBatch)
+{
+    const string batchExts[] = {
+#ifdef HAVE_JPEG
+        ".jpg",
+#endif
+#ifdef HAVE_PNG
+        ".png",
+#endif
+        ".bmp"
+    };
+    const int numExts = (int)(sizeof(batchExts)/sizeof(batchExts[0]));
+
+    std::vector<std::vector<uchar> > bufs;
+    for (int i = 0; i < 30; i++)
+    {
+        Mat image(40 + i*3, 64 - i, i % 4 ? CV_8UC3 : CV_8UC1);
+        randu(image, 0, 256);
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode(batchExts[i % numExts], image, buf));
+        bufs.push_back(buf);
+    }
+#ifdef HAVE_JPEG
+    {
+        // the orientation of an image must not be applied to the next one decoded by the same decoder
+        std::vector<uchar>& buf = bufs[0];
+        ASSERT_EQ(0xD8, buf[1]);
+        const uchar app1[] = {
+            0xFF, 0xE1, 0x00, 34, 'E', 'x', 'i', 'f', 0, 0,
+            'I', 'I', 42, 0, 8, 0, 0, 0,
+            1, 0, 0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+            0, 0, 0, 0
+        };
+        buf.insert(buf.begin() + 2, app1, app1 + sizeof(app1));
+    }
+#endif
+    bufs[7].assign(100, (uchar)'x');  // unknown format
+    bufs[11].resize(bufs[11].size() / 3);  // truncated image
+
+    const int modes[] = { IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_UNCHANGED, IMREAD_REDUCED_COLOR_2 };
+    for (size_t m = 0; m < sizeof(modes)/sizeof(modes[0]); m++)
+    {
+        std::vector<Mat> dst;
+        EXPECT_FALSE(imdecodeBatch(bufs, modes[m], dst));
+        ASSERT_EQ(bufs.size(), dst.size());
+        std::vector<uchar*> data(dst.size());
+        for (size_t i = 0; i < bufs.size(); i++)
+        {
+            const Mat ref = imdecode(bufs[i], modes[m]);
+            EXPECT_EQ(ref.empty(), dst[i].empty()) << "mode=" << modes[m] << " i=" << i;
+            if (ref.empty())
+                continue;
+            ASSERT_EQ(ref.size(), dst[i].size()) << "mode=" << modes[m] << " i=" << i;
+            ASSERT_EQ(ref.type(), dst[i].type()) << "mode=" << modes[m] << " i=" << i;
+            EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF)) << "mode=" << modes[m] << " i=" << i;
+            data[i] = dst[i].data;
+        }
+
+        // the output matrices are reused
+        EXPECT_FALSE(imdecodeBatch(bufs, modes[m], dst));
+        for (size_t i = 0; i < bufs.size(); i++)
+        {
+            if (modes[m] != IMREAD_REDUCED_COLOR_2 && i != 0 && data[i])  // rotated or resized images are reallocated
+            {
+                EXPECT_EQ(data[i], dst[i].data) << "mode=" << modes[m] << " i=" << i;
+            }
+        }
+    }
+
+    std::vector<Mat> dst(5);
+    EXPECT_TRUE(imdecodeBatch(std::vector<Mat>(1, Mat(bufs[1])), IMREAD_COLOR, dst));
+    ASSERT_EQ(1u, dst.size());
+    EXPECT_EQ(0, cvtest::norm(imdecode(bufs[1], IMREAD_COLOR), dst[0], NORM_INF));
+
+    // the reused output of the image, which header can't be read, is released
+    std::vector<std::vector<uchar> > bufs2(bufs.begin() + 1, bufs.begin() + 4);
+    EXPECT_TRUE(imdecodeBatch(bufs2, IMREAD_COLOR, dst));
+    ASSERT_EQ(3u, dst.size());
+    ASSERT_FALSE(dst[1].empty());
+    bufs2[1].resize(16);
+    EXPECT_FALSE(imdecodeBatch(bufs2, IMREAD_COLOR, dst));
+    ASSERT_EQ(3u, dst.size());
+    EXPECT_FALSE(dst[0].empty());
+    EXPECT_TRUE(dst[1].empty());
+    EXPECT_FALSE(dst[2].empty());
+}
+
+//==================================================================================================
+
+typedef tuple<string, int> Imgcodecs_ImageReaderWriter_t;
+typedef testing::TestWithParam<Imgcodecs_ImageReaderWriter_t> Imgcodecs_ImageReaderWriter;
+
+TEST_P(Imgcodecs_ImageReaderWriter, bands)
+{
+    const string ext = get<0>(GetParam());
+    const int type = get<1>(GetParam());
+    const string fname = cv::tempfile(ext.c_str()), fname_ref = cv::tempfile(ext.c_str());
+
+    Mat image(101, 67, type);
+    randu(image, 0, CV_MAT_DEPTH(type) == CV_16U ? 65536 : 256);
+    ASSERT_TRUE(imwrite(fname_ref, image));
+
+    {
+        Ptr<ImageWriter> writer = ImageWriter::create(fname, image.size(), type);
+        ASSERT_FALSE(writer.empty());
+        EXPECT_EQ(image.size(), writer->size());
+        for (int y = 0; y < image.rows; y += 7)
+        {
+            EXPECT_EQ(y, writer->nextRow());
+            ASSERT_TRUE(writer->write(image.rowRange(y, std::min(y + 7, image.rows))));
+        }
+        EXPECT_THROW(writer->write(image.row(0)), cv::Exception);
+        EXPECT_TRUE(writer->close());
+    }
+
+    const Mat ref = imread(fname_ref, IMREAD_UNCHANGED);
+    ASSERT_FALSE(ref.empty());
+    EXPECT_EQ(0, cvtest::norm(ref, imread(fname, IMREAD_UNCHANGED), NORM_INF));
+
+    Ptr<ImageReader> reader = ImageReader::create(fname, IMREAD_UNCHANGED);
+    ASSERT_FALSE(reader.empty());
+    EXPECT_EQ(image.size(), reader->size());
+    EXPECT_EQ(ref.type(), reader->type());
+    Mat band, result;
+    for (int y = 0; reader->read(band, 13); y += 13)
+    {
+        EXPECT_EQ(std::min(13, image.rows - y), band.rows);
+        result.push_back(band);
+    }
+    EXPECT_EQ(image.rows, reader->nextRow());
+    EXPECT_EQ(0, cvtest::norm(ref, result, NORM_INF));
+
+    // conversions of the decoded image are the same as imread() ones
+    reader = ImageReader::create(fname, IMREAD_GRAYSCALE);
+    ASSERT_FALSE(reader.empty());
+    ASSERT_TRUE(reader->read(band, 1000));
+    EXPECT_EQ(0, cvtest::norm(imread(fname, IMREAD_GRAYSCALE), band, NORM_INF));
+    EXPECT_FALSE(reader->read(band, 1000));
+
+    EXPECT_EQ(0, remove(fname.c_str()));
+    EXPECT_EQ(0, remove(fname_ref.c_str()));
+}
+
+const Imgcodecs_ImageReaderWriter_t reader_writer_params[] = {
+#ifdef HAVE_PNG
+    Imgcodecs_ImageReaderWriter_t(".png", CV_8UC3),
+    Imgcodecs_ImageReaderWriter_t(".png", CV_16UC4),
+#endif
+#ifdef HAVE_JPEG
+    Imgcodecs_ImageReaderWriter_t(".jpg", CV_8UC3),
+    Imgcodecs_ImageReaderWriter_t(".jpg", CV_8UC1),
+#endif
+#ifdef HAVE_TIFF
+    Imgcodecs_ImageReaderWriter_t(".tiff", CV_8UC3),
+    Imgcodecs_ImageReaderWriter_t(".tiff", CV_16UC1),
+#endif
+#ifdef HAVE_IMGCODEC_PXM
+    Imgcodecs_ImageReaderWriter_t(".ppm", CV_8UC3),
+    Imgcodecs_ImageReaderWriter_t(".pgm", CV_16UC1),
+#endif
+    Imgcodecs_ImageReaderWriter_t(".bmp", CV_8UC3),  // decoded and encoded completely
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_ImageReaderWriter, testing::ValuesIn(reader_writer_params));
+
+TEST(Imgcodecs_ImageWriter, incomplete_image)
+{
+    const string fname = cv::tempfile(".png");
+    Ptr<ImageWriter> writer = ImageWriter::create(fname, Size(10, 20), CV_8UC1);
+    ASSERT_TRUE(writer->write(Mat::zeros(10, 10, CV_8UC1)));
+    EXPECT_THROW(writer->write(Mat::zeros(10, 10, CV_8UC3)), cv::Exception);
+    EXPECT_FALSE(writer->close());
+    writer.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+
+    EXPECT_TRUE(ImageReader::create(fname).empty());
+}
+
 }} // namespace
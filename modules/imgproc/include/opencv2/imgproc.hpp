@@ -3357,6 +3357,66 @@ CV_EXPORTS_W void pyrMeanShiftFiltering( InputArray src, OutputArray dst,
                                          double sp, double sr, int maxLevel = 1,
                                          TermCriteria termcrit=TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS,5,1) );
 
+/** @brief Lazy pipeline of image processing functions which is executed by horizontal strips.
+
+A chain of calls like cvtColor -> resize -> GaussianBlur -> convertTo -> subtract makes a full pass over
+memory per function and allocates a full-size intermediate image for each of them. ImagePipeline records
+the operations and apply() executes the whole chain strip by strip: every strip of the output is computed
+from the corresponding rows of the source through small intermediate buffers which fit into L2 cache.
+Strips are processed in parallel. Filters are run by FilterEngine, rows which are shared by the adjacent strips
+(kernel height - 1 rows) are filtered twice.
+
+@code
+    Mat blob;
+    ImagePipeline()
+        .cvtColor(COLOR_BGR2RGB)
+        .resize(Size(224, 224))
+        .GaussianBlur(Size(3, 3), 0)
+        .convertTo(CV_32F, 1./255)
+        .subtract(Scalar(0.485, 0.456, 0.406))
+        .apply(img, blob);
+@endcode
+
+The results match the results of the corresponding functions except resize() which interpolates in floating
+point and GaussianBlur() of 8-bit images which is not bit-exact: they may differ by rounding.
+ */
+class CV_EXPORTS ImagePipeline
+{
+public:
+    ImagePipeline();
+
+    /** @brief Appends cv::cvtColor. Conversions which change size of the image (YUV 4:2:0) and demosaicing are not supported. */
+    ImagePipeline& cvtColor(int code, int dstCn = 0);
+    /** @brief Appends cv::resize. Only INTER_NEAREST and INTER_LINEAR interpolations are supported. */
+    ImagePipeline& resize(Size dsize, double fx = 0, double fy = 0, int interpolation = INTER_LINEAR);
+    /** @brief Appends cv::GaussianBlur. */
+    ImagePipeline& GaussianBlur(Size ksize, double sigmaX, double sigmaY = 0, int borderType = BORDER_DEFAULT);
+    /** @brief Appends Mat::convertTo. */
+    ImagePipeline& convertTo(int rtype, double alpha = 1, double beta = 0);
+    /** @brief Appends per-channel subtraction of the value (cv::subtract), e.g. mean. */
+    ImagePipeline& subtract(const Scalar& value);
+    /** @brief Appends per-channel multiplication by the value (cv::multiply), e.g. 1/std. */
+    ImagePipeline& multiply(const Scalar& value);
+
+    /** @brief Returns true if no operations are recorded. */
+    bool empty() const;
+    /** @brief Removes all the recorded operations. */
+    void clear();
+
+    /** @brief Executes the recorded operations.
+
+    @param src input image.
+    @param dst output image. It may be the same as src.
+    @param stripeHeight number of output rows which are computed at once. By default it is chosen
+    to keep the strip of the source and the intermediate buffers in L2 cache.
+     */
+    void apply(InputArray src, OutputArray dst, int stripeHeight = 0) const;
+
+protected:
+    struct Impl;
+    Ptr<Impl> p;
+};
+
 //! @}
 
 //! @addtogroup imgproc_segmentation
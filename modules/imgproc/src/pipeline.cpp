@@ -0,0 +1,450 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <functional>
+
+namespace cv
+{
+
+// Operation of the pipeline compiled for the input of the given size and type
+class PipelineStage
+{
+public:
+    PipelineStage(Size srcSize_, int srcType_)
+        : srcSize(srcSize_), dstSize(srcSize_), srcType(srcType_), dstType(srcType_) {}
+    virtual ~PipelineStage() {}
+
+    //! rows of the input which are required to compute the given rows of the output
+    virtual Range getSrcRows(const Range& dstRows) const { return dstRows; }
+    //! stages which process a neighborhood of rows keep their state in the filter engine, one per thread
+    virtual Ptr<FilterEngine> createFilterEngine() const { return Ptr<FilterEngine>(); }
+    //! computes rows [dstY, dstY + dst.rows) of the output from rows getSrcRows() of the input starting from srcY
+    virtual void process(const Mat& src, int srcY, Mat& dst, int dstY, FilterEngine* engine) const = 0;
+
+    Size srcSize, dstSize;
+    int srcType, dstType;
+};
+
+typedef std::function<Ptr<PipelineStage>(Size, int)> PipelineOp;
+
+struct ImagePipeline::Impl
+{
+    std::vector<PipelineOp> ops;
+};
+
+namespace {
+
+class CvtColorStage CV_FINAL : public PipelineStage
+{
+public:
+    CvtColorStage(Size srcSize_, int srcType_, int code_, int dcn_)
+        : PipelineStage(srcSize_, srcType_), code(code_), dcn(dcn_)
+    {
+        // demosaicing uses the neighbor rows
+        CV_Check(code, !((code >= COLOR_BayerBG2BGR && code <= COLOR_BayerGR2BGR) ||
+                         (code >= COLOR_BayerBG2BGR_VNG && code <= COLOR_BayerGR2BGR_VNG) ||
+                         (code >= COLOR_BayerBG2GRAY && code <= COLOR_BayerGR2GRAY) ||
+                         (code >= COLOR_BayerBG2BGR_EA && code <= COLOR_BayerGR2BGR_EA) ||
+                         (code >= COLOR_BayerBG2BGRA && code <= COLOR_BayerGR2BGRA)),
+                 "Bayer conversions are not supported by ImagePipeline");
+
+        // output type is found by conversion of a small image
+        Mat probe(6, 4, srcType, Scalar::all(0)), out;
+        cv::cvtColor(probe, out, code, dcn);
+        CV_Check(code, out.size() == probe.size(),
+                 "Color conversions which change size of the image are not supported by ImagePipeline");
+        dstType = out.type();
+    }
+
+    void process(const Mat& src, int, Mat& dst, int, FilterEngine*) const CV_OVERRIDE
+    {
+        cv::cvtColor(src, dst, code, dcn);
+    }
+
+private:
+    int code, dcn;
+};
+
+class ResizeStage CV_FINAL : public PipelineStage
+{
+public:
+    ResizeStage(Size srcSize_, int srcType_, Size dsize, double inv_scale_x, double inv_scale_y, int interpolation_)
+        : PipelineStage(srcSize_, srcType_), interpolation(interpolation_)
+    {
+        CV_Check(interpolation, interpolation == INTER_NEAREST || interpolation == INTER_LINEAR,
+                 "Only INTER_NEAREST and INTER_LINEAR interpolations are supported by ImagePipeline");
+        const int depth = CV_MAT_DEPTH(srcType);
+        CV_Check(depth, depth == CV_8U || depth == CV_16U || depth == CV_16S || depth == CV_32F, "");
+
+        // the same scale factors as cv::resize
+        if (dsize.empty())
+        {
+            CV_Assert(inv_scale_x > 0); CV_Assert(inv_scale_y > 0);
+            dsize = Size(saturate_cast<int>(srcSize.width*inv_scale_x),
+                         saturate_cast<int>(srcSize.height*inv_scale_y));
+            CV_Assert(!dsize.empty());
+        }
+        else
+        {
+            inv_scale_x = (double)dsize.width/srcSize.width;
+            inv_scale_y = (double)dsize.height/srcSize.height;
+        }
+        dstSize = dsize;
+
+        computeTab(srcSize.width, dstSize.width, inv_scale_x, xofs, xalpha);
+        computeTab(srcSize.height, dstSize.height, inv_scale_y, yofs, yalpha);
+    }
+
+    Range getSrcRows(const Range& dstRows) const CV_OVERRIDE
+    {
+        const int last = dstRows.end - 1;
+        const int end = interpolation == INTER_NEAREST ? yofs[last] + 1 : std::min(yofs[last] + 2, srcSize.height);
+        return Range(yofs[dstRows.start], end);
+    }
+
+    void process(const Mat& src, int srcY, Mat& dst, int dstY, FilterEngine*) const CV_OVERRIDE
+    {
+        if (interpolation == INTER_NEAREST)
+        {
+            const size_t esz = src.elemSize();
+            for (int y = 0; y < dst.rows; y++)
+            {
+                const uchar* S = src.ptr(yofs[dstY + y] - srcY);
+                uchar* D = dst.ptr(y);
+                for (int x = 0; x < dst.cols; x++)
+                    memcpy(D + x*esz, S + xofs[x]*esz, esz);
+            }
+            return;
+        }
+
+        switch (src.depth())
+        {
+        case CV_8U: resizeLinear<uchar>(src, srcY, dst, dstY); break;
+        case CV_16U: resizeLinear<ushort>(src, srcY, dst, dstY); break;
+        case CV_16S: resizeLinear<short>(src, srcY, dst, dstY); break;
+        case CV_32F: resizeLinear<float>(src, srcY, dst, dstY); break;
+        default: CV_Error(Error::StsUnsupportedFormat, "");
+        }
+    }
+
+private:
+    void computeTab(int ssize, int dsize, double inv_scale, std::vector<int>& ofs, std::vector<float>& alpha) const
+    {
+        const double scale = 1./inv_scale;
+        ofs.resize(dsize);
+        alpha.resize(dsize);
+        for (int d = 0; d < dsize; d++)
+        {
+            if (interpolation == INTER_NEAREST)
+            {
+                ofs[d] = std::min(cvFloor(d*scale), ssize - 1);
+                alpha[d] = 0.f;
+                continue;
+            }
+            float f = (float)((d + 0.5)*scale - 0.5);
+            int s = cvFloor(f);
+            f -= s;
+            if (s < 0)
+                f = 0, s = 0;
+            if (s >= ssize - 1)
+                f = 0, s = ssize - 1;
+            ofs[d] = s;
+            alpha[d] = f;
+        }
+    }
+
+    template<typename T>
+    void resizeLinear(const Mat& src, int srcY, Mat& dst, int dstY) const
+    {
+        const int cn = src.channels(), swidth = srcSize.width, dwidth = dst.cols*cn;
+        AutoBuffer<float> _buf(dwidth*2);
+        float* rows[2] = { _buf.data(), _buf.data() + dwidth };
+        int rowIdx[2] = { -1, -1 };
+
+        for (int y = 0; y < dst.rows; y++)
+        {
+            const int sy = yofs[dstY + y];
+            const int sy1 = std::min(sy + 1, srcSize.height - 1);
+            // horizontally interpolated rows are reused by the next output rows
+            if (rowIdx[0] != sy && rowIdx[1] == sy)
+            {
+                std::swap(rows[0], rows[1]);
+                std::swap(rowIdx[0], rowIdx[1]);
+            }
+            for (int k = 0; k < 2; k++)
+            {
+                const int idx = k == 0 ? sy : sy1;
+                if (rowIdx[k] == idx)
+                    continue;
+                const T* S = src.ptr<T>(idx - srcY);
+                float* R = rows[k];
+                for (int x = 0; x < dst.cols; x++)
+                {
+                    const int sx = xofs[x]*cn, sx1 = std::min(xofs[x] + 1, swidth - 1)*cn;
+                    const float a = xalpha[x];
+                    for (int c = 0; c < cn; c++)
+                        R[x*cn + c] = S[sx + c]*(1.f - a) + S[sx1 + c]*a;
+                }
+                rowIdx[k] = idx;
+            }
+
+            const float b = yalpha[dstY + y];
+            const float* R0 = rows[0];
+            const float* R1 = rows[1];
+            T* D = dst.ptr<T>(y);
+            for (int x = 0; x < dwidth; x++)
+                D[x] = saturate_cast<T>(R0[x]*(1.f - b) + R1[x]*b);
+        }
+    }
+
+    int interpolation;
+    std::vector<int> xofs, yofs;
+    std::vector<float> xalpha, yalpha;
+};
+
+class GaussianBlurStage CV_FINAL : public PipelineStage
+{
+public:
+    GaussianBlurStage(Size srcSize_, int srcType_, Size ksize_, double sigma1_, double sigma2_, int borderType_)
+        : PipelineStage(srcSize_, srcType_), ksize(ksize_), sigma1(sigma1_), sigma2(sigma2_),
+          borderType(borderType_ & ~BORDER_ISOLATED)
+    {
+        if (borderType != BORDER_CONSTANT)
+        {
+            if (srcSize.height == 1)
+                ksize.height = 1;
+            if (srcSize.width == 1)
+                ksize.width = 1;
+        }
+        Ptr<FilterEngine> engine = createFilterEngine();
+        kheight = engine->ksize.height;
+        anchorY = engine->anchor.y;
+    }
+
+    Range getSrcRows(const Range& dstRows) const CV_OVERRIDE
+    {
+        return Range(std::max(dstRows.start - anchorY, 0),
+                     std::min(dstRows.end + kheight - anchorY - 1, srcSize.height));
+    }
+
+    Ptr<FilterEngine> createFilterEngine() const CV_OVERRIDE
+    {
+        return createGaussianFilter(srcType, ksize, sigma1, sigma2, borderType);
+    }
+
+    void process(const Mat& src, int srcY, Mat& dst, int dstY, FilterEngine* engine) const CV_OVERRIDE
+    {
+        CV_Assert(engine);
+        // the engine extrapolates rows outside of the image only, the rest are taken from src
+        int y = engine->start(srcSize, dst.size(), Point(0, dstY));
+        CV_Assert(y == srcY);
+        int count = engine->proceed(src.ptr(), (int)src.step, src.rows, dst.ptr(), (int)dst.step);
+        CV_Assert(count == dst.rows);
+    }
+
+private:
+    Size ksize;
+    double sigma1, sigma2;
+    int borderType;
+    int kheight, anchorY;
+};
+
+class ConvertStage CV_FINAL : public PipelineStage
+{
+public:
+    ConvertStage(Size srcSize_, int srcType_, int rtype, double alpha_, double beta_)
+        : PipelineStage(srcSize_, srcType_), alpha(alpha_), beta(beta_)
+    {
+        dstType = CV_MAKETYPE(rtype < 0 ? CV_MAT_DEPTH(srcType) : CV_MAT_DEPTH(rtype), CV_MAT_CN(srcType));
+    }
+
+    void process(const Mat& src, int, Mat& dst, int, FilterEngine*) const CV_OVERRIDE
+    {
+        src.convertTo(dst, dstType, alpha, beta);
+    }
+
+private:
+    double alpha, beta;
+};
+
+class ScalarStage CV_FINAL : public PipelineStage
+{
+public:
+    ScalarStage(Size srcSize_, int srcType_, bool multiply_, const Scalar& value_)
+        : PipelineStage(srcSize_, srcType_), multiply(multiply_), value(value_) {}
+
+    void process(const Mat& src, int, Mat& dst, int, FilterEngine*) const CV_OVERRIDE
+    {
+        if (multiply)
+            cv::multiply(src, value, dst);
+        else
+            cv::subtract(src, value, dst);
+    }
+
+private:
+    bool multiply;
+    Scalar value;
+};
+
+// L2 cache budget for the source strip and intermediate buffers of a strip
+static const size_t PIPELINE_STRIPE_BYTES = 256 << 10;
+
+class PipelineInvoker : public ParallelLoopBody
+{
+public:
+    PipelineInvoker(const std::vector<Ptr<PipelineStage> >& stages_, const Mat& src_, Mat& dst_, int stripeHeight_)
+        : stages(stages_), src(src_), dst(dst_), stripeHeight(stripeHeight_) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const size_t n = stages.size();
+        std::vector<Ptr<FilterEngine> > engines(n);
+        for (size_t i = 0; i < n; i++)
+            engines[i] = stages[i]->createFilterEngine();
+        std::vector<Mat> buffers(n - 1);
+        // rows[i] - input rows of i-th stage, rows[n] - rows of the output strip
+        std::vector<Range> rows(n + 1);
+
+        for (int s = range.start; s < range.end; s++)
+        {
+            rows[n] = Range(s*stripeHeight, std::min((s + 1)*stripeHeight, dst.rows));
+            for (size_t i = n; i > 0; i--)
+                rows[i - 1] = stages[i - 1]->getSrcRows(rows[i]);
+
+            Mat in = src.rowRange(rows[0]);
+            for (size_t i = 0; i < n; i++)
+            {
+                Mat out;
+                if (i == n - 1)
+                    out = dst.rowRange(rows[n]);
+                else
+                {
+                    const int count = rows[i + 1].size();
+                    if (buffers[i].rows < count)
+                        buffers[i].create(count, stages[i]->dstSize.width, stages[i]->dstType);
+                    out = buffers[i].rowRange(0, count);
+                }
+                const uchar* data = out.data;
+                stages[i]->process(in, rows[i].start, out, rows[i + 1].start, engines[i].get());
+                CV_DbgAssert(out.data == data);
+                CV_UNUSED(data);
+                in = out;
+            }
+        }
+    }
+
+private:
+    const std::vector<Ptr<PipelineStage> >& stages;
+    const Mat& src;
+    Mat& dst;
+    int stripeHeight;
+};
+
+}  // namespace
+
+ImagePipeline::ImagePipeline() : p(makePtr<Impl>()) {}
+
+ImagePipeline& ImagePipeline::cvtColor(int code, int dstCn)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<CvtColorStage>(size, type, code, dstCn);
+    });
+    return *this;
+}
+
+ImagePipeline& ImagePipeline::resize(Size dsize, double fx, double fy, int interpolation)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<ResizeStage>(size, type, dsize, fx, fy, interpolation);
+    });
+    return *this;
+}
+
+ImagePipeline& ImagePipeline::GaussianBlur(Size ksize, double sigmaX, double sigmaY, int borderType)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<GaussianBlurStage>(size, type, ksize, sigmaX, sigmaY, borderType);
+    });
+    return *this;
+}
+
+ImagePipeline& ImagePipeline::convertTo(int rtype, double alpha, double beta)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<ConvertStage>(size, type, rtype, alpha, beta);
+    });
+    return *this;
+}
+
+ImagePipeline& ImagePipeline::subtract(const Scalar& value)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<ScalarStage>(size, type, false, value);
+    });
+    return *this;
+}
+
+ImagePipeline& ImagePipeline::multiply(const Scalar& value)
+{
+    p->ops.push_back([=](Size size, int type) -> Ptr<PipelineStage> {
+        return makePtr<ScalarStage>(size, type, true, value);
+    });
+    return *this;
+}
+
+bool ImagePipeline::empty() const
+{
+    return p->ops.empty();
+}
+
+void ImagePipeline::clear()
+{
+    p->ops.clear();
+}
+
+void ImagePipeline::apply(InputArray _src, OutputArray _dst, int stripeHeight) const
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert(!src.empty() && src.dims <= 2);
+    if (p->ops.empty())
+    {
+        src.copyTo(_dst);
+        return;
+    }
+
+    std::vector<Ptr<PipelineStage> > stages;
+    Size size = src.size();
+    int type = src.type();
+    for (size_t i = 0; i < p->ops.size(); i++)
+    {
+        stages.push_back(p->ops[i](size, type));
+        size = stages.back()->dstSize;
+        type = stages.back()->dstType;
+    }
+
+    _dst.create(size, type);
+    Mat dst = _dst.getMat();
+    // the source rows are read by the next strips after the output ones are written
+    if (src.datastart < dst.dataend && dst.datastart < src.dataend)
+        src = src.clone();
+
+    if (stripeHeight <= 0)
+    {
+        // bytes of the source and the intermediate buffers per row of the output
+        double rowBytes = (double)src.cols*src.elemSize()*src.rows/dst.rows;
+        for (size_t i = 0; i + 1 < stages.size(); i++)
+            rowBytes += (double)stages[i]->dstSize.width*CV_ELEM_SIZE(stages[i]->dstType)*stages[i]->dstSize.height/dst.rows;
+        stripeHeight = std::max(cvFloor(PIPELINE_STRIPE_BYTES/rowBytes), 8);
+    }
+    stripeHeight = std::min(stripeHeight, dst.rows);
+
+    const int nstripes = (dst.rows + stripeHeight - 1)/stripeHeight;
+    parallel_for_(Range(0, nstripes), PipelineInvoker(stages, src, dst, stripeHeight));
+}
+
+}  // namespace cv
@@ -0,0 +1,105 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+typedef testing::TestWithParam<int> Imgproc_ImagePipeline_Stripes;
+
+TEST_P(Imgproc_ImagePipeline_Stripes, preprocessing_accuracy)
+{
+    const int stripeHeight = GetParam();
+    Mat src(479, 641, CV_8UC3);
+    randu(src, 0, 256);
+    const Scalar mean(0.485, 0.456, 0.406), scale(1/0.229, 1/0.224, 1/0.225);
+
+    Mat ref;
+    cvtColor(src, ref, COLOR_BGR2RGB);
+    resize(ref, ref, Size(224, 224));
+    ref.convertTo(ref, CV_32F, 1./255);
+    GaussianBlur(ref, ref, Size(5, 5), 0);
+    cv::subtract(ref, mean, ref);
+    cv::multiply(ref, scale, ref);
+
+    Mat dst;
+    ImagePipeline()
+        .cvtColor(COLOR_BGR2RGB)
+        .resize(Size(224, 224))
+        .convertTo(CV_32F, 1./255)
+        .GaussianBlur(Size(5, 5), 0)
+        .subtract(mean)
+        .multiply(scale)
+        .apply(src, dst, stripeHeight);
+
+    ASSERT_EQ(CV_32FC3, dst.type());
+    ASSERT_EQ(Size(224, 224), dst.size());
+    // resize of 8-bit image is computed in floating point
+    EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1./255*scale[0] + 1e-4);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_ImagePipeline_Stripes, testing::Values(0, 1, 7, 64, 1000));
+
+TEST(Imgproc_ImagePipeline, filter_is_exact)
+{
+    Mat src(300, 200, CV_32FC1);
+    randu(src, -1, 1);
+    for (int borderType = BORDER_CONSTANT; borderType <= BORDER_REFLECT_101; borderType++)
+    {
+        if (borderType == BORDER_WRAP)
+            continue;
+        Mat ref, dst;
+        GaussianBlur(src, ref, Size(7, 9), 2, 3, borderType);
+        ImagePipeline().GaussianBlur(Size(7, 9), 2, 3, borderType).apply(src, dst, 5);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1e-5) << "borderType=" << borderType;
+    }
+}
+
+TEST(Imgproc_ImagePipeline, resize)
+{
+    Mat src(97, 131, CV_32FC3);
+    randu(src, 0, 1);
+    const Size sizes[] = { Size(40, 50), Size(300, 200), Size(131, 30) };
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+        for (int interpolation = INTER_NEAREST; interpolation <= INTER_LINEAR; interpolation++)
+        {
+            Mat ref, dst;
+            resize(src, ref, sizes[i], 0, 0, interpolation);
+            ImagePipeline().resize(sizes[i], 0, 0, interpolation).apply(src, dst, 3);
+            EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1e-5) << sizes[i] << " interpolation=" << interpolation;
+        }
+    }
+
+    Mat ref, dst;
+    resize(src, ref, Size(), 0.5, 0.25, INTER_NEAREST);
+    ImagePipeline().resize(Size(), 0.5, 0.25, INTER_NEAREST).apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+}
+
+TEST(Imgproc_ImagePipeline, inplace)
+{
+    Mat src(100, 100, CV_8UC3);
+    randu(src, 0, 256);
+    Mat ref;
+    cvtColor(src, ref, COLOR_BGR2YCrCb);
+    cv::subtract(ref, Scalar(16, 128, 128), ref);
+
+    ImagePipeline pipeline;
+    EXPECT_TRUE(pipeline.empty());
+    pipeline.cvtColor(COLOR_BGR2YCrCb).subtract(Scalar(16, 128, 128));
+    EXPECT_FALSE(pipeline.empty());
+    pipeline.apply(src, src, 10);
+    EXPECT_EQ(0, cvtest::norm(ref, src, NORM_INF));
+}
+
+TEST(Imgproc_ImagePipeline, unsupported)
+{
+    Mat src(60, 40, CV_8UC1), dst;
+    EXPECT_THROW(ImagePipeline().cvtColor(COLOR_BayerBG2BGR).apply(src, dst), cv::Exception);
+    EXPECT_THROW(ImagePipeline().cvtColor(COLOR_YUV2BGR_NV12).apply(src, dst), cv::Exception);
+    EXPECT_THROW(ImagePipeline().resize(Size(20, 20), 0, 0, INTER_CUBIC).apply(src, dst), cv::Exception);
+}
+
+}} // namespace
@@ -186,6 +186,11 @@ enum VideoCaptureProperties {
        CAP_PROP_HW_ACCELERATION=50, //!< (**open-only**) Hardware acceleration type (see #VideoAccelerationType). Setting supported only via `params` parameter in cv::VideoCapture constructor / .open() method. Default value is backend-specific.
        CAP_PROP_HW_DEVICE      =51, //!< (**open-only**) Hardware device index (select GPU if multiple available). Device enumeration is acceleration type specific.
        CAP_PROP_HW_ACCELERATION_USE_OPENCL=52, //!< (**open-only**) If non-zero, create new OpenCL context and bind it to current thread. The OpenCL context created with Video Acceleration context attached it (if not attached yet) for optimized GPU data copy between HW accelerated decoder and cv::UMat.
+       CAP_PROP_PREFETCH_FRAMES=53, //!< (**open-only**) Number of frames decoded in advance by the background thread. 0 (default) disables prefetching. Only the default channel of retrieve() is available if enabled. Not supported by waitAny().
+       CAP_PROP_PREFETCH_DROP_OLDEST=54, //!< (**open-only**) If non-zero, the oldest prefetched frame is dropped if the consumer is too slow instead of pausing decoding (suitable for live streams). Requires #CAP_PROP_PREFETCH_FRAMES
+       CAP_PROP_PREFETCH_DROPPED=55, //!< (read-only) Number of the prefetched frames dropped due to #CAP_PROP_PREFETCH_DROP_OLDEST
+       CAP_PROP_N_THREADS=56, //!< (**open-only**) Number of decoding threads, 0 - the number of CPU cores (default). The total number of decoding threads of all captures may be limited by the OPENCV_FFMPEG_CAPTURE_THREADS_LIMIT environment variable (applicable for FFmpeg back-end only)
+       CAP_PROP_THREAD_TYPE=57, //!< (**open-only**) Decoding threading mode: 1 - frame threading, 2 - slice threading, 3 - both, the decoder selects (default). Frame threading adds the delay of one frame per thread. Reading returns the mode used by the decoder (applicable for FFmpeg back-end only)
 #ifndef CV_DOXYGEN
        CV__CAP_PROP_LATEST
 #endif
@@ -204,6 +209,9 @@ enum VideoWriterProperties {
   VIDEOWRITER_PROP_HW_ACCELERATION = 6, //!< (**open-only**) Hardware acceleration type (see #VideoAccelerationType). Setting supported only via `params` parameter in VideoWriter constructor / .open() method. Default value is backend-specific.
   VIDEOWRITER_PROP_HW_DEVICE       = 7, //!< (**open-only**) Hardware device index (select GPU if multiple available). Device enumeration is acceleration type specific.
   VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL= 8, //!< (**open-only**) If non-zero, create new OpenCL context and bind it to current thread. The OpenCL context created with Video Acceleration context attached it (if not attached yet) for optimized GPU data copy between cv::UMat and HW accelerated encoder.
+  VIDEOWRITER_PROP_N_THREADS = 9,     //!< (**open-only**) Number of encoding threads, 0 - selected by the encoder (applicable for FFmpeg back-end only). Default value is backend-specific.
+  VIDEOWRITER_PROP_ASYNC_FRAMES = 10, //!< (**open-only**) If positive, VideoWriter::write() copies the frame into the queue of this size and returns, frames are encoded by the background thread. write() waits if the queue is full. 0 (default) disables asynchronous writing. See VideoWriter::flush()
+  VIDEOWRITER_PROP_ASYNC_QUEUED = 11, //!< (read-only) Number of frames passed to VideoWriter::write() and not encoded yet (see #VIDEOWRITER_PROP_ASYNC_FRAMES)
 #ifndef CV_DOXYGEN
   CV__VIDEOWRITER_PROP_LATEST
 #endif
@@ -927,6 +935,106 @@ protected:
     friend class internal::VideoCapturePrivateAccessor;
 };
 
+/** @brief Reads frames from several video sources concurrently.
+
+The class owns a set of VideoCapture streams (video files, network streams, image sequences, cameras)
+and returns their frames in batches. Frames of different streams are decoded in parallel using the
+OpenCV thread pool (see cv::setNumThreads).
+
+Two reading modes are supported and can't be mixed:
+ - synchronized: read() and readBlob() return one frame from each stream which is not finished;
+ - ready-first: readReady() decodes streams in the background by a pool of cv::getNumThreads() workers and
+   returns frames of the streams which are ready.
+
+@code
+    MultiVideoCapture streams;
+    for (size_t i = 0; i < urls.size(); i++)
+        streams.add(urls[i]);
+    Mat blob;
+    std::vector<int> streamIds;
+    while (streams.readBlob(blob, streamIds, Size(300, 300), 1.0 / 127.5, Scalar::all(127.5), true))
+    {
+        net.setInput(blob);
+        Mat detections = net.forward();  // i-th sample is the frame of streams[streamIds[i]]
+    }
+@endcode
+*/
+class CV_EXPORTS_W MultiVideoCapture
+{
+public:
+    CV_WRAP MultiVideoCapture();
+    virtual ~MultiVideoCapture();
+
+    /** @brief Opens a video file, a capturing device or an IP video stream and adds it to the set.
+
+    @param filename see VideoCapture::open
+    @param apiPreference see VideoCapture::open
+    @param params see VideoCapture::open
+    @return the stream index or -1 if the stream can't be opened
+    */
+    CV_WRAP int add(const String& filename, int apiPreference = CAP_ANY, const std::vector<int>& params = std::vector<int>());
+
+    /** @overload
+    @param index camera index, see VideoCapture::open
+    @param apiPreference see VideoCapture::open
+    @param params see VideoCapture::open
+    */
+    CV_WRAP int add(int index, int apiPreference = CAP_ANY, const std::vector<int>& params = std::vector<int>());
+
+    /** @brief Returns the number of the added streams */
+    CV_WRAP int getNumStreams() const;
+
+    /** @brief Returns true if the stream has no more frames (or it has failed) */
+    CV_WRAP bool isFinished(int streamIdx) const;
+
+    /** @brief Returns the property of the stream, see VideoCapture::get */
+    CV_WRAP double get(int streamIdx, int propId) const;
+
+    /** @brief Reads the next frame from each stream which is not finished.
+
+    @param frames output frames
+    @param streamIds indexes of the streams of the output frames
+    @return false if all streams are finished
+    */
+    CV_WRAP bool read(OutputArrayOfArrays frames, CV_OUT std::vector<int>& streamIds);
+
+    /** @brief Reads the next frame from each stream which is not finished into the 4D blob.
+
+    The frames are resized to the blob spatial size, converted to 32-bit floating point,
+    the mean is subtracted and the result is multiplied by the scale factor (see dnn::blobFromImages).
+    The conversion is performed in parallel with the output written to the blob directly.
+
+    @param blob output NCHW blob of CV_32F type, N is the number of the read frames
+    @param streamIds indexes of the streams of the samples
+    @param size spatial size of the blob. Empty size keeps the size of the frames which must be the same then.
+    @param scalefactor multiplier for the frame values
+    @param mean scalar subtracted from the frame channels
+    @param swapRB swap the first and the last channels
+    @return false if all streams are finished
+    */
+    CV_WRAP bool readBlob(OutputArray blob, CV_OUT std::vector<int>& streamIds, const Size& size = Size(),
+                          double scalefactor = 1.0, const Scalar& mean = Scalar(), bool swapRB = false);
+
+    /** @brief Returns frames of the streams decoded by the background workers since the previous call.
+
+    The first call starts decoding of all the streams in the background, one frame per stream is
+    decoded in advance. The method waits until the frame of at least one stream is ready.
+
+    @param frames output frames
+    @param streamIds indexes of the streams of the output frames
+    @param timeoutMs maximum waiting time in milliseconds, negative value means infinite waiting
+    @return false if there are no ready frames (all streams are finished or the timeout is expired)
+    */
+    CV_WRAP bool readReady(OutputArrayOfArrays frames, CV_OUT std::vector<int>& streamIds, int timeoutMs = -1);
+
+    /** @brief Stops the background decoding and closes all streams */
+    CV_WRAP void release();
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 class IVideoWriter;
 
 /** @example samples/cpp/tutorial_code/videoio/video-write/video-write.cpp
@@ -1058,6 +1166,13 @@ public:
      */
     CV_WRAP virtual void write(InputArray image);
 
+    /** @brief Waits until all frames passed to write() are encoded.
+
+    The method makes sense in the asynchronous mode only (see #VIDEOWRITER_PROP_ASYNC_FRAMES).
+    Errors of the background encoding are reported by the next write() or flush() call.
+     */
+    CV_WRAP void flush();
+
     /** @brief Sets a property in the VideoWriter.
 
      @param propId Property identifier from cv::VideoWriterProperties (eg. cv::VIDEOWRITER_PROP_QUALITY)
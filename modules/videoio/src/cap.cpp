@@ -65,6 +65,38 @@ static bool param_VIDEOWRITER_DEBUG = utils::getConfigurationParameterBool("OPEN
 void DefaultDeleter<CvCapture>::operator ()(CvCapture* obj) const { cvReleaseCapture(&obj); }
 void DefaultDeleter<CvVideoWriter>::operator ()(CvVideoWriter* obj) const { cvReleaseVideoWriter(&obj); }
 
+// Removes the parameter which is handled on top of backends, so it is not passed to them.
+// The value is left unchanged if the parameter is not specified.
+static std::vector<int> extractParameter(const std::vector<int>& params, int key, int& value)
+{
+    if (params.size() % 2 != 0)
+        return params;  // reported by VideoParameters
+    std::vector<int> result;
+    result.reserve(params.size());
+    for (size_t i = 0; i < params.size(); i += 2)
+    {
+        if (params[i] == key)
+            value = params[i + 1];
+        else
+        {
+            result.push_back(params[i]);
+            result.push_back(params[i + 1]);
+        }
+    }
+    return result;
+}
+
+static std::vector<int> extractPrefetchParameters(const std::vector<int>& params, int& numFrames, bool& dropOldest)
+{
+    numFrames = 0;
+    int dropOldestValue = 0;
+    std::vector<int> result = extractParameter(params, CAP_PROP_PREFETCH_FRAMES, numFrames);
+    result = extractParameter(result, CAP_PROP_PREFETCH_DROP_OLDEST, dropOldestValue);
+    CV_CheckGE(numFrames, 0, "CAP_PROP_PREFETCH_FRAMES must be non-negative");
+    dropOldest = dropOldestValue != 0;
+    return result;
+}
+
 
 VideoCapture::VideoCapture() : throwOnFail(false)
 {}
@@ -115,7 +147,9 @@ bool VideoCapture::open(const String& filename, int apiPreference, const std::ve
         release();
     }
 
-    const VideoCaptureParameters parameters(params);
+    int prefetchFrames = 0;
+    bool prefetchDropOldest = false;
+    const VideoCaptureParameters parameters(extractPrefetchParameters(params, prefetchFrames, prefetchDropOldest));
     const std::vector<VideoBackendInfo> backends = cv::videoio_registry::getAvailableBackends_CaptureByFilename();
     for (size_t i = 0; i < backends.size(); i++)
     {
@@ -140,6 +174,8 @@ bool VideoCapture::open(const String& filename, int apiPreference, const std::ve
                                                         info.name, icap->isOpened()));
                         if (icap->isOpened())
                         {
+                            if (prefetchFrames > 0)
+                                icap = createPrefetchCapture(icap, prefetchFrames, prefetchDropOldest);
                             return true;
                         }
                         icap.release();
@@ -225,7 +261,9 @@ bool VideoCapture::open(int cameraNum, int apiPreference, const std::vector<int>
         }
     }
 
-    const VideoCaptureParameters parameters(params);
+    int prefetchFrames = 0;
+    bool prefetchDropOldest = false;
+    const VideoCaptureParameters parameters(extractPrefetchParameters(params, prefetchFrames, prefetchDropOldest));
     const std::vector<VideoBackendInfo> backends = cv::videoio_registry::getAvailableBackends_CaptureByIndex();
     for (size_t i = 0; i < backends.size(); i++)
     {
@@ -250,6 +288,8 @@ bool VideoCapture::open(int cameraNum, int apiPreference, const std::vector<int>
                                                         info.name, icap->isOpened()));
                         if (icap->isOpened())
                         {
+                            if (prefetchFrames > 0)
+                                icap = createPrefetchCapture(icap, prefetchFrames, prefetchDropOldest);
                             return true;
                         }
                         icap.release();
@@ -450,6 +490,10 @@ bool VideoCapture::waitAny(const std::vector<VideoCapture>& streams,
         VideoCaptureAPIs backend_i = (VideoCaptureAPIs)streams[i].icap->getCaptureDomain();
         CV_CheckEQ((int)backend, (int)backend_i, "All captures must have the same backend");
     }
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        CV_Assert(!isPrefetchCapture(streams[i].icap) && "Prefetching captures are not supported");
+    }
 
 #if (defined HAVE_CAMV4L2 || defined HAVE_VIDEOIO) // see cap_v4l.cpp guard
     if (backend == CAP_V4L2)
@@ -537,7 +581,9 @@ bool VideoWriter::open(const String& filename, int apiPreference, int fourcc, do
         release();
     }
 
-    const VideoWriterParameters parameters(params);
+    int asyncFrames = 0;
+    const VideoWriterParameters parameters(extractParameter(params, VIDEOWRITER_PROP_ASYNC_FRAMES, asyncFrames));
+    CV_CheckGE(asyncFrames, 0, "VIDEOWRITER_PROP_ASYNC_FRAMES must be non-negative");
     for (const auto& info : videoio_registry::getAvailableBackends_Writer())
     {
         if (apiPreference == CAP_ANY || apiPreference == info.id)
@@ -572,6 +618,8 @@ bool VideoWriter::open(const String& filename, int apiPreference, int fourcc, do
                         }
                         if (iwriter->isOpened())
                         {
+                            if (asyncFrames > 0)
+                                iwriter = createAsyncWriter(iwriter, asyncFrames);
                             return true;
                         }
                         iwriter.release();
@@ -669,6 +717,16 @@ void VideoWriter::write(InputArray image)
     }
 }
 
+void VideoWriter::flush()
+{
+    CV_INSTRUMENT_REGION();
+
+    if (iwriter)
+    {
+        iwriter->flush();
+    }
+}
+
 VideoWriter& VideoWriter::operator << (const Mat& image)
 {
     CV_INSTRUMENT_REGION();
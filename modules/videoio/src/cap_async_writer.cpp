@@ -0,0 +1,169 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cv {
+
+// Encodes frames by the wrapped writer in the background thread. The frames are copied into
+// the bounded queue, the buffers of the encoded frames are reused.
+class AsyncWriter CV_FINAL : public IVideoWriter
+{
+public:
+    AsyncWriter(const Ptr<IVideoWriter>& writer_, int numFrames_)
+        : writer(writer_), numFrames(numFrames_), stop(false), busy(false), failed(false)
+    {
+        CV_Assert(writer && writer->isOpened());
+        CV_CheckGT(numFrames, 0, "");
+        worker = std::thread(&AsyncWriter::run, this);
+    }
+
+    ~AsyncWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_all();
+        worker.join();  // the queued frames are encoded before
+    }
+
+    double getProperty(int propId) const CV_OVERRIDE
+    {
+        if (propId == VIDEOWRITER_PROP_ASYNC_FRAMES)
+            return numFrames;
+        if (propId == VIDEOWRITER_PROP_ASYNC_QUEUED)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return (double)(queue.size() + (busy ? 1 : 0));
+        }
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        return writer->getProperty(propId);
+    }
+
+    bool setProperty(int propId, double value) CV_OVERRIDE
+    {
+        // the property is applied to the frames passed to write() after this call
+        flush();
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        return writer->setProperty(propId, value);
+    }
+
+    bool isOpened() const CV_OVERRIDE
+    {
+        return true;
+    }
+
+    void write(InputArray image) CV_OVERRIDE
+    {
+        Mat buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]{ return failed || (int)(queue.size() + (busy ? 1 : 0)) < numFrames; });
+            checkError();
+            if (!pool.empty())
+            {
+                buffer = pool.back();
+                pool.pop_back();
+            }
+        }
+        image.copyTo(buffer);  // the caller may reuse the frame after the call
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(buffer);
+        }
+        cond.notify_all();
+    }
+
+    void flush() CV_OVERRIDE
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]{ return failed || (queue.empty() && !busy); });
+        checkError();
+    }
+
+    int getCaptureDomain() const CV_OVERRIDE
+    {
+        return writer->getCaptureDomain();
+    }
+
+private:
+    // Errors of the background thread are reported to the caller. Must be called under the lock.
+    void checkError() const
+    {
+        if (failed)
+            throw error;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait(lock, [&]{ return stop || !queue.empty(); });
+            if (queue.empty())
+                break;  // stopped and all the frames are encoded
+
+            Mat frame = queue.front();
+            queue.pop_front();
+            busy = true;
+            lock.unlock();
+
+            cv::Exception e;
+            bool ok = true;
+            try
+            {
+                std::lock_guard<std::mutex> writerLock(writerMutex);
+                writer->write(frame);
+            }
+            catch (const cv::Exception& ex)
+            {
+                e = ex;
+                ok = false;
+            }
+            catch (const std::exception& ex)
+            {
+                e = cv::Exception(Error::StsError, ex.what(), CV_Func, __FILE__, __LINE__);
+                ok = false;
+            }
+
+            lock.lock();
+            busy = false;
+            if (!ok)
+            {
+                CV_LOG_ERROR(NULL, "VIDEOIO: asynchronous writing has failed: " << e.what());
+                if (!failed)
+                    error = e;
+                failed = true;
+                queue.clear();  // the following frames are dropped
+            }
+            pool.push_back(frame);
+            cond.notify_all();
+        }
+    }
+
+    Ptr<IVideoWriter> writer;
+    const int numFrames;
+
+    mutable std::mutex writerMutex;  // the wrapped writer is accessed by both threads
+    mutable std::mutex mutex;        // the queue and the state
+    std::condition_variable cond;
+    std::deque<Mat> queue;
+    std::vector<Mat> pool;
+    bool stop, busy, failed;
+    cv::Exception error;
+    std::thread worker;
+};
+
+Ptr<IVideoWriter> createAsyncWriter(const Ptr<IVideoWriter>& writer, int numFrames)
+{
+    return makePtr<AsyncWriter>(writer, numFrames);
+}
+
+}  // namespace cv
@@ -49,7 +49,10 @@ using namespace cv;
 #endif
 #include <assert.h>
 #include <algorithm>
+#include <fstream>
 #include <limits>
+#include <string>
+#include <vector>
 
 #ifndef __OPENCV_BUILD
 #define CV_FOURCC(c1, c2, c3, c4) (((c1) & 255) + (((c2) & 255) << 8) + (((c3) & 255) << 16) + (((c4) & 255) << 24))
@@ -467,6 +470,19 @@ static AVRational _opencv_ffmpeg_get_sample_aspect_ratio(AVStream *stream)
 }
 
 
+// Decoding threads of all captures are limited by OPENCV_FFMPEG_CAPTURE_THREADS_LIMIT (not limited by default).
+// A capture gets at least one thread, so the limit may be exceeded by the number of the opened captures.
+class DecodingThreadsLimit
+{
+public:
+    static int acquire(int requested);
+    static void release(int threads);
+private:
+    static int& getUsed();
+    static int getLimit();
+};
+
+
 struct CvCapture_FFMPEG
 {
     bool open(const char* filename, const VideoCaptureParameters& params);
@@ -484,6 +500,11 @@ struct CvCapture_FFMPEG
     void    seek(int64_t frame_number);
     void    seek(double sec);
     bool    slowSeek( int framenumber );
+    bool    seekKeyframe(int64_t frame_number);
+    void    buildKeyframeIndex();
+    bool    scanKeyframes(const std::vector<int64_t>& index_ts);
+    bool    loadKeyframeIndex(const std::string& path);
+    void    saveKeyframeIndex(const std::string& path) const;
 
     int64_t get_total_frames() const;
     double  get_duration_sec() const;
@@ -521,6 +542,10 @@ struct CvCapture_FFMPEG
 */
     char              * filename;
 
+    std::string source_name;
+    std::vector<int64_t> keyframes;  // PTS of key frames of the video stream, built on the first seek
+    bool keyframes_indexed;
+
     AVDictionary *dict;
 #if USE_AV_INTERRUPT_CALLBACK
     AVInterruptCallbackMetadata interrupt_metadata;
@@ -539,6 +564,9 @@ struct CvCapture_FFMPEG
     VideoAccelerationType va_type;
     int hw_device;
     int use_opencl;
+    int requested_threads;
+    int thread_type;
+    int n_threads;  // acquired from DecodingThreadsLimit
 };
 
 void CvCapture_FFMPEG::init()
@@ -552,6 +580,9 @@ void CvCapture_FFMPEG::init()
     memset( &rgb_picture, 0, sizeof(rgb_picture) );
     memset( &frame, 0, sizeof(frame) );
     filename = 0;
+    source_name.clear();
+    keyframes.clear();
+    keyframes_indexed = false;
     memset(&packet, 0, sizeof(packet));
     av_init_packet(&packet);
     img_convert_ctx = 0;
@@ -577,6 +608,9 @@ void CvCapture_FFMPEG::init()
     va_type = cv::VIDEO_ACCELERATION_NONE;  // TODO OpenCV 5.0: change to _ANY?
     hw_device = -1;
     use_opencl = 0;
+    requested_threads = 0;
+    thread_type = 0;
+    n_threads = 0;
 }
 
 
@@ -588,6 +622,9 @@ void CvCapture_FFMPEG::close()
         img_convert_ctx = 0;
     }
 
+    if( n_threads > 0 )
+        DecodingThreadsLimit::release(n_threads);
+
     if( picture )
     {
 #if LIBAVCODEC_BUILD >= (LIBAVCODEC_VERSION_MICRO >= 100 \
@@ -785,6 +822,46 @@ private:
 #endif
 
 static ImplMutex _mutex;
+static ImplMutex _threads_mutex;
+
+int DecodingThreadsLimit::acquire(int requested)
+{
+    AutoLock lock(_threads_mutex);
+    int& used = getUsed();
+    const int limit = getLimit();
+    int granted = requested;
+    if (limit > 0)
+        granted = std::max(1, std::min(requested, limit - used));
+    used += granted;
+    return granted;
+}
+
+void DecodingThreadsLimit::release(int threads)
+{
+    AutoLock lock(_threads_mutex);
+    getUsed() -= threads;
+}
+
+int& DecodingThreadsLimit::getUsed()
+{
+    static int used = 0;
+    return used;
+}
+
+int DecodingThreadsLimit::getLimit()
+{
+#ifndef NO_GETENV
+    static int limit = -1;
+    if (limit < 0)
+    {
+        const char* limit_option = getenv("OPENCV_FFMPEG_CAPTURE_THREADS_LIMIT");
+        limit = limit_option ? std::max(0, atoi(limit_option)) : 0;
+    }
+    return limit;
+#else
+    return 0;
+#endif
+}
 
 static int LockCallBack(void **mutex, AVLockOp op)
 {
@@ -928,6 +1005,24 @@ bool CvCapture_FFMPEG::open(const char* _filename, const VideoCaptureParameters&
         if (params.has(CAP_PROP_HW_ACCELERATION_USE_OPENCL)) {
             use_opencl = params.get<int>(CAP_PROP_HW_ACCELERATION_USE_OPENCL);
         }
+        if (params.has(CAP_PROP_N_THREADS))
+        {
+            requested_threads = params.get<int>(CAP_PROP_N_THREADS);
+            if (requested_threads < 0)
+            {
+                CV_LOG_ERROR(NULL, "VIDEOIO/FFMPEG: CAP_PROP_N_THREADS parameter value is invalid: " << requested_threads);
+                return false;
+            }
+        }
+        if (params.has(CAP_PROP_THREAD_TYPE))
+        {
+            thread_type = params.get<int>(CAP_PROP_THREAD_TYPE);
+            if (thread_type < 0 || thread_type > (FF_THREAD_FRAME | FF_THREAD_SLICE))
+            {
+                CV_LOG_ERROR(NULL, "VIDEOIO/FFMPEG: CAP_PROP_THREAD_TYPE parameter value is invalid: " << thread_type);
+                return false;
+            }
+        }
         if (params.warnUnusedParameters())
         {
             CV_LOG_ERROR(NULL, "VIDEOIO/FFMPEG: unsupported parameters in .open(), see logger INFO channel for details. Bailout");
@@ -977,21 +1072,25 @@ bool CvCapture_FFMPEG::open(const char* _filename, const VideoCaptureParameters&
         CV_WARN(_filename);
         goto exit_func;
     }
+    source_name = _filename ? _filename : "";
     err = avformat_find_stream_info(ic, NULL);
     if (err < 0)
     {
         CV_WARN("Could not find codec parameters");
         goto exit_func;
     }
+    n_threads = DecodingThreadsLimit::acquire(requested_threads > 0 ? requested_threads : get_number_of_cpus());
     for(i = 0; i < ic->nb_streams; i++)
     {
         AVCodecContext* enc = ic->streams[i]->codec;
 
 //#ifdef FF_API_THREAD_INIT
-//        avcodec_thread_init(enc, get_number_of_cpus());
+//        avcodec_thread_init(enc, n_threads);
 //#else
-        enc->thread_count = get_number_of_cpus();
+        enc->thread_count = n_threads;
 //#endif
+        if (thread_type != 0)
+            enc->thread_type = thread_type;
 
         AVDictionaryEntry* avdiscard_entry = av_dict_get(dict, "avdiscard", NULL, 0);
 
@@ -1566,6 +1665,10 @@ double CvCapture_FFMPEG::getProperty( int property_id ) const
 #else
         return 0;
 #endif
+    case CAP_PROP_N_THREADS:
+        return static_cast<double>(video_st->codec->thread_count);
+    case CAP_PROP_THREAD_TYPE:
+        return static_cast<double>(video_st->codec->active_thread_type);
 #if USE_AV_HW_CODECS
     case CAP_PROP_HW_ACCELERATION:
         return static_cast<double>(va_type);
@@ -1668,6 +1771,9 @@ void CvCapture_FFMPEG::seek(int64_t _frame_number)
     if( first_frame_number < 0 && get_total_frames() > 1 )
         grabFrame();
 
+    if( _frame_number > 0 && seekKeyframe(_frame_number) )
+        return;
+
     for(;;)
     {
         int64_t _frame_number_temp = std::max(_frame_number-delta, (int64_t)0);
@@ -1716,6 +1822,164 @@ void CvCapture_FFMPEG::seek(int64_t _frame_number)
     }
 }
 
+// Decodes frames starting from the nearest key frame preceding the requested frame, so the position
+// is exact and the decoding is not repeated. Returns false if the key frame index can't be used.
+bool CvCapture_FFMPEG::seekKeyframe(int64_t _frame_number)
+{
+    if (!keyframes_indexed)
+        buildKeyframeIndex();
+    if (keyframes.empty() || first_frame_number < 0)
+        return false;
+
+    std::vector<int64_t>::const_iterator it = std::upper_bound(keyframes.begin(), keyframes.end(), _frame_number,
+        [this](int64_t n, int64_t ts) { return n < dts_to_frame_number(ts) - first_frame_number; });
+    if (it == keyframes.begin())
+        return false;
+    const int64_t keyframe_ts = *(it - 1);
+    const int64_t keyframe_number = dts_to_frame_number(keyframe_ts) - first_frame_number;
+
+    // continue decoding if there are no key frames between the current and the requested frames
+    if (!(keyframe_number < frame_number && frame_number <= _frame_number))
+    {
+        // DTS of a key frame doesn't exceed its PTS, so the backward seek lands on this key frame
+        if (av_seek_frame(ic, video_stream, keyframe_ts, AVSEEK_FLAG_BACKWARD) < 0)
+            return false;
+        avcodec_flush_buffers(ic->streams[video_stream]->codec);
+        frame_number = keyframe_number;
+    }
+
+    while (frame_number < _frame_number)
+    {
+        if (!grabFrame() || picture_pts == AV_NOPTS_VALUE_)
+            return false;
+        const int64_t decoded_number = dts_to_frame_number(picture_pts) - first_frame_number;
+        if (decoded_number >= _frame_number)
+            return false;  // timestamps of the index don't match the decoded frames
+        frame_number = decoded_number + 1;
+    }
+    return true;
+}
+
+// Key frame positions are taken from the demuxer index if the container has it (mp4, mkv, avi), otherwise
+// the packets of the file are read without decoding. Set OPENCV_FFMPEG_KEYFRAME_INDEX_CACHE=1 to store
+// the index in the '<filename>.keyframes' file next to the video and to reuse it.
+void CvCapture_FFMPEG::buildKeyframeIndex()
+{
+    keyframes_indexed = true;
+    keyframes.clear();
+    if (rawMode || source_name.empty() || !ic->pb || !(ic->pb->seekable & AVIO_SEEKABLE_NORMAL))
+        return;
+
+    std::string cache_path;
+#ifndef NO_GETENV
+    const char* cache_option = getenv("OPENCV_FFMPEG_KEYFRAME_INDEX_CACHE");
+    if (cache_option && atoi(cache_option) != 0)
+        cache_path = source_name + ".keyframes";
+#endif
+    if (!cache_path.empty() && loadKeyframeIndex(cache_path))
+        return;
+
+    std::vector<int64_t> index_ts;
+    if (!(ic->iformat->flags & AVFMT_GENERIC_INDEX))
+    {
+        AVStream* st = ic->streams[video_stream];
+#if LIBAVFORMAT_BUILD >= CALC_FFMPEG_VERSION(58, 78, 100)
+        const int count = avformat_index_get_entries_count(st);
+        for (int i = 0; i < count; i++)
+        {
+            const AVIndexEntry* entry = avformat_index_get_entry(st, i);
+            if (entry && (entry->flags & AVINDEX_KEYFRAME))
+                index_ts.push_back(entry->timestamp);
+        }
+#else
+        for (int i = 0; i < st->nb_index_entries; i++)
+        {
+            if (st->index_entries[i].flags & AVINDEX_KEYFRAME)
+                index_ts.push_back(st->index_entries[i].timestamp);
+        }
+#endif
+    }
+
+    if (scanKeyframes(index_ts) || (!index_ts.empty() && scanKeyframes(std::vector<int64_t>())))
+    {
+        std::sort(keyframes.begin(), keyframes.end());
+        keyframes.erase(std::unique(keyframes.begin(), keyframes.end()), keyframes.end());
+        if (!cache_path.empty())
+            saveKeyframeIndex(cache_path);
+    }
+}
+
+// Collects PTS of key frame packets, frame numbers are computed from PTS of decoded frames.
+// Entries of the demuxer index are DTS for some containers (mp4, mov), which precede PTS of
+// the same frames in streams with B-frames, so the packets at the positions of @p index_ts are read.
+// The whole file is read if @p index_ts is empty.
+bool CvCapture_FFMPEG::scanKeyframes(const std::vector<int64_t>& index_ts)
+{
+    AVFormatContext* scan_ic = NULL;
+    if (avformat_open_input(&scan_ic, source_name.c_str(), ic->iformat, NULL) < 0)
+        return false;
+
+    AVPacket scan_packet;
+    memset(&scan_packet, 0, sizeof(scan_packet));
+    av_init_packet(&scan_packet);
+    size_t next = 0;
+    if (!index_ts.empty() && av_seek_frame(scan_ic, video_stream, index_ts[next], AVSEEK_FLAG_BACKWARD) < 0)
+        next = index_ts.size();
+    while ((index_ts.empty() || next < index_ts.size()) && av_read_frame(scan_ic, &scan_packet) >= 0)
+    {
+        const bool isVideo = scan_packet.stream_index == video_stream;
+        if (isVideo && (scan_packet.flags & AV_PKT_FLAG_KEY))
+        {
+            const int64_t ts = scan_packet.pts != AV_NOPTS_VALUE_ ? scan_packet.pts : scan_packet.dts;
+            if (ts != AV_NOPTS_VALUE_)
+                keyframes.push_back(ts);
+        }
+        _opencv_ffmpeg_av_packet_unref(&scan_packet);
+        // the first video packet after the seek is the indexed key frame
+        if (isVideo && !index_ts.empty() && ++next < index_ts.size() &&
+            av_seek_frame(scan_ic, video_stream, index_ts[next], AVSEEK_FLAG_BACKWARD) < 0)
+            break;
+    }
+    avformat_close_input(&scan_ic);
+    return !keyframes.empty();
+}
+
+// The cache is valid for the file of the same size only
+bool CvCapture_FFMPEG::loadKeyframeIndex(const std::string& path)
+{
+    std::ifstream f(path.c_str());
+    std::string header;
+    int64_t file_size = -1, count = 0;
+    int stream = -1;
+    if (!std::getline(f, header) || header != "OpenCV FFmpeg keyframe index v2" ||
+        !(f >> file_size >> stream >> count) || file_size != avio_size(ic->pb) || stream != video_stream || count <= 0)
+        return false;
+    keyframes.resize((size_t)count);
+    for (size_t i = 0; i < keyframes.size(); i++)
+    {
+        if (!(f >> keyframes[i]) || (i > 0 && keyframes[i] <= keyframes[i - 1]))
+        {
+            keyframes.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void CvCapture_FFMPEG::saveKeyframeIndex(const std::string& path) const
+{
+    std::ofstream f(path.c_str());
+    if (!f.is_open())
+    {
+        CV_LOG_DEBUG(NULL, "VIDEOIO/FFMPEG: can't write key frame index: " << path);
+        return;
+    }
+    f << "OpenCV FFmpeg keyframe index v2" << std::endl;
+    f << avio_size(ic->pb) << " " << video_stream << " " << keyframes.size() << std::endl;
+    for (size_t i = 0; i < keyframes.size(); i++)
+        f << keyframes[i] << std::endl;
+}
+
 void CvCapture_FFMPEG::seek(double sec)
 {
     seek((int64_t)(sec * get_fps() + 0.5));
@@ -1800,6 +2064,7 @@ struct CvVideoWriter_FFMPEG
     VideoAccelerationType va_type;
     int               hw_device;
     int               use_opencl;
+    int               n_threads;  // -1 - the encoder default
 };
 
 static const char * icvFFMPEGErrStr(int err)
@@ -1863,6 +2128,7 @@ void CvVideoWriter_FFMPEG::init()
     va_type = VIDEO_ACCELERATION_NONE;
     hw_device = -1;
     use_opencl = 0;
+    n_threads = -1;
     ok = false;
 }
 
@@ -2275,6 +2541,10 @@ bool CvVideoWriter_FFMPEG::writeHWFrame(cv::InputArray input) {
 double CvVideoWriter_FFMPEG::getProperty(int propId) const
 {
     CV_UNUSED(propId);
+    if (propId == VIDEOWRITER_PROP_N_THREADS)
+    {
+        return video_st ? static_cast<double>(video_st->codec->thread_count) : 0;
+    }
 #if USE_AV_HW_CODECS
     if (propId == VIDEOWRITER_PROP_HW_ACCELERATION)
     {
@@ -2444,6 +2714,15 @@ bool CvVideoWriter_FFMPEG::open( const char * filename, int fourcc,
     if (params.has(VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL)) {
         use_opencl = params.get<int>(VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL);
     }
+    if (params.has(VIDEOWRITER_PROP_N_THREADS))
+    {
+        n_threads = params.get<int>(VIDEOWRITER_PROP_N_THREADS);
+        if (n_threads < 0)
+        {
+            CV_LOG_ERROR(NULL, "VIDEOIO/FFMPEG: VIDEOWRITER_PROP_N_THREADS parameter value is invalid: " << n_threads);
+            return false;
+        }
+    }
 
     if (params.warnUnusedParameters())
     {
@@ -2743,6 +3022,8 @@ bool CvVideoWriter_FFMPEG::open( const char * filename, int fourcc,
 #endif
 
         c->codec_tag = fourcc;
+        if (n_threads >= 0)
+            c->thread_count = n_threads;
 
 #if USE_AV_HW_CODECS
         if (hw_device_ctx) {
@@ -2862,16 +3143,13 @@ bool CvVideoWriter_FFMPEG::open( const char * filename, int fourcc,
 static
 CvCapture_FFMPEG* cvCreateFileCaptureWithParams_FFMPEG(const char* filename, const VideoCaptureParameters& params)
 {
-    // FIXIT: remove unsafe malloc() approach
-    CvCapture_FFMPEG* capture = (CvCapture_FFMPEG*)malloc(sizeof(*capture));
-    if (!capture)
-        return 0;
+    CvCapture_FFMPEG* capture = new CvCapture_FFMPEG();
     capture->init();
     if (capture->open(filename, params))
         return capture;
 
     capture->close();
-    free(capture);
+    delete capture;
     return 0;
 }
 
@@ -2880,7 +3158,7 @@ void cvReleaseCapture_FFMPEG(CvCapture_FFMPEG** capture)
     if( capture && *capture )
     {
         (*capture)->close();
-        free(*capture);
+        delete *capture;
         *capture = 0;
     }
 }
@@ -221,6 +221,10 @@ public:
     virtual int getCaptureDomain() { return CAP_ANY; } // Return the type of the capture object: CAP_DSHOW, etc...
 };
 
+//! Decodes frames of the opened capture in the background thread (see CAP_PROP_PREFETCH_FRAMES)
+Ptr<IVideoCapture> createPrefetchCapture(const Ptr<IVideoCapture>& cap, int numFrames, bool dropOldest);
+bool isPrefetchCapture(const Ptr<IVideoCapture>& cap);
+
 class IVideoWriter
 {
 public:
@@ -229,9 +233,13 @@ public:
     virtual bool setProperty(int, double) { return false; }
     virtual bool isOpened() const = 0;
     virtual void write(InputArray) = 0;
+    virtual void flush() {}  // waits for the frames passed to write()
     virtual int getCaptureDomain() const { return cv::CAP_ANY; } // Return the type of the capture object: CAP_FFMPEG, etc...
 };
 
+//! Encodes frames in the background thread (see VIDEOWRITER_PROP_ASYNC_FRAMES)
+Ptr<IVideoWriter> createAsyncWriter(const Ptr<IVideoWriter>& writer, int numFrames);
+
 namespace internal {
 class VideoCapturePrivateAccessor
 {
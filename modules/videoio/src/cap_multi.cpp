@@ -0,0 +1,360 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace cv {
+
+class MultiVideoCapture::Impl
+{
+    struct Stream
+    {
+        Stream() : finished(false), busy(false) {}
+
+        VideoCapture cap;
+        std::mutex capMutex;  // held while the stream is read
+        bool finished;
+        bool busy;            // the background worker is reading the stream
+        Mat frame;            // the frame decoded in advance by the background worker
+    };
+
+public:
+    Impl() : started(false), stop(false), next(0) {}
+
+    ~Impl()
+    {
+        release();
+    }
+
+    int add(VideoCapture& cap)
+    {
+        if (!cap.isOpened())
+            return -1;
+        Ptr<Stream> stream = makePtr<Stream>();
+        stream->cap = cap;
+        std::lock_guard<std::mutex> lock(mutex);
+        streams.push_back(stream);
+        cond.notify_all();
+        return (int)streams.size() - 1;
+    }
+
+    int getNumStreams() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return (int)streams.size();
+    }
+
+    bool isFinished(int idx) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return getStream(idx)->finished;
+    }
+
+    double get(int idx, int propId) const
+    {
+        Ptr<Stream> stream;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stream = getStream(idx);
+        }
+        std::lock_guard<std::mutex> capLock(stream->capMutex);
+        return stream->cap.get(propId);
+    }
+
+    // Reads the next frame from each stream which is not finished in parallel
+    void readAll(std::vector<Mat>& frames, std::vector<int>& streamIds)
+    {
+        std::vector< Ptr<Stream> > active;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            CV_Assert(!started && "MultiVideoCapture: synchronized reading can't be mixed with readReady()");
+            for (size_t i = 0; i < streams.size(); i++)
+            {
+                if (!streams[i]->finished)
+                {
+                    active.push_back(streams[i]);
+                    streamIds.push_back((int)i);
+                }
+            }
+        }
+
+        std::vector<Mat> result(active.size());
+        parallel_for_(Range(0, (int)active.size()), [&](const Range& range)
+        {
+            for (int i = range.start; i < range.end; i++)
+                readStream(*active[i], result[i]);
+        });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < active.size(); i++)
+        {
+            if (!result[i].empty())
+            {
+                frames.push_back(result[i]);
+                streamIds[frames.size() - 1] = streamIds[i];
+            }
+            else
+                active[i]->finished = true;
+        }
+        streamIds.resize(frames.size());
+    }
+
+    void readReady(std::vector<Mat>& frames, std::vector<int>& streamIds, int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!started)
+            startWorkers();
+
+        auto hasResult = [&]
+        {
+            bool pending = false;
+            for (size_t i = 0; i < streams.size(); i++)
+            {
+                if (!streams[i]->frame.empty())
+                    return true;
+                pending |= !streams[i]->finished;
+            }
+            return !pending;
+        };
+        if (timeoutMs < 0)
+            cond.wait(lock, hasResult);
+        else
+            cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), hasResult);
+
+        for (size_t i = 0; i < streams.size(); i++)
+        {
+            Stream& stream = *streams[i];
+            if (!stream.frame.empty())
+            {
+                frames.push_back(stream.frame);
+                streamIds.push_back((int)i);
+                stream.frame.release();
+            }
+        }
+        cond.notify_all();
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_all();
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+        workers.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        streams.clear();
+        started = stop = false;
+        next = 0;
+    }
+
+private:
+    const Ptr<Stream>& getStream(int idx) const
+    {
+        CV_Assert(0 <= idx && idx < (int)streams.size());
+        return streams[idx];
+    }
+
+    // Returns an empty frame if there are no more frames
+    static void readStream(Stream& stream, Mat& frame)
+    {
+        std::lock_guard<std::mutex> capLock(stream.capMutex);
+        try
+        {
+            if (stream.cap.read(frame))
+                return;
+        }
+        catch (const std::exception& e)
+        {
+            CV_LOG_ERROR(NULL, "VIDEOIO: MultiVideoCapture stream has failed: " << e.what());
+        }
+        frame.release();
+    }
+
+    // Must be called under the lock
+    void startWorkers()
+    {
+        started = true;
+        const int numWorkers = std::max(1, std::min((int)streams.size(), getNumThreads()));
+        for (int i = 0; i < numWorkers; i++)
+            workers.push_back(std::thread(&Impl::run, this));
+    }
+
+    // Selects the next stream which frame is consumed, round-robin. Must be called under the lock.
+    Ptr<Stream> takeStream()
+    {
+        for (size_t k = 0; k < streams.size(); k++)
+        {
+            const size_t i = (next + k) % streams.size();
+            Stream& stream = *streams[i];
+            if (!stream.finished && !stream.busy && stream.frame.empty())
+            {
+                next = i + 1;
+                stream.busy = true;
+                return streams[i];
+            }
+        }
+        return Ptr<Stream>();
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            Ptr<Stream> stream;
+            cond.wait(lock, [&]{ return stop || !(stream = takeStream()).empty(); });
+            if (stop)
+            {
+                if (stream)
+                    stream->busy = false;
+                break;
+            }
+
+            lock.unlock();
+            Mat frame;
+            readStream(*stream, frame);
+            lock.lock();
+
+            stream->frame = frame;
+            stream->finished = frame.empty();
+            stream->busy = false;
+            cond.notify_all();
+        }
+    }
+
+    std::vector< Ptr<Stream> > streams;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::thread> workers;
+    bool started, stop;
+    size_t next;
+};
+
+static void assignFrames(std::vector<Mat>& src, OutputArrayOfArrays dst)
+{
+    if (dst.kind() == _InputArray::STD_VECTOR_MAT)
+    {
+        std::swap(*(std::vector<Mat>*)dst.getObj(), src);
+        return;
+    }
+    dst.create((int)src.size(), 1, 0, -1, true);
+    dst.assign(src);
+}
+
+MultiVideoCapture::MultiVideoCapture() : p(makePtr<Impl>()) {}
+
+MultiVideoCapture::~MultiVideoCapture() {}
+
+int MultiVideoCapture::add(const String& filename, int apiPreference, const std::vector<int>& params)
+{
+    VideoCapture cap(filename, apiPreference, params);
+    return p->add(cap);
+}
+
+int MultiVideoCapture::add(int index, int apiPreference, const std::vector<int>& params)
+{
+    VideoCapture cap(index, apiPreference, params);
+    return p->add(cap);
+}
+
+int MultiVideoCapture::getNumStreams() const
+{
+    return p->getNumStreams();
+}
+
+bool MultiVideoCapture::isFinished(int streamIdx) const
+{
+    return p->isFinished(streamIdx);
+}
+
+double MultiVideoCapture::get(int streamIdx, int propId) const
+{
+    return p->get(streamIdx, propId);
+}
+
+bool MultiVideoCapture::read(OutputArrayOfArrays frames, std::vector<int>& streamIds)
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> result;
+    streamIds.clear();
+    p->readAll(result, streamIds);
+    assignFrames(result, frames);
+    return !streamIds.empty();
+}
+
+bool MultiVideoCapture::readBlob(OutputArray blob, std::vector<int>& streamIds, const Size& size,
+                                 double scalefactor, const Scalar& mean, bool swapRB)
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> frames;
+    streamIds.clear();
+    p->readAll(frames, streamIds);
+    if (frames.empty())
+    {
+        blob.release();
+        return false;
+    }
+
+    const Size blobSize = size.empty() ? frames[0].size() : size;
+    const int cn = frames[0].channels();
+    CV_CheckLE(cn, 4, "");
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        CV_CheckEQ(frames[i].channels(), cn, "All frames must have the same number of channels");
+        if (size.empty())
+            CV_CheckEQ(frames[i].size(), blobSize, "All frames must have the same size if the blob size is not specified");
+    }
+
+    const int shape[] = { (int)frames.size(), cn, blobSize.height, blobSize.width };
+    blob.create(4, shape, CV_32F);
+    Mat dst = blob.getMat();
+    parallel_for_(Range(0, (int)frames.size()), [&](const Range& range)
+    {
+        for (int n = range.start; n < range.end; n++)
+        {
+            Mat img = frames[n];
+            if (img.size() != blobSize)
+                resize(img, img, blobSize, 0, 0, INTER_LINEAR);
+            std::vector<Mat> channels;
+            split(img, channels);
+            for (int c = 0; c < cn; c++)
+            {
+                // the blob plane is written by the conversion in place
+                const int k = swapRB && cn >= 3 && c != 1 && c < 3 ? 2 - c : c;
+                Mat plane(blobSize, CV_32F, dst.ptr<float>(n, k));
+                channels[c].convertTo(plane, CV_32F, scalefactor, -mean[k] * scalefactor);
+            }
+        }
+    });
+    return true;
+}
+
+bool MultiVideoCapture::readReady(OutputArrayOfArrays frames, std::vector<int>& streamIds, int timeoutMs)
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> result;
+    streamIds.clear();
+    p->readReady(result, streamIds, timeoutMs);
+    assignFrames(result, frames);
+    return !streamIds.empty();
+}
+
+void MultiVideoCapture::release()
+{
+    p->release();
+}
+
+}  // namespace cv
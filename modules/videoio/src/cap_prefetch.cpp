@@ -0,0 +1,234 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cv {
+
+// Decodes frames of the wrapped capture in the background thread into the bounded queue.
+// The frame buffers are reused unless the caller still holds the previously retrieved frames.
+class PrefetchCapture CV_FINAL : public IVideoCapture
+{
+    struct Frame
+    {
+        Mat image;
+        double posMsec;
+        double posFrames;
+    };
+
+public:
+    PrefetchCapture(const Ptr<IVideoCapture>& cap_, int numFrames_, bool dropOldest_)
+        : cap(cap_), numFrames(numFrames_), dropOldest(dropOldest_), stop(false), eof(false), numDropped(0)
+    {
+        CV_Assert(cap && cap->isOpened());
+        CV_CheckGT(numFrames, 0, "");
+        current.posMsec = cap->getProperty(CAP_PROP_POS_MSEC);
+        current.posFrames = cap->getProperty(CAP_PROP_POS_FRAMES);
+        worker = std::thread(&PrefetchCapture::run, this);
+    }
+
+    ~PrefetchCapture()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_all();
+        worker.join();
+    }
+
+    double getProperty(int propId) const CV_OVERRIDE
+    {
+        switch (propId)
+        {
+        case CAP_PROP_PREFETCH_FRAMES:
+            return numFrames;
+        case CAP_PROP_PREFETCH_DROP_OLDEST:
+            return dropOldest ? 1 : 0;
+        case CAP_PROP_PREFETCH_DROPPED:
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return (double)numDropped;
+        }
+        case CAP_PROP_POS_MSEC:
+        case CAP_PROP_POS_FRAMES:
+        {
+            // the position of the wrapped capture is ahead by the number of the prefetched frames
+            std::lock_guard<std::mutex> lock(mutex);
+            return propId == CAP_PROP_POS_MSEC ? current.posMsec : current.posFrames;
+        }
+        default:
+        {
+            std::lock_guard<std::mutex> lock(capMutex);
+            return cap->getProperty(propId);
+        }
+        }
+    }
+
+    bool setProperty(int propId, double value) CV_OVERRIDE
+    {
+        if (propId == CAP_PROP_PREFETCH_FRAMES || propId == CAP_PROP_PREFETCH_DROP_OLDEST)
+            return false;  // open-only
+
+        std::lock_guard<std::mutex> capLock(capMutex);
+        bool result = cap->setProperty(propId, value);
+        if (propId == CAP_PROP_POS_MSEC || propId == CAP_PROP_POS_FRAMES || propId == CAP_PROP_POS_AVI_RATIO)
+        {
+            // the prefetched frames are dropped after seeking
+            std::lock_guard<std::mutex> lock(mutex);
+            while (!ready.empty())
+            {
+                recycle(ready.front().image);
+                ready.pop_front();
+            }
+            current.posMsec = cap->getProperty(CAP_PROP_POS_MSEC);
+            current.posFrames = cap->getProperty(CAP_PROP_POS_FRAMES);
+            eof = false;
+            cond.notify_all();
+        }
+        return result;
+    }
+
+    bool grabFrame() CV_OVERRIDE
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]{ return !ready.empty() || eof; });
+        if (ready.empty())
+            return false;
+        recycle(current.image);
+        current = std::move(ready.front());
+        ready.pop_front();
+        cond.notify_all();
+        return true;
+    }
+
+    bool retrieveFrame(int channel, OutputArray image) CV_OVERRIDE
+    {
+        // only the default channel is prefetched
+        if (channel != 0 || current.image.empty())
+        {
+            image.release();
+            return false;
+        }
+        if (image.isMat() && !image.fixedType() && !image.fixedSize())
+            image.assign(current.image);  // the buffer is not reused while the caller holds it
+        else
+            current.image.copyTo(image);
+        return true;
+    }
+
+    bool isOpened() const CV_OVERRIDE
+    {
+        return true;
+    }
+
+    int getCaptureDomain() CV_OVERRIDE
+    {
+        return cap->getCaptureDomain();
+    }
+
+private:
+    // Returns the buffer of the consumed frame to the pool. Must be called under the lock.
+    void recycle(Mat& image)
+    {
+        if (!image.empty())
+            pool.push_back(image);
+        image.release();
+    }
+
+    // Takes the buffer for the next frame from the pool. Must be called under the lock.
+    void takeBuffer(Mat& image)
+    {
+        while (!pool.empty())
+        {
+            Mat buffer = pool.back();
+            pool.pop_back();
+            // the buffer is not referenced outside if the local header is the only owner
+            if (buffer.u && CV_XADD(&buffer.u->refcount, 0) == 1)
+            {
+                image = buffer;
+                return;
+            }
+        }
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait(lock, [&]{ return stop || (!eof && (dropOldest || (int)ready.size() < numFrames)); });
+            if (stop)
+                break;
+
+            Frame frame;
+            takeBuffer(frame.image);
+            lock.unlock();
+
+            std::lock_guard<std::mutex> capLock(capMutex);
+            bool ok = false;
+            try
+            {
+                ok = cap->grabFrame() && cap->retrieveFrame(0, frame.image) && !frame.image.empty();
+                frame.posMsec = cap->getProperty(CAP_PROP_POS_MSEC);
+                frame.posFrames = cap->getProperty(CAP_PROP_POS_FRAMES);
+            }
+            catch (const std::exception& e)
+            {
+                CV_LOG_ERROR(NULL, "VIDEOIO: exception in the prefetching thread: " << e.what());
+                ok = false;
+            }
+
+            // the frame is queued while the capture is locked, so it is never older than a seek
+            lock.lock();
+            if (ok)
+            {
+                if ((int)ready.size() >= numFrames)
+                {
+                    recycle(ready.front().image);
+                    ready.pop_front();
+                    numDropped++;
+                }
+                ready.push_back(std::move(frame));
+            }
+            else
+            {
+                recycle(frame.image);
+                eof = true;
+            }
+            cond.notify_all();
+        }
+    }
+
+    Ptr<IVideoCapture> cap;
+    const int numFrames;
+    const bool dropOldest;
+
+    mutable std::mutex capMutex;  // the wrapped capture is accessed by both threads
+    mutable std::mutex mutex;     // the queue and the state, locked after capMutex if both are needed
+    std::condition_variable cond;
+    std::deque<Frame> ready;
+    std::vector<Mat> pool;
+    Frame current;
+    bool stop, eof;
+    int64 numDropped;
+    std::thread worker;
+};
+
+Ptr<IVideoCapture> createPrefetchCapture(const Ptr<IVideoCapture>& cap, int numFrames, bool dropOldest)
+{
+    return makePtr<PrefetchCapture>(cap, numFrames, dropOldest);
+}
+
+bool isPrefetchCapture(const Ptr<IVideoCapture>& cap)
+{
+    return dynamic_cast<const PrefetchCapture*>(cap.get()) != NULL;
+}
+
+}  // namespace cv
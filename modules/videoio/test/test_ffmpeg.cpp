@@ -476,6 +476,110 @@ static void ffmpeg_check_read_raw(VideoCapture& cap)
     EXPECT_EQ((size_t)37118, data.total());
 }
 
+typedef tuple<string, string> FourCC_Ext;
+typedef testing::TestWithParam< FourCC_Ext > videoio_ffmpeg_seek;
+
+TEST_P(videoio_ffmpeg_seek, random_access)
+{
+    if (!videoio_registry::hasBackend(CAP_FFMPEG))
+        throw SkipTestException("FFmpeg backend was not found");
+
+    const string fourcc = get<0>(GetParam());
+    const string ext = get<1>(GetParam());
+    const string filename = tempfile(("seek_random_access." + ext).c_str());
+    const int numFrames = 100;
+    {
+        VideoWriter writer(filename, CAP_FFMPEG, fourccFromString(fourcc), 25, Size(160, 120));
+        if (!writer.isOpened())
+            throw SkipTestException(fourcc + "/" + ext + " codec is not supported");
+        for (int i = 0; i < numFrames; i++)
+        {
+            Mat img(120, 160, CV_8UC3, Scalar::all(0));
+            putText(img, format("%d", i), Point(20, 80), FONT_HERSHEY_SIMPLEX, 2, Scalar::all(255), 3);
+            writer << img;
+        }
+    }
+
+    VideoCapture cap(filename, CAP_FFMPEG);
+    ASSERT_TRUE(cap.isOpened());
+    vector<Mat> frames;
+    for (Mat frame; cap.read(frame);)
+        frames.push_back(frame.clone());
+    ASSERT_EQ((size_t)numFrames, frames.size());
+
+    // backward, forward within GOP and far forward seeks decode the exact frame
+    const int positions[] = { 50, 3, 4, 7, 97, 0, 61, 60, 99, 13, 1, 38 };
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++)
+    {
+        const int pos = positions[i];
+        ASSERT_TRUE(cap.set(CAP_PROP_POS_FRAMES, pos));
+        EXPECT_EQ(pos, cap.get(CAP_PROP_POS_FRAMES));
+        Mat frame;
+        ASSERT_TRUE(cap.read(frame)) << pos;
+        EXPECT_EQ(0, cvtest::norm(frames[pos], frame, NORM_INF)) << pos;
+        EXPECT_EQ(pos + 1, cap.get(CAP_PROP_POS_FRAMES));
+    }
+
+    cap.release();
+    remove(filename.c_str());
+}
+
+const FourCC_Ext seek_entries[] =
+{
+    make_tuple("mp4v", "avi"),
+    make_tuple("H264", "mp4"),  // B-frames, DTS of the demuxer index differ from PTS
+};
+
+INSTANTIATE_TEST_CASE_P(videoio, videoio_ffmpeg_seek, testing::ValuesIn(seek_entries));
+
+TEST(videoio_ffmpeg, decoding_threads)
+{
+    if (!videoio_registry::hasBackend(CAP_FFMPEG))
+        throw SkipTestException("FFmpeg backend was not found");
+
+    const string filename = tempfile("decoding_threads.avi");
+    {
+        VideoWriter writer(filename, CAP_FFMPEG, VideoWriter::fourcc('m', 'p', '4', 'v'), 25, Size(320, 240));
+        if (!writer.isOpened())
+            throw SkipTestException("mp4v codec is not supported");
+        for (int i = 0; i < 30; i++)
+        {
+            Mat img(240, 320, CV_8UC3, Scalar::all(i * 8));
+            circle(img, Point(10 * i, 120), 20, Scalar(0, 0, 255), -1);
+            writer << img;
+        }
+    }
+
+    VideoCapture ref(filename, CAP_FFMPEG, { CAP_PROP_N_THREADS, 1 });
+    ASSERT_TRUE(ref.isOpened());
+    EXPECT_EQ(1, ref.get(CAP_PROP_N_THREADS));
+    EXPECT_EQ(0, ref.get(CAP_PROP_THREAD_TYPE));  // single-threaded decoding
+
+    const int thread_types[] = { 1, 2, 3 };
+    for (size_t i = 0; i < sizeof(thread_types) / sizeof(thread_types[0]); i++)
+    {
+        VideoCapture cap(filename, CAP_FFMPEG, { CAP_PROP_N_THREADS, 3, CAP_PROP_THREAD_TYPE, thread_types[i] });
+        ASSERT_TRUE(cap.isOpened());
+        EXPECT_EQ(3, cap.get(CAP_PROP_N_THREADS));
+        EXPECT_EQ(0, (int)cap.get(CAP_PROP_THREAD_TYPE) & ~thread_types[i]);
+        ASSERT_TRUE(ref.set(CAP_PROP_POS_FRAMES, 0));
+        int count = 0;
+        for (Mat frame, refFrame; ref.read(refFrame); count++)
+        {
+            ASSERT_TRUE(cap.read(frame)) << count;
+            EXPECT_EQ(0, cvtest::norm(refFrame, frame, NORM_INF)) << count;
+        }
+        EXPECT_EQ(30, count);
+    }
+
+    VideoCapture cap;
+    EXPECT_FALSE(cap.open(filename, CAP_FFMPEG, { CAP_PROP_N_THREADS, -1 }));
+    EXPECT_FALSE(cap.open(filename, CAP_FFMPEG, { CAP_PROP_THREAD_TYPE, 4 }));
+
+    ref.release();
+    remove(filename.c_str());
+}
+
 TEST(videoio_ffmpeg, open_with_property)
 {
     if (!videoio_registry::hasBackend(CAP_FFMPEG))
@@ -42,6 +42,7 @@
 
 #include "test_precomp.hpp"
 #include "opencv2/videoio/videoio_c.h"
+#include <thread>
 
 namespace opencv_test
 {
@@ -649,6 +650,276 @@ TEST_P(safe_capture, frames_independency)
 static VideoCaptureAPIs safe_apis[] = {CAP_FFMPEG, CAP_GSTREAMER, CAP_MSMF,CAP_AVFOUNDATION};
 INSTANTIATE_TEST_CASE_P(videoio, safe_capture, testing::ValuesIn(safe_apis));
 
+TEST(Videoio_Prefetch, read_seek)
+{
+    const string filename = cv::tempfile(".avi");
+    const int numFrames = 20;
+    {
+        VideoWriter writer(filename, CAP_OPENCV_MJPEG, VideoWriter::fourcc('M', 'J', 'P', 'G'), 25, Size(64, 48));
+        ASSERT_TRUE(writer.isOpened());
+        for (int i = 0; i < numFrames; i++)
+        {
+            Mat frame(48, 64, CV_8UC3, Scalar::all(i * 10));
+            putText(frame, format("%d", i), Point(10, 30), FONT_HERSHEY_SIMPLEX, 0.8, Scalar(0, 0, 255));
+            writer << frame;
+        }
+    }
+
+    VideoCapture ref(filename, CAP_OPENCV_MJPEG);
+    ASSERT_TRUE(ref.isOpened());
+    vector<Mat> refFrames;
+    for (Mat frame; ref.read(frame);)
+        refFrames.push_back(frame.clone());
+    ASSERT_EQ((size_t)numFrames, refFrames.size());
+
+    VideoCapture cap(filename, CAP_OPENCV_MJPEG, { CAP_PROP_PREFETCH_FRAMES, 4 });
+    ASSERT_TRUE(cap.isOpened());
+    EXPECT_EQ(4, cap.get(CAP_PROP_PREFETCH_FRAMES));
+    EXPECT_EQ(CAP_OPENCV_MJPEG, cap.get(CAP_PROP_BACKEND));
+    EXPECT_EQ(64, cap.get(CAP_PROP_FRAME_WIDTH));
+
+    // retrieved frames stay valid while the caller holds them
+    vector<Mat> frames;
+    for (Mat frame; cap.read(frame);)
+    {
+        EXPECT_EQ((double)frames.size() + 1, cap.get(CAP_PROP_POS_FRAMES));
+        frames.push_back(frame);
+    }
+    ASSERT_EQ(refFrames.size(), frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+        EXPECT_EQ(0, cvtest::norm(refFrames[i], frames[i], NORM_INF)) << i;
+
+    ASSERT_TRUE(cap.set(CAP_PROP_POS_FRAMES, 5));
+    EXPECT_EQ(5, cap.get(CAP_PROP_POS_FRAMES));
+    Mat frame;
+    ASSERT_TRUE(cap.read(frame));
+    EXPECT_EQ(0, cvtest::norm(refFrames[5], frame, NORM_INF));
+    EXPECT_FALSE(cap.retrieve(frame, 1));
+
+    cap.release();
+    remove(filename.c_str());
+}
+
+TEST(Videoio_Prefetch, drop_oldest)
+{
+    const string filename = cv::tempfile(".avi");
+    {
+        VideoWriter writer(filename, CAP_OPENCV_MJPEG, VideoWriter::fourcc('M', 'J', 'P', 'G'), 25, Size(32, 32));
+        ASSERT_TRUE(writer.isOpened());
+        for (int i = 0; i < 50; i++)
+            writer << Mat(32, 32, CV_8UC3, Scalar::all(i * 5));
+    }
+
+    VideoCapture cap(filename, CAP_OPENCV_MJPEG, { CAP_PROP_PREFETCH_FRAMES, 2, CAP_PROP_PREFETCH_DROP_OLDEST, 1 });
+    ASSERT_TRUE(cap.isOpened());
+    EXPECT_EQ(1, cap.get(CAP_PROP_PREFETCH_DROP_OLDEST));
+    double pos = 0;
+    int count = 0;
+    for (Mat frame; cap.read(frame); count++)
+    {
+        EXPECT_GT(cap.get(CAP_PROP_POS_FRAMES), pos);
+        pos = cap.get(CAP_PROP_POS_FRAMES);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(50, count + cap.get(CAP_PROP_PREFETCH_DROPPED));
+    EXPECT_LE(count, 50);
+
+    cap.release();
+    remove(filename.c_str());
+}
+
+TEST(Videoio_Prefetch, invalid_params)
+{
+    VideoCapture cap;
+    EXPECT_THROW(cap.open("file.avi", CAP_OPENCV_MJPEG, { CAP_PROP_PREFETCH_FRAMES, -1 }), cv::Exception);
+}
+
+TEST(Videoio_Writer_Async, write_flush)
+{
+    const string refFile = cv::tempfile(".avi"), asyncFile = cv::tempfile(".avi");
+    const int fourcc = VideoWriter::fourcc('M', 'J', 'P', 'G');
+    const Size size(64, 48);
+    VideoWriter ref(refFile, CAP_OPENCV_MJPEG, fourcc, 25, size);
+    VideoWriter writer(asyncFile, CAP_OPENCV_MJPEG, fourcc, 25, size, { VIDEOWRITER_PROP_ASYNC_FRAMES, 3 });
+    ASSERT_TRUE(ref.isOpened());
+    ASSERT_TRUE(writer.isOpened());
+    EXPECT_EQ(3, writer.get(VIDEOWRITER_PROP_ASYNC_FRAMES));
+    EXPECT_EQ(CAP_OPENCV_MJPEG, writer.get(CAP_PROP_BACKEND));
+
+    Mat frame(size, CV_8UC3);
+    for (int i = 0; i < 30; i++)
+    {
+        frame.setTo(Scalar(i * 8, 100, 200 - i * 5));
+        putText(frame, format("%d", i), Point(10, 30), FONT_HERSHEY_SIMPLEX, 0.8, Scalar::all(255));
+        ref << frame;
+        writer << frame;  // the frame is reused by the caller immediately
+        EXPECT_LE(writer.get(VIDEOWRITER_PROP_ASYNC_QUEUED), 3);
+        if (i == 10)
+        {
+            writer.flush();
+            EXPECT_EQ(0, writer.get(VIDEOWRITER_PROP_ASYNC_QUEUED));
+        }
+    }
+    ref.release();
+    writer.release();
+
+    VideoCapture refCap(refFile, CAP_OPENCV_MJPEG), cap(asyncFile, CAP_OPENCV_MJPEG);
+    ASSERT_TRUE(cap.isOpened());
+    int count = 0;
+    for (Mat refFrame; refCap.read(refFrame); count++)
+    {
+        ASSERT_TRUE(cap.read(frame)) << count;
+        EXPECT_EQ(0, cvtest::norm(refFrame, frame, NORM_INF)) << count;
+    }
+    EXPECT_EQ(30, count);
+    EXPECT_FALSE(cap.read(frame));
+
+    remove(refFile.c_str());
+    remove(asyncFile.c_str());
+}
+
+TEST(Videoio_Writer_Async, invalid_params)
+{
+    VideoWriter writer;
+    EXPECT_THROW(writer.open(cv::tempfile(".avi"), CAP_OPENCV_MJPEG, VideoWriter::fourcc('M', 'J', 'P', 'G'), 25, Size(64, 48),
+                             { VIDEOWRITER_PROP_ASYNC_FRAMES, -1 }), cv::Exception);
+    EXPECT_NO_THROW(writer.flush());  // not opened
+}
+
+static string writeMultiCaptureVideo(int id, int numFrames)
+{
+    const string filename = cv::tempfile(".avi");
+    VideoWriter writer(filename, CAP_OPENCV_MJPEG, VideoWriter::fourcc('M', 'J', 'P', 'G'), 25, Size(64, 48));
+    EXPECT_TRUE(writer.isOpened());
+    for (int i = 0; i < numFrames; i++)
+    {
+        Mat frame(48, 64, CV_8UC3, Scalar(id * 60, i * 10, 100));
+        putText(frame, format("%d", i), Point(10, 30), FONT_HERSHEY_SIMPLEX, 0.8, Scalar::all(255));
+        writer << frame;
+    }
+    return filename;
+}
+
+TEST(Videoio_MultiVideoCapture, read)
+{
+    const int numFrames[] = { 5, 8, 3 };
+    vector<string> files;
+    vector< vector<Mat> > refFrames(3);
+    MultiVideoCapture streams;
+    for (int k = 0; k < 3; k++)
+    {
+        files.push_back(writeMultiCaptureVideo(k, numFrames[k]));
+        VideoCapture ref(files[k], CAP_OPENCV_MJPEG);
+        for (Mat frame; ref.read(frame);)
+            refFrames[k].push_back(frame.clone());
+        ASSERT_EQ((size_t)numFrames[k], refFrames[k].size());
+        EXPECT_EQ(k, streams.add(files[k], CAP_OPENCV_MJPEG));
+    }
+    EXPECT_EQ(-1, streams.add("this_does_not_exist.avi", CAP_OPENCV_MJPEG));
+    ASSERT_EQ(3, streams.getNumStreams());
+    EXPECT_EQ(64, streams.get(1, CAP_PROP_FRAME_WIDTH));
+
+    vector<Mat> frames;
+    vector<int> streamIds;
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(streams.read(frames, streamIds)) << i;
+        ASSERT_EQ(frames.size(), streamIds.size());
+        size_t n = 0;
+        for (int k = 0; k < 3; k++)
+        {
+            if (i >= numFrames[k])
+            {
+                EXPECT_TRUE(streams.isFinished(k));
+                continue;
+            }
+            ASSERT_LT(n, streamIds.size());
+            EXPECT_EQ(k, streamIds[n]);
+            EXPECT_EQ(0, cvtest::norm(refFrames[k][i], frames[n], NORM_INF)) << "stream=" << k << " frame=" << i;
+            n++;
+        }
+        EXPECT_EQ(n, frames.size());
+    }
+    EXPECT_FALSE(streams.read(frames, streamIds));
+    EXPECT_TRUE(streamIds.empty());
+
+    // ready-first mode returns all frames of all streams in order
+    MultiVideoCapture ready;
+    for (int k = 0; k < 3; k++)
+        ready.add(files[k], CAP_OPENCV_MJPEG);
+    vector<int> counts(3, 0);
+    while (ready.readReady(frames, streamIds, 10000))
+    {
+        ASSERT_EQ(frames.size(), streamIds.size());
+        for (size_t n = 0; n < frames.size(); n++)
+        {
+            const int k = streamIds[n];
+            ASSERT_LT(counts[k], numFrames[k]);
+            EXPECT_EQ(0, cvtest::norm(refFrames[k][counts[k]], frames[n], NORM_INF)) << "stream=" << k;
+            counts[k]++;
+        }
+    }
+    for (int k = 0; k < 3; k++)
+        EXPECT_EQ(numFrames[k], counts[k]);
+    EXPECT_THROW(ready.read(frames, streamIds), cv::Exception);
+
+    streams.release();
+    ready.release();
+    for (size_t k = 0; k < files.size(); k++)
+        remove(files[k].c_str());
+}
+
+TEST(Videoio_MultiVideoCapture, readBlob)
+{
+    vector<string> files;
+    MultiVideoCapture streams;
+    for (int k = 0; k < 2; k++)
+    {
+        files.push_back(writeMultiCaptureVideo(k, 2 + k));
+        streams.add(files[k], CAP_OPENCV_MJPEG);
+    }
+
+    VideoCapture ref(files[1], CAP_OPENCV_MJPEG);
+    const Scalar mean(10, 20, 30);
+    const double scale = 0.5;
+    Mat blob;
+    vector<int> streamIds;
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(streams.readBlob(blob, streamIds, Size(32, 40), scale, mean, true));
+        ASSERT_EQ(i < 2 ? 2u : 1u, streamIds.size());
+        ASSERT_EQ(4, blob.dims);
+        EXPECT_EQ(CV_32F, blob.type());
+        EXPECT_EQ((int)streamIds.size(), blob.size[0]);
+        EXPECT_EQ(3, blob.size[1]);
+        EXPECT_EQ(40, blob.size[2]);
+        EXPECT_EQ(32, blob.size[3]);
+
+        // the last sample is the frame of the second stream
+        Mat frame;
+        ASSERT_TRUE(ref.read(frame));
+        resize(frame, frame, Size(32, 40));
+        cvtColor(frame, frame, COLOR_BGR2RGB);
+        frame.convertTo(frame, CV_32F);
+        vector<Mat> channels;
+        split(frame, channels);
+        const int n = (int)streamIds.size() - 1;
+        EXPECT_EQ(1, streamIds[n]);
+        for (int c = 0; c < 3; c++)
+        {
+            Mat plane(40, 32, CV_32F, blob.ptr<float>(n, c));
+            Mat expected = (channels[c] - mean[c]) * scale;
+            EXPECT_LE(cvtest::norm(expected, plane, NORM_INF), 1e-4) << "frame=" << i << " channel=" << c;
+        }
+    }
+    EXPECT_FALSE(streams.readBlob(blob, streamIds));
+    EXPECT_TRUE(blob.empty());
+
+    streams.release();
+    for (size_t k = 0; k < files.size(); k++)
+        remove(files[k].c_str());
+}
+
 //==================================================================================================
 // TEST_P(videocapture_acceleration, ...)
 